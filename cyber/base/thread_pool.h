@@ -67,7 +67,8 @@ inline ThreadPool::ThreadPool(std::size_t threads, std::size_t max_task_num)
   }
 }
 
-// before using the return value, you should check value.valid()
+// before using the return value, you should check value.valid(), it is
+// invalid once the pool is stopped or its task queue is full
 template <typename F, typename... Args>
 auto ThreadPool::Enqueue(F&& f, Args&&... args)
     -> std::future<typename std::result_of<F(Args...)>::type> {
@@ -82,7 +83,9 @@ auto ThreadPool::Enqueue(F&& f, Args&&... args)
   if (stop_) {
     return std::future<return_type>();
   }
-  task_queue_.Enqueue([task]() { (*task)(); });
+  if (!task_queue_.Enqueue([task]() { (*task)(); })) {
+    return std::future<return_type>();
+  }
   return res;
 };
 
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/thread_pool.h"
+
+#include <future>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(ThreadPoolTest, Enqueue) {
+  ThreadPool pool(2);
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 10; ++i) {
+    results.emplace_back(pool.Enqueue([](int x) { return x * x; }, i));
+  }
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(results[i].valid());
+    EXPECT_EQ(i * i, results[i].get());
+  }
+}
+
+TEST(ThreadPoolTest, EnqueueFullQueue) {
+  ThreadPool pool(1, 2);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> started;
+  auto blocker = pool.Enqueue([&started, released]() {
+    started.set_value();
+    released.wait();
+  });
+  ASSERT_TRUE(blocker.valid());
+  started.get_future().wait();
+
+  // the only worker is busy, so the queue fills up and rejects the rest
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 10; ++i) {
+    results.emplace_back(pool.Enqueue([i]() { return i; }));
+  }
+  EXPECT_TRUE(results.front().valid());
+  EXPECT_FALSE(results.back().valid());
+
+  release.set_value();
+  blocker.get();
+  for (int i = 0; i < 10; ++i) {
+    if (results[i].valid()) {
+      EXPECT_EQ(i, results[i].get());
+    }
+  }
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
@@ -19,6 +19,10 @@
 #include <getopt.h>
 #include <libgen.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
 using apollo::cyber::common::GlobalData;
 
 namespace apollo {
@@ -34,6 +38,10 @@ void ModuleArgument::DisplayUsage() {
            "namespace for running this module, default in manager process\n"
         << "    -s, --sched_name=sched_name: sched policy "
            "conf for hole process, sched_name should be conf in cyber.pb.conf\n"
+        << "    -j, --init_thread_num=N: number of threads initializing "
+           "modules in parallel, default 1 initializes them one after the "
+           "other, 0 uses the number of cpus. Only for modules whose Init "
+           "does not depend on the others being initialized first\n"
         << "Example:\n"
         << "    " << binary_name_ << " -h\n"
         << "    " << binary_name_ << " -d dag_conf_file1 -d dag_conf_file2 "
@@ -52,6 +60,11 @@ void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
     sched_name_ = DEFAULT_sched_name_;
   }
 
+  if (init_thread_num_ <= 0) {
+    init_thread_num_ =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+
   GlobalData::Instance()->SetProcessGroup(process_group_);
   GlobalData::Instance()->SetSchedName(sched_name_);
   AINFO << "binary_name_ is " << binary_name_ << ", process_group_ is "
@@ -64,12 +77,13 @@ void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
 void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
   opterr = 0;  // extern int opterr
   int long_index = 0;
-  const std::string short_opts = "hd:p:s:";
+  const std::string short_opts = "hd:p:s:j:";
   static const struct option long_opts[] = {
       {"help", no_argument, nullptr, 'h'},
       {"dag_conf", required_argument, nullptr, 'd'},
       {"process_name", required_argument, nullptr, 'p'},
       {"sched_name", required_argument, nullptr, 's'},
+      {"init_thread_num", required_argument, nullptr, 'j'},
       {NULL, no_argument, nullptr, 0}};
 
   // log command for info
@@ -108,6 +122,9 @@ void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
       case 's':
         sched_name_ = std::string(optarg);
         break;
+      case 'j':
+        init_thread_num_ = std::atoi(optarg);
+        break;
       case 'h':
         DisplayUsage();
         exit(0);
@@ -42,12 +42,15 @@ class ModuleArgument {
   const std::string& GetProcessGroup() const;
   const std::string& GetSchedName() const;
   const std::list<std::string>& GetDAGConfList() const;
+  int GetInitThreadNum() const;
 
  private:
   std::list<std::string> dag_conf_list_;
   std::string binary_name_;
   std::string process_group_;
   std::string sched_name_;
+  // Modules are initialized one after the other unless set with -j.
+  int init_thread_num_ = 1;
 };
 
 inline const std::string& ModuleArgument::GetBinaryName() const {
@@ -66,6 +69,10 @@ inline const std::list<std::string>& ModuleArgument::GetDAGConfList() const {
   return dag_conf_list_;
 }
 
+inline int ModuleArgument::GetInitThreadNum() const {
+  return init_thread_num_;
+}
+
 }  // namespace mainboard
 }  // namespace cyber
 }  // namespace apollo
@@ -16,8 +16,14 @@
 
 #include "cyber/mainboard/module_controller.h"
 
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <utility>
 
+#include "gflags/gflags.h"
+
+#include "cyber/base/thread_pool.h"
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
 #include "cyber/component/component_base.h"
@@ -26,11 +32,22 @@ namespace apollo {
 namespace cyber {
 namespace mainboard {
 
+namespace {
+
+double ElapsedMs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
 void ModuleController::Clear() {
   for (auto& component : component_list_) {
     component->Shutdown();
   }
   component_list_.clear();  // keep alive
+  module_tasks_.clear();
   class_loader_manager_.UnloadAllLibrary();
 }
 
@@ -68,7 +85,7 @@ bool ModuleController::LoadAll() {
       return false;
     }
   }
-  return true;
+  return InitModules();
 }
 
 bool ModuleController::LoadModule(const DagConfig& dag_config) {
@@ -90,29 +107,167 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
 
     class_loader_manager_.LoadLibrary(load_path);
 
+    ModuleInitTask task;
+    task.library = load_path;
     for (auto& component : module_config.components()) {
       const std::string& class_name = component.class_name();
       std::shared_ptr<ComponentBase> base =
           class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
+      if (base == nullptr) {
         return false;
       }
-      component_list_.emplace_back(std::move(base));
+      ComponentInitTask component_task;
+      component_task.class_name = class_name;
+      component_task.component = base;
+      component_task.flag_file_path = component.config().flag_file_path();
+      const auto& config = component.config();
+      component_task.initialize = [base, config](bool apply_flag_file) {
+        if (apply_flag_file) {
+          return base->Initialize(config);
+        }
+        auto config_without_flag_file = config;
+        config_without_flag_file.clear_flag_file_path();
+        return base->Initialize(config_without_flag_file);
+      };
+      task.components.emplace_back(std::move(component_task));
     }
 
     for (auto& component : module_config.timer_components()) {
       const std::string& class_name = component.class_name();
       std::shared_ptr<ComponentBase> base =
           class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
+      if (base == nullptr) {
+        return false;
+      }
+      ComponentInitTask component_task;
+      component_task.class_name = class_name;
+      component_task.component = base;
+      component_task.flag_file_path = component.config().flag_file_path();
+      const auto& config = component.config();
+      component_task.initialize = [base, config](bool apply_flag_file) {
+        if (apply_flag_file) {
+          return base->Initialize(config);
+        }
+        auto config_without_flag_file = config;
+        config_without_flag_file.clear_flag_file_path();
+        return base->Initialize(config_without_flag_file);
+      };
+      task.components.emplace_back(std::move(component_task));
+    }
+    module_tasks_.emplace_back(std::move(task));
+  }
+  return true;
+}
+
+bool ModuleController::InitModule(ModuleInitTask* task,
+                                  bool apply_flag_files) {
+  for (auto& component : task->components) {
+    const auto start = std::chrono::steady_clock::now();
+    component.initialized = component.initialize(apply_flag_files);
+    component.init_time_ms = ElapsedMs(start);
+    if (!component.initialized) {
+      AERROR << "Failed to initialize component: " << component.class_name;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ModuleController::InitModules() {
+  const auto start = std::chrono::steady_clock::now();
+  size_t thread_num = std::min(
+      static_cast<size_t>(std::max(args_.GetInitThreadNum(), 1)),
+      module_tasks_.size());
+
+  // Each component applies its flag file when it is initialized, over the
+  // flags of the components before it, which only holds one after the
+  // other. In parallel, the components must share one flag file, which is
+  // applied once before any of them reads flags.
+  std::string flag_file_path;
+  if (thread_num > 1 && !SameFlagFile(&flag_file_path)) {
+    AINFO << "Components have different flag files, initialize them one "
+             "after the other.";
+    thread_num = 1;
+  }
+
+  bool success = true;
+  if (thread_num <= 1) {
+    for (auto& task : module_tasks_) {
+      if (!InitModule(&task, true)) {
+        success = false;
+        break;
+      }
+    }
+  } else {
+    if (!flag_file_path.empty()) {
+      if (flag_file_path[0] != '/') {
+        flag_file_path =
+            common::GetAbsolutePath(common::WorkRoot(), flag_file_path);
+      }
+      google::SetCommandLineOption("flagfile", flag_file_path.c_str());
+    }
+    base::ThreadPool pool(thread_num, module_tasks_.size());
+    std::vector<std::future<bool>> results;
+    results.reserve(module_tasks_.size());
+    for (auto& task : module_tasks_) {
+      results.emplace_back(
+          pool.Enqueue(&ModuleController::InitModule, &task, false));
+    }
+    for (auto& result : results) {
+      success = result.get() && success;
+    }
+  }
+
+  // Keep the dag order, and only what needs to be shut down on Clear().
+  for (auto& task : module_tasks_) {
+    for (auto& component : task.components) {
+      if (component.initialized) {
+        component_list_.emplace_back(component.component);
+      }
+    }
+  }
+  ReportInitTime(ElapsedMs(start));
+  module_tasks_.clear();
+  return success;
+}
+
+bool ModuleController::SameFlagFile(std::string* flag_file_path) const {
+  bool first = true;
+  for (const auto& task : module_tasks_) {
+    for (const auto& component : task.components) {
+      if (first) {
+        *flag_file_path = component.flag_file_path;
+        first = false;
+      } else if (component.flag_file_path != *flag_file_path) {
         return false;
       }
-      component_list_.emplace_back(std::move(base));
     }
   }
   return true;
 }
 
+void ModuleController::ReportInitTime(double total_time_ms) const {
+  std::vector<const ComponentInitTask*> components;
+  double sum_time_ms = 0.0;
+  for (const auto& task : module_tasks_) {
+    for (const auto& component : task.components) {
+      components.push_back(&component);
+      sum_time_ms += component.init_time_ms;
+    }
+  }
+  std::sort(components.begin(), components.end(),
+            [](const ComponentInitTask* lhs, const ComponentInitTask* rhs) {
+              return lhs->init_time_ms > rhs->init_time_ms;
+            });
+  AINFO << "Initialized " << components.size() << " components of "
+        << module_tasks_.size() << " modules in " << total_time_ms
+        << " ms (" << sum_time_ms << " ms of component initialization):";
+  for (const auto* component : components) {
+    AINFO << "  " << component->class_name << ": " << component->init_time_ms
+          << " ms" << (component->initialized ? "" : " (not initialized)");
+  }
+}
+
 bool ModuleController::LoadModule(const std::string& path) {
   DagConfig dag_config;
   if (!common::GetProtoFromFile(path, &dag_config)) {
@@ -16,6 +16,7 @@
 #ifndef CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 #define CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,14 +43,42 @@ class ModuleController {
   void Clear();
 
  private:
+  struct ComponentInitTask {
+    std::string class_name;
+    std::shared_ptr<ComponentBase> component;
+    std::string flag_file_path;
+    // Initializes the component, applying its flag file or not.
+    std::function<bool(bool)> initialize;
+    double init_time_ms = 0.0;
+    bool initialized = false;
+  };
+
+  // Components of one module config of a dag. They come from the same library
+  // and may share its singletons, so they are initialized in dag order, one
+  // after the other. Different modules are initialized in parallel when
+  // asked for with -j, which their Init must then allow: it may not depend on
+  // the order of the modules, nor on another module being initialized.
+  struct ModuleInitTask {
+    std::string library;
+    std::vector<ComponentInitTask> components;
+  };
+
+  // Loads the libraries of the dag and creates its components, which are
+  // initialized later by InitModules().
   bool LoadModule(const std::string& path);
   bool LoadModule(const DagConfig& dag_config);
+  bool InitModules();
+  static bool InitModule(ModuleInitTask* task, bool apply_flag_files);
+  // Whether all components have the same flag file, which is returned.
+  bool SameFlagFile(std::string* flag_file_path) const;
+  void ReportInitTime(double total_time_ms) const;
   int GetComponentNum(const std::string& path);
   int total_component_nums = 0;
   bool has_timer_component = false;
 
   ModuleArgument args_;
   class_loader::ClassLoaderManager class_loader_manager_;
+  std::vector<ModuleInitTask> module_tasks_;
   std::vector<std::shared_ptr<ComponentBase>> component_list_;
 };
 
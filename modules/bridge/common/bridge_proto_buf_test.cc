@@ -14,6 +14,10 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <memory>
+#include <random>
+
 #include "gtest/gtest.h"
 
 #include "modules/planning/proto/planning.pb.h"
@@ -93,5 +97,72 @@ TEST(BridgeProtoBufTest, Simple) {
   }
 }
 
+namespace {
+
+// Feeds the frames of proto_buf to recv_buf in the given order, returns
+// whether the message is complete after the last one.
+bool Reassemble(
+    const BridgeProtoSerializedBuf<planning::ADCTrajectory> &proto_buf,
+    const std::vector<size_t> &order,
+    BridgeProtoDiserializedBuf<planning::ADCTrajectory> *recv_buf) {
+  for (size_t i : order) {
+    const char *frame = proto_buf.GetSerializedBuf(i);
+    const size_t offset = sizeof(BRIDGE_HEADER_FLAG) + 1 + sizeof(hsize) + 1;
+    hsize header_size = 0;
+    memcpy(&header_size, frame + sizeof(BRIDGE_HEADER_FLAG) + 1,
+           sizeof(hsize));
+    BridgeHeader header;
+    EXPECT_TRUE(header.Diserialize(frame + offset, header_size - offset));
+    EXPECT_EQ(header_size + header.GetFrameSize(),
+              proto_buf.GetSerializedBufSize(i));
+    EXPECT_TRUE(recv_buf->Initialize(header));
+    memcpy(recv_buf->GetBuf(header.GetFramePos()), frame + header_size,
+           header.GetFrameSize());
+    recv_buf->UpdateStatus(header.GetIndex());
+  }
+  return recv_buf->IsReadyDiserialize();
+}
+
+std::shared_ptr<planning::ADCTrajectory> MakeTrajectory(int points,
+                                                        uint32_t seq) {
+  auto trajectory = std::make_shared<planning::ADCTrajectory>();
+  for (int i = 0; i < points; ++i) {
+    auto *point = trajectory->add_trajectory_point();
+    point->mutable_path_point()->set_x(0.5 * i);
+    point->mutable_path_point()->set_y(-0.25 * i);
+  }
+  trajectory->mutable_header()->set_sequence_num(seq);
+  return trajectory;
+}
+
+}  // namespace
+
+TEST(BridgeProtoBufTest, ReuseBuffers) {
+  BridgeProtoSerializedBuf<planning::ADCTrajectory> proto_buf;
+  BridgeProtoDiserializedBuf<planning::ADCTrajectory> recv_buf;
+  std::mt19937 rng(7);
+
+  // A message of more than 32 frames, then a smaller one in the same buffers.
+  for (const int points : {3000, 40, 1700}) {
+    auto trajectory = MakeTrajectory(points, static_cast<uint32_t>(points));
+    ASSERT_TRUE(proto_buf.Serialize(trajectory, "planning::ADCTrajectory"));
+    const size_t frame_count = proto_buf.GetSerializedBufCount();
+    EXPECT_EQ(frame_count,
+              (trajectory->ByteSizeLong() + FRAME_SIZE - 1) / FRAME_SIZE);
+
+    std::vector<size_t> order(frame_count);
+    for (size_t i = 0; i < frame_count; ++i) {
+      order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    recv_buf.Reset();
+    EXPECT_TRUE(Reassemble(proto_buf, order, &recv_buf));
+
+    auto pb_msg = std::make_shared<planning::ADCTrajectory>();
+    EXPECT_TRUE(recv_buf.Diserialized(pb_msg));
+    EXPECT_EQ(pb_msg->SerializeAsString(), trajectory->SerializeAsString());
+  }
+}
+
 }  // namespace bridge
 }  // namespace apollo
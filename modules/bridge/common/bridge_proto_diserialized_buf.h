@@ -44,6 +44,8 @@ class ProtoDiserializedBufBase {
   virtual uint32_t GetMsgID() const = 0;
   virtual std::string GetMsgName() const = 0;
   virtual char *GetBuf(size_t offset) = 0;
+  virtual size_t GetBufSize() const = 0;
+  virtual void Reset() = 0;
 };
 
 template <typename T>
@@ -65,8 +67,12 @@ class BridgeProtoDiserializedBuf : public ProtoDiserializedBufBase {
   bool Initialize(const BridgeHeader &header);
   bool Diserialized(std::shared_ptr<T> proto);
   virtual char *GetBuf(size_t offset) { return proto_buf_ + offset; }
+  virtual size_t GetBufSize() const { return total_size_; }
   virtual uint32_t GetMsgID() const { return sequence_num_; }
   virtual std::string GetMsgName() const { return proto_name_; }
+  // Forgets the message being assembled but keeps the buffer and the writer,
+  // so that the object can be reused for a later message.
+  virtual void Reset();
 
  private:
   size_t total_frames_ = 0;
@@ -74,6 +80,7 @@ class BridgeProtoDiserializedBuf : public ProtoDiserializedBufBase {
   std::string proto_name_ = "";
   std::vector<uint32_t> status_list_;
   char *proto_buf_ = nullptr;
+  size_t proto_buf_capacity_ = 0;
   bool is_ready_diser = false;
   uint32_t sequence_num_ = 0;
   std::shared_ptr<cyber::Writer<T>> writer_;
@@ -97,31 +104,24 @@ bool BridgeProtoDiserializedBuf<T>::Diserialized(std::shared_ptr<T> proto) {
 template <typename T>
 void BridgeProtoDiserializedBuf<T>::UpdateStatus(uint32_t frame_index) {
   size_t status_size = status_list_.size();
-  if (status_size == 0) {
+  if (status_size == 0 || frame_index >= total_frames_) {
     is_ready_diser = false;
     return;
   }
 
   uint32_t status_index = frame_index / INT_BITS;
-  status_list_[status_index] |= (1 << (frame_index % INT_BITS));
+  status_list_[status_index] |= (1u << (frame_index % INT_BITS));
+  const uint32_t last_bits = static_cast<uint32_t>(total_frames_ % INT_BITS);
+  const uint32_t last_mask = last_bits ? (1u << last_bits) - 1 : 0xffffffff;
   for (size_t i = 0; i < status_size; i++) {
-    if (i == status_size - 1) {
-      if (static_cast<int>(status_list_[i]) ==
-          (1 << total_frames_ % INT_BITS) - 1) {
-        AINFO << "diserialized is ready";
-        is_ready_diser = true;
-      } else {
-        is_ready_diser = false;
-        break;
-      }
-    } else {
-      if (status_list_[i] != 0xffffffff) {
-        is_ready_diser = false;
-        break;
-      }
-      is_ready_diser = true;
+    const uint32_t mask = (i == status_size - 1) ? last_mask : 0xffffffff;
+    if (status_list_[i] != mask) {
+      is_ready_diser = false;
+      return;
     }
   }
+  AINFO << "diserialized is ready";
+  is_ready_diser = true;
 }
 
 template <typename T>
@@ -135,29 +135,46 @@ bool BridgeProtoDiserializedBuf<T>::IsTheProto(const BridgeHeader &header) {
 
 template <typename T>
 bool BridgeProtoDiserializedBuf<T>::Initialize(const BridgeHeader &header) {
+  if (!status_list_.empty() && IsTheProto(header)) {
+    // Already assembling this message.
+    return true;
+  }
   total_size_ = header.GetMsgSize();
   total_frames_ = header.GetTotalFrames();
+  proto_name_ = header.GetMsgName();
+  sequence_num_ = header.GetMsgID();
+  is_ready_diser = false;
   if (total_frames_ == 0) {
     return false;
   }
-  int status_size = static_cast<int>(total_frames_ / INT_BITS +
-                                     ((total_frames_ % INT_BITS) ? 1 : 0));
-  if (status_list_.empty()) {
-    for (int i = 0; i < status_size; i++) {
-      status_list_.push_back(0);
-    }
-  }
+  size_t status_size =
+      total_frames_ / INT_BITS + ((total_frames_ % INT_BITS) ? 1 : 0);
+  status_list_.assign(status_size, 0);
 
-  if (!proto_buf_) {
+  if (proto_buf_capacity_ < total_size_) {
+    FREE_ARRY(proto_buf_);
     proto_buf_ = new char[total_size_];
+    proto_buf_capacity_ = total_size_;
   }
   return true;
 }
 
+template <typename T>
+void BridgeProtoDiserializedBuf<T>::Reset() {
+  total_size_ = 0;
+  total_frames_ = 0;
+  proto_name_.clear();
+  sequence_num_ = 0;
+  status_list_.clear();
+  is_ready_diser = false;
+}
+
 template <typename T>
 bool BridgeProtoDiserializedBuf<T>::Initialize(
     const BridgeHeader &header, std::shared_ptr<cyber::Node> node) {
-  writer_ = node->CreateWriter<T>(topic_name_.c_str());
+  if (writer_ == nullptr) {
+    writer_ = node->CreateWriter<T>(topic_name_.c_str());
+  }
   return Initialize(header);
 }
 
@@ -16,65 +16,103 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+
 #include "modules/bridge/common/bridge_header.h"
 #include "modules/bridge/common/macro.h"
 
 namespace apollo {
 namespace bridge {
 
+// Hands out the payload slice of each frame in turn, so that a proto is
+// serialized straight into its frames.
+class FramePayloadOutputStream
+    : public google::protobuf::io::ZeroCopyOutputStream {
+ public:
+  FramePayloadOutputStream(char *frames, size_t frame_stride,
+                           size_t header_size, size_t payload_size)
+      : frames_(frames),
+        frame_stride_(frame_stride),
+        header_size_(header_size),
+        payload_size_(payload_size) {}
+
+  bool Next(void **data, int *size) override {
+    if (written_ >= payload_size_) {
+      return false;
+    }
+    const size_t index = written_ / FRAME_SIZE;
+    const size_t offset = written_ % FRAME_SIZE;
+    const size_t len =
+        std::min(static_cast<size_t>(FRAME_SIZE) - offset,
+                 payload_size_ - written_);
+    *data = frames_ + index * frame_stride_ + header_size_ + offset;
+    *size = static_cast<int>(len);
+    written_ += len;
+    return true;
+  }
+  void BackUp(int count) override { written_ -= count; }
+  int64_t ByteCount() const override {
+    return static_cast<int64_t>(written_);
+  }
+
+ private:
+  char *frames_;
+  size_t frame_stride_;
+  size_t header_size_;
+  size_t payload_size_;
+  size_t written_ = 0;
+};
+
+// Splits a proto into FRAME_SIZE frames, each one a bridge header followed
+// by its slice of the serialized proto. The frames are written back to back
+// in one buffer, which is kept across Serialize() calls and only grows, so
+// serializing costs no allocation and no copy once it is large enough.
 template <typename T>
 class BridgeProtoSerializedBuf {
  public:
   BridgeProtoSerializedBuf() {}
-  ~BridgeProtoSerializedBuf();
+  ~BridgeProtoSerializedBuf() {}
 
-  char *GetFrame(size_t index);
+  char *GetFrame(size_t index) { return &buf_[index * frame_stride_]; }
   bool Serialize(const std::shared_ptr<T> &proto, const std::string &msg_name);
 
   const char *GetSerializedBuf(size_t index) const {
-    return frames_[index].buf_;
+    return &buf_[index * frame_stride_];
   }
-  size_t GetSerializedBufCount() const { return frames_.size(); }
+  size_t GetSerializedBufCount() const { return frame_count_; }
   size_t GetSerializedBufSize(size_t index) const {
-    return frames_[index].buf_len_;
+    return header_size_ +
+           std::min(static_cast<size_t>(FRAME_SIZE),
+                    msg_len_ - index * static_cast<size_t>(FRAME_SIZE));
   }
 
  private:
-  struct Buf {
-    char *buf_;
-    size_t buf_len_;
-  };
-
- private:
-  std::vector<Buf> frames_;
+  std::vector<char> buf_;
+  size_t frame_count_ = 0;
+  size_t frame_stride_ = 0;
+  size_t header_size_ = 0;
+  size_t msg_len_ = 0;
 };
 
-template <typename T>
-BridgeProtoSerializedBuf<T>::~BridgeProtoSerializedBuf() {
-  for (auto frame : frames_) {
-    FREE_ARRY(frame.buf_);
-  }
-}
-
 template <typename T>
 bool BridgeProtoSerializedBuf<T>::Serialize(const std::shared_ptr<T> &proto,
                                             const std::string &msg_name) {
-  bsize msg_len = static_cast<bsize>(proto->ByteSizeLong());
-  char *tmp = new char[msg_len]();
-  if (!proto->SerializeToArray(tmp, static_cast<int>(msg_len))) {
-    FREE_ARRY(tmp);
+  frame_count_ = 0;
+  if (!proto->IsInitialized()) {
     return false;
   }
-  bsize offset = 0;
-  bsize frame_index = 0;
+  bsize msg_len = static_cast<bsize>(proto->ByteSizeLong());
   uint32_t total_frames = static_cast<uint32_t>(msg_len / FRAME_SIZE +
                                                 (msg_len % FRAME_SIZE ? 1 : 0));
 
-  while (offset < msg_len) {
+  msg_len_ = msg_len;
+  for (uint32_t frame_index = 0; frame_index < total_frames; ++frame_index) {
     bsize left = msg_len - frame_index * FRAME_SIZE;
     bsize cpy_size = (left > FRAME_SIZE) ? FRAME_SIZE : left;
 
@@ -88,17 +126,27 @@ bool BridgeProtoSerializedBuf<T>::Serialize(const std::shared_ptr<T> &proto,
     header.SetFrameSize(cpy_size);
     header.SetIndex(frame_index);
     header.SetFramePos(frame_index * FRAME_SIZE);
-    hsize header_size = header.GetHeaderSize();
-    Buf buf;
-    buf.buf_ = new char[cpy_size + header_size];
-    buf.buf_len_ = cpy_size + header_size;
-    header.Serialize(buf.buf_, buf.buf_len_);
-    memcpy(buf.buf_ + header_size, tmp + frame_index * FRAME_SIZE, cpy_size);
-    frames_.push_back(buf);
-    frame_index++;
-    offset += cpy_size;
+    if (frame_index == 0) {
+      // All the headers of a message have the same size, only their values
+      // differ.
+      header_size_ = header.GetHeaderSize();
+      frame_stride_ = header_size_ + FRAME_SIZE;
+      if (buf_.size() < total_frames * frame_stride_) {
+        buf_.resize(total_frames * frame_stride_);
+      }
+    }
+    header.Serialize(GetFrame(frame_index), header_size_);
+  }
+  {
+    FramePayloadOutputStream payload(buf_.data(), frame_stride_, header_size_,
+                                     msg_len_);
+    google::protobuf::io::CodedOutputStream output(&payload);
+    proto->SerializeWithCachedSizes(&output);
+    if (output.HadError()) {
+      return false;
+    }
   }
-  FREE_ARRY(tmp);
+  frame_count_ = total_frames;
   return true;
 }
 
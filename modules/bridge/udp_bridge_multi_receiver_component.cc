@@ -23,6 +23,15 @@
 namespace apollo {
 namespace bridge {
 
+namespace {
+
+// Datagrams read by one recvmmsg() call.
+constexpr int kRecvBatchSize = 16;
+// Idle reassembly buffers kept per message name.
+constexpr size_t kMaxFreeProtoBufs = 4;
+
+}  // namespace
+
 UDPBridgeMultiReceiverComponent::UDPBridgeMultiReceiverComponent()
     : monitor_logger_buffer_(common::monitor::MonitorMessageItem::CONTROL) {}
 
@@ -64,6 +73,7 @@ UDPBridgeMultiReceiverComponent::CreateBridgeProtoBuf(
         proto_list_.begin();
     for (; itor != proto_list_.end();) {
       if ((*itor)->IsTheProto(header)) {
+        RecycleProtoBuf(*itor);
         itor = proto_list_.erase(itor);
         break;
       }
@@ -78,15 +88,33 @@ UDPBridgeMultiReceiverComponent::CreateBridgeProtoBuf(
     }
   }
 
-  proto_buf = ProtoDiserializedBufBaseFactory::CreateObj(header);
+  auto &free_list = free_proto_bufs_[header.GetMsgName()];
+  if (!free_list.empty()) {
+    proto_buf = free_list.back();
+    free_list.pop_back();
+  } else {
+    proto_buf = ProtoDiserializedBufBaseFactory::CreateObj(header);
+  }
   if (!proto_buf) {
     return proto_buf;
   }
-  proto_buf->Initialize(header, node_);
+  if (!proto_buf->Initialize(header, node_)) {
+    RecycleProtoBuf(proto_buf);
+    return nullptr;
+  }
   proto_list_.push_back(proto_buf);
   return proto_buf;
 }
 
+void UDPBridgeMultiReceiverComponent::RecycleProtoBuf(
+    const std::shared_ptr<ProtoDiserializedBufBase> &proto_buf) {
+  auto &free_list = free_proto_bufs_[proto_buf->GetMsgName()];
+  proto_buf->Reset();
+  if (free_list.size() < kMaxFreeProtoBufs) {
+    free_list.push_back(proto_buf);
+  }
+}
+
 bool UDPBridgeMultiReceiverComponent::IsProtoExist(const BridgeHeader &header) {
   for (auto proto : proto_list_) {
     if (proto->IsTheProto(header)) {
@@ -111,16 +139,42 @@ bool UDPBridgeMultiReceiverComponent::IsTimeout(double time_stamp) {
 }
 
 bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
-  struct sockaddr_in client_addr;
-  socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
-  int bytes = 0;
-  int total_recv = 2 * FRAME_SIZE;
-  char total_buf[2 * FRAME_SIZE] = {0};
-  bytes =
-      static_cast<int>(recvfrom(fd, total_buf, total_recv, 0,
-                                (struct sockaddr *)&client_addr, &sock_len));
-  ADEBUG << "total recv " << bytes;
-  if (bytes <= 0 || bytes > total_recv) {
+  // The listener is edge triggered: read everything that is pending, by
+  // batches of datagrams.
+  char total_buf[kRecvBatchSize][2 * FRAME_SIZE];
+  struct iovec iovecs[kRecvBatchSize];
+  struct mmsghdr msgs[kRecvBatchSize];
+  bool res = false;
+  while (true) {
+    memset(msgs, 0, sizeof(msgs));
+    for (int i = 0; i < kRecvBatchSize; ++i) {
+      iovecs[i].iov_base = total_buf[i];
+      iovecs[i].iov_len = sizeof(total_buf[i]);
+      msgs[i].msg_hdr.msg_iov = &iovecs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    int count = recvmmsg(fd, msgs, kRecvBatchSize, MSG_DONTWAIT, nullptr);
+    ADEBUG << "total recv " << count << " frames";
+    if (count <= 0) {
+      break;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < count; ++i) {
+      if (FrameHandle(total_buf[i], msgs[i].msg_len)) {
+        res = true;
+      }
+    }
+  }
+  return res;
+}
+
+bool UDPBridgeMultiReceiverComponent::FrameHandle(const char *total_buf,
+                                                  size_t bytes) {
+  if (bytes == 0 || bytes > 2 * FRAME_SIZE) {
+    return false;
+  }
+  if (bytes < HEADER_FLAG_SIZE + sizeof(hsize) + 1) {
+    AINFO << "frame is smaller than a header!";
     return false;
   }
   char header_flag[sizeof(BRIDGE_HEADER_FLAG) + 1] = {0};
@@ -136,8 +190,9 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
   const char *cursor = total_buf + offset;
   memcpy(header_size_buf, cursor, sizeof(hsize));
   hsize header_size = *(reinterpret_cast<hsize *>(header_size_buf));
-  if (header_size > FRAME_SIZE) {
-    AINFO << "header size is more than FRAME_SIZE!";
+  if (header_size > FRAME_SIZE || header_size > bytes ||
+      header_size < offset + sizeof(hsize) + 1) {
+    AINFO << "header size is invalid!";
     return false;
   }
   offset += sizeof(hsize) + 1;
@@ -155,13 +210,17 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
   ADEBUG << "proto total frames: " << header.GetTotalFrames();
   ADEBUG << "proto frame index: " << header.GetIndex();
 
-  std::lock_guard<std::mutex> lock(mutex_);
   std::shared_ptr<ProtoDiserializedBufBase> proto_buf =
       CreateBridgeProtoBuf(header);
   if (!proto_buf) {
     return false;
   }
 
+  if (header_size + header.GetFrameSize() > bytes ||
+      header.GetFramePos() + header.GetFrameSize() > proto_buf->GetBufSize()) {
+    AINFO << "frame is out of the proto buffer!";
+    return false;
+  }
   cursor = total_buf + header_size;
   char *buf = proto_buf->GetBuf(header.GetFramePos());
   memcpy(buf, cursor, header.GetFrameSize());
@@ -170,6 +229,7 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
     proto_buf->DiserializedAndPub();
     RemoveInvalidBuf(proto_buf->GetMsgID(), proto_buf->GetMsgName());
     RemoveItem(&proto_list_, proto_buf);
+    RecycleProtoBuf(proto_buf);
   }
   return true;
 }
@@ -184,6 +244,7 @@ bool UDPBridgeMultiReceiverComponent::RemoveInvalidBuf(
   for (; itor != proto_list_.end();) {
     if ((*itor)->GetMsgID() < msg_id &&
         strcmp((*itor)->GetMsgName().c_str(), msg_name.c_str()) == 0) {
+      RecycleProtoBuf(*itor);
       itor = proto_list_.erase(itor);
       continue;
     }
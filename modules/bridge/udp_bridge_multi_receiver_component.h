@@ -22,6 +22,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/bridge/proto/udp_bridge_remote_info.pb.h"
@@ -56,7 +57,12 @@ class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
   bool MsgHandle(int fd);
 
  private:
+  bool FrameHandle(const char *total_buf, size_t bytes);
   bool RemoveInvalidBuf(uint32_t msg_id, const std::string &msg_name);
+  // Returns a buffer no longer in proto_list_ to the free list of its
+  // message name, to reassemble a later message of the same kind.
+  void RecycleProtoBuf(
+      const std::shared_ptr<ProtoDiserializedBufBase> &proto_buf);
 
  private:
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
@@ -66,6 +72,9 @@ class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
   bool enable_timeout_ = true;
   std::mutex mutex_;
   std::vector<std::shared_ptr<ProtoDiserializedBufBase>> proto_list_;
+  std::unordered_map<std::string,
+                     std::vector<std::shared_ptr<ProtoDiserializedBufBase>>>
+      free_proto_bufs_;
 };
 
 }  // namespace bridge
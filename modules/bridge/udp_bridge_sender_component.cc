@@ -16,7 +16,9 @@
 
 #include "modules/bridge/udp_bridge_sender_component.h"
 
-#include "modules/bridge/common/bridge_proto_serialized_buf.h"
+#include <cerrno>
+#include <cstring>
+
 #include "modules/bridge/common/macro.h"
 #include "modules/bridge/common/util.h"
 
@@ -29,6 +31,13 @@ using apollo::bridge::UDPBridgeSenderRemoteInfo;
 using apollo::cyber::io::Session;
 using apollo::localization::LocalizationEstimate;
 
+template <typename T>
+UDPBridgeSenderComponent<T>::~UDPBridgeSenderComponent() {
+  if (sock_fd_ != -1) {
+    close(sock_fd_);
+  }
+}
+
 template <typename T>
 bool UDPBridgeSenderComponent<T>::Init() {
   AINFO << "UDP bridge sender init, startin...";
@@ -43,12 +52,38 @@ bool UDPBridgeSenderComponent<T>::Init() {
   ADEBUG << "UDP Bridge remote ip is: " << remote_ip_;
   ADEBUG << "UDP Bridge remote port is: " << remote_port_;
   ADEBUG << "UDP Bridge for Proto is: " << proto_name_;
+  if (remote_port_ == 0 || remote_ip_.empty()) {
+    // Every message is rejected by Proc().
+    AERROR << "remote info is invalid!";
+    return true;
+  }
+
+  // One connected socket for the lifetime of the component, instead of one
+  // per message.
+  struct sockaddr_in server_addr;
+  server_addr.sin_addr.s_addr = inet_addr(remote_ip_.c_str());
+  server_addr.sin_family = AF_INET;
+  server_addr.sin_port = htons(static_cast<uint16_t>(remote_port_));
+  sock_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+  if (sock_fd_ < 0) {
+    AERROR << "create udp socket failed!";
+    return false;
+  }
+  int res =
+      connect(sock_fd_, (struct sockaddr *)&server_addr, sizeof(server_addr));
+  if (res < 0) {
+    AERROR << "connect to " << remote_ip_ << ":" << remote_port_
+           << " failed!";
+    close(sock_fd_);
+    sock_fd_ = -1;
+    return false;
+  }
   return true;
 }
 
 template <typename T>
 bool UDPBridgeSenderComponent<T>::Proc(const std::shared_ptr<T> &pb_msg) {
-  if (remote_port_ == 0 || remote_ip_.empty()) {
+  if (sock_fd_ < 0) {
     AERROR << "remote info is invalid!";
     return false;
   }
@@ -58,30 +93,47 @@ bool UDPBridgeSenderComponent<T>::Proc(const std::shared_ptr<T> &pb_msg) {
     return false;
   }
 
-  struct sockaddr_in server_addr;
-  server_addr.sin_addr.s_addr = inet_addr(remote_ip_.c_str());
-  server_addr.sin_family = AF_INET;
-  server_addr.sin_port = htons(static_cast<uint16_t>(remote_port_));
-  int sock_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
-
-  int res =
-      connect(sock_fd, (struct sockaddr *)&server_addr, sizeof(server_addr));
-  if (res < 0) {
-    close(sock_fd);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!proto_buf_.Serialize(pb_msg, proto_name_)) {
+    AERROR << "serialize " << proto_name_ << " failed!";
     return false;
   }
+  SendFrames();
+  return true;
+}
 
-  BridgeProtoSerializedBuf<T> proto_buf;
-  proto_buf.Serialize(pb_msg, proto_name_);
-  for (size_t j = 0; j < proto_buf.GetSerializedBufCount(); j++) {
-    ssize_t nbytes = send(sock_fd, proto_buf.GetSerializedBuf(j),
-                          proto_buf.GetSerializedBufSize(j), 0);
-    if (nbytes != static_cast<ssize_t>(proto_buf.GetSerializedBufSize(j))) {
-      break;
-    }
+template <typename T>
+bool UDPBridgeSenderComponent<T>::SendFrames() {
+  // Each frame is already header + payload slice in proto_buf_, so it goes
+  // out as is, with as few sendmmsg() calls as the kernel allows.
+  const size_t frame_count = proto_buf_.GetSerializedBufCount();
+  if (msgs_.size() < frame_count) {
+    iovecs_.resize(frame_count);
+    msgs_.resize(frame_count);
+  }
+  for (size_t i = 0; i < frame_count; ++i) {
+    iovecs_[i].iov_base = const_cast<char *>(proto_buf_.GetSerializedBuf(i));
+    iovecs_[i].iov_len = proto_buf_.GetSerializedBufSize(i);
+    memset(&msgs_[i], 0, sizeof(msgs_[i]));
+    msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+    msgs_[i].msg_hdr.msg_iovlen = 1;
   }
-  close(sock_fd);
 
+  size_t sent = 0;
+  while (sent < frame_count) {
+    int res = sendmmsg(sock_fd_, &msgs_[sent],
+                       static_cast<unsigned int>(frame_count - sent), 0);
+    if (res < 0 && errno == EINTR) {
+      continue;
+    }
+    if (res <= 0) {
+      // Like a failed send() before: the rest of the message is dropped.
+      ADEBUG << "send frames failed, " << sent << " of " << frame_count
+             << " frames sent";
+      return false;
+    }
+    sent += static_cast<size_t>(res);
+  }
   return true;
 }
 
@@ -18,6 +18,7 @@
 
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <cstdlib>
 #include <iostream>
@@ -35,6 +36,7 @@
 #include "cyber/io/session.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "modules/bridge/common/bridge_gflags.h"
+#include "modules/bridge/common/bridge_proto_serialized_buf.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/util/util.h"
 
@@ -49,18 +51,27 @@ class UDPBridgeSenderComponent final : public cyber::Component<T> {
  public:
   UDPBridgeSenderComponent()
       : monitor_logger_buffer_(common::monitor::MonitorMessageItem::CONTROL) {}
+  ~UDPBridgeSenderComponent();
 
   bool Init() override;
   bool Proc(const std::shared_ptr<T> &pb_msg) override;
 
   std::string Name() const { return FLAGS_bridge_module_name; }
 
+ private:
+  bool SendFrames();
+
  private:
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
   unsigned int remote_port_ = 0;
   std::string remote_ip_ = "";
   std::string proto_name_ = "";
   std::mutex mutex_;
+  int sock_fd_ = -1;
+  // Reused for every message, guarded by mutex_.
+  BridgeProtoSerializedBuf<T> proto_buf_;
+  std::vector<struct iovec> iovecs_;
+  std::vector<struct mmsghdr> msgs_;
 };
 
 BRIDGE_COMPONENT_REGISTER(planning::ADCTrajectory)
@@ -33,6 +33,23 @@ DEFINE_string(end_way_point_filename, "default_end_way_point.txt",
               "End way point of the map, will be sent in RoutingRequest.");
 DEFINE_string(speed_control_filename, "speed_control.pb.txt",
               "The speed control region in a map.");
+DEFINE_bool(use_compiled_map, true,
+            "Map the lane index from the compiled map next to a map file, "
+            "if any, instead of building it when the map is loaded.");
+DEFINE_bool(use_tiled_map, false,
+            "Load the base map tile by tile around the ego pose from the tile "
+            "directory next to the map file, if any, in processes with a "
+            "module driving the ego pose, such as planning or prediction. "
+            "All modules of such a process must only query the map around "
+            "the ego.");
+DEFINE_double(map_tile_load_radius, 400.0,
+              "Map tiles within this distance of the ego position, and of "
+              "the read-ahead point, are loaded.");
+DEFINE_double(map_tile_read_ahead_distance, 300.0,
+              "Distance ahead of the ego position, along its heading, around "
+              "which map tiles are loaded as well.");
+DEFINE_int32(map_tile_max_loaded, 32,
+             "Maximum number of map tiles kept in memory.");
 
 DEFINE_string(vehicle_config_path,
               "/apollo/modules/common/data/vehicle_param.pb.txt",
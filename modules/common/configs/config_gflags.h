@@ -29,6 +29,11 @@ DECLARE_string(sim_map_filename);
 DECLARE_string(routing_map_filename);
 DECLARE_string(end_way_point_filename);
 DECLARE_string(speed_control_filename);
+DECLARE_bool(use_compiled_map);
+DECLARE_bool(use_tiled_map);
+DECLARE_double(map_tile_load_radius);
+DECLARE_double(map_tile_read_ahead_distance);
+DECLARE_int32(map_tile_max_loaded);
 
 DECLARE_double(look_forward_time_sec);
 
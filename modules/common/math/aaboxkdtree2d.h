@@ -16,11 +16,15 @@
 
 /**
  * @file
- * @brief Defines the templated AABoxKDTree2dNode class.
+ * @brief Defines the templated AABoxKDTree2dNode and AABoxKDTree2d classes.
  */
 
 #pragma once
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include <algorithm>
 #include <limits>
 #include <memory>
@@ -55,6 +59,10 @@ struct AABoxKDTreeParams {
 /**
  * @class AABoxKDTree2dNode
  * @brief The class of KD-tree node of axis-aligned bounding box.
+ *
+ * The nodes are linked by pointers. AABoxKDTree2d builds the same tree laid
+ * out in flat arrays, and is the one to query; this class serves as the
+ * reference it is tested and benchmarked against.
  */
 template <class ObjectType>
 class AABoxKDTree2dNode {
@@ -410,6 +418,14 @@ class AABoxKDTree2dNode {
 /**
  * @class AABoxKDTree2d
  * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
+ *
+ * The nodes are stored in one array in depth-first order, so that the left
+ * sub-node of a node follows it, and the objects of a sub-tree are
+ * contiguous. The objects of every node are stored twice, sorted by min and
+ * by max bound along the partition axis, in blocks of four which hold each
+ * coordinate of their bounding boxes together. Queries skip the objects whose
+ * bounding box is out of range before computing their distance, testing the
+ * four boxes of a block at once when built with AVX2.
  */
 template <class ObjectType>
 class AABoxKDTree2d {
@@ -424,10 +440,12 @@ class AABoxKDTree2d {
                 const AABoxKDTreeParams &params) {
     if (!objects.empty()) {
       std::vector<ObjectPtr> object_ptrs;
+      object_ptrs.reserve(objects.size());
       for (const auto &object : objects) {
         object_ptrs.push_back(&object);
       }
-      root_.reset(new AABoxKDTree2dNode<ObjectType>(object_ptrs, params, 0));
+      objects_.reserve(objects.size());
+      BuildNode(object_ptrs, params, 0);
     }
   }
 
@@ -437,7 +455,41 @@ class AABoxKDTree2d {
    * @return The nearest object to the target point.
    */
   ObjectPtr GetNearestObject(const Vec2d &point) const {
-    return root_ == nullptr ? nullptr : root_->GetNearestObject(point);
+    if (nodes_.empty()) {
+      return nullptr;
+    }
+    ObjectPtr nearest_object = nullptr;
+    double min_distance_sqr = std::numeric_limits<double>::infinity();
+    GetNearestObjectInternal(0, point, &min_distance_sqr, &nearest_object);
+    return nearest_object;
+  }
+
+  /**
+   * @brief Get the nearest objects to a batch of target points.
+   *
+   * The search for each point starts from the distance to the nearest object
+   * of the previous one, which prunes most of the tree when consecutive
+   * points are close, e.g. along a path.
+   * @param points The target points.
+   * @return The nearest object to each target point.
+   */
+  std::vector<ObjectPtr> GetNearestObjects(
+      const std::vector<Vec2d> &points) const {
+    std::vector<ObjectPtr> nearest_objects(points.size(), nullptr);
+    if (nodes_.empty()) {
+      return nearest_objects;
+    }
+    ObjectPtr nearest_object = nullptr;
+    for (size_t i = 0; i < points.size(); ++i) {
+      double min_distance_sqr =
+          nearest_object == nullptr
+              ? std::numeric_limits<double>::infinity()
+              : nearest_object->DistanceSquareTo(points[i]);
+      GetNearestObjectInternal(0, points[i], &min_distance_sqr,
+                               &nearest_object);
+      nearest_objects[i] = nearest_object;
+    }
+    return nearest_objects;
   }
 
   /**
@@ -448,10 +500,73 @@ class AABoxKDTree2d {
    */
   std::vector<ObjectPtr> GetObjects(const Vec2d &point,
                                     const double distance) const {
-    if (root_ == nullptr) {
-      return {};
+    std::vector<ObjectPtr> result_objects;
+    GetObjects(point, distance, &result_objects);
+    return result_objects;
+  }
+
+  /**
+   * @brief Get objects within a distance to a point, reusing the storage of
+   *        the result.
+   * @param point The center point of the range to search objects.
+   * @param distance The radius of the range to search objects.
+   * @param result_objects All objects within the specified distance to the
+   *        specified point.
+   */
+  void GetObjects(const Vec2d &point, const double distance,
+                  std::vector<ObjectPtr> *const result_objects) const {
+    result_objects->clear();
+    if (!nodes_.empty()) {
+      GetObjectsInternal(0, point, distance, Square(distance),
+                         result_objects);
+    }
+  }
+
+  /**
+   * @brief Get objects within a distance to each of a batch of points.
+   * @param points The center points of the ranges to search objects.
+   * @param distance The radius of the ranges to search objects.
+   * @param result_objects All objects within the specified distance to each
+   *        of the points, in the order of the points.
+   */
+  void GetObjects(
+      const std::vector<Vec2d> &points, const double distance,
+      std::vector<std::vector<ObjectPtr>> *const result_objects) const {
+    result_objects->resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      GetObjects(points[i], distance, &(*result_objects)[i]);
+    }
+  }
+
+  /**
+   * @brief Get objects within each of a batch of distances to a point, by a
+   *        single search of the largest distance.
+   * @param point The center point of the ranges to search objects.
+   * @param distances The radii of the ranges to search objects.
+   * @param result_objects All objects within each of the distances to the
+   *        point, in the order of the distances.
+   */
+  void GetObjects(
+      const Vec2d &point, const std::vector<double> &distances,
+      std::vector<std::vector<ObjectPtr>> *const result_objects) const {
+    result_objects->resize(distances.size());
+    for (auto &objects : *result_objects) {
+      objects.clear();
+    }
+    if (distances.empty()) {
+      return;
+    }
+    std::vector<ObjectPtr> objects;
+    GetObjects(point, *std::max_element(distances.begin(), distances.end()),
+               &objects);
+    for (ObjectPtr object : objects) {
+      const double distance_sqr = object->DistanceSquareTo(point);
+      for (size_t i = 0; i < distances.size(); ++i) {
+        if (distance_sqr <= Square(distances[i])) {
+          (*result_objects)[i].push_back(object);
+        }
+      }
     }
-    return root_->GetObjects(point, distance);
   }
 
   /**
@@ -459,11 +574,340 @@ class AABoxKDTree2d {
    * @return The axis-aligned bounding box of the objects.
    */
   AABox2d GetBoundingBox() const {
-    return root_ == nullptr ? AABox2d() : root_->GetBoundingBox();
+    if (nodes_.empty()) {
+      return AABox2d();
+    }
+    const Node &root = nodes_.front();
+    return AABox2d({root.min_x, root.min_y}, {root.max_x, root.max_y});
+  }
+
+ private:
+  struct Node {
+    // Boundary
+    double min_x = 0.0;
+    double min_y = 0.0;
+    double max_x = 0.0;
+    double max_y = 0.0;
+    // The left sub-node, if any, is the next node.
+    bool has_left_subnode = false;
+    bool partition_x = true;
+    int right_subnode = -1;
+    // Object blocks of the node.
+    int blocks_begin = 0;
+    int blocks_end = 0;
+    // Objects of the whole sub-tree.
+    int objects_begin = 0;
+    int objects_end = 0;
+  };
+
+  static constexpr int kBlockSize = 4;
+
+  // Objects with the coordinates of their bounding boxes, by groups of four
+  // to be tested at once. The last block of a node is padded with empty
+  // boxes, which are out of range of any query.
+  struct ObjectBlock {
+    double min_x[kBlockSize];
+    double min_y[kBlockSize];
+    double max_x[kBlockSize];
+    double max_y[kBlockSize];
+    ObjectPtr objects[kBlockSize];
+  };
+
+  int BuildNode(const std::vector<ObjectPtr> &objects,
+                const AABoxKDTreeParams &params, const int depth) {
+    ACHECK(!objects.empty());
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+
+    Node node;
+    node.min_x = std::numeric_limits<double>::infinity();
+    node.min_y = std::numeric_limits<double>::infinity();
+    node.max_x = -std::numeric_limits<double>::infinity();
+    node.max_y = -std::numeric_limits<double>::infinity();
+    for (ObjectPtr object : objects) {
+      node.min_x = std::fmin(node.min_x, object->aabox().min_x());
+      node.max_x = std::fmax(node.max_x, object->aabox().max_x());
+      node.min_y = std::fmin(node.min_y, object->aabox().min_y());
+      node.max_y = std::fmax(node.max_y, object->aabox().max_y());
+    }
+    ACHECK(!std::isinf(node.max_x) && !std::isinf(node.max_y) &&
+           !std::isinf(node.min_x) && !std::isinf(node.min_y))
+        << "the provided object box size is infinity";
+    node.partition_x = node.max_x - node.min_x >= node.max_y - node.min_y;
+    const double partition_position = PartitionPosition(node);
+
+    std::vector<ObjectPtr> left_subnode_objects;
+    std::vector<ObjectPtr> right_subnode_objects;
+    std::vector<ObjectPtr> node_objects;
+    if (SplitToSubNodes(node, objects, params, depth)) {
+      for (ObjectPtr object : objects) {
+        const AABox2d &box = object->aabox();
+        if ((node.partition_x ? box.max_x() : box.max_y()) <=
+            partition_position) {
+          left_subnode_objects.push_back(object);
+        } else if ((node.partition_x ? box.min_x() : box.min_y()) >=
+                   partition_position) {
+          right_subnode_objects.push_back(object);
+        } else {
+          node_objects.push_back(object);
+        }
+      }
+    } else {
+      node_objects = objects;
+    }
+
+    node.objects_begin = static_cast<int>(objects_.size());
+    objects_.insert(objects_.end(), node_objects.begin(), node_objects.end());
+    node.blocks_begin = static_cast<int>(by_min_blocks_.size());
+    std::sort(node_objects.begin(), node_objects.end(),
+              [&](ObjectPtr obj1, ObjectPtr obj2) {
+                return node.partition_x
+                           ? obj1->aabox().min_x() < obj2->aabox().min_x()
+                           : obj1->aabox().min_y() < obj2->aabox().min_y();
+              });
+    AppendBlocks(node_objects, &by_min_blocks_);
+    std::sort(node_objects.begin(), node_objects.end(),
+              [&](ObjectPtr obj1, ObjectPtr obj2) {
+                return node.partition_x
+                           ? obj1->aabox().max_x() > obj2->aabox().max_x()
+                           : obj1->aabox().max_y() > obj2->aabox().max_y();
+              });
+    AppendBlocks(node_objects, &by_max_blocks_);
+    node.blocks_end = static_cast<int>(by_min_blocks_.size());
+
+    if (!left_subnode_objects.empty()) {
+      BuildNode(left_subnode_objects, params, depth + 1);
+      node.has_left_subnode = true;
+    }
+    if (!right_subnode_objects.empty()) {
+      node.right_subnode = BuildNode(right_subnode_objects, params, depth + 1);
+    }
+    node.objects_end = static_cast<int>(objects_.size());
+    nodes_[index] = node;
+    return index;
+  }
+
+  static void AppendBlocks(const std::vector<ObjectPtr> &sorted_objects,
+                           std::vector<ObjectBlock> *const blocks) {
+    for (size_t i = 0; i < sorted_objects.size(); i += kBlockSize) {
+      ObjectBlock block;
+      for (int k = 0; k < kBlockSize; ++k) {
+        if (i + k < sorted_objects.size()) {
+          const AABox2d &box = sorted_objects[i + k]->aabox();
+          block.min_x[k] = box.min_x();
+          block.min_y[k] = box.min_y();
+          block.max_x[k] = box.max_x();
+          block.max_y[k] = box.max_y();
+          block.objects[k] = sorted_objects[i + k];
+        } else {
+          block.min_x[k] = std::numeric_limits<double>::infinity();
+          block.min_y[k] = std::numeric_limits<double>::infinity();
+          block.max_x[k] = -std::numeric_limits<double>::infinity();
+          block.max_y[k] = -std::numeric_limits<double>::infinity();
+          block.objects[k] = nullptr;
+        }
+      }
+      blocks->push_back(block);
+    }
+  }
+
+  static bool SplitToSubNodes(const Node &node,
+                              const std::vector<ObjectPtr> &objects,
+                              const AABoxKDTreeParams &params,
+                              const int depth) {
+    if (params.max_depth >= 0 && depth >= params.max_depth) {
+      return false;
+    }
+    if (static_cast<int>(objects.size()) <= std::max(1, params.max_leaf_size)) {
+      return false;
+    }
+    if (params.max_leaf_dimension >= 0.0 &&
+        std::max(node.max_x - node.min_x, node.max_y - node.min_y) <=
+            params.max_leaf_dimension) {
+      return false;
+    }
+    return true;
+  }
+
+  static double PartitionPosition(const Node &node) {
+    return node.partition_x ? (node.min_x + node.max_x) / 2.0
+                            : (node.min_y + node.max_y) / 2.0;
+  }
+
+  static double LowerDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
+    double dx = 0.0;
+    if (point.x() < node.min_x) {
+      dx = node.min_x - point.x();
+    } else if (point.x() > node.max_x) {
+      dx = point.x() - node.max_x;
+    }
+    double dy = 0.0;
+    if (point.y() < node.min_y) {
+      dy = node.min_y - point.y();
+    } else if (point.y() > node.max_y) {
+      dy = point.y() - node.max_y;
+    }
+    return dx * dx + dy * dy;
+  }
+
+  static double UpperDistanceSquareToPoint(const Node &node,
+                                           const Vec2d &point) {
+    const double mid_x = (node.min_x + node.max_x) / 2.0;
+    const double mid_y = (node.min_y + node.max_y) / 2.0;
+    const double dx = (point.x() > mid_x ? (point.x() - node.min_x)
+                                         : (point.x() - node.max_x));
+    const double dy = (point.y() > mid_y ? (point.y() - node.min_y)
+                                         : (point.y() - node.max_y));
+    return dx * dx + dy * dy;
+  }
+
+  // Squared distances from the point to the bounding boxes of a block, lower
+  // bounds of the distances to the objects themselves.
+  static void BoxDistanceSquares(const ObjectBlock &block, const Vec2d &point,
+                                 double *const distance_sqrs) {
+#if defined(__AVX2__)
+    const __m256d x = _mm256_set1_pd(point.x());
+    const __m256d y = _mm256_set1_pd(point.y());
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d dx = _mm256_max_pd(
+        _mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(block.min_x), x),
+                      _mm256_sub_pd(x, _mm256_loadu_pd(block.max_x))),
+        zero);
+    const __m256d dy = _mm256_max_pd(
+        _mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(block.min_y), y),
+                      _mm256_sub_pd(y, _mm256_loadu_pd(block.max_y))),
+        zero);
+    _mm256_storeu_pd(distance_sqrs, _mm256_add_pd(_mm256_mul_pd(dx, dx),
+                                                  _mm256_mul_pd(dy, dy)));
+#else
+    for (int k = 0; k < kBlockSize; ++k) {
+      const double dx = std::max(
+          std::max(block.min_x[k] - point.x(), point.x() - block.max_x[k]),
+          0.0);
+      const double dy = std::max(
+          std::max(block.min_y[k] - point.y(), point.y() - block.max_y[k]),
+          0.0);
+      distance_sqrs[k] = dx * dx + dy * dy;
+    }
+#endif
+  }
+
+  void GetObjectsInternal(const int index, const Vec2d &point,
+                          const double distance, const double distance_sqr,
+                          std::vector<ObjectPtr> *const result_objects) const {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node, point) > distance_sqr) {
+      return;
+    }
+    if (UpperDistanceSquareToPoint(node, point) <= distance_sqr) {
+      result_objects->insert(result_objects->end(),
+                             objects_.begin() + node.objects_begin,
+                             objects_.begin() + node.objects_end);
+      return;
+    }
+    // Objects are sorted by their bound along the partition axis, from the
+    // side of the point, up to the first block beyond reach; the box test
+    // rejects the others.
+    const double pvalue = (node.partition_x ? point.x() : point.y());
+    const bool by_min = (pvalue < PartitionPosition(node));
+    const auto &blocks = by_min ? by_min_blocks_ : by_max_blocks_;
+    const double limit = by_min ? pvalue + distance : pvalue - distance;
+    double box_distance_sqrs[kBlockSize];
+    for (int i = node.blocks_begin; i < node.blocks_end; ++i) {
+      const ObjectBlock &block = blocks[i];
+      if (by_min ? (node.partition_x ? block.min_x[0] : block.min_y[0]) > limit
+                 : (node.partition_x ? block.max_x[0] : block.max_y[0]) <
+                       limit) {
+        break;
+      }
+      BoxDistanceSquares(block, point, box_distance_sqrs);
+      for (int k = 0; k < kBlockSize; ++k) {
+        if (box_distance_sqrs[k] <= distance_sqr &&
+            block.objects[k]->DistanceSquareTo(point) <= distance_sqr) {
+          result_objects->push_back(block.objects[k]);
+        }
+      }
+    }
+    if (node.has_left_subnode) {
+      GetObjectsInternal(index + 1, point, distance, distance_sqr,
+                         result_objects);
+    }
+    if (node.right_subnode >= 0) {
+      GetObjectsInternal(node.right_subnode, point, distance, distance_sqr,
+                         result_objects);
+    }
+  }
+
+  void GetNearestObjectInternal(const int index, const Vec2d &point,
+                                double *const min_distance_sqr,
+                                ObjectPtr *const nearest_object) const {
+    const Node &node = nodes_[index];
+    if (LowerDistanceSquareToPoint(node, point) >=
+        *min_distance_sqr - kMathEpsilon) {
+      return;
+    }
+    const int left_subnode = node.has_left_subnode ? index + 1 : -1;
+    const double pvalue = (node.partition_x ? point.x() : point.y());
+    const bool search_left_first = (pvalue < PartitionPosition(node));
+    const int first_subnode =
+        search_left_first ? left_subnode : node.right_subnode;
+    const int second_subnode =
+        search_left_first ? node.right_subnode : left_subnode;
+    if (first_subnode >= 0) {
+      GetNearestObjectInternal(first_subnode, point, min_distance_sqr,
+                               nearest_object);
+    }
+    if (*min_distance_sqr <= kMathEpsilon) {
+      return;
+    }
+
+    // Objects are sorted by their bound along the partition axis, from the
+    // side of the point, up to the first block farther than the nearest
+    // object so far; the box test rejects the others.
+    const auto &blocks = search_left_first ? by_min_blocks_ : by_max_blocks_;
+    double box_distance_sqrs[kBlockSize];
+    for (int i = node.blocks_begin; i < node.blocks_end; ++i) {
+      const ObjectBlock &block = blocks[i];
+      const double bound =
+          search_left_first
+              ? (node.partition_x ? block.min_x[0] : block.min_y[0])
+              : (node.partition_x ? block.max_x[0] : block.max_y[0]);
+      if ((search_left_first ? bound > pvalue : bound < pvalue) &&
+          Square(bound - pvalue) > *min_distance_sqr) {
+        break;
+      }
+      BoxDistanceSquares(block, point, box_distance_sqrs);
+      for (int k = 0; k < kBlockSize; ++k) {
+        if (box_distance_sqrs[k] >= *min_distance_sqr) {
+          continue;
+        }
+        const double distance_sqr = block.objects[k]->DistanceSquareTo(point);
+        if (distance_sqr < *min_distance_sqr) {
+          *min_distance_sqr = distance_sqr;
+          *nearest_object = block.objects[k];
+        }
+      }
+    }
+    if (*min_distance_sqr <= kMathEpsilon) {
+      return;
+    }
+    if (second_subnode >= 0) {
+      GetNearestObjectInternal(second_subnode, point, min_distance_sqr,
+                               nearest_object);
+    }
   }
 
  private:
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> root_ = nullptr;
+  std::vector<Node> nodes_;
+  // The objects of the nodes in the order of the nodes, so that those of a
+  // sub-tree are contiguous.
+  std::vector<ObjectPtr> objects_;
+  // The object blocks of each node, from blocks_begin to blocks_end, sorted
+  // by increasing min bound and by decreasing max bound along the partition
+  // axis.
+  std::vector<ObjectBlock> by_min_blocks_;
+  std::vector<ObjectBlock> by_max_blocks_;
 };
 
 }  // namespace math
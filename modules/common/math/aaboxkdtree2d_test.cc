@@ -16,7 +16,9 @@
 
 #include "modules/common/math/aaboxkdtree2d.h"
 
+#include <set>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -118,6 +120,108 @@ TEST(AABoxKDTree2dNode, OverallTests) {
   }
 }
 
+TEST(AABoxKDTree2d, MatchesNodeTree) {
+  const int kNumBoxes = 500;
+  const int kNumQueries = 1000;
+  const double kSize = 100;
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;
+  params.max_leaf_size = 16;
+
+  std::vector<Object> objects;
+  std::vector<const Object *> object_ptrs;
+  for (int i = 0; i < kNumBoxes; ++i) {
+    const double cx = RandomDouble(-kSize, kSize);
+    const double cy = RandomDouble(-kSize, kSize);
+    const double dx = RandomDouble(-kSize / 20.0, kSize / 20.0);
+    const double dy = RandomDouble(-kSize / 20.0, kSize / 20.0);
+    objects.emplace_back(cx - dx, cy - dy, cx + dx, cy + dy, i);
+  }
+  for (const auto &object : objects) {
+    object_ptrs.push_back(&object);
+  }
+  const AABoxKDTree2d<Object> kdtree(objects, params);
+  const AABoxKDTree2dNode<Object> node(object_ptrs, params, 0);
+  EXPECT_NEAR(kdtree.GetBoundingBox().min_x(),
+              node.GetBoundingBox().min_x(), 1e-9);
+  EXPECT_NEAR(kdtree.GetBoundingBox().max_y(),
+              node.GetBoundingBox().max_y(), 1e-9);
+
+  for (int i = 0; i < kNumQueries; ++i) {
+    const Vec2d point(RandomDouble(-kSize * 1.5, kSize * 1.5),
+                      RandomDouble(-kSize * 1.5, kSize * 1.5));
+    const double distance = RandomDouble(0, kSize / 2.0);
+    std::set<int> ids;
+    for (const Object *object : kdtree.GetObjects(point, distance)) {
+      ids.insert(object->id());
+    }
+    std::set<int> expected_ids;
+    for (const Object *object : node.GetObjects(point, distance)) {
+      expected_ids.insert(object->id());
+    }
+    EXPECT_EQ(expected_ids, ids);
+    EXPECT_NEAR(node.GetNearestObject(point)->DistanceTo(point),
+                kdtree.GetNearestObject(point)->DistanceTo(point), 1e-9);
+  }
+}
+
+TEST(AABoxKDTree2d, BatchQueries) {
+  const int kNumBoxes = 200;
+  const int kNumPoints = 100;
+  const double kSize = 100;
+  AABoxKDTreeParams params;
+  params.max_leaf_size = 4;
+
+  std::vector<Object> objects;
+  for (int i = 0; i < kNumBoxes; ++i) {
+    const double cx = RandomDouble(-kSize, kSize);
+    const double cy = RandomDouble(-kSize, kSize);
+    const double dx = RandomDouble(-kSize / 10.0, kSize / 10.0);
+    const double dy = RandomDouble(-kSize / 10.0, kSize / 10.0);
+    objects.emplace_back(cx - dx, cy - dy, cx + dx, cy + dy, i);
+  }
+  const AABoxKDTree2d<Object> kdtree(objects, params);
+
+  // Points along a line, as along a path.
+  std::vector<Vec2d> points;
+  for (int i = 0; i < kNumPoints; ++i) {
+    points.emplace_back(-kSize + 2.0 * kSize * i / kNumPoints,
+                        RandomDouble(-1.0, 1.0));
+  }
+  const auto nearest_objects = kdtree.GetNearestObjects(points);
+  ASSERT_EQ(points.size(), nearest_objects.size());
+  std::vector<std::vector<const Object *>> result_objects;
+  kdtree.GetObjects(points, 10.0, &result_objects);
+  ASSERT_EQ(points.size(), result_objects.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(kdtree.GetNearestObject(points[i])->DistanceTo(points[i]),
+                nearest_objects[i]->DistanceTo(points[i]), 1e-9);
+    EXPECT_EQ(kdtree.GetObjects(points[i], 10.0).size(),
+              result_objects[i].size());
+  }
+
+  const std::vector<double> distances = {30.0, 0.0, 5.0, 60.0};
+  kdtree.GetObjects(points.front(), distances, &result_objects);
+  ASSERT_EQ(distances.size(), result_objects.size());
+  for (size_t i = 0; i < distances.size(); ++i) {
+    std::set<int> ids;
+    for (const Object *object : result_objects[i]) {
+      ids.insert(object->id());
+    }
+    std::set<int> expected_ids;
+    for (const Object *object :
+         kdtree.GetObjects(points.front(), distances[i])) {
+      expected_ids.insert(object->id());
+    }
+    EXPECT_EQ(expected_ids, ids);
+  }
+
+  const AABoxKDTree2d<Object> empty_kdtree({}, params);
+  EXPECT_EQ(nullptr, empty_kdtree.GetNearestObject(points.front()));
+  EXPECT_TRUE(empty_kdtree.GetObjects(points.front(), 10.0).empty());
+  EXPECT_EQ(nullptr, empty_kdtree.GetNearestObjects(points).front());
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "cyber/common/log.h"
+#include "modules/common/math/fast_math.h"
 #include "modules/common/math/math_utils.h"
 
 namespace apollo {
@@ -34,8 +35,9 @@ void CartesianFrenetConverter::cartesian_to_frenet(
   const double dx = x - rx;
   const double dy = y - ry;
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  FastSinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   const double cross_rd_nd = cos_theta_r * dy - sin_theta_r * dx;
   ptr_d_condition->at(0) =
@@ -75,8 +77,9 @@ void CartesianFrenetConverter::cartesian_to_frenet(
   const double dx = x - rx;
   const double dy = y - ry;
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  FastSinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   const double cross_rd_nd = cos_theta_r * dy - sin_theta_r * dx;
   *ptr_d = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
@@ -93,8 +96,9 @@ void CartesianFrenetConverter::frenet_to_cartesian(
   ACHECK(std::abs(rs - s_condition[0]) < 1.0e-6)
       << "The reference point s and s_condition[0] don't match";
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  FastSinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   *ptr_x = rx - sin_theta_r * d_condition[0];
   *ptr_y = ry + cos_theta_r * d_condition[0];
@@ -102,10 +106,10 @@ void CartesianFrenetConverter::frenet_to_cartesian(
   const double one_minus_kappa_r_d = 1 - rkappa * d_condition[0];
 
   const double tan_delta_theta = d_condition[1] / one_minus_kappa_r_d;
-  const double delta_theta = std::atan2(d_condition[1], one_minus_kappa_r_d);
-  const double cos_delta_theta = std::cos(delta_theta);
+  const double delta_theta = FastAtan2(d_condition[1], one_minus_kappa_r_d);
+  const double cos_delta_theta = FastCos(delta_theta);
 
-  *ptr_theta = NormalizeAngle(delta_theta + rtheta);
+  *ptr_theta = FastNormalizeAngle(delta_theta + rtheta);
 
   const double kappa_r_d_prime =
       rdkappa * d_condition[0] + rkappa * d_condition[1];
@@ -132,7 +136,7 @@ double CartesianFrenetConverter::CalculateTheta(const double rtheta,
                                                 const double rkappa,
                                                 const double l,
                                                 const double dl) {
-  return NormalizeAngle(rtheta + std::atan2(dl, 1 - l * rkappa));
+  return FastNormalizeAngle(rtheta + FastAtan2(dl, 1 - l * rkappa));
 }
 
 double CartesianFrenetConverter::CalculateKappa(const double rkappa,
@@ -153,8 +157,11 @@ double CartesianFrenetConverter::CalculateKappa(const double rkappa,
 Vec2d CartesianFrenetConverter::CalculateCartesianPoint(const double rtheta,
                                                         const Vec2d& rpoint,
                                                         const double l) {
-  const double x = rpoint.x() - l * std::sin(rtheta);
-  const double y = rpoint.y() + l * std::cos(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  FastSinCos(rtheta, &sin_theta_r, &cos_theta_r);
+  const double x = rpoint.x() - l * sin_theta_r;
+  const double y = rpoint.y() + l * cos_theta_r;
   return Vec2d(x, y);
 }
 
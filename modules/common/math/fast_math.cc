@@ -0,0 +1,250 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/fast_math.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+#if defined(__AVX2__)
+
+namespace internal = fast_math_internal;
+
+constexpr size_t kLanes = 4;
+
+__m256d Set(const double value) { return _mm256_set1_pd(value); }
+
+__m256d Add(const __m256d a, const __m256d b) { return _mm256_add_pd(a, b); }
+
+__m256d Sub(const __m256d a, const __m256d b) { return _mm256_sub_pd(a, b); }
+
+__m256d Mul(const __m256d a, const __m256d b) { return _mm256_mul_pd(a, b); }
+
+__m256d Abs(const __m256d a) { return _mm256_andnot_pd(Set(-0.0), a); }
+
+// Rounds to the nearest integer, and returns the biased sum, whose low bits
+// are those of the integer.
+__m256d Round(const __m256d a, __m256d *biased) {
+  *biased = Add(a, Set(internal::kRoundingBias));
+  return Sub(*biased, Set(internal::kRoundingBias));
+}
+
+// Returns false if some angle is out of the range FastSinCos() reduces.
+bool SinCos4(const double *angles, double *sines, double *cosines) {
+  const __m256d angle = _mm256_loadu_pd(angles);
+  const __m256d out_of_range =
+      _mm256_cmp_pd(Abs(angle), Set(kFastSinCosMaxAngle), _CMP_NLE_UQ);
+  if (_mm256_movemask_pd(out_of_range) != 0) {
+    return false;
+  }
+  __m256d biased;
+  const __m256d q = Round(Mul(angle, Set(internal::kTwoOverPi)), &biased);
+  __m256d r = Sub(angle, Mul(q, Set(internal::kPiOver2Part1)));
+  r = Sub(r, Mul(q, Set(internal::kPiOver2Part2)));
+  r = Sub(r, Mul(q, Set(internal::kPiOver2Part3)));
+  const __m256d z = Mul(r, r);
+
+  __m256d s = Add(Mul(z, Set(internal::kSin6)), Set(internal::kSin5));
+  s = Add(Mul(z, s), Set(internal::kSin4));
+  s = Add(Mul(z, s), Set(internal::kSin3));
+  s = Add(Mul(z, s), Set(internal::kSin2));
+  s = Add(Mul(z, s), Set(internal::kSin1));
+  s = Add(r, Mul(Mul(r, z), s));
+
+  __m256d c = Add(Mul(z, Set(internal::kCos6)), Set(internal::kCos5));
+  c = Add(Mul(z, c), Set(internal::kCos4));
+  c = Add(Mul(z, c), Set(internal::kCos3));
+  c = Add(Mul(z, c), Set(internal::kCos2));
+  c = Add(Mul(z, c), Set(internal::kCos1));
+  c = Add(Sub(Set(1.0), Mul(Set(0.5), z)), Mul(Mul(z, z), c));
+
+  // Quadrants 1 and 3 swap sine and cosine, the sine is negated in
+  // quadrants 2 and 3, and the cosine in quadrants 1 and 2.
+  const __m256i quadrant = _mm256_castpd_si256(biased);
+  const __m256i one = _mm256_set1_epi64x(1);
+  const __m256i two = _mm256_set1_epi64x(2);
+  const __m256d swap = _mm256_castsi256_pd(
+      _mm256_cmpeq_epi64(_mm256_and_si256(quadrant, one), one));
+  const __m256d sine_sign = _mm256_castsi256_pd(
+      _mm256_slli_epi64(_mm256_and_si256(quadrant, two), 62));
+  const __m256d cosine_sign = _mm256_castsi256_pd(_mm256_slli_epi64(
+      _mm256_and_si256(_mm256_add_epi64(quadrant, one), two), 62));
+  _mm256_storeu_pd(sines, _mm256_xor_pd(_mm256_blendv_pd(s, c, swap),
+                                        sine_sign));
+  _mm256_storeu_pd(cosines, _mm256_xor_pd(_mm256_blendv_pd(c, s, swap),
+                                          cosine_sign));
+  return true;
+}
+
+void Atan24(const double *ys, const double *xs, double *angles) {
+  const __m256d y = _mm256_loadu_pd(ys);
+  const __m256d x = _mm256_loadu_pd(xs);
+  const __m256d abs_x = Abs(x);
+  const __m256d abs_y = Abs(y);
+  const __m256d swapped = _mm256_cmp_pd(abs_y, abs_x, _CMP_GT_OQ);
+  const __m256d max = _mm256_blendv_pd(abs_x, abs_y, swapped);
+  const __m256d min = _mm256_blendv_pd(abs_y, abs_x, swapped);
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d a = _mm256_blendv_pd(
+      zero, _mm256_div_pd(min, max), _mm256_cmp_pd(max, zero, _CMP_GT_OQ));
+
+  const __m256d reduced =
+      _mm256_cmp_pd(a, Set(internal::kAtanReductionThreshold), _CMP_GT_OQ);
+  const __m256d t = _mm256_blendv_pd(
+      a, _mm256_div_pd(Sub(a, Set(1.0)), Add(a, Set(1.0))), reduced);
+  const __m256d z = Mul(t, t);
+  __m256d p = Add(Mul(Set(internal::kAtanP0), z), Set(internal::kAtanP1));
+  p = Add(Mul(p, z), Set(internal::kAtanP2));
+  p = Add(Mul(p, z), Set(internal::kAtanP3));
+  p = Add(Mul(p, z), Set(internal::kAtanP4));
+  __m256d q = Add(z, Set(internal::kAtanQ0));
+  q = Add(Mul(q, z), Set(internal::kAtanQ1));
+  q = Add(Mul(q, z), Set(internal::kAtanQ2));
+  q = Add(Mul(q, z), Set(internal::kAtanQ3));
+  q = Add(Mul(q, z), Set(internal::kAtanQ4));
+  const __m256d atan_t = Add(t, _mm256_div_pd(Mul(Mul(t, z), p), q));
+  __m256d angle = _mm256_blendv_pd(
+      atan_t,
+      Add(Set(M_PI_4), Add(atan_t, Set(0.5 * internal::kPiOver2Error))),
+      reduced);
+
+  angle = _mm256_blendv_pd(
+      angle, Add(Sub(Set(M_PI_2), angle), Set(internal::kPiOver2Error)),
+      swapped);
+  // Blends on the sign bits of x and y.
+  angle = _mm256_blendv_pd(
+      angle, Add(Sub(Set(M_PI), angle), Set(2.0 * internal::kPiOver2Error)),
+      x);
+  angle = _mm256_xor_pd(angle, _mm256_and_pd(y, Set(-0.0)));
+  _mm256_storeu_pd(angles, angle);
+}
+
+void Hypot4(const double *xs, const double *ys, double *lengths) {
+  const __m256d x = _mm256_loadu_pd(xs);
+  const __m256d y = _mm256_loadu_pd(ys);
+  _mm256_storeu_pd(lengths, _mm256_sqrt_pd(Add(Mul(x, x), Mul(y, y))));
+}
+
+// Returns false if some angle is too large to be normalized by rounding.
+bool NormalizeAngles4(double *angles) {
+  const __m256d angle = _mm256_loadu_pd(angles);
+  const __m256d out_of_range = _mm256_cmp_pd(
+      Abs(angle), Set(4.0 * kFastSinCosMaxAngle), _CMP_NLE_UQ);
+  if (_mm256_movemask_pd(out_of_range) != 0) {
+    return false;
+  }
+  __m256d biased;
+  const __m256d n = Round(Mul(angle, Set(0.5 * M_1_PI)), &biased);
+  __m256d a = Sub(angle, Mul(n, Set(4.0 * internal::kPiOver2Part1)));
+  a = Sub(a, Mul(n, Set(4.0 * internal::kPiOver2Part2)));
+  a = _mm256_blendv_pd(a, Sub(a, Set(2.0 * M_PI)),
+                       _mm256_cmp_pd(a, Set(M_PI), _CMP_GE_OQ));
+  a = _mm256_blendv_pd(a, Add(a, Set(2.0 * M_PI)),
+                       _mm256_cmp_pd(a, Set(-M_PI), _CMP_LT_OQ));
+  _mm256_storeu_pd(angles, a);
+  return true;
+}
+
+#endif
+
+}  // namespace
+
+void FastSinCos(const std::vector<double> &angles, std::vector<double> *sines,
+                std::vector<double> *cosines) {
+  CHECK_NOTNULL(sines);
+  CHECK_NOTNULL(cosines);
+  const size_t size = angles.size();
+  sines->resize(size);
+  cosines->resize(size);
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + kLanes <= size; i += kLanes) {
+    if (!SinCos4(&angles[i], &(*sines)[i], &(*cosines)[i])) {
+      for (size_t j = i; j < i + kLanes; ++j) {
+        FastSinCos(angles[j], &(*sines)[j], &(*cosines)[j]);
+      }
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    FastSinCos(angles[i], &(*sines)[i], &(*cosines)[i]);
+  }
+}
+
+void FastAtan2(const std::vector<double> &ys, const std::vector<double> &xs,
+               std::vector<double> *angles) {
+  CHECK_NOTNULL(angles);
+  CHECK_EQ(ys.size(), xs.size());
+  const size_t size = ys.size();
+  angles->resize(size);
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + kLanes <= size; i += kLanes) {
+    Atan24(&ys[i], &xs[i], &(*angles)[i]);
+  }
+#endif
+  for (; i < size; ++i) {
+    (*angles)[i] = FastAtan2(ys[i], xs[i]);
+  }
+}
+
+void FastHypot(const std::vector<double> &xs, const std::vector<double> &ys,
+               std::vector<double> *lengths) {
+  CHECK_NOTNULL(lengths);
+  CHECK_EQ(xs.size(), ys.size());
+  const size_t size = xs.size();
+  lengths->resize(size);
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + kLanes <= size; i += kLanes) {
+    Hypot4(&xs[i], &ys[i], &(*lengths)[i]);
+  }
+#endif
+  for (; i < size; ++i) {
+    (*lengths)[i] = FastHypot(xs[i], ys[i]);
+  }
+}
+
+void FastNormalizeAngles(std::vector<double> *angles) {
+  CHECK_NOTNULL(angles);
+  const size_t size = angles->size();
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + kLanes <= size; i += kLanes) {
+    if (!NormalizeAngles4(&(*angles)[i])) {
+      for (size_t j = i; j < i + kLanes; ++j) {
+        (*angles)[j] = FastNormalizeAngle((*angles)[j]);
+      }
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    (*angles)[i] = FastNormalizeAngle((*angles)[i]);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
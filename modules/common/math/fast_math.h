@@ -0,0 +1,291 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Fast trigonometric functions, with batch variants over vectors.
+ *
+ * The functions are within a few units in the last place of their libm
+ * counterparts on finite inputs: the absolute error is below 1e-15 for sine,
+ * cosine and atan2, and the relative error below 1e-15 for hypot. They skip
+ * what libm does for special inputs: FastHypot() does not avoid overflow, and
+ * FastAtan2() returns NaN where both arguments are infinite. The batch
+ * variants compute several elements at once with AVX2 when it is enabled,
+ * and give the same results as the scalar functions up to rounding.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace fast_math_internal {
+
+// Adding then subtracting 1.5 * 2^52 rounds a double of magnitude below 2^51
+// to the nearest integer, which is also in the low bits of the sum.
+constexpr double kRoundingBias = 6755399441055744.0;
+
+// pi / 2 split into parts of 33 bits, so that multiples of the first two by
+// integers below 2^20 are exact.
+constexpr double kPiOver2Part1 = 1.57079632673412561417e+00;
+constexpr double kPiOver2Part2 = 6.07710050630396597660e-11;
+constexpr double kPiOver2Part3 = 2.02226624871116645580e-21;
+constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+
+// The error of the double closest to pi / 2.
+constexpr double kPiOver2Error = 6.123233995736765886130e-17;
+
+// Minimax polynomials of sine and cosine on [-pi / 4, pi / 4], from fdlibm.
+constexpr double kSin1 = -1.66666666666666324348e-01;
+constexpr double kSin2 = 8.33333333332248946124e-03;
+constexpr double kSin3 = -1.98412698298579493134e-04;
+constexpr double kSin4 = 2.75573137070700676789e-06;
+constexpr double kSin5 = -2.50507602534068634195e-08;
+constexpr double kSin6 = 1.58969099521155010221e-10;
+constexpr double kCos1 = 4.16666666666666019037e-02;
+constexpr double kCos2 = -1.38888888888741095749e-03;
+constexpr double kCos3 = 2.48015872894767294178e-05;
+constexpr double kCos4 = -2.75573143513906633035e-07;
+constexpr double kCos5 = 2.08757232129817482790e-09;
+constexpr double kCos6 = -1.13596475577881948265e-11;
+
+// Rational approximation of arctangent on [0, 0.66], from Cephes.
+constexpr double kAtanP0 = -8.750608600031904122785e-01;
+constexpr double kAtanP1 = -1.615753718733365076637e+01;
+constexpr double kAtanP2 = -7.500855792314704667340e+01;
+constexpr double kAtanP3 = -1.228866684490136173410e+02;
+constexpr double kAtanP4 = -6.485021904942025371773e+01;
+constexpr double kAtanQ0 = 2.485846490142306297962e+01;
+constexpr double kAtanQ1 = 1.650270098316988542046e+02;
+constexpr double kAtanQ2 = 4.328810604912902668951e+02;
+constexpr double kAtanQ3 = 4.853903996359136964868e+02;
+constexpr double kAtanQ4 = 1.945506571482613964425e+02;
+constexpr double kAtanReductionThreshold = 0.66;
+
+inline double SinKernel(const double r) {
+  const double z = r * r;
+  const double p =
+      ((((kSin6 * z + kSin5) * z + kSin4) * z + kSin3) * z + kSin2) * z +
+      kSin1;
+  return r + r * z * p;
+}
+
+inline double CosKernel(const double r) {
+  const double z = r * r;
+  const double p =
+      ((((kCos6 * z + kCos5) * z + kCos4) * z + kCos3) * z + kCos2) * z +
+      kCos1;
+  return 1.0 - 0.5 * z + z * z * p;
+}
+
+// Arctangent of a in [0, 1].
+inline double AtanKernel(const double a) {
+  // Both branches are computed so that the selection compiles without jumps.
+  const bool reduced = a > kAtanReductionThreshold;
+  const double reduced_a = (a - 1.0) / (a + 1.0);
+  const double t = reduced ? reduced_a : a;
+  const double z = t * t;
+  const double p =
+      (((kAtanP0 * z + kAtanP1) * z + kAtanP2) * z + kAtanP3) * z + kAtanP4;
+  const double q =
+      ((((z + kAtanQ0) * z + kAtanQ1) * z + kAtanQ2) * z + kAtanQ3) * z +
+      kAtanQ4;
+  const double atan_t = t + t * z * p / q;
+  return reduced ? M_PI_4 + (atan_t + 0.5 * kPiOver2Error) : atan_t;
+}
+
+}  // namespace fast_math_internal
+
+/// Largest magnitude of the angles FastSinCos() reduces by itself; it falls
+/// back to libm beyond.
+constexpr double kFastSinCosMaxAngle = 1.0e6;
+
+/**
+ * @brief Computes the sine and cosine of an angle.
+ * @param angle The angle, in radians.
+ * @param sine The sine of the angle.
+ * @param cosine The cosine of the angle.
+ */
+inline void FastSinCos(const double angle, double *sine, double *cosine) {
+  namespace internal = fast_math_internal;
+  if (!(std::abs(angle) <= kFastSinCosMaxAngle)) {
+    *sine = std::sin(angle);
+    *cosine = std::cos(angle);
+    return;
+  }
+  const double q =
+      (angle * internal::kTwoOverPi + internal::kRoundingBias) -
+      internal::kRoundingBias;
+  const double r = ((angle - q * internal::kPiOver2Part1) -
+                    q * internal::kPiOver2Part2) -
+                   q * internal::kPiOver2Part3;
+  const double s = internal::SinKernel(r);
+  const double c = internal::CosKernel(r);
+  switch (static_cast<int64_t>(q) & 3) {
+    case 0:
+      *sine = s;
+      *cosine = c;
+      break;
+    case 1:
+      *sine = c;
+      *cosine = -s;
+      break;
+    case 2:
+      *sine = -s;
+      *cosine = -c;
+      break;
+    default:
+      *sine = -c;
+      *cosine = s;
+      break;
+  }
+}
+
+/**
+ * @brief Computes the sine of an angle.
+ * @param angle The angle, in radians.
+ * @return The sine of the angle.
+ */
+inline double FastSin(const double angle) {
+  double sine = 0.0;
+  double cosine = 0.0;
+  FastSinCos(angle, &sine, &cosine);
+  return sine;
+}
+
+/**
+ * @brief Computes the cosine of an angle.
+ * @param angle The angle, in radians.
+ * @return The cosine of the angle.
+ */
+inline double FastCos(const double angle) {
+  double sine = 0.0;
+  double cosine = 0.0;
+  FastSinCos(angle, &sine, &cosine);
+  return cosine;
+}
+
+/**
+ * @brief Computes the angle of the vector (x, y) as std::atan2(y, x) does.
+ * @param y The y coordinate of the vector.
+ * @param x The x coordinate of the vector.
+ * @return The angle, in [-pi, pi].
+ */
+inline double FastAtan2(const double y, const double x) {
+  namespace internal = fast_math_internal;
+  const double abs_x = std::abs(x);
+  const double abs_y = std::abs(y);
+  const bool swapped = abs_y > abs_x;
+  const double max = swapped ? abs_y : abs_x;
+  const double min = swapped ? abs_x : abs_y;
+  double angle = internal::AtanKernel(max > 0.0 ? min / max : 0.0);
+  if (swapped) {
+    angle = (M_PI_2 - angle) + internal::kPiOver2Error;
+  }
+  if (std::signbit(x)) {
+    angle = (M_PI - angle) + 2.0 * internal::kPiOver2Error;
+  }
+  return std::signbit(y) ? -angle : angle;
+}
+
+/**
+ * @brief Computes the length of the vector (x, y), without the overflow and
+ *        underflow care of std::hypot().
+ * @param x The x coordinate of the vector.
+ * @param y The y coordinate of the vector.
+ * @return The length of the vector.
+ */
+inline double FastHypot(const double x, const double y) {
+  return std::sqrt(x * x + y * y);
+}
+
+/**
+ * @brief Normalizes an angle to [-pi, pi), as NormalizeAngle() does, and
+ *        returns angles already in range as they are.
+ * @param angle The angle, in radians.
+ * @return The normalized angle.
+ */
+inline double FastNormalizeAngle(const double angle) {
+  namespace internal = fast_math_internal;
+  if (angle >= -M_PI && angle < M_PI) {
+    return angle;
+  }
+  if (!(std::abs(angle) <= 4.0 * kFastSinCosMaxAngle)) {
+    double a = std::fmod(angle + M_PI, 2.0 * M_PI);
+    if (a < 0.0) {
+      a += (2.0 * M_PI);
+    }
+    return a - M_PI;
+  }
+  const double n =
+      (angle * (0.5 * M_1_PI) + internal::kRoundingBias) -
+      internal::kRoundingBias;
+  double a = (angle - n * (4.0 * internal::kPiOver2Part1)) -
+             n * (4.0 * internal::kPiOver2Part2);
+  if (a >= M_PI) {
+    a -= 2.0 * M_PI;
+  } else if (a < -M_PI) {
+    a += 2.0 * M_PI;
+  }
+  return a;
+}
+
+/**
+ * @brief Computes the sines and cosines of angles.
+ * @param angles The angles, in radians.
+ * @param sines The sines of the angles.
+ * @param cosines The cosines of the angles.
+ */
+void FastSinCos(const std::vector<double> &angles, std::vector<double> *sines,
+                std::vector<double> *cosines);
+
+/**
+ * @brief Computes the angles of vectors as FastAtan2() does.
+ * @param ys The y coordinates of the vectors.
+ * @param xs The x coordinates of the vectors, as many as ys.
+ * @param angles The angles of the vectors.
+ */
+void FastAtan2(const std::vector<double> &ys, const std::vector<double> &xs,
+               std::vector<double> *angles);
+
+/**
+ * @brief Computes the lengths of vectors as FastHypot() does.
+ * @param xs The x coordinates of the vectors.
+ * @param ys The y coordinates of the vectors, as many as xs.
+ * @param lengths The lengths of the vectors.
+ */
+void FastHypot(const std::vector<double> &xs, const std::vector<double> &ys,
+               std::vector<double> *lengths);
+
+/**
+ * @brief Normalizes angles to [-pi, pi) in place, as FastNormalizeAngle()
+ *        does.
+ * @param angles The angles, in radians.
+ */
+void FastNormalizeAngles(std::vector<double> *angles);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
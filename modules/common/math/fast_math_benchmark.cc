@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Compares the time and the error of the fast math functions with
+ *        those of libm.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/math/fast_math.h"
+#include "modules/common/math/math_utils.h"
+
+DEFINE_int32(num_values, 1000000, "Number of arguments per function.");
+DEFINE_double(max_angle, 10.0, "Maximum magnitude of the angles, in radians.");
+
+namespace {
+
+using apollo::common::math::FastAtan2;
+using apollo::common::math::FastHypot;
+using apollo::common::math::FastNormalizeAngle;
+using apollo::common::math::FastNormalizeAngles;
+using apollo::common::math::FastSinCos;
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+double MaxError(const std::vector<double> &expected,
+                const std::vector<double> &values) {
+  double max_error = 0.0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    max_error = std::max(max_error, std::abs(expected[i] - values[i]));
+  }
+  return max_error;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const size_t size = static_cast<size_t>(FLAGS_num_values);
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<double> distribution(-FLAGS_max_angle,
+                                                      FLAGS_max_angle);
+  std::vector<double> xs(size);
+  std::vector<double> ys(size);
+  for (size_t i = 0; i < size; ++i) {
+    xs[i] = distribution(random_engine);
+    ys[i] = distribution(random_engine);
+  }
+  std::vector<double> expected(size);
+  std::vector<double> expected_cosines(size);
+  std::vector<double> values(size);
+  std::vector<double> cosines(size);
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    expected[i] = std::sin(xs[i]);
+    expected_cosines[i] = std::cos(xs[i]);
+  }
+  const double libm_ms = MillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    FastSinCos(xs[i], &values[i], &cosines[i]);
+  }
+  const double scalar_ms = MillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+  FastSinCos(xs, &values, &cosines);
+  AINFO << "sincos: libm " << libm_ms << " ms, scalar " << scalar_ms
+        << " ms, batch " << MillisecondsSince(start) << " ms, max error "
+        << std::max(MaxError(expected, values),
+                    MaxError(expected_cosines, cosines));
+
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    expected[i] = std::atan2(ys[i], xs[i]);
+  }
+  const double atan2_libm_ms = MillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = FastAtan2(ys[i], xs[i]);
+  }
+  const double atan2_scalar_ms = MillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+  FastAtan2(ys, xs, &values);
+  AINFO << "atan2: libm " << atan2_libm_ms << " ms, scalar "
+        << atan2_scalar_ms << " ms, batch " << MillisecondsSince(start)
+        << " ms, max error " << MaxError(expected, values);
+
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    expected[i] = std::hypot(xs[i], ys[i]);
+  }
+  const double hypot_libm_ms = MillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = FastHypot(xs[i], ys[i]);
+  }
+  const double hypot_scalar_ms = MillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+  FastHypot(xs, ys, &values);
+  AINFO << "hypot: libm " << hypot_libm_ms << " ms, scalar "
+        << hypot_scalar_ms << " ms, batch " << MillisecondsSince(start)
+        << " ms, max error " << MaxError(expected, values);
+
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    expected[i] = apollo::common::math::NormalizeAngle(xs[i]);
+  }
+  const double normalize_libm_ms = MillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < size; ++i) {
+    values[i] = FastNormalizeAngle(xs[i]);
+  }
+  const double normalize_scalar_ms = MillisecondsSince(start);
+  values = xs;
+  start = std::chrono::steady_clock::now();
+  FastNormalizeAngles(&values);
+  AINFO << "NormalizeAngle: libm " << normalize_libm_ms << " ms, scalar "
+        << normalize_scalar_ms << " ms, batch " << MillisecondsSince(start)
+        << " ms, max error " << MaxError(expected, values);
+  return 0;
+}
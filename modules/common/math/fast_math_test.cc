@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/fast_math.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+constexpr double kMaxError = 1e-15;
+
+std::vector<double> RandomValues(const double bound, const size_t size) {
+  std::mt19937 random_engine(0);
+  std::uniform_real_distribution<double> distribution(-bound, bound);
+  std::vector<double> values(size);
+  for (double &value : values) {
+    value = distribution(random_engine);
+  }
+  return values;
+}
+
+// Angles around the multiples of pi / 4, where the argument reduction and the
+// polynomials are the least accurate.
+std::vector<double> HardAngles() {
+  std::vector<double> angles = {0.0, -0.0};
+  for (int k = -64; k <= 64; ++k) {
+    const double angle = k * M_PI_4;
+    angles.push_back(angle);
+    angles.push_back(std::nextafter(angle, -1e9));
+    angles.push_back(std::nextafter(angle, 1e9));
+    angles.push_back(angle + 1e-9);
+    angles.push_back(angle - 1e-9);
+  }
+  for (const double angle : {1e3, 1e4, 1e5, 1e6, 1e7, 1e8}) {
+    angles.push_back(angle);
+    angles.push_back(-angle);
+  }
+  return angles;
+}
+
+}  // namespace
+
+TEST(FastMathTest, SinCos) {
+  std::vector<double> angles = RandomValues(100.0, 100000);
+  const std::vector<double> hard_angles = HardAngles();
+  angles.insert(angles.end(), hard_angles.begin(), hard_angles.end());
+  for (const double angle : angles) {
+    double sine = 0.0;
+    double cosine = 0.0;
+    FastSinCos(angle, &sine, &cosine);
+    EXPECT_NEAR(std::sin(angle), sine, kMaxError) << angle;
+    EXPECT_NEAR(std::cos(angle), cosine, kMaxError) << angle;
+    EXPECT_EQ(sine, FastSin(angle));
+    EXPECT_EQ(cosine, FastCos(angle));
+  }
+  for (const double angle : RandomValues(kFastSinCosMaxAngle, 10000)) {
+    EXPECT_NEAR(std::sin(angle), FastSin(angle), 1e-13) << angle;
+    EXPECT_NEAR(std::cos(angle), FastCos(angle), 1e-13) << angle;
+  }
+  EXPECT_TRUE(std::isnan(FastSin(std::numeric_limits<double>::quiet_NaN())));
+  EXPECT_TRUE(std::isnan(FastCos(std::numeric_limits<double>::infinity())));
+}
+
+TEST(FastMathTest, Atan2) {
+  const std::vector<double> ys = RandomValues(10.0, 100000);
+  const std::vector<double> xs = RandomValues(1e-3, 100000);
+  for (size_t i = 0; i < ys.size(); ++i) {
+    EXPECT_NEAR(std::atan2(ys[i], xs[i]), FastAtan2(ys[i], xs[i]), kMaxError);
+    EXPECT_NEAR(std::atan2(xs[i], ys[i]), FastAtan2(xs[i], ys[i]), kMaxError);
+  }
+  for (const double y : {0.0, -0.0, 1.0, -1.0, 0.66, -0.66, 1e-300}) {
+    for (const double x : {0.0, -0.0, 1.0, -1.0, 0.66, -0.66, 1e-300}) {
+      EXPECT_NEAR(std::atan2(y, x), FastAtan2(y, x), kMaxError)
+          << y << " " << x;
+      EXPECT_EQ(std::signbit(std::atan2(y, x)), std::signbit(FastAtan2(y, x)))
+          << y << " " << x;
+    }
+  }
+  const double infinity = std::numeric_limits<double>::infinity();
+  EXPECT_DOUBLE_EQ(M_PI_2, FastAtan2(infinity, 1.0));
+  EXPECT_DOUBLE_EQ(M_PI, FastAtan2(1.0, -infinity));
+}
+
+TEST(FastMathTest, Hypot) {
+  const std::vector<double> xs = RandomValues(1e3, 10000);
+  const std::vector<double> ys = RandomValues(1e-2, 10000);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    const double expected = std::hypot(xs[i], ys[i]);
+    EXPECT_NEAR(expected, FastHypot(xs[i], ys[i]), expected * kMaxError);
+  }
+  EXPECT_EQ(5.0, FastHypot(3.0, -4.0));
+  EXPECT_EQ(0.0, FastHypot(0.0, 0.0));
+}
+
+TEST(FastMathTest, NormalizeAngle) {
+  std::vector<double> angles = RandomValues(1e3, 100000);
+  const std::vector<double> hard_angles = HardAngles();
+  angles.insert(angles.end(), hard_angles.begin(), hard_angles.end());
+  for (const double angle : angles) {
+    const double normalized = FastNormalizeAngle(angle);
+    EXPECT_GE(normalized, -M_PI);
+    EXPECT_LT(normalized, M_PI);
+    EXPECT_NEAR(0.0, NormalizeAngle(normalized - NormalizeAngle(angle)),
+                1e-12 * std::max(1.0, std::abs(angle)))
+        << angle;
+    if (angle >= -M_PI && angle < M_PI) {
+      EXPECT_EQ(angle, normalized);
+    }
+  }
+  EXPECT_EQ(-M_PI, FastNormalizeAngle(M_PI));
+  EXPECT_EQ(-M_PI, FastNormalizeAngle(-M_PI));
+  EXPECT_NEAR(0.5, FastNormalizeAngle(0.5 + 20.0 * M_PI), 1e-13);
+}
+
+TEST(FastMathTest, Batch) {
+  std::vector<double> angles = RandomValues(100.0, 1001);
+  const std::vector<double> hard_angles = HardAngles();
+  angles.insert(angles.end(), hard_angles.begin(), hard_angles.end());
+  std::vector<double> sines;
+  std::vector<double> cosines;
+  FastSinCos(angles, &sines, &cosines);
+  ASSERT_EQ(angles.size(), sines.size());
+  ASSERT_EQ(angles.size(), cosines.size());
+  for (size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_NEAR(FastSin(angles[i]), sines[i], kMaxError) << angles[i];
+    EXPECT_NEAR(FastCos(angles[i]), cosines[i], kMaxError) << angles[i];
+  }
+
+  std::vector<double> ys = RandomValues(10.0, 1003);
+  std::vector<double> xs = RandomValues(1.0, 1003);
+  for (const double y : {0.0, -0.0, 1.0, -1.0}) {
+    for (const double x : {0.0, -0.0, 1.0, -1.0}) {
+      ys.push_back(y);
+      xs.push_back(x);
+    }
+  }
+  std::vector<double> atan2s;
+  FastAtan2(ys, xs, &atan2s);
+  ASSERT_EQ(ys.size(), atan2s.size());
+  for (size_t i = 0; i < ys.size(); ++i) {
+    EXPECT_NEAR(FastAtan2(ys[i], xs[i]), atan2s[i], kMaxError);
+    EXPECT_EQ(std::signbit(FastAtan2(ys[i], xs[i])), std::signbit(atan2s[i]));
+  }
+
+  std::vector<double> lengths;
+  FastHypot(xs, ys, &lengths);
+  ASSERT_EQ(xs.size(), lengths.size());
+  for (size_t i = 0; i < xs.size(); ++i) {
+    EXPECT_DOUBLE_EQ(FastHypot(xs[i], ys[i]), lengths[i]);
+  }
+
+  std::vector<double> normalized = angles;
+  FastNormalizeAngles(&normalized);
+  ASSERT_EQ(angles.size(), normalized.size());
+  for (size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_NEAR(FastNormalizeAngle(angles[i]), normalized[i], 1e-13)
+        << angles[i];
+  }
+
+  FastSinCos({}, &sines, &cosines);
+  EXPECT_TRUE(sines.empty());
+  EXPECT_TRUE(cosines.empty());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
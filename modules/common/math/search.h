@@ -21,7 +21,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 
 /**
  * @namespace apollo::common::math
@@ -45,6 +47,50 @@ double GoldenSectionSearch(const std::function<double(double)> &func,
                            const double lower_bound, const double upper_bound,
                            const double tol = 1e-6);
 
+/**
+ * @brief Same as std::lower_bound(first, last, value, comp), searched from a
+ *        hint by galloping towards the result, so that it takes a time
+ *        logarithmic in the distance from the hint to the result. Lookups of
+ *        values moving along sorted samples take an amortized constant time
+ *        with the previous result as hint.
+ * @param first The beginning of the sorted range.
+ * @param last The end of the sorted range.
+ * @param hint The position in [first, last] to start the search from.
+ * @param value The value to search for.
+ * @param comp Returns whether an element is less than the value.
+ * @return The first position in [first, last] whose element is not less than
+ *         the value.
+ */
+template <typename RandomIt, typename T, typename Compare>
+RandomIt LowerBoundWithHint(RandomIt first, RandomIt last, RandomIt hint,
+                            const T &value, Compare comp) {
+  typename std::iterator_traits<RandomIt>::difference_type step = 1;
+  if (hint != last && comp(*hint, value)) {
+    // The result is after the hint.
+    RandomIt lower = hint + 1;
+    while (last - lower > step) {
+      const RandomIt probe = lower + step;
+      if (!comp(*probe, value)) {
+        return std::lower_bound(lower, probe, value, comp);
+      }
+      lower = probe + 1;
+      step *= 2;
+    }
+    return std::lower_bound(lower, last, value, comp);
+  }
+  // The result is at or before the hint.
+  RandomIt upper = hint;
+  while (upper - first > step) {
+    const RandomIt probe = upper - step;
+    if (comp(*probe, value)) {
+      return std::lower_bound(probe + 1, upper, value, comp);
+    }
+    upper = probe;
+    step *= 2;
+  }
+  return std::lower_bound(first, upper, value, comp);
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -16,7 +16,9 @@
 
 #include "modules/common/math/search.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -51,6 +53,24 @@ TEST(SearchTest, GoldenSectionSearch) {
   EXPECT_NEAR(sin_argmin, 1.5 * M_PI, 1e-5);
 }
 
+TEST(SearchTest, LowerBoundWithHint) {
+  const std::vector<double> values = {0.0, 1.0, 1.0, 2.0, 3.5, 3.5, 3.5, 4.0,
+                                      5.0, 7.0, 8.0, 8.5, 9.0, 9.5, 10.0};
+  const auto less = [](const double a, const double b) { return a < b; };
+  for (double value = -1.0; value <= 11.0; value += 0.25) {
+    const auto expected =
+        std::lower_bound(values.begin(), values.end(), value, less);
+    for (auto hint = values.begin(); hint <= values.end(); ++hint) {
+      EXPECT_EQ(expected, LowerBoundWithHint(values.begin(), values.end(),
+                                             hint, value, less));
+    }
+  }
+
+  const std::vector<double> empty;
+  EXPECT_EQ(empty.end(), LowerBoundWithHint(empty.begin(), empty.end(),
+                                            empty.begin(), 1.0, less));
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
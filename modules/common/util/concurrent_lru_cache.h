@@ -0,0 +1,293 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A thread-safe LRU cache, split into independently locked shards.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class ConcurrentLRUCache
+ * @brief An LRU cache which may be used from several threads at once.
+ *
+ * Keys are spread over shards by hash, each shard being an LRU cache of its
+ * own behind its own mutex, so that threads touching different shards do not
+ * wait for each other. The least recently used entry of a shard is evicted
+ * when the shard is full, hence the cache as a whole is only approximately
+ * LRU. Entries may also expire a given time after they are put.
+ *
+ * Values are copied out of the cache, since a pointer into it could be
+ * invalidated by another thread at any time.
+ */
+template <class K, class V, class Hash = std::hash<K>>
+class ConcurrentLRUCache {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Constructor.
+   * @param capacity The maximum number of entries, rounded up to a multiple
+   *        of the number of shards.
+   * @param num_shards The number of shards, at most capacity.
+   * @param time_to_live How long entries stay in the cache after they are
+   *        put, or zero for them to stay until evicted.
+   */
+  explicit ConcurrentLRUCache(
+      const size_t capacity = kDefaultCapacity,
+      const size_t num_shards = kDefaultNumShards,
+      const Clock::duration time_to_live = Clock::duration::zero())
+      : shards_(std::max<size_t>(1, std::min(num_shards, capacity))),
+        shard_capacity_(std::max<size_t>(
+            1, (capacity + shards_.size() - 1) / shards_.size())),
+        time_to_live_(time_to_live) {}
+
+  ConcurrentLRUCache(const ConcurrentLRUCache&) = delete;
+  ConcurrentLRUCache& operator=(const ConcurrentLRUCache&) = delete;
+
+  /**
+   * @brief Adds an entry, or updates it, and marks it most recently used.
+   */
+  template <typename VV>
+  void Put(const K& key, VV&& val) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    PutLocked(key, std::forward<VV>(val), &shard);
+  }
+
+  /**
+   * @brief Copies the value of an entry out, and marks it most recently used.
+   * @return false if there is no such entry, or if it has expired.
+   */
+  bool GetCopy(const K& key, V* const val) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto* entry = FindLocked(key, &shard);
+    if (entry == nullptr) {
+      ++shard.misses;
+      return false;
+    }
+    ++shard.hits;
+    *val = entry->val;
+    return true;
+  }
+
+  /**
+   * @brief Copies the value of an entry out, computing and adding it first if
+   *        missing.
+   *
+   * The value is computed without holding any lock. Two threads missing the
+   * same key may thus both compute it, and the last one to finish wins.
+   * @param compute A callable returning the value to cache.
+   */
+  template <typename F>
+  V GetOrCompute(const K& key, F&& compute) {
+    V val;
+    if (GetCopy(key, &val)) {
+      return val;
+    }
+    val = compute();
+    Put(key, val);
+    return val;
+  }
+
+  /**
+   * @brief Checks for an entry, without marking it used nor counting a hit.
+   */
+  bool Contains(const K& key) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    return it != shard.index.end() && !Expired(*it->second);
+  }
+
+  bool Remove(const K& key) {
+    Shard& shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+      return false;
+    }
+    shard.entries.erase(it->second);
+    shard.index.erase(it);
+    return true;
+  }
+
+  /**
+   * @brief Removes all entries, and keeps the hit and miss counts.
+   */
+  void Clear() {
+    for (Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.index.clear();
+      shard.entries.clear();
+    }
+  }
+
+  /**
+   * @brief The number of entries, including the expired ones not yet
+   *        dropped.
+   */
+  size_t size() const {
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      size += shard.entries.size();
+    }
+    return size;
+  }
+
+  bool Empty() const { return size() == 0; }
+
+  size_t capacity() const { return shard_capacity_ * shards_.size(); }
+
+  size_t num_shards() const { return shards_.size(); }
+
+  /**
+   * @brief The number of lookups which found an unexpired entry.
+   */
+  uint64_t hits() const {
+    uint64_t hits = 0;
+    for (const Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      hits += shard.hits;
+    }
+    return hits;
+  }
+
+  /**
+   * @brief The number of lookups which did not.
+   */
+  uint64_t misses() const {
+    uint64_t misses = 0;
+    for (const Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      misses += shard.misses;
+    }
+    return misses;
+  }
+
+  void ResetCounters() {
+    for (Shard& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.hits = 0;
+      shard.misses = 0;
+    }
+  }
+
+ private:
+  static constexpr size_t kDefaultCapacity = 1024;
+  static constexpr size_t kDefaultNumShards = 16;
+
+  struct Entry {
+    K key;
+    V val;
+    Clock::time_point expiration_time;
+
+    template <typename VV>
+    Entry(const K& key, VV&& val, const Clock::time_point expiration_time)
+        : key(key),
+          val(std::forward<VV>(val)),
+          expiration_time(expiration_time) {}
+  };
+
+  // Entries are ordered from the most to the least recently used.
+  struct Shard {
+    mutable std::mutex mutex;
+    std::list<Entry> entries;
+    std::unordered_map<K, typename std::list<Entry>::iterator, Hash> index;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+  };
+
+  Shard& GetShard(const K& key) {
+    // Scrambles the hash, which is the identity for integers in libstdc++,
+    // so that keys with a common stride still spread over all shards.
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return shards_[hash % shards_.size()];
+  }
+
+  Clock::time_point ExpirationTime() const {
+    return time_to_live_ == Clock::duration::zero()
+               ? Clock::time_point::max()
+               : Clock::now() + time_to_live_;
+  }
+
+  bool Expired(const Entry& entry) const {
+    return entry.expiration_time != Clock::time_point::max() &&
+           entry.expiration_time <= Clock::now();
+  }
+
+  // Returns the unexpired entry of the key, moved to the front, or nullptr.
+  Entry* FindLocked(const K& key, Shard* const shard) {
+    auto it = shard->index.find(key);
+    if (it == shard->index.end()) {
+      return nullptr;
+    }
+    if (Expired(*it->second)) {
+      shard->entries.erase(it->second);
+      shard->index.erase(it);
+      return nullptr;
+    }
+    shard->entries.splice(shard->entries.begin(), shard->entries, it->second);
+    return &shard->entries.front();
+  }
+
+  template <typename VV>
+  void PutLocked(const K& key, VV&& val, Shard* const shard) {
+    auto it = shard->index.find(key);
+    if (it != shard->index.end()) {
+      it->second->val = std::forward<VV>(val);
+      it->second->expiration_time = ExpirationTime();
+      shard->entries.splice(shard->entries.begin(), shard->entries,
+                            it->second);
+      return;
+    }
+    if (shard->entries.size() >= shard_capacity_) {
+      shard->index.erase(shard->entries.back().key);
+      shard->entries.pop_back();
+    }
+    shard->entries.emplace_front(key, std::forward<VV>(val),
+                                 ExpirationTime());
+    shard->index.emplace(key, shard->entries.begin());
+  }
+
+  std::vector<Shard> shards_;
+  const size_t shard_capacity_;
+  const Clock::duration time_to_live_;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Measures the throughput of the concurrent LRU cache against that of
+ *        the LRU cache behind a mutex, as the number of threads grows.
+ */
+
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/util/concurrent_lru_cache.h"
+#include "modules/common/util/lru_cache.h"
+
+DEFINE_int32(max_num_threads, 8, "Largest number of threads to run.");
+DEFINE_int32(num_operations, 1000000, "Number of operations per thread.");
+DEFINE_int32(num_keys, 4096, "Number of distinct keys looked up.");
+DEFINE_int32(capacity, 2048, "Capacity of the caches.");
+DEFINE_int32(num_shards, 16, "Number of shards of the concurrent cache.");
+
+namespace {
+
+using apollo::common::util::ConcurrentLRUCache;
+using apollo::common::util::LRUCache;
+
+// Runs the lookup of random keys, with a put on each miss, on the given
+// number of threads, and returns the millions of operations per second.
+template <typename Lookup>
+double Run(const int num_threads, const Lookup& lookup) {
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&lookup, t]() {
+      std::mt19937 random_engine(t);
+      std::uniform_int_distribution<int> distribution(0, FLAGS_num_keys - 1);
+      for (int i = 0; i < FLAGS_num_operations; ++i) {
+        lookup(distribution(random_engine));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  return num_threads * static_cast<double>(FLAGS_num_operations) / seconds /
+         1e6;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  for (int num_threads = 1; num_threads <= FLAGS_max_num_threads;
+       num_threads *= 2) {
+    LRUCache<int, int> lru_cache(FLAGS_capacity);
+    std::mutex mutex;
+    const double locked_rate = Run(num_threads, [&](const int key) {
+      std::lock_guard<std::mutex> lock(mutex);
+      int val = 0;
+      if (!lru_cache.GetCopy(key, &val)) {
+        lru_cache.Put(key, key);
+      }
+    });
+
+    ConcurrentLRUCache<int, int> single_shard_cache(FLAGS_capacity, 1);
+    const double single_shard_rate = Run(num_threads, [&](const int key) {
+      single_shard_cache.GetOrCompute(key, [key]() { return key; });
+    });
+
+    ConcurrentLRUCache<int, int> cache(FLAGS_capacity, FLAGS_num_shards);
+    const double sharded_rate = Run(num_threads, [&](const int key) {
+      cache.GetOrCompute(key, [key]() { return key; });
+    });
+    AINFO << num_threads << " threads, million operations per second: "
+          << "locked LRUCache " << locked_rate << ", 1 shard "
+          << single_shard_rate << ", " << cache.num_shards() << " shards "
+          << sharded_rate << ", hit rate "
+          << static_cast<double>(cache.hits()) /
+                 static_cast<double>(cache.hits() + cache.misses());
+  }
+  return 0;
+}
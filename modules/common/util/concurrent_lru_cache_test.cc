@@ -0,0 +1,144 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/concurrent_lru_cache.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ConcurrentLRUCache, General) {
+  // A single shard is an exact LRU cache.
+  ConcurrentLRUCache<int, std::string> cache(3, 1);
+  EXPECT_EQ(3, cache.capacity());
+  EXPECT_TRUE(cache.Empty());
+  cache.Put(1, "a");
+  cache.Put(2, "b");
+  cache.Put(3, "c");
+  std::string val;
+  EXPECT_TRUE(cache.GetCopy(1, &val));
+  EXPECT_EQ("a", val);
+  // 2 is now the least recently used.
+  cache.Put(4, "d");
+  EXPECT_EQ(3, cache.size());
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_TRUE(cache.Contains(1));
+  EXPECT_TRUE(cache.Contains(3));
+  EXPECT_TRUE(cache.Contains(4));
+
+  cache.Put(3, "e");
+  EXPECT_TRUE(cache.GetCopy(3, &val));
+  EXPECT_EQ("e", val);
+  EXPECT_FALSE(cache.GetCopy(2, &val));
+  EXPECT_EQ(2, cache.hits());
+  EXPECT_EQ(1, cache.misses());
+
+  EXPECT_TRUE(cache.Remove(3));
+  EXPECT_FALSE(cache.Remove(3));
+  EXPECT_EQ(2, cache.size());
+  cache.Clear();
+  EXPECT_TRUE(cache.Empty());
+  EXPECT_EQ(2, cache.hits());
+  cache.ResetCounters();
+  EXPECT_EQ(0, cache.hits());
+  EXPECT_EQ(0, cache.misses());
+}
+
+TEST(ConcurrentLRUCache, Shards) {
+  ConcurrentLRUCache<int, int> cache(100, 8);
+  EXPECT_EQ(8, cache.num_shards());
+  EXPECT_EQ(104, cache.capacity());
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i, i);
+  }
+  EXPECT_LE(cache.size(), cache.capacity());
+  EXPECT_GT(cache.size(), 80);
+  // The most recent entries are in whatever shard they fell.
+  int val = 0;
+  EXPECT_TRUE(cache.GetCopy(999, &val));
+  EXPECT_EQ(999, val);
+
+  ConcurrentLRUCache<int, int> small_cache(2, 16);
+  EXPECT_EQ(2, small_cache.num_shards());
+}
+
+TEST(ConcurrentLRUCache, TimeToLive) {
+  ConcurrentLRUCache<int, int> cache(10, 2, std::chrono::milliseconds(1));
+  cache.Put(1, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(cache.Contains(1));
+  int val = 0;
+  EXPECT_FALSE(cache.GetCopy(1, &val));
+  EXPECT_EQ(1, cache.misses());
+  EXPECT_EQ(0, cache.size());
+
+  ConcurrentLRUCache<int, int> long_cache(10, 2, std::chrono::hours(1));
+  long_cache.Put(1, 1);
+  EXPECT_TRUE(long_cache.GetCopy(1, &val));
+}
+
+TEST(ConcurrentLRUCache, GetOrCompute) {
+  ConcurrentLRUCache<int, int> cache(10, 2);
+  int num_computations = 0;
+  auto square = [&num_computations](const int i) {
+    return [&num_computations, i]() {
+      ++num_computations;
+      return i * i;
+    };
+  };
+  EXPECT_EQ(9, cache.GetOrCompute(3, square(3)));
+  EXPECT_EQ(9, cache.GetOrCompute(3, square(3)));
+  EXPECT_EQ(1, num_computations);
+  EXPECT_EQ(1, cache.hits());
+  EXPECT_EQ(1, cache.misses());
+}
+
+TEST(ConcurrentLRUCache, Threads) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 64;
+  constexpr int kNumIterations = 10000;
+  ConcurrentLRUCache<int, int> cache(kNumKeys, 4);
+  std::atomic<int> num_wrong_values(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&cache, &num_wrong_values, t]() {
+      for (int i = 0; i < kNumIterations; ++i) {
+        const int key = (i * 7 + t) % kNumKeys;
+        const int val = cache.GetOrCompute(key, [key]() { return key * 2; });
+        if (val != key * 2) {
+          ++num_wrong_values;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, num_wrong_values.load());
+  EXPECT_EQ(kNumThreads * kNumIterations, cache.hits() + cache.misses());
+  EXPECT_LE(cache.size(), cache.capacity());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
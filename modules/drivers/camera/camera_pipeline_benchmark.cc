@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Measures the throughput of the camera pipeline (yuyv -> rgb conversion and
+// jpeg compression) on recorded raw frames. The input file is a plain
+// concatenation of yuyv frames, e.g. dumped from the v4l2 device with
+// `v4l2-ctl --stream-mmap --stream-to=frames.yuyv`.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/base/thread_pool.h"
+#include "cyber/common/log.h"
+#include "modules/drivers/camera/jpeg_encoder.h"
+#include "modules/drivers/camera/util.h"
+
+DEFINE_string(raw_frames, "", "File of concatenated raw yuyv frames.");
+DEFINE_int32(width, 1920, "Frame width in pixels.");
+DEFINE_int32(height, 1080, "Frame height in pixels.");
+DEFINE_bool(uyvy, false, "Frames are uyvy instead of yuyv.");
+DEFINE_int32(threads, 4, "Number of jpeg compression threads.");
+DEFINE_int32(repeat, 10, "Number of passes over the recorded frames.");
+DEFINE_int32(quality, 95, "Quality of the jpeg compression.");
+
+namespace {
+
+using apollo::cyber::base::ThreadPool;
+using apollo::drivers::camera::JpegEncoder;
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  const size_t pixels = static_cast<size_t>(FLAGS_width) * FLAGS_height;
+  const size_t frame_size = 2 * pixels;
+
+  std::ifstream fin(FLAGS_raw_frames, std::ios::binary);
+  if (!fin) {
+    AERROR << "failed to open raw frames file: " << FLAGS_raw_frames;
+    return -1;
+  }
+  std::vector<std::vector<unsigned char>> frames;
+  std::vector<unsigned char> frame(frame_size);
+  while (fin.read(reinterpret_cast<char*>(frame.data()), frame_size)) {
+    frames.push_back(frame);
+  }
+  if (frames.empty()) {
+    AERROR << "no complete " << FLAGS_width << "x" << FLAGS_height
+           << " frame in " << FLAGS_raw_frames;
+    return -1;
+  }
+  AINFO << "loaded " << frames.size() << " frames";
+
+  const int total = static_cast<int>(frames.size()) * FLAGS_repeat;
+  const int threads = std::max(FLAGS_threads, 1);
+  std::vector<std::vector<unsigned char>> rgb_frames(
+      threads, std::vector<unsigned char>(3 * pixels));
+  std::vector<std::unique_ptr<JpegEncoder>> encoders;
+  for (int i = 0; i < threads; ++i) {
+    encoders.emplace_back(new JpegEncoder(FLAGS_quality));
+  }
+
+  // color conversion only, single thread
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < total; ++i) {
+    auto& raw = frames[i % frames.size()];
+    if (FLAGS_uyvy) {
+      apollo::drivers::camera::uyvy2rgb_avx(raw.data(), rgb_frames[0].data(),
+                                            static_cast<int>(pixels));
+    } else {
+      apollo::drivers::camera::yuyv2rgb_avx(raw.data(), rgb_frames[0].data(),
+                                            static_cast<int>(pixels));
+    }
+  }
+  double seconds = SecondsSince(start);
+  AINFO << "convert: " << total / seconds << " fps, "
+        << total * frame_size / seconds / 1e6 << " MB/s";
+
+  // conversion + compression, every worker owns a rgb buffer and an encoder
+  ThreadPool pool(threads, threads);
+  size_t jpeg_bytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < total; i += threads) {
+    std::vector<std::future<size_t>> results;
+    for (int t = 0; t < threads && i + t < total; ++t) {
+      results.push_back(pool.Enqueue([&, i, t]() -> size_t {
+        auto& raw = frames[(i + t) % frames.size()];
+        auto& rgb = rgb_frames[t];
+        if (FLAGS_uyvy) {
+          apollo::drivers::camera::uyvy2rgb_avx(raw.data(), rgb.data(),
+                                                static_cast<int>(pixels));
+        } else {
+          apollo::drivers::camera::yuyv2rgb_avx(raw.data(), rgb.data(),
+                                                static_cast<int>(pixels));
+        }
+        if (!encoders[t]->Encode(rgb.data(), FLAGS_width, FLAGS_height,
+                                 3 * FLAGS_width)) {
+          return 0;
+        }
+        return encoders[t]->size();
+      }));
+    }
+    for (auto& result : results) {
+      jpeg_bytes += result.get();
+    }
+  }
+  seconds = SecondsSince(start);
+  AINFO << "convert + compress with " << threads
+        << " threads: " << total / seconds << " fps, average jpeg size "
+        << jpeg_bytes / total << " bytes";
+  return 0;
+}
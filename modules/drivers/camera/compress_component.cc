@@ -16,12 +16,20 @@
 
 #include "modules/drivers/camera/compress_component.h"
 
+#include <algorithm>
 #include <exception>
-#include <vector>
 
-#include "opencv2/core/core.hpp"
-#include "opencv2/highgui/highgui.hpp"
-#include "opencv2/imgproc/imgproc.hpp"
+#include "gflags/gflags.h"
+
+DEFINE_int32(camera_compress_thread_num, 2,
+             "Number of threads encoding jpeg images in parallel, 0 encodes "
+             "synchronously in Proc. With more than one thread, compressed "
+             "images may be published out of order, readers should sort "
+             "them by header timestamp if they need to.");
+DEFINE_int32(camera_compress_queue_size, 4,
+             "Max number of images waiting for a compress thread, newer "
+             "images are dropped when the queue is full.");
+DEFINE_int32(camera_jpeg_quality, 95, "Quality of the jpeg compression.");
 
 namespace apollo {
 namespace drivers {
@@ -42,6 +50,21 @@ bool CompressComponent::Init() {
     return false;
   }
 
+  const int thread_num = std::max(FLAGS_camera_compress_thread_num, 0);
+  try {
+    for (int i = 0; i < std::max(thread_num, 1); ++i) {
+      encoders_.emplace_back(new JpegEncoder(FLAGS_camera_jpeg_quality));
+      free_encoders_.push_back(encoders_.back().get());
+    }
+    if (thread_num > 0) {
+      compress_pool_.reset(
+          new ThreadPool(thread_num, FLAGS_camera_compress_queue_size));
+    }
+  } catch (const std::exception& e) {
+    AERROR << e.what();
+    return false;
+  }
+
   writer_ = node_->CreateWriter<CompressedImage>(
       config_.compress_conf().output_channel());
   return true;
@@ -49,33 +72,65 @@ bool CompressComponent::Init() {
 
 bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   ADEBUG << "procing compressed";
+  if (compress_pool_ == nullptr) {
+    return Compress(image);
+  }
+  // the task shares the message instead of copying the raw image
+  if (!compress_pool_->Enqueue([this, image]() { Compress(image); }).valid()) {
+    const uint64_t num_dropped_images = ++num_dropped_images_;
+    AWARN_EVERY(100) << "compress queue is full, dropped "
+                     << num_dropped_images << " images so far";
+    return false;
+  }
+  return true;
+}
+
+void CompressComponent::EncoderReleaser::operator()(
+    JpegEncoder* encoder) const {
+  std::lock_guard<std::mutex> lock(component->free_encoders_mutex_);
+  component->free_encoders_.push_back(encoder);
+}
+
+CompressComponent::EncoderPtr CompressComponent::AcquireEncoder() {
+  std::lock_guard<std::mutex> lock(free_encoders_mutex_);
+  if (free_encoders_.empty()) {
+    return EncoderPtr(nullptr, EncoderReleaser{this});
+  }
+  JpegEncoder* encoder = free_encoders_.back();
+  free_encoders_.pop_back();
+  return EncoderPtr(encoder, EncoderReleaser{this});
+}
+
+bool CompressComponent::Compress(const std::shared_ptr<Image>& image) {
+  auto encoder = AcquireEncoder();
+  if (encoder == nullptr) {
+    AERROR << "no free jpeg encoder";
+    return false;
+  }
   auto compressed_image = image_pool_->GetObject();
+  if (compressed_image == nullptr) {
+    AERROR << "compressed image pool is exhausted";
+    return false;
+  }
   compressed_image->mutable_header()->CopyFrom(image->header());
   compressed_image->set_frame_id(image->frame_id());
   compressed_image->set_measurement_time(image->measurement_time());
   compressed_image->set_format(image->encoding() + "; jpeg compressed bgr8");
 
-  std::vector<int> params;
-  params.resize(3, 0);
-  params[0] = cv::IMWRITE_JPEG_QUALITY;
-  params[1] = 95;
-
-  try {
-    cv::Mat mat_image(image->height(), image->width(), CV_8UC3,
-                      const_cast<char*>(image->data().data()), image->step());
-    cv::Mat tmp_mat;
-    cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
-    std::vector<uint8_t> compress_buffer;
-    if (!cv::imencode(".jpg", tmp_mat, compress_buffer, params)) {
-      AERROR << "cv::imencode (jpeg) failed on input image";
-      return false;
-    }
-    compressed_image->set_data(compress_buffer.data(), compress_buffer.size());
-    writer_->Write(compressed_image);
-  } catch (std::exception& e) {
-    AERROR << "cv::imencode (jpeg) exception :" << e.what();
+  if (image->data().size() <
+      static_cast<size_t>(image->step()) * image->height()) {
+    AERROR << "image data is smaller than step * height: "
+           << image->data().size();
+    return false;
+  }
+  // libjpeg takes the rgb input directly, no color conversion pass needed
+  if (!encoder->Encode(reinterpret_cast<const uint8_t*>(image->data().data()),
+                       image->width(), image->height(), image->step())) {
+    AERROR << "jpeg encoding failed on input image";
     return false;
   }
+  compressed_image->set_data(encoder->data(), encoder->size());
+  writer_->Write(compressed_image);
   return true;
 }
 
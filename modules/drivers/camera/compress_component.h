@@ -16,13 +16,20 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
-#include "cyber/base/concurrent_object_pool.h"
-#include "cyber/cyber.h"
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 
+#include "cyber/base/concurrent_object_pool.h"
+#include "cyber/base/thread_pool.h"
+#include "cyber/cyber.h"
+#include "modules/drivers/camera/jpeg_encoder.h"
+
 namespace apollo {
 namespace drivers {
 namespace camera {
@@ -30,6 +37,7 @@ namespace camera {
 using apollo::cyber::Component;
 using apollo::cyber::Writer;
 using apollo::cyber::base::CCObjectPool;
+using apollo::cyber::base::ThreadPool;
 using apollo::drivers::Image;
 using apollo::drivers::camera::config::Config;
 
@@ -39,9 +47,31 @@ class CompressComponent : public Component<Image> {
   bool Proc(const std::shared_ptr<Image>& image) override;
 
  private:
+  // Returns an encoder to the free list when the compression is done.
+  struct EncoderReleaser {
+    CompressComponent* component = nullptr;
+    void operator()(JpegEncoder* encoder) const;
+  };
+  using EncoderPtr = std::unique_ptr<JpegEncoder, EncoderReleaser>;
+
+  bool Compress(const std::shared_ptr<Image>& image);
+
+  EncoderPtr AcquireEncoder();
+
   std::shared_ptr<CCObjectPool<CompressedImage>> image_pool_;
+  // one encoder per compress thread, reused across frames and destroyed with
+  // the component
+  std::vector<std::unique_ptr<JpegEncoder>> encoders_;
+  std::mutex free_encoders_mutex_;
+  std::vector<JpegEncoder*> free_encoders_;
+  // images dropped since the compress queue was full
+  std::atomic<uint64_t> num_dropped_images_{0};
   std::shared_ptr<Writer<CompressedImage>> writer_ = nullptr;
   Config config_;
+  // declared last so that workers are joined before the pools are released,
+  // its workers publish each image once encoded, so not in input order
+  // when there are several of them
+  std::unique_ptr<ThreadPool> compress_pool_;
 };
 
 CYBER_REGISTER_COMPONENT(CompressComponent)
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/camera/jpeg_encoder.h"
+
+#include <cstdlib>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+JpegEncoder::JpegEncoder(int quality) : quality_(quality) {
+  cinfo_.err = jpeg_std_error(&error_manager_.pub);
+  error_manager_.pub.error_exit = &JpegEncoder::OnError;
+  jpeg_create_compress(&cinfo_);
+}
+
+JpegEncoder::~JpegEncoder() {
+  jpeg_destroy_compress(&cinfo_);
+  free(buffer_);
+}
+
+void JpegEncoder::OnError(j_common_ptr cinfo) {
+  char message[JMSG_LENGTH_MAX];
+  (*cinfo->err->format_message)(cinfo, message);
+  AERROR << "libjpeg error: " << message;
+  // the default handler calls exit(), jump back to Encode instead
+  longjmp(reinterpret_cast<ErrorManager*>(cinfo->err)->jump_buffer, 1);
+}
+
+bool JpegEncoder::Encode(const uint8_t* rgb, int width, int height,
+                         int step) {
+  if (rgb == nullptr || width <= 0 || height <= 0 || step < 3 * width) {
+    AERROR << "invalid image, width: " << width << ", height: " << height
+           << ", step: " << step;
+    return false;
+  }
+  // a jpeg is practically never larger than the raw image, so reserving that
+  // once keeps libjpeg from growing the buffer with malloc + memcpy
+  const size_t raw_size = static_cast<size_t>(3 * width) * height;
+  if (capacity_ < raw_size) {
+    free(buffer_);
+    buffer_ = static_cast<unsigned char*>(malloc(raw_size));
+    if (buffer_ == nullptr) {
+      AERROR << "failed to allocate jpeg buffer of " << raw_size << " bytes";
+      capacity_ = 0;
+      return false;
+    }
+    capacity_ = raw_size;
+  }
+  size_ = 0;
+
+  unsigned char* output = buffer_;
+  unsigned long output_size = capacity_;  // NOLINT
+  if (setjmp(error_manager_.jump_buffer)) {
+    jpeg_abort_compress(&cinfo_);
+    return false;
+  }
+  jpeg_mem_dest(&cinfo_, &output, &output_size);
+
+  cinfo_.image_width = width;
+  cinfo_.image_height = height;
+  cinfo_.input_components = 3;
+  cinfo_.in_color_space = JCS_RGB;
+  jpeg_set_defaults(&cinfo_);
+  jpeg_set_quality(&cinfo_, quality_, TRUE);
+  jpeg_start_compress(&cinfo_, TRUE);
+  while (cinfo_.next_scanline < cinfo_.image_height) {
+    JSAMPROW row = const_cast<JSAMPROW>(rgb + cinfo_.next_scanline * step);
+    jpeg_write_scanlines(&cinfo_, &row, 1);
+  }
+  jpeg_finish_compress(&cinfo_);
+
+  if (output != buffer_) {
+    // libjpeg had to grow the buffer, adopt the one it allocated
+    free(buffer_);
+    buffer_ = output;
+    capacity_ = output_size;
+  }
+  size_ = output_size;
+  return true;
+}
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
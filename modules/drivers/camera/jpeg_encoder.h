@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <csetjmp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "jpeglib.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @class JpegEncoder
+ * @brief Encodes rgb8 images to jpeg with libjpeg(-turbo). The compressor
+ * state and the output buffer are kept across calls, so steady state encoding
+ * does not allocate. An encoder must only be used by one thread at a time.
+ */
+class JpegEncoder {
+ public:
+  explicit JpegEncoder(int quality = 95);
+  ~JpegEncoder();
+
+  JpegEncoder(const JpegEncoder&) = delete;
+  JpegEncoder& operator=(const JpegEncoder&) = delete;
+
+  /**
+   * @brief encode a packed rgb8 image.
+   * @param rgb pointer to the first row of the image.
+   * @param width image width in pixels.
+   * @param height image height in pixels.
+   * @param step row stride in bytes.
+   * @return true if the image was encoded, the result is then available by
+   * data() and size() until the next call.
+   */
+  bool Encode(const uint8_t* rgb, int width, int height, int step);
+
+  const uint8_t* data() const { return buffer_; }
+  size_t size() const { return size_; }
+
+ private:
+  struct ErrorManager {
+    jpeg_error_mgr pub;
+    jmp_buf jump_buffer;
+  };
+
+  static void OnError(j_common_ptr cinfo);
+
+  jpeg_compress_struct cinfo_;
+  ErrorManager error_manager_;
+  int quality_ = 95;
+  unsigned char* buffer_ = nullptr;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -36,6 +36,7 @@
 
 #include <cmath>
 #include <string>
+#include <utility>
 
 #ifndef __aarch64__
 #include "adv_trigger.h"
@@ -934,26 +935,49 @@ bool UsbCam::process_image(void* src, int len, CameraImagePtr dest) {
   }
   if (pixel_format_ == V4L2_PIX_FMT_YUYV ||
       pixel_format_ == V4L2_PIX_FMT_UYVY) {
-    if (pixel_format_ == V4L2_PIX_FMT_UYVY) {
-      unsigned char yuyvbuf[len];
-      unsigned char uyvybuf[len];
-      memcpy(yuyvbuf, src, len);
-      for (int index = 0; index < len; index = index + 2) {
-        uyvybuf[index] = yuyvbuf[index + 1];
-        uyvybuf[index + 1] = yuyvbuf[index];
-      }
-      memcpy(src, uyvybuf, len);
+    const bool uyvy = pixel_format_ == V4L2_PIX_FMT_UYVY;
+    unsigned char* src_image = reinterpret_cast<unsigned char*>(src);
+    unsigned char* dest_image = reinterpret_cast<unsigned char*>(dest->image);
+    const int num_pixels = dest->width * dest->height;
+    if (len < 2 * num_pixels) {
+      AERROR << "frame is too small, len: " << len
+             << ", expected: " << 2 * num_pixels;
+      return false;
     }
+    // convert straight from the v4l2 buffer, without intermediate copies
     if (config_->output_type() == YUYV) {
-      memcpy(dest->image, src, dest->width * dest->height * 2);
+#ifdef __aarch64__
+      if (uyvy) {
+        for (int index = 0; index < 2 * num_pixels; index += 2) {
+          dest_image[index] = src_image[index + 1];
+          dest_image[index + 1] = src_image[index];
+        }
+      } else {
+        memcpy(dest_image, src_image, 2 * num_pixels);
+      }
+#else
+      if (uyvy) {
+        uyvy2yuyv_avx(src_image, dest_image, num_pixels);
+      } else {
+        memcpy(dest_image, src_image, 2 * num_pixels);
+      }
+#endif
     } else if (config_->output_type() == RGB) {
 #ifdef __aarch64__
-      convert_yuv_to_rgb_buffer((unsigned char*)src,
-                                (unsigned char*)dest->image, dest->width,
+      if (uyvy) {
+        // swap in place, the mmap'ed buffer is requeued after processing
+        for (int index = 0; index < 2 * num_pixels; index += 2) {
+          std::swap(src_image[index], src_image[index + 1]);
+        }
+      }
+      convert_yuv_to_rgb_buffer(src_image, dest_image, dest->width,
                                 dest->height);
 #else
-      yuyv2rgb_avx((unsigned char*)src, (unsigned char*)dest->image,
-                   dest->width * dest->height);
+      if (uyvy) {
+        uyvy2rgb_avx(src_image, dest_image, num_pixels);
+      } else {
+        yuyv2rgb_avx(src_image, dest_image, num_pixels);
+      }
 #endif
     } else {
       AERROR << "unsupported output format:" << config_->output_type();
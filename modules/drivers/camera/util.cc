@@ -58,7 +58,7 @@ void print_m256_i16(const __m256i a) {
   }
 }
 
-template <bool align>
+template <bool align, bool uyvy>
 SIMD_INLINE void yuv_separate_avx2(uint8_t* y, __m256i* y0, __m256i* y1,
                                    __m256i* u0, __m256i* v0) {
   __m256i yuv_m256[4];
@@ -74,6 +74,12 @@ SIMD_INLINE void yuv_separate_avx2(uint8_t* y, __m256i* y0, __m256i* y1,
     yuv_m256[2] = Load<false>(reinterpret_cast<__m256i*>(y) + 2);
     yuv_m256[3] = Load<false>(reinterpret_cast<__m256i*>(y) + 3);
   }
+  if (uyvy) {
+    // uyvy only differs from yuyv by the order inside each byte pair
+    for (int i = 0; i < 4; ++i) {
+      yuv_m256[i] = _mm256_shuffle_epi8(yuv_m256[i], K8_SHUFFLE_SWAP_PAIRS);
+    }
+  }
 
   *y0 =
       _mm256_or_si256(_mm256_permute4x64_epi64(
@@ -116,11 +122,11 @@ void yuv2rgb_avx2(__m256i y0, __m256i u0, __m256i v0, uint8_t* rgb) {
                InterleaveBgr<2>(r0, g0, b0));
 }
 
-template <bool align>
+template <bool align, bool uyvy>
 void yuv2rgb_avx2(uint8_t* yuv, uint8_t* rgb) {
   __m256i y0, y1, u0, v0;
 
-  yuv_separate_avx2<align>(yuv, &y0, &y1, &u0, &v0);
+  yuv_separate_avx2<align, uyvy>(yuv, &y0, &y1, &u0, &v0);
   __m256i u0_u0 = _mm256_permute4x64_epi64(u0, 0xD8);
   __m256i v0_v0 = _mm256_permute4x64_epi64(v0, 0xD8);
   yuv2rgb_avx2<align>(y0, _mm256_unpacklo_epi8(u0_u0, u0_u0),
@@ -130,25 +136,71 @@ void yuv2rgb_avx2(uint8_t* yuv, uint8_t* rgb) {
                       rgb + 3 * sizeof(__m256i));
 }
 
-void yuyv2rgb_avx(unsigned char* YUV, unsigned char* RGB, int NumPixels) {
-  assert(NumPixels == (1920 * 1080));
-  bool align = Aligned(YUV) & Aligned(RGB);
-  uint8_t* yuv_offset = YUV;
-  uint8_t* rgb_offset = RGB;
-  if (align) {
-    for (int i = 0; i < NumPixels;
-         i = i + static_cast<int>(2 * sizeof(__m256i)),
-             yuv_offset += 4 * static_cast<int>(sizeof(__m256i)),
-             rgb_offset += 6 * static_cast<int>(sizeof(__m256i))) {
-      yuv2rgb_avx2<true>(yuv_offset, rgb_offset);
+SIMD_INLINE uint8_t clamp_u8(int value) {
+  return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// Scalar version of yuv2rgb_avx2 with the same fixed point weights, used for
+// the pixels left over after the last full avx2 block.
+void yuv2rgb_scalar(const uint8_t* yuv, uint8_t* rgb, int num_pixels,
+                    bool uyvy) {
+  const int y_offset = uyvy ? 1 : 0;
+  const int uv_offset = uyvy ? 0 : 1;
+  for (int i = 0; i + 1 < num_pixels; i += 2, yuv += 4, rgb += 6) {
+    const int u = yuv[uv_offset] - UV_ADJUST;
+    const int v = yuv[uv_offset + 2] - UV_ADJUST;
+    for (int k = 0; k < 2; ++k) {
+      const int y = (yuv[y_offset + 2 * k] - Y_ADJUST) * Y_TO_RGB_WEIGHT;
+      rgb[3 * k] = clamp_u8((y + v * V_TO_RED_WEIGHT) >>
+                            YUV_TO_BGR_AVERAGING_SHIFT);
+      rgb[3 * k + 1] =
+          clamp_u8((y + u * U_TO_GREEN_WEIGHT + v * V_TO_GREEN_WEIGHT) >>
+                   YUV_TO_BGR_AVERAGING_SHIFT);
+      rgb[3 * k + 2] = clamp_u8((y + u * U_TO_BLUE_WEIGHT) >>
+                                YUV_TO_BGR_AVERAGING_SHIFT);
     }
-  } else {
-    for (int i = 0; i < NumPixels;
-         i = i + static_cast<int>(2 * sizeof(__m256i)),
-             yuv_offset += 4 * static_cast<int>(sizeof(__m256i)),
-             rgb_offset += 6 * static_cast<int>(sizeof(__m256i))) {
-      yuv2rgb_avx2<false>(yuv_offset, rgb_offset);
+  }
+}
+
+template <bool uyvy>
+void yuv2rgb_frame_avx2(uint8_t* yuv, uint8_t* rgb, int num_pixels) {
+  // every avx2 block converts 64 pixels: 128 yuv bytes into 192 rgb bytes
+  const int block_pixels = static_cast<int>(2 * sizeof(__m256i));
+  const int block_count = num_pixels / block_pixels;
+  const bool align = Aligned(yuv) && Aligned(rgb);
+  for (int i = 0; i < block_count; ++i) {
+    if (align) {
+      yuv2rgb_avx2<true, uyvy>(yuv, rgb);
+    } else {
+      yuv2rgb_avx2<false, uyvy>(yuv, rgb);
     }
+    yuv += 4 * sizeof(__m256i);
+    rgb += 6 * sizeof(__m256i);
+  }
+  yuv2rgb_scalar(yuv, rgb, num_pixels - block_count * block_pixels, uyvy);
+}
+
+void yuyv2rgb_avx(unsigned char* YUV, unsigned char* RGB, int NumPixels) {
+  yuv2rgb_frame_avx2<false>(YUV, RGB, NumPixels);
+}
+
+void uyvy2rgb_avx(unsigned char* UYVY, unsigned char* RGB, int NumPixels) {
+  yuv2rgb_frame_avx2<true>(UYVY, RGB, NumPixels);
+}
+
+void uyvy2yuyv_avx(unsigned char* UYVY, unsigned char* YUYV, int NumPixels) {
+  const int len = 2 * NumPixels;
+  const int step = static_cast<int>(sizeof(__m256i));
+  int i = 0;
+  for (; i + step <= len; i += step) {
+    Store<false>(reinterpret_cast<__m256i*>(YUYV + i),
+                 _mm256_shuffle_epi8(
+                     Load<false>(reinterpret_cast<__m256i*>(UYVY + i)),
+                     K8_SHUFFLE_SWAP_PAIRS));
+  }
+  for (; i + 1 < len; i += 2) {
+    YUYV[i] = UYVY[i + 1];
+    YUYV[i + 1] = UYVY[i];
   }
 }
 
@@ -38,7 +38,12 @@ namespace apollo {
 namespace drivers {
 namespace camera {
 
+// Converts packed yuyv (or uyvy) pixels to packed rgb8. NumPixels must be
+// even; the source may be the mmap'ed v4l2 buffer itself, it is never written.
 void yuyv2rgb_avx(unsigned char *YUV, unsigned char *RGB, int NumPixels);
+void uyvy2rgb_avx(unsigned char *UYVY, unsigned char *RGB, int NumPixels);
+// Reorders packed uyvy pixels to yuyv while copying them to YUYV.
+void uyvy2yuyv_avx(unsigned char *UYVY, unsigned char *YUYV, int NumPixels);
 
 #define SIMD_INLINE inline __attribute__((always_inline))
 
@@ -201,6 +206,11 @@ const __m256i K32_00010000 = SIMD_MM256_SET1_EPI32(0x00010000);
 const __m256i K32_01000000 = SIMD_MM256_SET1_EPI32(0x01000000);
 const __m256i K32_FFFFFF00 = SIMD_MM256_SET1_EPI32(0xFFFFFF00);
 
+const __m256i K8_SHUFFLE_SWAP_PAIRS = SIMD_MM256_SETR_EPI8(
+    0x1, 0x0, 0x3, 0x2, 0x5, 0x4, 0x7, 0x6, 0x9, 0x8, 0xB, 0xA, 0xD, 0xC, 0xF,
+    0xE, 0x1, 0x0, 0x3, 0x2, 0x5, 0x4, 0x7, 0x6, 0x9, 0x8, 0xB, 0xA, 0xD, 0xC,
+    0xF, 0xE);
+
 const __m256i K8_SHUFFLE_BGR0_TO_BLUE = SIMD_MM256_SETR_EPI8(
     0x0, 0x3, 0x6, 0x9, 0xC, 0xF, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
     -1, -1, -1, -1, -1, 0x2, 0x5, 0x8, 0xB, 0xE, -1, -1, -1, -1, -1);
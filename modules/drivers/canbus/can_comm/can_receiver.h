@@ -141,8 +141,11 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
   const int32_t ERROR_COUNT_MAX = 10;
   auto default_period = 10 * 1000;
 
+  // the frame buffer is reused by every receive, clients append to it
+  std::vector<CanFrame> buf;
+  buf.reserve(MAX_CAN_RECV_FRAME_LEN);
   while (IsRunning()) {
-    std::vector<CanFrame> buf;
+    buf.clear();
     int32_t frame_num = MAX_CAN_RECV_FRAME_LEN;
     if (can_client_->Receive(&buf, &frame_num) !=
         ::apollo::common::ErrorCode::OK) {
@@ -178,6 +181,8 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
         ADEBUG << "recv_can_frame#" << frame.CanFrameString();
       }
     }
+    // readers copy the published snapshot, never blocking the next receive
+    pt_manager_->PublishSensorData();
     cyber::Yield();
   }
   AINFO << "Can client receiver thread stopped.";
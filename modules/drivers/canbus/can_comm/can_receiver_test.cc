@@ -16,6 +16,9 @@
 
 #include "modules/drivers/canbus/can_comm/can_receiver.h"
 
+#include <chrono>
+#include <thread>
+
 #include "gtest/gtest.h"
 
 #include "modules/canbus/proto/chassis_detail.pb.h"
@@ -41,6 +44,44 @@ TEST(CanReceiverTest, ReceiveOne) {
   // cyber::Clear();
 }
 
+class MockCarTypeProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  // the fake can client sends ids 0 to MAX_CAN_RECV_FRAME_LEN - 1
+  static const int32_t ID = 0x1;
+  void Parse(const uint8_t *bytes, int32_t length,
+             ::apollo::canbus::ChassisDetail *chassis_detail) const override {
+    chassis_detail->set_car_type(::apollo::canbus::ChassisDetail::QIRUI_EQ_15);
+  }
+};
+
+class MockMessageManager
+    : public MessageManager<::apollo::canbus::ChassisDetail> {
+ public:
+  MockMessageManager() {
+    AddRecvProtocolData<MockCarTypeProtocolData, false>();
+  }
+};
+
+TEST(CanReceiverTest, PublishParsedFrames) {
+  cyber::Init("can_receiver_test");
+  can::FakeCanClient can_client;
+  MockMessageManager pm;
+  CanReceiver<::apollo::canbus::ChassisDetail> receiver;
+
+  ::apollo::canbus::ChassisDetail chassis_detail;
+  EXPECT_EQ(pm.GetSensorData(&chassis_detail), common::ErrorCode::OK);
+  EXPECT_FALSE(chassis_detail.has_car_type());
+
+  receiver.Init(&can_client, &pm, false);
+  EXPECT_EQ(receiver.Start(), common::ErrorCode::OK);
+  // the fake client delivers a batch of frames every 10 ms
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  receiver.Stop();
+  EXPECT_EQ(pm.GetSensorData(&chassis_detail), common::ErrorCode::OK);
+  EXPECT_TRUE(chassis_detail.has_car_type());
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -28,6 +29,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/common/log.h"
 #include "cyber/time/time.h"
 #include "modules/common/proto/error_code.pb.h"
@@ -58,6 +60,18 @@ struct CheckIdArg {
   int32_t error_count = 0;
 };
 
+/**
+ * @struct ProtocolSlot
+ *
+ * @brief entry of the flat dispatch table from message id to protocol data.
+ */
+template <typename SensorType>
+struct ProtocolSlot {
+  ProtocolData<SensorType> *protocol_data = nullptr;
+  CheckIdArg *check_id = nullptr;
+  bool received = false;
+};
+
 /**
  * @class MessageManager
  *
@@ -70,7 +84,11 @@ class MessageManager {
   /*
    * @brief constructor function
    */
-  MessageManager() {}
+  MessageManager()
+      : snapshot_pool_(
+            new cyber::base::CCObjectPool<SensorType>(kSnapshotPoolSize)) {
+    snapshot_pool_->ConstructAll();
+  }
   /*
    * @brief destructor function
    */
@@ -104,6 +122,15 @@ class MessageManager {
    */
   common::ErrorCode GetSensorData(SensorType *const sensor_data);
 
+  /**
+   * @brief publish a snapshot of the parsed sensor data. Once a snapshot has
+   * been published, GetSensorData copies from the latest snapshot and never
+   * blocks the thread calling Parse. CanReceiver publishes after every
+   * received batch of frames. This is a no-op until GetSensorData has been
+   * called once, so managers that are never read this way pay nothing.
+   */
+  void PublishSensorData();
+
   /*
    * @brief reset send messages
    */
@@ -128,6 +155,26 @@ class MessageManager {
   bool is_received_on_time_ = false;
 
   std::condition_variable cvar_;
+
+ private:
+  // standard (11 bit) ids are dispatched by direct indexing, extended ids
+  // fall back to protocol_data_map_
+  static constexpr uint32_t kMaxStandardId = 0x7FF;
+  // number of snapshots that can be held by readers at the same time
+  static constexpr uint32_t kSnapshotPoolSize = 8;
+
+  void RegisterProtocolData(const uint32_t message_id,
+                            ProtocolData<SensorType> *protocol_data,
+                            const bool need_check);
+  ProtocolSlot<SensorType> *GetMutableSlot(const uint32_t message_id);
+  void UpdateCheckId(CheckIdArg *check_id);
+
+  std::vector<ProtocolSlot<SensorType>> standard_slots_;
+
+  std::shared_ptr<cyber::base::CCObjectPool<SensorType>> snapshot_pool_;
+  std::shared_ptr<SensorType> snapshot_;
+  std::atomic<bool> is_snapshot_requested_ = {false};
+  std::atomic<bool> is_snapshot_published_ = {false};
 };
 
 template <typename SensorType>
@@ -138,13 +185,7 @@ void MessageManager<SensorType>::AddRecvProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
-  if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
-  }
+  RegisterProtocolData(T::ID, dt, need_check);
 }
 
 template <typename SensorType>
@@ -155,30 +196,105 @@ void MessageManager<SensorType>::AddSendProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
+  RegisterProtocolData(T::ID, dt, need_check);
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::RegisterProtocolData(
+    const uint32_t message_id, ProtocolData<SensorType> *protocol_data,
+    const bool need_check) {
+  protocol_data_map_[message_id] = protocol_data;
+  CheckIdArg *check_id = nullptr;
   if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
+    check_id = &check_ids_[message_id];
+    check_id->period = protocol_data->GetPeriod();
+    check_id->real_period = 0;
+    check_id->last_time = 0;
+    check_id->error_count = 0;
+  } else {
+    // keep a check registered earlier for the same id, as the map does
+    const auto it = check_ids_.find(message_id);
+    if (it != check_ids_.end()) {
+      check_id = &it->second;
+    }
+  }
+  if (message_id <= kMaxStandardId) {
+    if (standard_slots_.empty()) {
+      standard_slots_.resize(kMaxStandardId + 1);
+    }
+    standard_slots_[message_id].protocol_data = protocol_data;
+    standard_slots_[message_id].check_id = check_id;
   }
 }
 
+template <typename SensorType>
+ProtocolSlot<SensorType> *MessageManager<SensorType>::GetMutableSlot(
+    const uint32_t message_id) {
+  if (message_id > kMaxStandardId || standard_slots_.empty()) {
+    return nullptr;
+  }
+  return &standard_slots_[message_id];
+}
+
 template <typename SensorType>
 ProtocolData<SensorType>
     *MessageManager<SensorType>::GetMutableProtocolDataById(
         const uint32_t message_id) {
-  if (protocol_data_map_.find(message_id) == protocol_data_map_.end()) {
+  if (message_id <= kMaxStandardId) {
+    auto *slot = GetMutableSlot(message_id);
+    if (slot == nullptr || slot->protocol_data == nullptr) {
+      ADEBUG << "Unable to get protocol data because of invalid message_id:"
+             << Byte::byte_to_hex(message_id);
+      return nullptr;
+    }
+    return slot->protocol_data;
+  }
+  const auto it = protocol_data_map_.find(message_id);
+  if (it == protocol_data_map_.end()) {
     ADEBUG << "Unable to get protocol data because of invalid message_id:"
            << Byte::byte_to_hex(message_id);
     return nullptr;
   }
-  return protocol_data_map_[message_id];
+  return it->second;
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::UpdateCheckId(CheckIdArg *check_id) {
+  const int64_t time = Time::Now().ToNanosecond() / 1e3;
+  check_id->real_period = time - check_id->last_time;
+  // if period 1.5 large than base period, inc error_count
+  const double period_multiplier = 1.5;
+  if (static_cast<double>(check_id->real_period) >
+      (static_cast<double>(check_id->period) * period_multiplier)) {
+    check_id->error_count += 1;
+  } else {
+    check_id->error_count = 0;
+  }
+  check_id->last_time = time;
 }
 
 template <typename SensorType>
 void MessageManager<SensorType>::Parse(const uint32_t message_id,
                                        const uint8_t *data, int32_t length) {
+  auto *slot = GetMutableSlot(message_id);
+  if (slot != nullptr) {
+    if (slot->protocol_data == nullptr) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+      slot->protocol_data->Parse(data, length, &sensor_data_);
+    }
+    if (!slot->received) {
+      slot->received = true;
+      received_ids_.insert(message_id);
+    }
+    if (slot->check_id != nullptr) {
+      UpdateCheckId(slot->check_id);
+    }
+    return;
+  }
+
   ProtocolData<SensorType> *protocol_data =
       GetMutableProtocolDataById(message_id);
   if (protocol_data == nullptr) {
@@ -192,24 +308,19 @@ void MessageManager<SensorType>::Parse(const uint32_t message_id,
   // check if need to check period
   const auto it = check_ids_.find(message_id);
   if (it != check_ids_.end()) {
-    const int64_t time = Time::Now().ToNanosecond() / 1e3;
-    it->second.real_period = time - it->second.last_time;
-    // if period 1.5 large than base period, inc error_count
-    const double period_multiplier = 1.5;
-    if (static_cast<double>(it->second.real_period) >
-        (static_cast<double>(it->second.period) * period_multiplier)) {
-      it->second.error_count += 1;
-    } else {
-      it->second.error_count = 0;
-    }
-    it->second.last_time = time;
+    UpdateCheckId(&it->second);
   }
 }
 
 template <typename SensorType>
 void MessageManager<SensorType>::ClearSensorData() {
-  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
-  sensor_data_.Clear();
+  {
+    std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+    sensor_data_.Clear();
+  }
+  if (is_snapshot_published_.load(std::memory_order_acquire)) {
+    PublishSensorData();
+  }
 }
 
 template <typename SensorType>
@@ -224,11 +335,37 @@ ErrorCode MessageManager<SensorType>::GetSensorData(
     AERROR << "Failed to get sensor_data due to nullptr.";
     return ErrorCode::CANBUS_ERROR;
   }
+  is_snapshot_requested_.store(true, std::memory_order_relaxed);
+  if (is_snapshot_published_.load(std::memory_order_acquire)) {
+    const auto snapshot = std::atomic_load(&snapshot_);
+    sensor_data->CopyFrom(*snapshot);
+    return ErrorCode::OK;
+  }
   std::lock_guard<std::mutex> lock(sensor_data_mutex_);
   sensor_data->CopyFrom(sensor_data_);
   return ErrorCode::OK;
 }
 
+template <typename SensorType>
+void MessageManager<SensorType>::PublishSensorData() {
+  if (!is_snapshot_requested_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // pooled snapshots keep their allocated fields, so the copy below does not
+  // allocate in steady state
+  auto snapshot = snapshot_pool_->GetObject();
+  if (snapshot == nullptr) {
+    AWARN_EVERY(100) << "All sensor data snapshots are in use.";
+    snapshot = std::make_shared<SensorType>();
+  }
+  {
+    std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+    snapshot->CopyFrom(sensor_data_);
+  }
+  std::atomic_store(&snapshot_, snapshot);
+  is_snapshot_published_.store(true, std::memory_order_release);
+}
+
 template <typename SensorType>
 void MessageManager<SensorType>::ResetSendMessages() {
   for (auto &protocol_data : send_protocol_data_) {
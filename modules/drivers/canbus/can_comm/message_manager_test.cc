@@ -36,12 +36,32 @@ class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
   MockProtocolData() {}
 };
 
+class MockCarTypeProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x222;
+  MockCarTypeProtocolData() {}
+  void Parse(const uint8_t *bytes, int32_t length,
+             ::apollo::canbus::ChassisDetail *chassis_detail) const override {
+    chassis_detail->set_car_type(::apollo::canbus::ChassisDetail::QIRUI_EQ_15);
+  }
+};
+
+class MockExtendedProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x18FF0001;
+  MockExtendedProtocolData() {}
+};
+
 class MockMessageManager
     : public MessageManager<::apollo::canbus::ChassisDetail> {
  public:
   MockMessageManager() {
     AddRecvProtocolData<MockProtocolData, true>();
     AddSendProtocolData<MockProtocolData, true>();
+    AddRecvProtocolData<MockCarTypeProtocolData, false>();
+    AddRecvProtocolData<MockExtendedProtocolData, true>();
   }
 };
 
@@ -58,6 +78,56 @@ TEST(MessageManagerTest, GetMutableProtocolDataById) {
   EXPECT_EQ(manager.GetSensorData(nullptr), ErrorCode::CANBUS_ERROR);
 }
 
+TEST(MessageManagerTest, DispatchStandardAndExtendedIds) {
+  MockMessageManager manager;
+  EXPECT_NE(manager.GetMutableProtocolDataById(MockCarTypeProtocolData::ID),
+            nullptr);
+  EXPECT_NE(manager.GetMutableProtocolDataById(MockExtendedProtocolData::ID),
+            nullptr);
+  EXPECT_EQ(manager.GetMutableProtocolDataById(0x333), nullptr);
+  EXPECT_EQ(manager.GetMutableProtocolDataById(0x18FF0002), nullptr);
+
+  uint8_t mock_data[8] = {0};
+  manager.Parse(0x333, mock_data, 8);
+  manager.Parse(0x18FF0002, mock_data, 8);
+  manager.Parse(MockExtendedProtocolData::ID, mock_data, 8);
+  manager.Parse(MockCarTypeProtocolData::ID, mock_data, 8);
+  ::apollo::canbus::ChassisDetail chassis_detail;
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_EQ(chassis_detail.car_type(),
+            ::apollo::canbus::ChassisDetail::QIRUI_EQ_15);
+}
+
+TEST(MessageManagerTest, PublishSensorData) {
+  MockMessageManager manager;
+  uint8_t mock_data[8] = {0};
+  ::apollo::canbus::ChassisDetail chassis_detail;
+  // nothing is published before the sensor data has been asked for
+  manager.PublishSensorData();
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_FALSE(chassis_detail.has_car_type());
+
+  // without a published snapshot the live data is returned
+  manager.Parse(MockCarTypeProtocolData::ID, mock_data, 8);
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_TRUE(chassis_detail.has_car_type());
+
+  manager.ClearSensorData();
+  manager.PublishSensorData();
+  manager.Parse(MockCarTypeProtocolData::ID, mock_data, 8);
+  // the snapshot stays as published until the next publication
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_FALSE(chassis_detail.has_car_type());
+  manager.PublishSensorData();
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_TRUE(chassis_detail.has_car_type());
+
+  // clearing republishes once snapshots are in use
+  manager.ClearSensorData();
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_FALSE(chassis_detail.has_car_type());
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -40,6 +40,7 @@ namespace gnss {
 using ::apollo::localization::CorrectedImu;
 using ::apollo::localization::Gps;
 
+using apollo::cyber::base::CCObjectPool;
 using apollo::transform::TransformStamped;
 
 namespace {
@@ -52,6 +53,28 @@ static const boost::array<double, 36> POSE_COVAR = {
     2, 0, 0, 0,    0, 0, 0, 2, 0, 0, 0,    0, 0, 0, 2, 0, 0, 0,
     0, 0, 0, 0.01, 0, 0, 0, 0, 0, 0, 0.01, 0, 0, 0, 0, 0, 0, 0.01};
 
+// Enough for the messages of a few reads to be in flight in the readers.
+constexpr uint32_t kMessagePoolSize = 32;
+
+template <typename T>
+std::shared_ptr<CCObjectPool<T>> CreateMessagePool() {
+  auto pool = std::make_shared<CCObjectPool<T>>(kMessagePoolSize);
+  pool->ConstructAll();
+  return pool;
+}
+
+// Pooled objects keep the content of their last use, callers either copy
+// over it or clear it first. Falls back to the heap when the pool is empty.
+template <typename T>
+std::shared_ptr<T> AcquireMessage(
+    const std::shared_ptr<CCObjectPool<T>> &pool) {
+  auto message = pool->GetObject();
+  if (message == nullptr) {
+    return std::make_shared<T>();
+  }
+  return message;
+}
+
 Parser *CreateParser(config::Config config, bool is_base_station = false) {
   switch (config.data().format()) {
     case config::Stream::NOVATEL_BINARY:
@@ -98,6 +121,15 @@ bool DataParser::Init() {
   rawimu_writer_ = node_->CreateWriter<Imu>(FLAGS_raw_imu_topic);
   gps_writer_ = node_->CreateWriter<Gps>(FLAGS_gps_topic);
 
+  gnssbestpose_pool_ = CreateMessagePool<GnssBestPose>();
+  corrimu_pool_ = CreateMessagePool<CorrectedImu>();
+  rawimu_pool_ = CreateMessagePool<Imu>();
+  gps_pool_ = CreateMessagePool<Gps>();
+  insstat_pool_ = CreateMessagePool<InsStat>();
+  gnssephemeris_pool_ = CreateMessagePool<GnssEphemeris>();
+  epochobservation_pool_ = CreateMessagePool<EpochObservation>();
+  heading_pool_ = CreateMessagePool<Heading>();
+
   common::util::FillHeader("gnss", &ins_status_);
   insstatus_writer_->Write(ins_status_);
   common::util::FillHeader("gnss", &gnss_status_);
@@ -131,6 +163,12 @@ void DataParser::ParseRawData(const std::string &msg) {
     }
     DispatchMessage(type, msg_ptr);
   }
+
+  if (gnss_status_updated_) {
+    gnss_status_updated_ = false;
+    common::util::FillHeader("gnss", &gnss_status_);
+    gnssstatus_writer_->Write(gnss_status_);
+  }
 }
 
 void DataParser::CheckInsStatus(::apollo::drivers::gnss::Ins *ins) {
@@ -171,8 +209,7 @@ void DataParser::CheckGnssStatus(::apollo::drivers::gnss::Gnss *gnss) {
   } else {
     gnss_status_.set_solution_completed(false);
   }
-  common::util::FillHeader("gnss", &gnss_status_);
-  gnssstatus_writer_->Write(gnss_status_);
+  gnss_status_updated_ = true;
 }
 
 void DataParser::DispatchMessage(Parser::MessageType type, MessagePtr message) {
@@ -219,20 +256,23 @@ void DataParser::DispatchMessage(Parser::MessageType type, MessagePtr message) {
 }
 
 void DataParser::PublishInsStat(const MessagePtr message) {
-  auto ins_stat = std::make_shared<InsStat>(*As<InsStat>(message));
+  auto ins_stat = AcquireMessage(insstat_pool_);
+  ins_stat->CopyFrom(*As<InsStat>(message));
   common::util::FillHeader("gnss", ins_stat.get());
   insstat_writer_->Write(ins_stat);
 }
 
 void DataParser::PublishBestpos(const MessagePtr message) {
-  auto bestpos = std::make_shared<GnssBestPose>(*As<GnssBestPose>(message));
+  auto bestpos = AcquireMessage(gnssbestpose_pool_);
+  bestpos->CopyFrom(*As<GnssBestPose>(message));
   common::util::FillHeader("gnss", bestpos.get());
   gnssbestpose_writer_->Write(bestpos);
 }
 
 void DataParser::PublishImu(const MessagePtr message) {
-  auto raw_imu = std::make_shared<Imu>(*As<Imu>(message));
   Imu *imu = As<Imu>(message);
+  auto raw_imu = AcquireMessage(rawimu_pool_);
+  raw_imu->CopyFrom(*imu);
 
   raw_imu->mutable_linear_acceleration()->set_x(
       -imu->linear_acceleration().y());
@@ -249,7 +289,8 @@ void DataParser::PublishImu(const MessagePtr message) {
 
 void DataParser::PublishOdometry(const MessagePtr message) {
   Ins *ins = As<Ins>(message);
-  auto gps = std::make_shared<Gps>();
+  auto gps = AcquireMessage(gps_pool_);
+  gps->Clear();
 
   double unix_sec = apollo::drivers::util::gps2unix(ins->measurement_time());
   gps->mutable_header()->set_timestamp_sec(unix_sec);
@@ -293,7 +334,8 @@ void DataParser::PublishOdometry(const MessagePtr message) {
 
 void DataParser::PublishCorrimu(const MessagePtr message) {
   Ins *ins = As<Ins>(message);
-  auto imu = std::make_shared<CorrectedImu>();
+  auto imu = AcquireMessage(corrimu_pool_);
+  imu->Clear();
   double unix_sec = apollo::drivers::util::gps2unix(ins->measurement_time());
   imu->mutable_header()->set_timestamp_sec(unix_sec);
 
@@ -316,18 +358,20 @@ void DataParser::PublishCorrimu(const MessagePtr message) {
 }
 
 void DataParser::PublishEphemeris(const MessagePtr message) {
-  auto eph = std::make_shared<GnssEphemeris>(*As<GnssEphemeris>(message));
+  auto eph = AcquireMessage(gnssephemeris_pool_);
+  eph->CopyFrom(*As<GnssEphemeris>(message));
   gnssephemeris_writer_->Write(eph);
 }
 
 void DataParser::PublishObservation(const MessagePtr message) {
-  auto observation =
-      std::make_shared<EpochObservation>(*As<EpochObservation>(message));
+  auto observation = AcquireMessage(epochobservation_pool_);
+  observation->CopyFrom(*As<EpochObservation>(message));
   epochobservation_writer_->Write(observation);
 }
 
 void DataParser::PublishHeading(const MessagePtr message) {
-  auto heading = std::make_shared<Heading>(*As<Heading>(message));
+  auto heading = AcquireMessage(heading_pool_);
+  heading->CopyFrom(*As<Heading>(message));
   heading_writer_->Write(heading);
 }
 
@@ -22,6 +22,7 @@
 #define ACCEPT_USE_OF_DEPRECATED_PROJ_API_H
 #include <proj_api.h>
 
+#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
 #include "modules/transform/transform_broadcaster.h"
 
@@ -52,6 +53,9 @@ class DataParser {
   void ParseRawData(const std::string &msg);
 
  private:
+  template <typename T>
+  using MessagePool = apollo::cyber::base::CCObjectPool<T>;
+
   void DispatchMessage(Parser::MessageType type, MessagePtr message);
   void PublishInsStat(const MessagePtr message);
   void PublishOdometry(const MessagePtr message);
@@ -73,6 +77,9 @@ class DataParser {
   apollo::transform::TransformBroadcaster tf_broadcaster_;
 
   GnssStatus gnss_status_;
+  // Gnss status is published once per ParseRawData() call instead of once
+  // per decoded GNSS message.
+  bool gnss_status_updated_ = false;
   InsStatus ins_status_;
   uint32_t ins_status_record_ = static_cast<uint32_t>(0);
   projPJ wgs84pj_source_;
@@ -95,6 +102,19 @@ class DataParser {
   std::shared_ptr<apollo::cyber::Writer<EpochObservation>>
       epochobservation_writer_ = nullptr;
   std::shared_ptr<apollo::cyber::Writer<Heading>> heading_writer_ = nullptr;
+
+  // Published messages are taken from these pools and return to them once
+  // every reader has released them, so the high-rate IMU/INS paths do not
+  // allocate a new protobuf per message.
+  std::shared_ptr<MessagePool<GnssBestPose>> gnssbestpose_pool_;
+  std::shared_ptr<MessagePool<apollo::localization::CorrectedImu>>
+      corrimu_pool_;
+  std::shared_ptr<MessagePool<Imu>> rawimu_pool_;
+  std::shared_ptr<MessagePool<apollo::localization::Gps>> gps_pool_;
+  std::shared_ptr<MessagePool<InsStat>> insstat_pool_;
+  std::shared_ptr<MessagePool<GnssEphemeris>> gnssephemeris_pool_;
+  std::shared_ptr<MessagePool<EpochObservation>> epochobservation_pool_;
+  std::shared_ptr<MessagePool<Heading>> heading_pool_;
 };
 
 }  // namespace gnss
@@ -18,7 +18,10 @@
 // messages must be
 // logged in order for this parser to work properly.
 //
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -76,16 +79,78 @@ inline uint32_t crc32_word(uint32_t word) {
   return word;
 }
 
+// crc32_word of every byte value, so that the block crc costs one lookup per
+// byte instead of eight shift rounds.
+const std::array<uint32_t, 256>& crc32_table() {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> words;
+    for (uint32_t i = 0; i < words.size(); ++i) {
+      words[i] = crc32_word(i);
+    }
+    return words;
+  }();
+  return table;
+}
+
 inline uint32_t crc32_block(const uint8_t* buffer, size_t length) {
+  const auto& table = crc32_table();
   uint32_t word = 0;
   while (length--) {
-    uint32_t t1 = (word >> 8) & 0xFFFFFF;
-    uint32_t t2 = crc32_word((word ^ *buffer++) & 0xFF);
-    word = t1 ^ t2;
+    word = ((word >> 8) & 0xFFFFFF) ^ table[(word ^ *buffer++) & 0xFF];
   }
   return word;
 }
 
+enum class FrameStatus {
+  INVALID,
+  INCOMPLETE,
+  COMPLETE,
+};
+
+// Checks the frame starting at data (which must start with SYNC_0). On
+// INCOMPLETE, *frame_length is the number of bytes needed before the frame can
+// be checked again; on COMPLETE it is the length of the frame.
+FrameStatus CheckFrame(const uint8_t* data, size_t length,
+                       size_t* frame_length) {
+  if (length < 3) {
+    if (length >= 2 && data[1] != novatel::SYNC_1) {
+      return FrameStatus::INVALID;
+    }
+    *frame_length = 3;
+    return FrameStatus::INCOMPLETE;
+  }
+  if (data[1] != novatel::SYNC_1) {
+    return FrameStatus::INVALID;
+  }
+  size_t header_length = 0;
+  size_t message_length = 0;
+  switch (data[2]) {
+    case novatel::SYNC_2_LONG_HEADER:
+      header_length = sizeof(novatel::LongHeader);
+      if (length >= header_length) {
+        message_length =
+            reinterpret_cast<const novatel::LongHeader*>(data)->message_length;
+      }
+      break;
+    case novatel::SYNC_2_SHORT_HEADER:
+      header_length = sizeof(novatel::ShortHeader);
+      if (length >= header_length) {
+        message_length =
+            reinterpret_cast<const novatel::ShortHeader*>(data)->message_length;
+      }
+      break;
+    default:
+      return FrameStatus::INVALID;
+  }
+  if (length < header_length) {
+    *frame_length = header_length;
+    return FrameStatus::INCOMPLETE;
+  }
+  *frame_length = header_length + message_length + novatel::CRC_LENGTH;
+  return length < *frame_length ? FrameStatus::INCOMPLETE
+                                : FrameStatus::COMPLETE;
+}
+
 // Converts NovAtel's azimuth (north = 0, east = 90) to FLU yaw (east = 0, north
 // = pi/2).
 constexpr double azimuth_deg_to_yaw_rad(double azimuth) {
@@ -111,9 +176,10 @@ class NovatelParser : public Parser {
   virtual MessageType GetMessage(MessagePtr* message_ptr);
 
  private:
-  bool check_crc();
+  bool check_crc(const uint8_t* frame, size_t length);
 
-  Parser::MessageType PrepareMessage(MessagePtr* message_ptr);
+  Parser::MessageType PrepareMessage(const uint8_t* frame, size_t length,
+                                     MessagePtr* message_ptr);
 
   // The handle_xxx functions return whether a message is ready.
   bool HandleBestPos(const novatel::BestPos* pos, uint16_t gps_week,
@@ -162,12 +228,10 @@ class NovatelParser : public Parser {
 
   double imu_measurement_time_previous_ = -1.0;
 
+  // Holds a frame that is split across two Update() calls. Frames that are
+  // complete in the input are decoded in place without being copied here.
   std::vector<uint8_t> buffer_;
 
-  size_t header_length_ = 0;
-
-  size_t total_length_ = 0;
-
   config::ImuType imu_type_ = config::ImuType::ADIS16488;
 
   // -1 is an unused value.
@@ -227,93 +291,105 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
     return MessageType::NONE;
   }
 
+  size_t frame_length = 0;
   while (data_ < data_end_) {
-    if (buffer_.empty()) {  // Looking for SYNC0
-      if (*data_ == novatel::SYNC_0) {
-        buffer_.push_back(*data_);
-      }
-      ++data_;
-    } else if (buffer_.size() == 1) {  // Looking for SYNC1
-      if (*data_ == novatel::SYNC_1) {
-        buffer_.push_back(*data_++);
-      } else {
+    if (!buffer_.empty()) {  // Completing a frame split across updates.
+      FrameStatus status =
+          CheckFrame(buffer_.data(), buffer_.size(), &frame_length);
+      if (status == FrameStatus::INVALID) {
         buffer_.clear();
+        continue;
       }
-    } else if (buffer_.size() == 2) {  // Looking for SYNC2
-      switch (*data_) {
-        case novatel::SYNC_2_LONG_HEADER:
-          buffer_.push_back(*data_++);
-          header_length_ = sizeof(novatel::LongHeader);
-          break;
-        case novatel::SYNC_2_SHORT_HEADER:
-          buffer_.push_back(*data_++);
-          header_length_ = sizeof(novatel::ShortHeader);
-          break;
-        default:
-          buffer_.clear();
-      }
-    } else if (header_length_ > 0) {  // Working on header.
-      if (buffer_.size() < header_length_) {
-        buffer_.push_back(*data_++);
-      } else {
-        if (header_length_ == sizeof(novatel::LongHeader)) {
-          total_length_ = header_length_ + novatel::CRC_LENGTH +
-                          reinterpret_cast<novatel::LongHeader*>(buffer_.data())
-                              ->message_length;
-        } else if (header_length_ == sizeof(novatel::ShortHeader)) {
-          total_length_ =
-              header_length_ + novatel::CRC_LENGTH +
-              reinterpret_cast<novatel::ShortHeader*>(buffer_.data())
-                  ->message_length;
-        } else {
-          AERROR << "Incorrect header_length_. Should never reach here.";
-          buffer_.clear();
+      if (status == FrameStatus::INCOMPLETE) {
+        if (buffer_.size() < 3) {
+          // Sync bytes are appended one at a time. A wrong one is not
+          // consumed, it is looked at again as a SYNC_0 candidate.
+          buffer_.push_back(*data_);
+          if (CheckFrame(buffer_.data(), buffer_.size(), &frame_length) ==
+              FrameStatus::INVALID) {
+            buffer_.clear();
+          } else {
+            ++data_;
+          }
+          continue;
+        }
+        const size_t count =
+            std::min(frame_length - buffer_.size(),
+                     static_cast<size_t>(data_end_ - data_));
+        buffer_.insert(buffer_.end(), data_, data_ + count);
+        data_ += count;
+        // the header may just have been completed, giving the frame length
+        if (CheckFrame(buffer_.data(), buffer_.size(), &frame_length) !=
+            FrameStatus::COMPLETE) {
+          continue;
         }
-        header_length_ = 0;
-      }
-    } else if (total_length_ > 0) {
-      if (buffer_.size() < total_length_) {  // Working on body.
-        buffer_.push_back(*data_++);
-        continue;
       }
-      MessageType type = PrepareMessage(message_ptr);
+      MessageType type =
+          PrepareMessage(buffer_.data(), buffer_.size(), message_ptr);
       buffer_.clear();
-      total_length_ = 0;
       if (type != MessageType::NONE) {
         return type;
       }
+      continue;
+    }
+
+    // Looking for SYNC0.
+    const void* sync = std::memchr(data_, novatel::SYNC_0, data_end_ - data_);
+    if (sync == nullptr) {
+      data_ = data_end_;
+      break;
+    }
+    data_ = static_cast<const uint8_t*>(sync);
+    FrameStatus status = CheckFrame(data_, data_end_ - data_, &frame_length);
+    if (status == FrameStatus::INVALID) {
+      ++data_;
+      continue;
+    }
+    if (status == FrameStatus::INCOMPLETE) {
+      buffer_.assign(data_, data_end_);
+      data_ = data_end_;
+      break;
+    }
+    const uint8_t* frame = data_;
+    data_ += frame_length;
+    MessageType type = PrepareMessage(frame, frame_length, message_ptr);
+    if (type != MessageType::NONE) {
+      return type;
     }
   }
   return MessageType::NONE;
 }
 
-bool NovatelParser::check_crc() {
-  size_t l = buffer_.size() - novatel::CRC_LENGTH;
-  return crc32_block(buffer_.data(), l) ==
-         *reinterpret_cast<uint32_t*>(buffer_.data() + l);
+bool NovatelParser::check_crc(const uint8_t* frame, size_t length) {
+  size_t l = length - novatel::CRC_LENGTH;
+  uint32_t crc = 0;
+  std::memcpy(&crc, frame + l, sizeof(crc));
+  return crc32_block(frame, l) == crc;
 }
 
-Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
-  if (!check_crc()) {
+Parser::MessageType NovatelParser::PrepareMessage(const uint8_t* frame,
+                                                  size_t length,
+                                                  MessagePtr* message_ptr) {
+  if (!check_crc(frame, length)) {
     AERROR << "CRC check failed.";
     return MessageType::NONE;
   }
 
-  uint8_t* message = nullptr;
+  const uint8_t* message = nullptr;
   novatel::MessageId message_id;
   uint16_t message_length;
   uint16_t gps_week;
   uint32_t gps_millisecs;
-  if (buffer_[2] == novatel::SYNC_2_LONG_HEADER) {
-    auto header = reinterpret_cast<const novatel::LongHeader*>(buffer_.data());
-    message = buffer_.data() + sizeof(novatel::LongHeader);
+  if (frame[2] == novatel::SYNC_2_LONG_HEADER) {
+    auto header = reinterpret_cast<const novatel::LongHeader*>(frame);
+    message = frame + sizeof(novatel::LongHeader);
     gps_week = header->gps_week;
     gps_millisecs = header->gps_millisecs;
     message_id = header->message_id;
     message_length = header->message_length;
   } else {
-    auto header = reinterpret_cast<const novatel::ShortHeader*>(buffer_.data());
-    message = buffer_.data() + sizeof(novatel::ShortHeader);
+    auto header = reinterpret_cast<const novatel::ShortHeader*>(frame);
+    message = frame + sizeof(novatel::ShortHeader);
     gps_week = header->gps_week;
     gps_millisecs = header->gps_millisecs;
     message_id = header->message_id;
@@ -325,7 +401,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleGnssBestpos(reinterpret_cast<novatel::BestPos*>(message),
+      if (HandleGnssBestpos(reinterpret_cast<const novatel::BestPos*>(message),
                             gps_week, gps_millisecs)) {
         *message_ptr = &bestpos_;
         return MessageType::BEST_GNSS_POS;
@@ -338,8 +414,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleBestPos(reinterpret_cast<novatel::BestPos*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleBestPos(reinterpret_cast<const novatel::BestPos*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &gnss_;
         return MessageType::GNSS;
       }
@@ -352,8 +428,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleBestVel(reinterpret_cast<novatel::BestVel*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleBestVel(reinterpret_cast<const novatel::BestVel*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &gnss_;
         return MessageType::GNSS;
       }
@@ -367,7 +443,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleCorrImuData(reinterpret_cast<novatel::CorrImuData*>(message))) {
+      if (HandleCorrImuData(
+              reinterpret_cast<const novatel::CorrImuData*>(message))) {
         *message_ptr = &ins_;
         return MessageType::INS;
       }
@@ -380,7 +457,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleInsCov(reinterpret_cast<novatel::InsCov*>(message))) {
+      if (HandleInsCov(reinterpret_cast<const novatel::InsCov*>(message))) {
         *message_ptr = &ins_;
         return MessageType::INS;
       }
@@ -393,7 +470,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleInsPva(reinterpret_cast<novatel::InsPva*>(message))) {
+      if (HandleInsPva(reinterpret_cast<const novatel::InsPva*>(message))) {
         *message_ptr = &ins_;
         return MessageType::INS;
       }
@@ -406,7 +483,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleRawImuX(reinterpret_cast<novatel::RawImuX*>(message))) {
+      if (HandleRawImuX(reinterpret_cast<const novatel::RawImuX*>(message))) {
         *message_ptr = &imu_;
         return MessageType::IMU;
       }
@@ -419,7 +496,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleRawImu(reinterpret_cast<novatel::RawImu*>(message))) {
+      if (HandleRawImu(reinterpret_cast<const novatel::RawImu*>(message))) {
         *message_ptr = &imu_;
         return MessageType::IMU;
       }
@@ -431,8 +508,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleInsPvax(reinterpret_cast<novatel::InsPvaX*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleInsPvax(reinterpret_cast<const novatel::InsPvaX*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &ins_stat_;
         return MessageType::INS_STAT;
       }
@@ -443,7 +520,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect BDSEPHEMERIS message_length";
         break;
       }
-      if (HandleBdsEph(reinterpret_cast<novatel::BDS_Ephemeris*>(message))) {
+      if (HandleBdsEph(
+              reinterpret_cast<const novatel::BDS_Ephemeris*>(message))) {
         *message_ptr = &gnss_ephemeris_;
         return MessageType::BDSEPHEMERIDES;
       }
@@ -454,7 +532,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect GPSEPHEMERIS message_length";
         break;
       }
-      if (HandleGpsEph(reinterpret_cast<novatel::GPS_Ephemeris*>(message))) {
+      if (HandleGpsEph(
+              reinterpret_cast<const novatel::GPS_Ephemeris*>(message))) {
         *message_ptr = &gnss_ephemeris_;
         return MessageType::GPSEPHEMERIDES;
       }
@@ -465,15 +544,15 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect GLOEPHEMERIS message length";
         break;
       }
-      if (HandleGloEph(reinterpret_cast<novatel::GLO_Ephemeris*>(message))) {
+      if (HandleGloEph(
+              reinterpret_cast<const novatel::GLO_Ephemeris*>(message))) {
         *message_ptr = &gnss_ephemeris_;
         return MessageType::GLOEPHEMERIDES;
       }
       break;
 
     case novatel::RANGE:
-      if (DecodeGnssObservation(buffer_.data(),
-                                buffer_.data() + buffer_.size())) {
+      if (DecodeGnssObservation(frame, frame + length)) {
         *message_ptr = &gnss_observation_;
         return MessageType::OBSERVATION;
       }
@@ -484,8 +563,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleHeading(reinterpret_cast<novatel::Heading*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleHeading(reinterpret_cast<const novatel::Heading*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &heading_;
         return MessageType::HEADING;
       }
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/drivers/gnss/parser/novatel_messages.h"
+#include "modules/drivers/gnss/parser/parser.h"
+#include "modules/drivers/gnss/proto/config.pb.h"
+#include "modules/drivers/gnss/proto/gnss.pb.h"
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+namespace {
+
+uint32_t Crc32(const uint8_t* buffer, size_t length) {
+  uint32_t word = 0;
+  while (length--) {
+    word ^= *buffer++;
+    for (int j = 0; j < 8; ++j) {
+      word = (word & 1) ? (word >> 1) ^ 0xEDB88320 : word >> 1;
+    }
+  }
+  return word;
+}
+
+// A BESTPOS log with a long header, followed by its CRC.
+std::vector<uint8_t> BestPosFrame() {
+  novatel::LongHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.sync[0] = novatel::SYNC_0;
+  header.sync[1] = novatel::SYNC_1;
+  header.sync[2] = novatel::SYNC_2_LONG_HEADER;
+  header.header_length = sizeof(header);
+  header.message_id = novatel::BESTPOS;
+  header.message_length = sizeof(novatel::BestPos);
+  header.gps_week = 2100;
+  header.gps_millisecs = 345600500;
+
+  novatel::BestPos pos;
+  std::memset(&pos, 0, sizeof(pos));
+  pos.solution_status = novatel::SolutionStatus::SOL_COMPUTED;
+  pos.position_type = novatel::SolutionType::SINGLE;
+  pos.latitude = 37.4164;
+  pos.longitude = -122.0253;
+  pos.height_msl = 10.5;
+  pos.undulation = -32.0f;
+  pos.datum_id = novatel::DatumId::WGS84;
+  pos.latitude_std_dev = 1.5f;
+  pos.longitude_std_dev = 1.25f;
+  pos.height_std_dev = 2.5f;
+  pos.num_sats_in_solution = 9;
+
+  std::vector<uint8_t> frame(sizeof(header) + sizeof(pos));
+  std::memcpy(frame.data(), &header, sizeof(header));
+  std::memcpy(frame.data() + sizeof(header), &pos, sizeof(pos));
+  const uint32_t crc = Crc32(frame.data(), frame.size());
+  for (size_t i = 0; i < novatel::CRC_LENGTH; ++i) {
+    frame.push_back(static_cast<uint8_t>(crc >> (8 * i)));
+  }
+  return frame;
+}
+
+}  // namespace
+
+TEST(NovatelParserTest, FrameSplitAcrossUpdates) {
+  std::unique_ptr<Parser> parser(Parser::CreateNovatel(config::Config()));
+  const std::vector<uint8_t> frame = BestPosFrame();
+  Parser::MessagePtr message = nullptr;
+
+  // The first BESTPOS of a measurement time only records it.
+  parser->Update(frame.data(), frame.size());
+  EXPECT_EQ(Parser::MessageType::NONE, parser->GetMessage(&message));
+
+  // The same log again, after some junk, cut within the sync bytes, the
+  // header, the body and the CRC.
+  std::vector<uint8_t> data = {0x00, novatel::SYNC_0, 0x13};
+  data.insert(data.end(), frame.begin(), frame.end());
+  const std::vector<size_t> cuts = {4, 5, 6, 15, 40, data.size() - 2};
+  size_t begin = 0;
+  for (const size_t end : cuts) {
+    parser->Update(data.data() + begin, end - begin);
+    EXPECT_EQ(Parser::MessageType::NONE, parser->GetMessage(&message))
+        << "piece ending at " << end;
+    begin = end;
+  }
+  parser->Update(data.data() + begin, data.size() - begin);
+  ASSERT_EQ(Parser::MessageType::GNSS, parser->GetMessage(&message));
+
+  const Gnss* gnss = As<Gnss>(message);
+  ASSERT_NE(nullptr, gnss);
+  EXPECT_DOUBLE_EQ(-122.0253, gnss->position().lon());
+  EXPECT_DOUBLE_EQ(37.4164, gnss->position().lat());
+  EXPECT_DOUBLE_EQ(10.5 - 32.0, gnss->position().height());
+  EXPECT_FLOAT_EQ(1.25f, gnss->position_std_dev().x());
+  EXPECT_FLOAT_EQ(1.5f, gnss->position_std_dev().y());
+  EXPECT_FLOAT_EQ(2.5f, gnss->position_std_dev().z());
+  EXPECT_EQ(9u, gnss->num_sats());
+  EXPECT_EQ(Gnss::SINGLE, gnss->type());
+  EXPECT_DOUBLE_EQ(2100 * 604800 + 345600.5, gnss->measurement_time());
+  EXPECT_EQ(Parser::MessageType::NONE, parser->GetMessage(&message));
+}
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Measures the throughput of the NovAtel parser on the captures parser_cli
+// reads (a raw "bin" dump or a "record" with the gnss raw_data channel). The
+// whole capture is loaded in memory first and then fed to the parser in chunks
+// of each of the given sizes, so only framing and decoding are timed.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/record/record_reader.h"
+
+#include "modules/drivers/gnss/parser/parser.h"
+#include "modules/drivers/gnss/proto/config.pb.h"
+#include "modules/drivers/gnss/proto/gnss_status.pb.h"
+
+DEFINE_string(input_file, "", "parser_cli capture to decode.");
+DEFINE_string(input_type, "bin", "Type of the capture: bin or record.");
+DEFINE_string(gnss_conf,
+              "/apollo/modules/drivers/gnss/conf/gnss_conf.pb.txt",
+              "Gnss config the parser is created from.");
+DEFINE_string(raw_data_channel, "/apollo/sensor/gnss/raw_data",
+              "Channel holding the raw stream in record captures.");
+DEFINE_string(chunk_sizes, "128,1024,65536",
+              "Comma separated sizes of the reads fed to the parser.");
+DEFINE_int32(iterations, 10, "Passes over the capture per chunk size.");
+
+namespace apollo {
+namespace drivers {
+namespace gnss {
+
+namespace {
+
+bool LoadBin(const std::string& filename, std::string* data) {
+  std::ifstream f(filename, std::ifstream::binary);
+  if (!f) {
+    return false;
+  }
+  data->assign(std::istreambuf_iterator<char>(f),
+               std::istreambuf_iterator<char>());
+  return true;
+}
+
+bool LoadRecord(const std::string& filename, std::string* data) {
+  cyber::record::RecordReader reader(filename);
+  cyber::record::RecordMessage message;
+  RawData raw_data;
+  while (reader.ReadMessage(&message)) {
+    if (message.channel_name != FLAGS_raw_data_channel) {
+      continue;
+    }
+    if (raw_data.ParseFromString(message.content)) {
+      data->append(raw_data.data());
+    }
+  }
+  return !data->empty();
+}
+
+std::vector<size_t> ParseChunkSizes(const std::string& text) {
+  std::vector<size_t> sizes;
+  size_t begin = 0;
+  while (begin < text.size()) {
+    size_t end = text.find(',', begin);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    const int64_t size = std::strtoll(text.c_str() + begin, nullptr, 10);
+    if (size > 0) {
+      sizes.push_back(static_cast<size_t>(size));
+    }
+    begin = end + 1;
+  }
+  return sizes;
+}
+
+}  // namespace
+
+int Run() {
+  config::Config config;
+  if (!cyber::common::GetProtoFromFile(FLAGS_gnss_conf, &config)) {
+    AERROR << "Unable to load gnss conf file " << FLAGS_gnss_conf;
+    return -1;
+  }
+
+  std::string data;
+  const bool loaded = FLAGS_input_type == "record"
+                          ? LoadRecord(FLAGS_input_file, &data)
+                          : LoadBin(FLAGS_input_file, &data);
+  if (!loaded || data.empty()) {
+    AERROR << "No data loaded from " << FLAGS_input_file;
+    return -1;
+  }
+  AINFO << "Loaded " << data.size() << " bytes from " << FLAGS_input_file;
+
+  const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+  for (const size_t chunk_size : ParseChunkSizes(FLAGS_chunk_sizes)) {
+    std::unique_ptr<Parser> parser(Parser::CreateNovatel(config));
+    if (!parser) {
+      AERROR << "Failed to create novatel parser.";
+      return -1;
+    }
+
+    size_t message_count = 0;
+    Parser::MessagePtr message = nullptr;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FLAGS_iterations; ++i) {
+      for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+        parser->Update(bytes + offset,
+                       std::min(chunk_size, data.size() - offset));
+        while (parser->GetMessage(&message) != Parser::MessageType::NONE) {
+          ++message_count;
+        }
+      }
+    }
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    const double megabytes = static_cast<double>(data.size()) *
+                             FLAGS_iterations / (1024.0 * 1024.0);
+    AINFO << "chunk " << chunk_size << " bytes: " << megabytes / seconds
+          << " MB/s, " << static_cast<double>(message_count) / seconds
+          << " messages/s (" << message_count / FLAGS_iterations
+          << " messages per pass)";
+  }
+  return 0;
+}
+
+}  // namespace gnss
+}  // namespace drivers
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::drivers::gnss::Run();
+}
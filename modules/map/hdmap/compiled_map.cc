@@ -0,0 +1,583 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/compiled_map.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "cyber/common/log.h"
+#include "modules/common/math/line_segment2d.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+using compiled_map::FileHeader;
+using compiled_map::Lane;
+using compiled_map::Node;
+using compiled_map::NodeObject;
+using compiled_map::Segment;
+
+namespace {
+
+// Same parameters as the lane segment kd-tree of HDMapImpl.
+constexpr double kMaxLeafDimension = 5.0;
+constexpr size_t kMaxLeafSize = 16;
+
+constexpr size_t kSectionAlignment = 64;
+
+size_t Align(size_t offset) {
+  return (offset + kSectionAlignment - 1) / kSectionAlignment *
+         kSectionAlignment;
+}
+
+double SegmentMin(const Segment& segment, uint32_t partition) {
+  return partition == 0 ? std::fmin(segment.start_x, segment.end_x)
+                        : std::fmin(segment.start_y, segment.end_y);
+}
+
+double SegmentMax(const Segment& segment, uint32_t partition) {
+  return partition == 0 ? std::fmax(segment.start_x, segment.end_x)
+                        : std::fmax(segment.start_y, segment.end_y);
+}
+
+double LowerDistanceSquare(const Node& node, const Vec2d& point) {
+  double dx = 0.0;
+  if (point.x() < node.min_x) {
+    dx = node.min_x - point.x();
+  } else if (point.x() > node.max_x) {
+    dx = point.x() - node.max_x;
+  }
+  double dy = 0.0;
+  if (point.y() < node.min_y) {
+    dy = node.min_y - point.y();
+  } else if (point.y() > node.max_y) {
+    dy = point.y() - node.max_y;
+  }
+  return dx * dx + dy * dy;
+}
+
+double UpperDistanceSquare(const Node& node, const Vec2d& point) {
+  const double mid_x = (node.min_x + node.max_x) / 2.0;
+  const double mid_y = (node.min_y + node.max_y) / 2.0;
+  const double dx =
+      point.x() > mid_x ? point.x() - node.min_x : point.x() - node.max_x;
+  const double dy =
+      point.y() > mid_y ? point.y() - node.min_y : point.y() - node.max_y;
+  return dx * dx + dy * dy;
+}
+
+template <typename T>
+void AppendSection(const std::vector<T>& items, compiled_map::Section section,
+                   FileHeader* header, std::string* data) {
+  data->resize(Align(data->size()), '\0');
+  header->sections[section].offset = data->size();
+  header->sections[section].count = items.size();
+  data->append(reinterpret_cast<const char*>(items.data()),
+               items.size() * sizeof(T));
+}
+
+}  // namespace
+
+std::string CompiledMapFilename(const std::string& map_filename) {
+  const size_t slash = map_filename.rfind('/');
+  const size_t dot = map_filename.rfind('.');
+  if (dot == std::string::npos ||
+      (slash != std::string::npos && dot < slash)) {
+    return map_filename + ".compiled";
+  }
+  return map_filename.substr(0, dot) + ".compiled";
+}
+
+void MapFingerprint::Add(const void* data, size_t size) {
+  // FNV-1a.
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    value_ ^= bytes[i];
+    value_ *= 1099511628211ULL;
+  }
+}
+
+void MapFingerprint::AddLane(const std::string& id,
+                             const std::vector<Vec2d>& points) {
+  const uint64_t id_length = id.size();
+  Add(&id_length, sizeof(id_length));
+  Add(id.data(), id.size());
+  const uint64_t num_points = points.size();
+  Add(&num_points, sizeof(num_points));
+  for (const auto& point : points) {
+    const double xy[2] = {point.x(), point.y()};
+    Add(xy, sizeof(xy));
+  }
+}
+
+bool CompiledMapBuilder::AddLane(const std::string& id,
+                                 const std::vector<Vec2d>& points) {
+  if (points.size() < 2) {
+    AERROR << "Lane " << id << " has less than two points.";
+    return false;
+  }
+  fingerprint_.AddLane(id, points);
+
+  Lane lane;
+  lane.id_offset = strings_.size();
+  lane.id_length = static_cast<uint32_t>(id.size());
+  lane.first_segment = static_cast<uint32_t>(segments_.size());
+  lane.num_segments = static_cast<uint32_t>(points.size() - 1);
+  strings_.append(id);
+
+  const uint32_t lane_index = static_cast<uint32_t>(lanes_.size());
+  for (size_t i = 0; i + 1 < points.size(); ++i) {
+    const LineSegment2d line(points[i], points[i + 1]);
+    Segment segment;
+    segment.start_x = points[i].x();
+    segment.start_y = points[i].y();
+    segment.end_x = points[i + 1].x();
+    segment.end_y = points[i + 1].y();
+    segment.unit_x = line.unit_direction().x();
+    segment.unit_y = line.unit_direction().y();
+    segment.length = line.length();
+    segment.lane = lane_index;
+    segment.index = static_cast<uint32_t>(i);
+    segments_.push_back(segment);
+  }
+  lanes_.push_back(lane);
+  return true;
+}
+
+int CompiledMapBuilder::BuildNode(
+    std::vector<uint32_t>* segments, std::vector<Node>* nodes,
+    std::vector<NodeObject>* objects_by_min,
+    std::vector<NodeObject>* objects_by_max) const {
+  Node node;
+  node.min_x = node.min_y = std::numeric_limits<double>::infinity();
+  node.max_x = node.max_y = -std::numeric_limits<double>::infinity();
+  for (const uint32_t index : *segments) {
+    const Segment& segment = segments_[index];
+    node.min_x = std::fmin(node.min_x, SegmentMin(segment, 0));
+    node.max_x = std::fmax(node.max_x, SegmentMax(segment, 0));
+    node.min_y = std::fmin(node.min_y, SegmentMin(segment, 1));
+    node.max_y = std::fmax(node.max_y, SegmentMax(segment, 1));
+  }
+  if (node.max_x - node.min_x >= node.max_y - node.min_y) {
+    node.partition = 0;
+    node.partition_position = (node.min_x + node.max_x) / 2.0;
+  } else {
+    node.partition = 1;
+    node.partition_position = (node.min_y + node.max_y) / 2.0;
+  }
+  node.left = node.right = -1;
+  node.reserved = 0;
+
+  const bool split =
+      segments->size() > kMaxLeafSize &&
+      std::max(node.max_x - node.min_x, node.max_y - node.min_y) >
+          kMaxLeafDimension;
+  std::vector<uint32_t> left;
+  std::vector<uint32_t> right;
+  std::vector<uint32_t> kept;
+  if (split) {
+    for (const uint32_t index : *segments) {
+      const Segment& segment = segments_[index];
+      if (SegmentMax(segment, node.partition) <= node.partition_position) {
+        left.push_back(index);
+      } else if (SegmentMin(segment, node.partition) >=
+                 node.partition_position) {
+        right.push_back(index);
+      } else {
+        kept.push_back(index);
+      }
+    }
+  } else {
+    kept.swap(*segments);
+  }
+  segments->clear();
+  segments->shrink_to_fit();
+
+  // Objects of a node are contiguous, so they are written before recursing.
+  node.first_object = static_cast<uint32_t>(objects_by_min->size());
+  node.num_objects = static_cast<uint32_t>(kept.size());
+  const uint32_t partition = node.partition;
+  std::stable_sort(kept.begin(), kept.end(), [&](uint32_t a, uint32_t b) {
+    return SegmentMin(segments_[a], partition) <
+           SegmentMin(segments_[b], partition);
+  });
+  for (const uint32_t index : kept) {
+    objects_by_min->push_back(
+        {SegmentMin(segments_[index], partition), index, 0});
+  }
+  std::stable_sort(kept.begin(), kept.end(), [&](uint32_t a, uint32_t b) {
+    return SegmentMax(segments_[a], partition) >
+           SegmentMax(segments_[b], partition);
+  });
+  for (const uint32_t index : kept) {
+    objects_by_max->push_back(
+        {SegmentMax(segments_[index], partition), index, 0});
+  }
+
+  const int node_index = static_cast<int>(nodes->size());
+  nodes->push_back(node);
+  if (!left.empty()) {
+    const int left_index =
+        BuildNode(&left, nodes, objects_by_min, objects_by_max);
+    (*nodes)[node_index].left = left_index;
+  }
+  if (!right.empty()) {
+    const int right_index =
+        BuildNode(&right, nodes, objects_by_min, objects_by_max);
+    (*nodes)[node_index].right = right_index;
+  }
+  return node_index;
+}
+
+void CompiledMapBuilder::BuildTree(
+    std::vector<Node>* nodes, std::vector<NodeObject>* objects_by_min,
+    std::vector<NodeObject>* objects_by_max) const {
+  if (segments_.empty()) {
+    return;
+  }
+  std::vector<uint32_t> segments(segments_.size());
+  for (size_t i = 0; i < segments.size(); ++i) {
+    segments[i] = static_cast<uint32_t>(i);
+  }
+  objects_by_min->reserve(segments_.size());
+  objects_by_max->reserve(segments_.size());
+  BuildNode(&segments, nodes, objects_by_min, objects_by_max);
+}
+
+bool CompiledMapBuilder::Write(const std::string& filename) const {
+  std::vector<Node> nodes;
+  std::vector<NodeObject> objects_by_min;
+  std::vector<NodeObject> objects_by_max;
+  BuildTree(&nodes, &objects_by_min, &objects_by_max);
+
+  FileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, compiled_map::kMagic, sizeof(header.magic));
+  header.version = compiled_map::kVersion;
+  header.num_sections = compiled_map::kNumSections;
+  header.fingerprint = fingerprint_.value();
+
+  std::string data(sizeof(header), '\0');
+  AppendSection(lanes_, compiled_map::kLanes, &header, &data);
+  AppendSection(segments_, compiled_map::kSegments, &header, &data);
+  AppendSection(nodes, compiled_map::kNodes, &header, &data);
+  AppendSection(objects_by_min, compiled_map::kNodeObjectsByMin, &header,
+                &data);
+  AppendSection(objects_by_max, compiled_map::kNodeObjectsByMax, &header,
+                &data);
+  data.resize(Align(data.size()), '\0');
+  header.sections[compiled_map::kStrings].offset = data.size();
+  header.sections[compiled_map::kStrings].count = strings_.size();
+  data.append(strings_);
+  header.file_size = data.size();
+  std::memcpy(&data[0], &header, sizeof(header));
+
+  // Written aside and renamed, so that a process mapping the previous file
+  // never sees a partially written one.
+  const std::string tmp_filename = filename + ".tmp";
+  {
+    std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+    if (!out.write(data.data(), data.size())) {
+      AERROR << "Failed to write " << tmp_filename;
+      return false;
+    }
+  }
+  if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    AERROR << "Failed to rename " << tmp_filename << " to " << filename;
+    return false;
+  }
+  AINFO << "Compiled " << lanes_.size() << " lanes, " << segments_.size()
+        << " segments and " << nodes.size() << " kd-tree nodes into "
+        << filename << " (" << data.size() << " bytes).";
+  return true;
+}
+
+CompiledMap::~CompiledMap() { Unmap(); }
+
+void CompiledMap::Unmap() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  header_ = nullptr;
+}
+
+bool CompiledMap::Load(const std::string& filename) {
+  Unmap();
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < sizeof(FileHeader)) {
+    AERROR << "Invalid compiled map " << filename;
+    close(fd);
+    return false;
+  }
+  size_ = static_cast<size_t>(file_stat.st_size);
+  data_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data_ == MAP_FAILED) {
+    AERROR << "Failed to mmap " << filename;
+    data_ = nullptr;
+    size_ = 0;
+    return false;
+  }
+
+  const char* base = static_cast<const char*>(data_);
+  header_ = reinterpret_cast<const FileHeader*>(base);
+  if (std::memcmp(header_->magic, compiled_map::kMagic,
+                  sizeof(header_->magic)) != 0 ||
+      header_->version != compiled_map::kVersion ||
+      header_->num_sections != compiled_map::kNumSections ||
+      header_->file_size != size_) {
+    AERROR << "Unsupported or truncated compiled map " << filename;
+    Unmap();
+    return false;
+  }
+  static constexpr size_t kElementSizes[compiled_map::kNumSections] = {
+      sizeof(Lane),       sizeof(Segment),    sizeof(Node),
+      sizeof(NodeObject), sizeof(NodeObject), sizeof(char)};
+  for (uint32_t i = 0; i < compiled_map::kNumSections; ++i) {
+    const auto& section = header_->sections[i];
+    if (section.offset > size_ ||
+        section.count > (size_ - section.offset) / kElementSizes[i]) {
+      AERROR << "Section " << i << " out of bounds in " << filename;
+      Unmap();
+      return false;
+    }
+  }
+  const auto section_data = [&](compiled_map::Section section) {
+    return base + header_->sections[section].offset;
+  };
+  lanes_ = reinterpret_cast<const Lane*>(section_data(compiled_map::kLanes));
+  segments_ =
+      reinterpret_cast<const Segment*>(section_data(compiled_map::kSegments));
+  nodes_ = reinterpret_cast<const Node*>(section_data(compiled_map::kNodes));
+  objects_by_min_ = reinterpret_cast<const NodeObject*>(
+      section_data(compiled_map::kNodeObjectsByMin));
+  objects_by_max_ = reinterpret_cast<const NodeObject*>(
+      section_data(compiled_map::kNodeObjectsByMax));
+  strings_ = section_data(compiled_map::kStrings);
+  // Lanes and segments are checked once here, so that queries index without
+  // checks.
+  const size_t num_strings = Count(compiled_map::kStrings);
+  for (size_t i = 0; i < num_lanes(); ++i) {
+    const Lane& lane = lanes_[i];
+    if (lane.num_segments < 1 ||
+        uint64_t{lane.first_segment} + lane.num_segments > num_segments() ||
+        lane.id_offset + lane.id_length > num_strings) {
+      AERROR << "Lane " << i << " out of bounds in " << filename;
+      Unmap();
+      return false;
+    }
+  }
+  const size_t num_nodes = Count(compiled_map::kNodes);
+  const size_t num_objects = Count(compiled_map::kNodeObjectsByMin);
+  for (size_t i = 0; i < num_segments(); ++i) {
+    if (segments_[i].lane >= num_lanes()) {
+      AERROR << "Segment " << i << " out of bounds in " << filename;
+      Unmap();
+      return false;
+    }
+  }
+  for (size_t i = 0; i < num_nodes; ++i) {
+    const Node& node = nodes_[i];
+    // Children always follow their parent, which also rules out cycles.
+    if ((node.left >= 0 && (static_cast<size_t>(node.left) >= num_nodes ||
+                            static_cast<size_t>(node.left) <= i)) ||
+        (node.right >= 0 && (static_cast<size_t>(node.right) >= num_nodes ||
+                             static_cast<size_t>(node.right) <= i)) ||
+        uint64_t{node.first_object} + node.num_objects > num_objects ||
+        num_objects != Count(compiled_map::kNodeObjectsByMax)) {
+      AERROR << "Node " << i << " out of bounds in " << filename;
+      Unmap();
+      return false;
+    }
+  }
+  for (size_t i = 0; i < num_objects; ++i) {
+    if (objects_by_min_[i].segment >= num_segments() ||
+        objects_by_max_[i].segment >= num_segments()) {
+      AERROR << "Node object " << i << " out of bounds in " << filename;
+      Unmap();
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string CompiledMap::lane_id(size_t index) const {
+  return std::string(strings_ + lanes_[index].id_offset,
+                     lanes_[index].id_length);
+}
+
+double CompiledMap::DistanceSquareToSegment(const Vec2d& point,
+                                            size_t index) const {
+  // Same as LineSegment2d::DistanceSquareTo().
+  const Segment& segment = segments_[index];
+  const double x0 = point.x() - segment.start_x;
+  const double y0 = point.y() - segment.start_y;
+  if (segment.length <= common::math::kMathEpsilon) {
+    return x0 * x0 + y0 * y0;
+  }
+  const double proj = x0 * segment.unit_x + y0 * segment.unit_y;
+  if (proj <= 0.0) {
+    return x0 * x0 + y0 * y0;
+  }
+  if (proj >= segment.length) {
+    const double x1 = point.x() - segment.end_x;
+    const double y1 = point.y() - segment.end_y;
+    return x1 * x1 + y1 * y1;
+  }
+  const double cross = x0 * segment.unit_y - y0 * segment.unit_x;
+  return cross * cross;
+}
+
+void CompiledMap::GetSegments(const Vec2d& point, double distance,
+                              std::vector<uint32_t>* segments) const {
+  segments->clear();
+  if (header_ == nullptr || Count(compiled_map::kNodes) == 0) {
+    return;
+  }
+  GetSegmentsInternal(0, point, distance, distance * distance, segments);
+}
+
+void CompiledMap::GetAllSegments(int node_index,
+                                 std::vector<uint32_t>* segments) const {
+  const Node& node = nodes_[node_index];
+  for (uint32_t i = 0; i < node.num_objects; ++i) {
+    segments->push_back(objects_by_min_[node.first_object + i].segment);
+  }
+  if (node.left >= 0) {
+    GetAllSegments(node.left, segments);
+  }
+  if (node.right >= 0) {
+    GetAllSegments(node.right, segments);
+  }
+}
+
+void CompiledMap::GetSegmentsInternal(int node_index, const Vec2d& point,
+                                      double distance, double distance_sqr,
+                                      std::vector<uint32_t>* segments) const {
+  const Node& node = nodes_[node_index];
+  if (LowerDistanceSquare(node, point) > distance_sqr) {
+    return;
+  }
+  if (UpperDistanceSquare(node, point) <= distance_sqr) {
+    GetAllSegments(node_index, segments);
+    return;
+  }
+  const double pvalue = node.partition == 0 ? point.x() : point.y();
+  if (pvalue < node.partition_position) {
+    const double limit = pvalue + distance;
+    const NodeObject* objects = objects_by_min_ + node.first_object;
+    for (uint32_t i = 0; i < node.num_objects; ++i) {
+      if (objects[i].bound > limit) {
+        break;
+      }
+      if (DistanceSquareToSegment(point, objects[i].segment) <= distance_sqr) {
+        segments->push_back(objects[i].segment);
+      }
+    }
+  } else {
+    const double limit = pvalue - distance;
+    const NodeObject* objects = objects_by_max_ + node.first_object;
+    for (uint32_t i = 0; i < node.num_objects; ++i) {
+      if (objects[i].bound < limit) {
+        break;
+      }
+      if (DistanceSquareToSegment(point, objects[i].segment) <= distance_sqr) {
+        segments->push_back(objects[i].segment);
+      }
+    }
+  }
+  if (node.left >= 0) {
+    GetSegmentsInternal(node.left, point, distance, distance_sqr, segments);
+  }
+  if (node.right >= 0) {
+    GetSegmentsInternal(node.right, point, distance, distance_sqr, segments);
+  }
+}
+
+int CompiledMap::GetNearestSegment(const Vec2d& point) const {
+  int nearest_segment = -1;
+  if (header_ == nullptr || Count(compiled_map::kNodes) == 0) {
+    return nearest_segment;
+  }
+  double min_distance_sqr = std::numeric_limits<double>::infinity();
+  GetNearestSegmentInternal(0, point, &min_distance_sqr, &nearest_segment);
+  return nearest_segment;
+}
+
+void CompiledMap::GetNearestSegmentInternal(int node_index, const Vec2d& point,
+                                            double* min_distance_sqr,
+                                            int* nearest_segment) const {
+  const Node& node = nodes_[node_index];
+  if (LowerDistanceSquare(node, point) >=
+      *min_distance_sqr - common::math::kMathEpsilon) {
+    return;
+  }
+  const double pvalue = node.partition == 0 ? point.x() : point.y();
+  const bool search_left_first = pvalue < node.partition_position;
+  const int first = search_left_first ? node.left : node.right;
+  const int second = search_left_first ? node.right : node.left;
+  if (first >= 0) {
+    GetNearestSegmentInternal(first, point, min_distance_sqr, nearest_segment);
+  }
+  if (*min_distance_sqr <= common::math::kMathEpsilon) {
+    return;
+  }
+
+  const NodeObject* objects = (search_left_first ? objects_by_min_
+                                                 : objects_by_max_) +
+                              node.first_object;
+  for (uint32_t i = 0; i < node.num_objects; ++i) {
+    const double bound = objects[i].bound;
+    const bool beyond = search_left_first ? bound > pvalue : bound < pvalue;
+    if (beyond && (bound - pvalue) * (bound - pvalue) > *min_distance_sqr) {
+      break;
+    }
+    const double distance_sqr =
+        DistanceSquareToSegment(point, objects[i].segment);
+    if (distance_sqr < *min_distance_sqr) {
+      *min_distance_sqr = distance_sqr;
+      *nearest_segment = static_cast<int>(objects[i].segment);
+    }
+  }
+  if (*min_distance_sqr <= common::math::kMathEpsilon) {
+    return;
+  }
+  if (second >= 0) {
+    GetNearestSegmentInternal(second, point, min_distance_sqr,
+                              nearest_segment);
+  }
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A compiled, memory mapped lane index of a map.
+ *
+ * The compiled map holds the lane segments of a map, with their unit
+ * directions, and a kd-tree over them, which is all GetLanes() and
+ * GetNearestLane() need. Everything is stored in flat arrays that refer to
+ * each other by index, so the file is used in place once mapped: loading it
+ * costs an mmap() and a few checks, and all the processes of a host share its
+ * pages.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace hdmap {
+namespace compiled_map {
+
+constexpr char kMagic[8] = {'A', 'P', 'O', 'L', 'L', 'O', 'C', 'M'};
+constexpr uint32_t kVersion = 2;
+
+enum Section : uint32_t {
+  kLanes = 0,
+  kSegments,
+  kNodes,
+  kNodeObjectsByMin,
+  kNodeObjectsByMax,
+  kStrings,
+  kNumSections,
+};
+
+struct SectionRef {
+  uint64_t offset;  // From the start of the file.
+  uint64_t count;   // Number of elements.
+};
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_sections;
+  uint64_t file_size;
+  // MapFingerprint of the lanes the file was compiled from.
+  uint64_t fingerprint;
+  SectionRef sections[kNumSections];
+};
+
+struct Lane {
+  uint64_t id_offset;  // In the string section.
+  uint32_t id_length;
+  uint32_t first_segment;
+  uint32_t num_segments;
+};
+
+struct Segment {
+  double start_x;
+  double start_y;
+  double end_x;
+  double end_y;
+  double unit_x;
+  double unit_y;
+  double length;
+  uint32_t lane;
+  uint32_t index;  // In the lane.
+};
+
+struct Node {
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+  double partition_position;
+  int32_t left;  // Node index, -1 if none.
+  int32_t right;
+  uint32_t first_object;  // In both object sections.
+  uint32_t num_objects;
+  uint32_t partition;  // 0: x, 1: y.
+  uint32_t reserved;
+};
+
+// The segments kept by a node, sorted by their lower (resp. upper) bound
+// along the partition axis of the node.
+struct NodeObject {
+  double bound;
+  uint32_t segment;
+  uint32_t reserved;
+};
+
+}  // namespace compiled_map
+
+/**
+ * @brief Gets the compiled map file of a map file: the map file with its
+ * extension replaced by ".compiled", e.g. base_map.compiled for base_map.bin.
+ */
+std::string CompiledMapFilename(const std::string& map_filename);
+
+/**
+ * @class MapFingerprint
+ * @brief Hash of lane ids and points, to tell whether a compiled map was
+ * compiled from the map it is used with.
+ */
+class MapFingerprint {
+ public:
+  void AddLane(const std::string& id,
+               const std::vector<apollo::common::math::Vec2d>& points);
+  uint64_t value() const { return value_; }
+
+ private:
+  void Add(const void* data, size_t size);
+
+  uint64_t value_ = 14695981039346656037ULL;
+};
+
+/**
+ * @class CompiledMapBuilder
+ * @brief Compiles lanes, in the order they are added, into a compiled map
+ * file.
+ */
+class CompiledMapBuilder {
+ public:
+  /**
+   * @brief Adds a lane from its deduplicated central curve points, as in
+   * LaneInfo::points(). Returns false if it has less than two points.
+   */
+  bool AddLane(const std::string& id,
+               const std::vector<apollo::common::math::Vec2d>& points);
+
+  bool Write(const std::string& filename) const;
+
+  uint64_t fingerprint() const { return fingerprint_.value(); }
+
+ private:
+  void BuildTree(std::vector<compiled_map::Node>* nodes,
+                 std::vector<compiled_map::NodeObject>* objects_by_min,
+                 std::vector<compiled_map::NodeObject>* objects_by_max) const;
+  int BuildNode(std::vector<uint32_t>* segments,
+                std::vector<compiled_map::Node>* nodes,
+                std::vector<compiled_map::NodeObject>* objects_by_min,
+                std::vector<compiled_map::NodeObject>* objects_by_max) const;
+
+  MapFingerprint fingerprint_;
+  std::vector<compiled_map::Lane> lanes_;
+  std::vector<compiled_map::Segment> segments_;
+  std::string strings_;
+};
+
+/**
+ * @class CompiledMap
+ * @brief Read only view of a memory mapped compiled map file.
+ */
+class CompiledMap {
+ public:
+  CompiledMap() = default;
+  ~CompiledMap();
+
+  bool Load(const std::string& filename);
+
+  uint64_t fingerprint() const { return header_->fingerprint; }
+
+  size_t num_lanes() const { return Count(compiled_map::kLanes); }
+  const compiled_map::Lane& lane(size_t index) const { return lanes_[index]; }
+  std::string lane_id(size_t index) const;
+
+  size_t num_segments() const { return Count(compiled_map::kSegments); }
+  const compiled_map::Segment& segment(size_t index) const {
+    return segments_[index];
+  }
+  double DistanceSquareToSegment(const apollo::common::math::Vec2d& point,
+                                 size_t index) const;
+
+  /**
+   * @brief Gets the segments within distance of the point, like
+   * AABoxKDTree2d::GetObjects() over the lane segment boxes.
+   */
+  void GetSegments(const apollo::common::math::Vec2d& point, double distance,
+                   std::vector<uint32_t>* segments) const;
+
+  /**
+   * @brief Gets the segment nearest to the point, -1 if there is none.
+   */
+  int GetNearestSegment(const apollo::common::math::Vec2d& point) const;
+
+ private:
+  CompiledMap(const CompiledMap&) = delete;
+  CompiledMap& operator=(const CompiledMap&) = delete;
+
+  size_t Count(compiled_map::Section section) const {
+    return static_cast<size_t>(header_->sections[section].count);
+  }
+  void Unmap();
+  void GetSegmentsInternal(int node_index,
+                           const apollo::common::math::Vec2d& point,
+                           double distance, double distance_sqr,
+                           std::vector<uint32_t>* segments) const;
+  void GetAllSegments(int node_index, std::vector<uint32_t>* segments) const;
+  void GetNearestSegmentInternal(int node_index,
+                                 const apollo::common::math::Vec2d& point,
+                                 double* min_distance_sqr,
+                                 int* nearest_segment) const;
+
+  void* data_ = nullptr;
+  size_t size_ = 0;
+  const compiled_map::FileHeader* header_ = nullptr;
+  const compiled_map::Lane* lanes_ = nullptr;
+  const compiled_map::Segment* segments_ = nullptr;
+  const compiled_map::Node* nodes_ = nullptr;
+  const compiled_map::NodeObject* objects_by_min_ = nullptr;
+  const compiled_map::NodeObject* objects_by_max_ = nullptr;
+  const char* strings_ = nullptr;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/compiled_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/line_segment2d.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+class CompiledMapTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    filename_ = ::testing::TempDir() + "compiled_map_test.compiled";
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> position(-200.0, 200.0);
+    std::uniform_real_distribution<double> step(0.5, 4.0);
+    std::uniform_real_distribution<double> turn(-0.2, 0.2);
+    for (int i = 0; i < 60; ++i) {
+      std::vector<Vec2d> points;
+      Vec2d point(position(random), position(random));
+      double heading = turn(random) * 15.0;
+      const int num_points = 2 + static_cast<int>(random() % 40);
+      for (int j = 0; j < num_points; ++j) {
+        points.push_back(point);
+        heading += turn(random);
+        point += Vec2d::CreateUnitVec2d(heading) * step(random);
+      }
+      ids_.push_back("lane_" + std::to_string(i));
+      lanes_.push_back(points);
+      for (int j = 0; j + 1 < num_points; ++j) {
+        segments_.emplace_back(points[j], points[j + 1]);
+      }
+    }
+  }
+
+  void TearDown() override { std::remove(filename_.c_str()); }
+
+  bool Compile() {
+    CompiledMapBuilder builder;
+    for (size_t i = 0; i < lanes_.size(); ++i) {
+      if (!builder.AddLane(ids_[i], lanes_[i])) {
+        return false;
+      }
+    }
+    return builder.Write(filename_);
+  }
+
+ protected:
+  std::string filename_;
+  std::vector<std::string> ids_;
+  std::vector<std::vector<Vec2d>> lanes_;
+  // All lane segments, in compiled order.
+  std::vector<LineSegment2d> segments_;
+};
+
+TEST_F(CompiledMapTest, LanesAndSegments) {
+  ASSERT_TRUE(Compile());
+  CompiledMap map;
+  ASSERT_TRUE(map.Load(filename_));
+
+  MapFingerprint fingerprint;
+  for (size_t i = 0; i < lanes_.size(); ++i) {
+    fingerprint.AddLane(ids_[i], lanes_[i]);
+  }
+  EXPECT_EQ(fingerprint.value(), map.fingerprint());
+
+  ASSERT_EQ(lanes_.size(), map.num_lanes());
+  ASSERT_EQ(segments_.size(), map.num_segments());
+  for (size_t i = 0; i < lanes_.size(); ++i) {
+    EXPECT_EQ(ids_[i], map.lane_id(i));
+    const auto& lane = map.lane(i);
+    ASSERT_EQ(lanes_[i].size() - 1, lane.num_segments);
+    for (size_t j = 0; j < lane.num_segments; ++j) {
+      const LineSegment2d segment(lanes_[i][j], lanes_[i][j + 1]);
+      const auto& compiled = map.segment(lane.first_segment + j);
+      EXPECT_DOUBLE_EQ(lanes_[i][j].x(), compiled.start_x);
+      EXPECT_DOUBLE_EQ(lanes_[i][j].y(), compiled.start_y);
+      EXPECT_DOUBLE_EQ(lanes_[i][j + 1].x(), compiled.end_x);
+      EXPECT_DOUBLE_EQ(lanes_[i][j + 1].y(), compiled.end_y);
+      EXPECT_NEAR(segment.length(), compiled.length, 1e-12);
+      EXPECT_EQ(i, compiled.lane);
+      EXPECT_EQ(j, compiled.index);
+    }
+  }
+}
+
+TEST_F(CompiledMapTest, Queries) {
+  ASSERT_TRUE(Compile());
+  CompiledMap map;
+  ASSERT_TRUE(map.Load(filename_));
+
+  std::mt19937 random(11);
+  std::uniform_real_distribution<double> position(-250.0, 250.0);
+  std::vector<uint32_t> segments;
+  for (int i = 0; i < 500; ++i) {
+    const Vec2d point(position(random), position(random));
+    const double distance = 0.5 + static_cast<double>(i % 20);
+
+    std::vector<uint32_t> expected;
+    double min_distance = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < segments_.size(); ++j) {
+      const double d = segments_[j].DistanceTo(point);
+      if (d <= distance) {
+        expected.push_back(static_cast<uint32_t>(j));
+      }
+      min_distance = std::min(min_distance, d);
+    }
+    map.GetSegments(point, distance, &segments);
+    std::sort(segments.begin(), segments.end());
+    EXPECT_EQ(expected, segments);
+
+    const int nearest = map.GetNearestSegment(point);
+    ASSERT_GE(nearest, 0);
+    EXPECT_NEAR(min_distance, segments_[nearest].DistanceTo(point), 1e-9);
+  }
+}
+
+TEST_F(CompiledMapTest, RejectsInvalidFiles) {
+  CompiledMap map;
+  EXPECT_FALSE(map.Load(filename_));
+
+  ASSERT_TRUE(Compile());
+  std::string data;
+  {
+    std::ifstream in(filename_, std::ios::binary);
+    data.assign(std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(filename_, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), data.size() / 2);
+  }
+  EXPECT_FALSE(map.Load(filename_));
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "modules/map/hdmap/hdmap.h"
 
+#include "cyber/common/file.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
@@ -22,126 +23,225 @@ namespace hdmap {
 
 int HDMap::LoadMapFromFile(const std::string& map_filename) {
   AINFO << "Loading HDMap: " << map_filename << " ...";
+  tiled_map_.reset();
   return impl_.LoadMapFromFile(map_filename);
 }
 
+int HDMap::LoadTiledMapFromFile(const std::string& map_filename) {
+  const std::string tile_directory = TiledMapDirectory(map_filename);
+  if (!cyber::common::DirectoryExists(tile_directory)) {
+    AWARN << "No tile directory " << tile_directory
+          << ", loading the whole map instead.";
+    return LoadMapFromFile(map_filename);
+  }
+  AINFO << "Loading HDMap tile by tile: " << tile_directory << " ...";
+  tiled_map_.reset(new TiledMap());
+  if (tiled_map_->Load(tile_directory)) {
+    return 0;
+  }
+  AWARN << "Failed to load tiled map " << tile_directory
+        << ", loading the whole map instead.";
+  return LoadMapFromFile(map_filename);
+}
+
 int HDMap::LoadMapFromProto(const Map& map_proto) {
   ADEBUG << "Loading HDMap with header: "
          << map_proto.header().ShortDebugString();
+  tiled_map_.reset();
   return impl_.LoadMapFromProto(map_proto);
 }
 
+void HDMap::UpdateEgoPose(const apollo::common::PointENU& position,
+                          double heading) {
+  if (tiled_map_ != nullptr) {
+    tiled_map_->UpdateEgoPose(position, heading);
+  }
+}
+
 LaneInfoConstPtr HDMap::GetLaneById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetLaneById(id);
+  }
   return impl_.GetLaneById(id);
 }
 
 JunctionInfoConstPtr HDMap::GetJunctionById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetJunctionById(id);
+  }
   return impl_.GetJunctionById(id);
 }
 
 SignalInfoConstPtr HDMap::GetSignalById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetSignalById(id);
+  }
   return impl_.GetSignalById(id);
 }
 
 CrosswalkInfoConstPtr HDMap::GetCrosswalkById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetCrosswalkById(id);
+  }
   return impl_.GetCrosswalkById(id);
 }
 
 StopSignInfoConstPtr HDMap::GetStopSignById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetStopSignById(id);
+  }
   return impl_.GetStopSignById(id);
 }
 
 YieldSignInfoConstPtr HDMap::GetYieldSignById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetYieldSignById(id);
+  }
   return impl_.GetYieldSignById(id);
 }
 
 ClearAreaInfoConstPtr HDMap::GetClearAreaById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetClearAreaById(id);
+  }
   return impl_.GetClearAreaById(id);
 }
 
 SpeedBumpInfoConstPtr HDMap::GetSpeedBumpById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetSpeedBumpById(id);
+  }
   return impl_.GetSpeedBumpById(id);
 }
 
 OverlapInfoConstPtr HDMap::GetOverlapById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetOverlapById(id);
+  }
   return impl_.GetOverlapById(id);
 }
 
 RoadInfoConstPtr HDMap::GetRoadById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetRoadById(id);
+  }
   return impl_.GetRoadById(id);
 }
 
 ParkingSpaceInfoConstPtr HDMap::GetParkingSpaceById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetParkingSpaceById(id);
+  }
   return impl_.GetParkingSpaceById(id);
 }
 
 PNCJunctionInfoConstPtr HDMap::GetPNCJunctionById(const Id& id) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetPNCJunctionById(id);
+  }
   return impl_.GetPNCJunctionById(id);
 }
 
 int HDMap::GetLanes(const apollo::common::PointENU& point, double distance,
                     std::vector<LaneInfoConstPtr>* lanes) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetLanes(point, distance, lanes);
+  }
   return impl_.GetLanes(point, distance, lanes);
 }
 
 int HDMap::GetJunctions(const apollo::common::PointENU& point, double distance,
                         std::vector<JunctionInfoConstPtr>* junctions) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetJunctions(point, distance, junctions);
+  }
   return impl_.GetJunctions(point, distance, junctions);
 }
 
 int HDMap::GetSignals(const apollo::common::PointENU& point, double distance,
                       std::vector<SignalInfoConstPtr>* signals) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetSignals(point, distance, signals);
+  }
   return impl_.GetSignals(point, distance, signals);
 }
 
 int HDMap::GetCrosswalks(const apollo::common::PointENU& point, double distance,
                          std::vector<CrosswalkInfoConstPtr>* crosswalks) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetCrosswalks(point, distance, crosswalks);
+  }
   return impl_.GetCrosswalks(point, distance, crosswalks);
 }
 
 int HDMap::GetStopSigns(const apollo::common::PointENU& point, double distance,
                         std::vector<StopSignInfoConstPtr>* stop_signs) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetStopSigns(point, distance, stop_signs);
+  }
   return impl_.GetStopSigns(point, distance, stop_signs);
 }
 
 int HDMap::GetYieldSigns(
     const apollo::common::PointENU& point, double distance,
     std::vector<YieldSignInfoConstPtr>* yield_signs) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetYieldSigns(point, distance, yield_signs);
+  }
   return impl_.GetYieldSigns(point, distance, yield_signs);
 }
 
 int HDMap::GetClearAreas(
     const apollo::common::PointENU& point, double distance,
     std::vector<ClearAreaInfoConstPtr>* clear_areas) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetClearAreas(point, distance, clear_areas);
+  }
   return impl_.GetClearAreas(point, distance, clear_areas);
 }
 
 int HDMap::GetSpeedBumps(
     const apollo::common::PointENU& point, double distance,
     std::vector<SpeedBumpInfoConstPtr>* speed_bumps) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetSpeedBumps(point, distance, speed_bumps);
+  }
   return impl_.GetSpeedBumps(point, distance, speed_bumps);
 }
 
 int HDMap::GetRoads(const apollo::common::PointENU& point, double distance,
                     std::vector<RoadInfoConstPtr>* roads) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetRoads(point, distance, roads);
+  }
   return impl_.GetRoads(point, distance, roads);
 }
 
 int HDMap::GetParkingSpaces(
     const apollo::common::PointENU& point, double distance,
     std::vector<ParkingSpaceInfoConstPtr>* parking_spaces) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetParkingSpaces(point, distance, parking_spaces);
+  }
   return impl_.GetParkingSpaces(point, distance, parking_spaces);
 }
 
 int HDMap::GetPNCJunctions(
     const apollo::common::PointENU& point, double distance,
     std::vector<PNCJunctionInfoConstPtr>* pnc_junctions) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetPNCJunctions(point, distance, pnc_junctions);
+  }
   return impl_.GetPNCJunctions(point, distance, pnc_junctions);
 }
 
 int HDMap::GetNearestLane(const common::PointENU& point,
                           LaneInfoConstPtr* nearest_lane, double* nearest_s,
                           double* nearest_l) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetNearestLane(point, nearest_lane, nearest_s,
+                                      nearest_l);
+  }
   return impl_.GetNearestLane(point, nearest_lane, nearest_s, nearest_l);
 }
 
@@ -152,9 +252,14 @@ int HDMap::GetNearestLaneWithHeading(const apollo::common::PointENU& point,
                                      LaneInfoConstPtr* nearest_lane,
                                      double* nearest_s,
                                      double* nearest_l) const {
-  return impl_.GetNearestLaneWithHeading(point, distance, central_heading,
-                                         max_heading_difference, nearest_lane,
-                                         nearest_s, nearest_l);
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetNearestLaneWithHeading(
+        point, distance, central_heading, max_heading_difference, nearest_lane,
+        nearest_s, nearest_l);
+  }
+  return impl_.GetNearestLaneWithHeading(
+      point, distance, central_heading, max_heading_difference, nearest_lane,
+      nearest_s, nearest_l);
 }
 
 int HDMap::GetLanesWithHeading(const apollo::common::PointENU& point,
@@ -162,6 +267,10 @@ int HDMap::GetLanesWithHeading(const apollo::common::PointENU& point,
                                const double central_heading,
                                const double max_heading_difference,
                                std::vector<LaneInfoConstPtr>* lanes) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetLanesWithHeading(
+        point, distance, central_heading, max_heading_difference, lanes);
+  }
   return impl_.GetLanesWithHeading(point, distance, central_heading,
                                    max_heading_difference, lanes);
 }
@@ -170,6 +279,10 @@ int HDMap::GetRoadBoundaries(
     const apollo::common::PointENU& point, double radius,
     std::vector<RoadROIBoundaryPtr>* road_boundaries,
     std::vector<JunctionBoundaryPtr>* junctions) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetRoadBoundaries(
+        point, radius, road_boundaries, junctions);
+  }
   return impl_.GetRoadBoundaries(point, radius, road_boundaries, junctions);
 }
 
@@ -177,34 +290,53 @@ int HDMap::GetRoadBoundaries(
     const apollo::common::PointENU& point, double radius,
     std::vector<RoadRoiPtr>* road_boundaries,
     std::vector<JunctionInfoConstPtr>* junctions) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetRoadBoundaries(
+        point, radius, road_boundaries, junctions);
+  }
   return impl_.GetRoadBoundaries(point, radius, road_boundaries, junctions);
 }
 
 int HDMap::GetRoi(const apollo::common::PointENU& point, double radius,
                   std::vector<RoadRoiPtr>* roads_roi,
                   std::vector<PolygonRoiPtr>* polygons_roi) {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetRoi(point, radius, roads_roi, polygons_roi);
+  }
   return impl_.GetRoi(point, radius, roads_roi, polygons_roi);
 }
 
 int HDMap::GetForwardNearestSignalsOnLane(
     const apollo::common::PointENU& point, const double distance,
     std::vector<SignalInfoConstPtr>* signals) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetForwardNearestSignalsOnLane(point, distance, signals);
+  }
   return impl_.GetForwardNearestSignalsOnLane(point, distance, signals);
 }
 
 int HDMap::GetStopSignAssociatedStopSigns(
     const Id& id, std::vector<StopSignInfoConstPtr>* stop_signs) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetStopSignAssociatedStopSigns(id, stop_signs);
+  }
   return impl_.GetStopSignAssociatedStopSigns(id, stop_signs);
 }
 
 int HDMap::GetStopSignAssociatedLanes(
     const Id& id, std::vector<LaneInfoConstPtr>* lanes) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetStopSignAssociatedLanes(id, lanes);
+  }
   return impl_.GetStopSignAssociatedLanes(id, lanes);
 }
 
 int HDMap::GetLocalMap(const apollo::common::PointENU& point,
                        const std::pair<double, double>& range,
                        Map* local_map) const {
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetLocalMap(point, range, local_map);
+  }
   return impl_.GetLocalMap(point, range, local_map);
 }
 
@@ -212,9 +344,12 @@ int HDMap::GetForwardNearestRSUs(const apollo::common::PointENU& point,
                     double distance, double central_heading,
                     double max_heading_difference,
                     std::vector<RSUInfoConstPtr>* rsus) const {
-  return impl_.GetForwardNearestRSUs(point, distance,
-                    central_heading,
-                    max_heading_difference, rsus);
+  if (tiled_map_ != nullptr) {
+    return tiled_map_->GetForwardNearestRSUs(
+        point, distance, central_heading, max_heading_difference, rsus);
+  }
+  return impl_.GetForwardNearestRSUs(point, distance, central_heading,
+                                     max_heading_difference, rsus);
 }
 
 }  // namespace hdmap
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,6 +38,7 @@
 
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/map/hdmap/hdmap_impl.h"
+#include "modules/map/hdmap/tiled_map.h"
 
 /**
  * @namespace apollo::hdmap
@@ -53,12 +55,22 @@ namespace hdmap {
 class HDMap {
  public:
   /**
-   * @brief load map from local file
+   * @brief load map from local file.
    * @param map_filename path of map data file
    * @return 0:success, otherwise failed
    */
   int LoadMapFromFile(const std::string& map_filename);
 
+  /**
+   * @brief load map tile by tile from the tile directory of a local file,
+   * or the whole file if there is none. Only the tiles around the pose
+   * given to UpdateEgoPose() are then loaded, so that the map is empty until
+   * it is first called, and queries far from that pose find nothing.
+   * @param map_filename path of map data file
+   * @return 0:success, otherwise failed
+   */
+  int LoadTiledMapFromFile(const std::string& map_filename);
+
   /**
    * @brief load map from a given protobuf message.
    * @param map_proto map data in protobuf format
@@ -66,6 +78,15 @@ class HDMap {
    */
   int LoadMapFromProto(const Map& map_proto);
 
+  /**
+   * @brief load the tiles of a tiled map around the ego pose, in the
+   * background. Does nothing if the map is not tiled.
+   * @param position the ego position
+   * @param heading the ego heading
+   */
+  void UpdateEgoPose(const apollo::common::PointENU& position,
+                     double heading);
+
   LaneInfoConstPtr GetLaneById(const Id& id) const;
   JunctionInfoConstPtr GetJunctionById(const Id& id) const;
   SignalInfoConstPtr GetSignalById(const Id& id) const;
@@ -314,6 +335,8 @@ class HDMap {
 
  private:
   HDMapImpl impl_;
+  // Set when the map is loaded tile by tile, and answers all queries then.
+  std::unique_ptr<TiledMap> tiled_map_;
 };
 
 }  // namespace hdmap
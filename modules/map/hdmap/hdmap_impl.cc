@@ -23,6 +23,7 @@ limitations under the License.
 
 #include "absl/strings/match.h"
 #include "cyber/common/file.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 
@@ -59,6 +60,15 @@ int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
     return -1;
   }
 
+  if (FLAGS_use_compiled_map) {
+    const std::string compiled_map_filename = CompiledMapFilename(map_filename);
+    if (cyber::common::PathExists(compiled_map_filename)) {
+      compiled_map_.reset(new CompiledMap());
+      if (!compiled_map_->Load(compiled_map_filename)) {
+        compiled_map_.reset();
+      }
+    }
+  }
   return LoadMapFromProto(map_);
 }
 
@@ -139,7 +149,9 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
   for (const auto& stop_sign_ptr_pair : stop_sign_table_) {
     stop_sign_ptr_pair.second->PostProcess(*this);
   }
-  BuildLaneSegmentKDTree();
+  if (!UseCompiledLaneIndex()) {
+    BuildLaneSegmentKDTree();
+  }
   BuildJunctionPolygonKDTree();
   BuildSignalSegmentKDTree();
   BuildCrosswalkPolygonKDTree();
@@ -223,7 +235,29 @@ int HDMapImpl::GetLanes(const PointENU& point, double distance,
 
 int HDMapImpl::GetLanes(const Vec2d& point, double distance,
                         std::vector<LaneInfoConstPtr>* lanes) const {
-  if (lanes == nullptr || lane_segment_kdtree_ == nullptr) {
+  if (lanes == nullptr) {
+    return -1;
+  }
+  if (compiled_map_ != nullptr) {
+    lanes->clear();
+    std::vector<uint32_t> segments;
+    compiled_map_->GetSegments(point, distance, &segments);
+    std::vector<uint32_t> lane_indices;
+    lane_indices.reserve(segments.size());
+    for (const uint32_t segment : segments) {
+      lane_indices.push_back(compiled_map_->segment(segment).lane);
+    }
+    // In compiled order, which is the map order, so that callers taking the
+    // first of several lanes, as routing does, always get the same one.
+    std::sort(lane_indices.begin(), lane_indices.end());
+    lane_indices.erase(std::unique(lane_indices.begin(), lane_indices.end()),
+                       lane_indices.end());
+    for (const uint32_t lane_index : lane_indices) {
+      lanes->push_back(compiled_lanes_[lane_index]);
+    }
+    return 0;
+  }
+  if (lane_segment_kdtree_ == nullptr) {
     return -1;
   }
   lanes->clear();
@@ -509,14 +543,25 @@ int HDMapImpl::GetNearestLane(const Vec2d& point,
   CHECK_NOTNULL(nearest_lane);
   CHECK_NOTNULL(nearest_s);
   CHECK_NOTNULL(nearest_l);
-  const auto* segment_object = lane_segment_kdtree_->GetNearestObject(point);
-  if (segment_object == nullptr) {
-    return -1;
+  int id = -1;
+  if (compiled_map_ != nullptr) {
+    const int segment_index = compiled_map_->GetNearestSegment(point);
+    if (segment_index < 0) {
+      return -1;
+    }
+    const auto& compiled_segment = compiled_map_->segment(segment_index);
+    *nearest_lane = compiled_lanes_[compiled_segment.lane];
+    id = static_cast<int>(compiled_segment.index);
+  } else {
+    const auto* segment_object = lane_segment_kdtree_->GetNearestObject(point);
+    if (segment_object == nullptr) {
+      return -1;
+    }
+    const Id& lane_id = segment_object->object()->id();
+    *nearest_lane = GetLaneById(lane_id);
+    ACHECK(*nearest_lane);
+    id = segment_object->id();
   }
-  const Id& lane_id = segment_object->object()->id();
-  *nearest_lane = GetLaneById(lane_id);
-  ACHECK(*nearest_lane);
-  const int id = segment_object->id();
   const auto& segment = (*nearest_lane)->segments()[id];
   Vec2d nearest_pt;
   segment.DistanceTo(point, &nearest_pt);
@@ -1305,6 +1350,30 @@ int HDMapImpl::GetForwardNearestRSUs(const apollo::common::PointENU& point,
   return 0;
 }
 
+bool HDMapImpl::UseCompiledLaneIndex() {
+  if (compiled_map_ == nullptr) {
+    return false;
+  }
+  // Lanes are compiled in map order, see compiled_map_generator.
+  MapFingerprint fingerprint;
+  compiled_lanes_.clear();
+  compiled_lanes_.reserve(map_.lane_size());
+  for (const auto& lane : map_.lane()) {
+    const auto& lane_info = lane_table_.at(lane.id().id());
+    fingerprint.AddLane(lane.id().id(), lane_info->points());
+    compiled_lanes_.push_back(lane_info);
+  }
+  if (compiled_map_->num_lanes() != compiled_lanes_.size() ||
+      compiled_map_->fingerprint() != fingerprint.value()) {
+    AWARN << "Compiled map does not match the map, building the lane index.";
+    compiled_map_.reset();
+    compiled_lanes_.clear();
+    return false;
+  }
+  AINFO << "Using the lane index of the compiled map.";
+  return true;
+}
+
 template <class Table, class BoxTable, class KDTree>
 void HDMapImpl::BuildSegmentKDTree(const Table& table,
                                    const AABoxKDTreeParams& params,
@@ -1451,6 +1520,8 @@ void HDMapImpl::Clear() {
   rsu_table_.clear();
   lane_segment_boxes_.clear();
   lane_segment_kdtree_.reset(nullptr);
+  compiled_map_.reset();
+  compiled_lanes_.clear();
   junction_polygon_boxes_.clear();
   junction_polygon_kdtree_.reset(nullptr);
   crosswalk_polygon_boxes_.clear();
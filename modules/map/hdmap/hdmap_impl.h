@@ -26,6 +26,7 @@ limitations under the License.
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/polygon2d.h"
 #include "modules/common/math/vec2d.h"
+#include "modules/map/hdmap/compiled_map.h"
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/map/proto/map.pb.h"
 #include "modules/map/proto/map_clear_area.pb.h"
@@ -394,6 +395,12 @@ class HDMapImpl {
       BoxTable* const box_table, std::unique_ptr<KDTree>* const kdtree);
 
   void BuildLaneSegmentKDTree();
+  /**
+   * @brief Uses the lane index of the compiled map mapped by LoadMapFromFile()
+   * if it was compiled from the loaded lanes.
+   * @return true if the compiled lane index is used.
+   */
+  bool UseCompiledLaneIndex();
   void BuildJunctionPolygonKDTree();
   void BuildCrosswalkPolygonKDTree();
   void BuildSignalSegmentKDTree();
@@ -430,6 +437,11 @@ class HDMapImpl {
   std::vector<LaneSegmentBox> lane_segment_boxes_;
   std::unique_ptr<LaneSegmentKDTree> lane_segment_kdtree_;
 
+  // Lane index of the compiled map, used instead of lane_segment_kdtree_ when
+  // set. compiled_lanes_ holds the lanes in compiled order.
+  std::unique_ptr<CompiledMap> compiled_map_;
+  std::vector<LaneInfoConstPtr> compiled_lanes_;
+
   std::vector<JunctionPolygonBox> junction_polygon_boxes_;
   std::unique_ptr<JunctionPolygonKDTree> junction_polygon_kdtree_;
 
@@ -15,6 +15,7 @@ limitations under the License.
 #include "modules/map/hdmap/hdmap_util.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_split.h"
@@ -90,8 +91,10 @@ std::unique_ptr<HDMap> CreateMap(const MapMsg& map_msg) {
 }
 
 std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
+std::atomic<HDMap*> HDMapUtil::base_map_ptr_(nullptr);
 uint64_t HDMapUtil::base_map_seq_ = 0;
 std::mutex HDMapUtil::base_map_mutex_;
+std::atomic<bool> HDMapUtil::tiled_base_map_enabled_(false);
 
 std::unique_ptr<HDMap> HDMapUtil::sim_map_ = nullptr;
 std::mutex HDMapUtil::sim_map_mutex_;
@@ -103,7 +106,7 @@ const HDMap* HDMapUtil::BaseMapPtr(const MapMsg& map_msg) {
     // avoid re-create map in the same cycle.
     return base_map_.get();
   } else {
-    base_map_ = CreateMap(map_msg);
+    SetBaseMap(CreateMap(map_msg));
     base_map_seq_ = map_msg.header().sequence_num();
   }
   return base_map_.get();
@@ -132,25 +135,69 @@ const HDMap* HDMapUtil::BaseMapPtr() {
       base_map_seq_ = latest.header().sequence_num();
     }
   } else*/
+  // Only locked until the map is loaded: with components initialized in
+  // parallel, several threads may ask for the map while it is being loaded.
+  HDMap* base_map = base_map_ptr_.load(std::memory_order_acquire);
+  if (base_map != nullptr) {
+    return base_map;
+  }
+  std::lock_guard<std::mutex> lock(base_map_mutex_);
   if (base_map_ == nullptr) {
-    std::lock_guard<std::mutex> lock(base_map_mutex_);
-    if (base_map_ == nullptr) {  // Double check.
-      base_map_ = CreateMap(BaseMapFile());
-    }
+    SetBaseMap(CreateBaseMap());
   }
   return base_map_.get();
 }
 
+void HDMapUtil::SetBaseMap(std::unique_ptr<HDMap> base_map) {
+  base_map_ = std::move(base_map);
+  base_map_ptr_.store(base_map_.get(), std::memory_order_release);
+}
+
+std::unique_ptr<HDMap> HDMapUtil::CreateBaseMap() {
+  const std::string map_file = BaseMapFile();
+  if (!FLAGS_use_tiled_map) {
+    return CreateMap(map_file);
+  }
+  if (!tiled_base_map_enabled_) {
+    AWARN << "No module of the process drives the ego pose, which the tiled "
+             "map needs, loading the whole base map.";
+    return CreateMap(map_file);
+  }
+  std::unique_ptr<HDMap> hdmap(new HDMap());
+  if (hdmap->LoadTiledMapFromFile(map_file) != 0) {
+    AERROR << "Failed to load HDMap " << map_file;
+    return nullptr;
+  }
+  AINFO << "Load HDMap success: " << map_file;
+  return hdmap;
+}
+
+void HDMapUtil::EnableTiledBaseMap() {
+  tiled_base_map_enabled_ = true;
+  std::lock_guard<std::mutex> lock(base_map_mutex_);
+  if (FLAGS_use_tiled_map && base_map_ != nullptr) {
+    AWARN << "The base map is already loaded as a whole.";
+  }
+}
+
 const HDMap& HDMapUtil::BaseMap() { return *CHECK_NOTNULL(BaseMapPtr()); }
 
+void HDMapUtil::UpdateBaseMapEgoPose(const common::PointENU& position,
+                                     double heading) {
+  // Not locked, since the tiled map may wait there for its pending tiles.
+  HDMap* base_map = base_map_ptr_.load(std::memory_order_acquire);
+  if (base_map != nullptr) {
+    base_map->UpdateEgoPose(position, heading);
+  }
+}
+
 const HDMap* HDMapUtil::SimMapPtr() {
   if (FLAGS_use_navigation_mode) {
     return BaseMapPtr();
-  } else if (sim_map_ == nullptr) {
-    std::lock_guard<std::mutex> lock(sim_map_mutex_);
-    if (sim_map_ == nullptr) {  // Double check.
-      sim_map_ = CreateMap(SimMapFile());
-    }
+  }
+  std::lock_guard<std::mutex> lock(sim_map_mutex_);
+  if (sim_map_ == nullptr) {
+    sim_map_ = CreateMap(SimMapFile());
   }
   return sim_map_.get();
 }
@@ -160,7 +207,7 @@ const HDMap& HDMapUtil::SimMap() { return *CHECK_NOTNULL(SimMapPtr()); }
 bool HDMapUtil::ReloadMaps() {
   {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
-    base_map_ = CreateMap(BaseMapFile());
+    SetBaseMap(CreateBaseMap());
   }
   {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
@@ -15,7 +15,9 @@ limitations under the License.
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "absl/strings/str_cat.h"
@@ -82,6 +84,14 @@ class HDMapUtil {
   static const HDMap* BaseMapPtr(const relative_map::MapMsg& map_msg);
   // Guarantee to return a valid base_map, or else raise fatal error.
   static const HDMap& BaseMap();
+  // Load the tiles of the base map around the ego pose, if it is tiled.
+  static void UpdateBaseMapEgoPose(const common::PointENU& position,
+                                   double heading);
+  // Let the base map be loaded tile by tile, if FLAGS_use_tiled_map is set,
+  // for a module calling UpdateBaseMapEgoPose() on every localization. To be
+  // called before the base map is first loaded; without it, the whole base
+  // map is loaded.
+  static void EnableTiledBaseMap();
 
   // Get default sim_map from the file specified by global flags.
   // Return nullptr if failed to load.
@@ -96,9 +106,17 @@ class HDMapUtil {
  private:
   HDMapUtil() = delete;
 
+  static std::unique_ptr<HDMap> CreateBaseMap();
+
+  // Sets base_map_, to be called with base_map_mutex_ held.
+  static void SetBaseMap(std::unique_ptr<HDMap> base_map);
+
   static std::unique_ptr<HDMap> base_map_;
+  // base_map_.get(), read without the lock once the map is loaded.
+  static std::atomic<HDMap*> base_map_ptr_;
   static uint64_t base_map_seq_;
   static std::mutex base_map_mutex_;
+  static std::atomic<bool> tiled_base_map_enabled_;
 
   static std::unique_ptr<HDMap> sim_map_;
   static std::mutex sim_map_mutex_;
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/map_raster_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+// Tiles are few and slow to render, so that lookups hardly ever contend, but
+// an area spans many tiles, which a shard too small could not hold at once.
+constexpr size_t kNumShards = 4;
+
+// Rounds toward negative infinity, unlike the division of integers.
+int FloorDiv(const int a, const int b) {
+  return a / b - (a % b != 0 && (a < 0) != (b < 0) ? 1 : 0);
+}
+
+}  // namespace
+
+MapRasterCache::MapRasterCache(const double resolution, const int num_levels,
+                               const int tile_size, const size_t capacity,
+                               const int image_type, TileRenderer renderer)
+    : resolution_(resolution),
+      num_levels_(num_levels),
+      tile_size_(tile_size),
+      image_type_(image_type),
+      renderer_(std::move(renderer)),
+      tiles_(capacity, kNumShards) {
+  CHECK_GT(resolution_, 0.0);
+  CHECK_GT(num_levels_, 0);
+  CHECK_GT(tile_size_, 0);
+  CHECK(renderer_);
+}
+
+cv::Point2i MapRasterCache::ToPixel(const int level, const double x,
+                                    const double y) const {
+  MapRasterTile grid;
+  grid.resolution = resolution(level);
+  return grid.ToPixel(x, y);
+}
+
+void MapRasterCache::GetArea(const int level, const cv::Point2i& origin,
+                             const cv::Size& size, cv::Mat* img) {
+  CHECK_GE(level, 0);
+  CHECK_LT(level, num_levels_);
+  CHECK_NOTNULL(img);
+  // Every pixel of the area is copied from a tile, so the image needs no
+  // clearing.
+  img->create(size, image_type_);
+  const int first_col = FloorDiv(origin.x, tile_size_);
+  const int last_col = FloorDiv(origin.x + size.width - 1, tile_size_);
+  const int first_row = FloorDiv(origin.y, tile_size_);
+  const int last_row = FloorDiv(origin.y + size.height - 1, tile_size_);
+  for (int row = first_row; row <= last_row; ++row) {
+    const int tile_top = row * tile_size_;
+    const int top = std::max(origin.y, tile_top);
+    const int bottom = std::min(origin.y + size.height, tile_top + tile_size_);
+    for (int col = first_col; col <= last_col; ++col) {
+      const int tile_left = col * tile_size_;
+      const int left = std::max(origin.x, tile_left);
+      const int right = std::min(origin.x + size.width, tile_left + tile_size_);
+      const cv::Mat tile = GetTile({level, col, row});
+      tile(cv::Rect(left - tile_left, top - tile_top, right - left,
+                    bottom - top))
+          .copyTo((*img)(cv::Rect(left - origin.x, top - origin.y,
+                                  right - left, bottom - top)));
+    }
+  }
+}
+
+cv::Mat MapRasterCache::GetTile(const TileKey& key) {
+  return tiles_.GetOrCompute(key, [this, &key]() {
+    MapRasterTile tile;
+    tile.resolution = resolution(key.level);
+    tile.origin = cv::Point2i(key.col * tile_size_, key.row * tile_size_);
+    tile.size = cv::Size(tile_size_, tile_size_);
+    cv::Mat img(tile.size, image_type_, cv::Scalar::all(0));
+    renderer_(tile, &img);
+    return img;
+  });
+}
+
+}  // namespace hdmap
+}  // namespace apollo
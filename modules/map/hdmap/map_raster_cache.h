@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A cache of raster images of the static map layers, split into tiles
+ * at several resolutions.
+ *
+ * Rasters are laid on a global pixel grid per level: the pixel at column c
+ * and row r covers x in [c * resolution, (c + 1) * resolution) and y in
+ * (-(r + 1) * resolution, -r * resolution], so that rows grow southward as in
+ * images. Tiles are the squares of tile_size pixels of that grid, rendered on
+ * first use by a callback and kept in an LRU cache. Since tiles sit on the
+ * grid, an area composed of tiles is the same image as the area rendered at
+ * once, as long as the renderer draws on the grid, with points placed by
+ * MapRasterTile::ToPixel().
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+#include "opencv2/opencv.hpp"
+
+#include "modules/common/util/concurrent_lru_cache.h"
+
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @brief The area of a raster on the global pixel grid of its level.
+ */
+struct MapRasterTile {
+  /// the side of a pixel, in meters
+  double resolution = 0.0;
+  /// the global pixel of the top left corner
+  cv::Point2i origin;
+  /// the width and height, in pixels
+  cv::Size size;
+
+  /**
+   * @brief the pixel of a point within the raster, which may lie outside of
+   * it.
+   */
+  cv::Point2i ToPixel(const double x, const double y) const {
+    return cv::Point2i(
+        static_cast<int>(std::floor(x / resolution)) - origin.x,
+        static_cast<int>(std::floor(-y / resolution)) - origin.y);
+  }
+
+  /**
+   * @brief the x of the center of the raster, in meters.
+   */
+  double center_x() const {
+    return (origin.x + 0.5 * size.width) * resolution;
+  }
+
+  /**
+   * @brief the y of the center of the raster, in meters.
+   */
+  double center_y() const {
+    return -(origin.y + 0.5 * size.height) * resolution;
+  }
+
+  /**
+   * @brief the distance from the center to the corners, in meters.
+   */
+  double radius() const {
+    return 0.5 * std::hypot(size.width, size.height) * resolution;
+  }
+};
+
+/**
+ * @class MapRasterCache
+ *
+ * @brief Tiles of the static map layers, rendered once and copied into the
+ * areas asked for.
+ *
+ * Level 0 has the finest resolution, and each level after it halves the
+ * resolution of the one before. The cache may be used from several threads
+ * at once; the renderer is then called from these threads too, without any
+ * lock held. Two threads missing the same tile may both render it.
+ */
+class MapRasterCache {
+ public:
+  /**
+   * @brief draws the static map layers within a tile into its image, which
+   * is black at first.
+   */
+  using TileRenderer =
+      std::function<void(const MapRasterTile& tile, cv::Mat* img)>;
+
+  /**
+   * @brief constructor.
+   * @param resolution the side of a pixel at level 0, in meters
+   * @param num_levels the number of levels
+   * @param tile_size the width and height of the tiles, in pixels
+   * @param capacity the number of tiles kept, over all levels, which should
+   * be a few times the number of tiles of the areas asked for at once
+   * @param image_type the OpenCV type of the images, such as CV_8UC3
+   * @param renderer the callback rendering tiles
+   */
+  MapRasterCache(const double resolution, const int num_levels,
+                 const int tile_size, const size_t capacity,
+                 const int image_type, TileRenderer renderer);
+
+  MapRasterCache(const MapRasterCache&) = delete;
+  MapRasterCache& operator=(const MapRasterCache&) = delete;
+
+  int num_levels() const { return num_levels_; }
+
+  int tile_size() const { return tile_size_; }
+
+  /**
+   * @brief the side of a pixel at a level, in meters.
+   */
+  double resolution(const int level) const {
+    return std::ldexp(resolution_, level);
+  }
+
+  /**
+   * @brief the global pixel of a point at a level.
+   */
+  cv::Point2i ToPixel(const int level, const double x, const double y) const;
+
+  /**
+   * @brief copies an area of the static map layers into an image, from the
+   * tiles it overlaps, rendering the missing ones.
+   * @param level the level of the area
+   * @param origin the global pixel of the top left corner of the area
+   * @param size the width and height of the area, in pixels
+   * @param img the image of the area, reallocated only if its size or type
+   * differs
+   */
+  void GetArea(const int level, const cv::Point2i& origin,
+               const cv::Size& size, cv::Mat* img);
+
+  /**
+   * @brief drops all tiles, e.g. after the map changes.
+   */
+  void Clear() { tiles_.Clear(); }
+
+  size_t num_tiles() const { return tiles_.size(); }
+
+  uint64_t hits() const { return tiles_.hits(); }
+
+  uint64_t misses() const { return tiles_.misses(); }
+
+ private:
+  struct TileKey {
+    int level = 0;
+    int col = 0;
+    int row = 0;
+
+    bool operator==(const TileKey& other) const {
+      return level == other.level && col == other.col && row == other.row;
+    }
+  };
+
+  struct TileKeyHash {
+    size_t operator()(const TileKey& key) const {
+      const uint64_t col = static_cast<uint32_t>(key.col);
+      const uint64_t row = static_cast<uint32_t>(key.row);
+      return std::hash<uint64_t>()(((col << 32) | row) * 31 + key.level);
+    }
+  };
+
+  cv::Mat GetTile(const TileKey& key);
+
+  const double resolution_;
+  const int num_levels_;
+  const int tile_size_;
+  const int image_type_;
+  const TileRenderer renderer_;
+  // Tiles are never written once rendered, so the shallow copies of cv::Mat
+  // handed out by the cache may be read while the tile is evicted.
+  common::util::ConcurrentLRUCache<TileKey, cv::Mat, TileKeyHash> tiles_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/map_raster_cache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+// Draws a polygon and a thick line, both crossing several tiles.
+void RenderLayers(const MapRasterTile& tile, cv::Mat* img) {
+  std::vector<cv::Point> polygon = {tile.ToPixel(-3.0, 4.0),
+                                    tile.ToPixel(5.0, -2.0),
+                                    tile.ToPixel(9.5, 7.2)};
+  cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({polygon}),
+               cv::Scalar(64, 64, 64));
+  cv::line(*img, tile.ToPixel(-10.0, -6.0), tile.ToPixel(12.0, 7.0),
+           cv::Scalar(255, 0, 0), 4);
+}
+
+}  // namespace
+
+TEST(MapRasterCacheTest, ComposedAreaMatchesRendering) {
+  int num_renders = 0;
+  MapRasterCache cache(0.1, 1, 64, 100, CV_8UC3,
+                       [&num_renders](const MapRasterTile& tile,
+                                      cv::Mat* img) {
+                         ++num_renders;
+                         RenderLayers(tile, img);
+                       });
+
+  // An area of 20 m by 15 m, off the tile boundaries.
+  MapRasterTile area;
+  area.resolution = cache.resolution(0);
+  area.origin = cache.ToPixel(0, -9.95, 8.05);
+  area.size = cv::Size(200, 150);
+  EXPECT_EQ(cv::Point2i(-100, -81), area.origin);
+  cv::Mat expected(area.size, CV_8UC3, cv::Scalar::all(0));
+  RenderLayers(area, &expected);
+  EXPECT_GT(cv::countNonZero(expected.reshape(1)), 0);
+
+  cv::Mat img;
+  cache.GetArea(0, area.origin, area.size, &img);
+  EXPECT_EQ(0.0, cv::norm(img, expected, cv::NORM_INF));
+  // Columns -2 to 1 and rows -2 to 1.
+  EXPECT_EQ(16, num_renders);
+  EXPECT_EQ(16, cache.num_tiles());
+
+  // A shifted area reuses the tiles.
+  area.origin += cv::Point2i(10, 5);
+  expected.setTo(cv::Scalar::all(0));
+  RenderLayers(area, &expected);
+  cache.GetArea(0, area.origin, area.size, &img);
+  EXPECT_EQ(0.0, cv::norm(img, expected, cv::NORM_INF));
+  EXPECT_EQ(16, num_renders);
+  EXPECT_EQ(16, cache.hits());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.num_tiles());
+}
+
+TEST(MapRasterCacheTest, Levels) {
+  MapRasterCache cache(0.1, 3, 32, 100, CV_8UC3, RenderLayers);
+  EXPECT_EQ(3, cache.num_levels());
+  EXPECT_DOUBLE_EQ(0.4, cache.resolution(2));
+  EXPECT_EQ(cv::Point2i(25, -10), cache.ToPixel(2, 10.1, 3.9));
+
+  MapRasterTile area;
+  area.resolution = cache.resolution(2);
+  area.origin = cache.ToPixel(2, -12.0, 10.0);
+  area.size = cv::Size(60, 45);
+  cv::Mat expected(area.size, CV_8UC3, cv::Scalar::all(0));
+  RenderLayers(area, &expected);
+  cv::Mat img;
+  cache.GetArea(2, area.origin, area.size, &img);
+  EXPECT_EQ(0.0, cv::norm(img, expected, cv::NORM_INF));
+}
+
+}  // namespace hdmap
+}  // namespace apollo
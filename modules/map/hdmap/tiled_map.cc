@@ -0,0 +1,1295 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/tiled_map.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/common/configs/config_gflags.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::PointENU;
+using apollo::common::math::AABox2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+constexpr char kIndexFilename[] = "index";
+constexpr char kIdIndexFilename[] = "ids";
+
+Id CreateHDMapId(const std::string& string_id) {
+  Id id;
+  id.set_id(string_id);
+  return id;
+}
+
+std::string TileFilename(int x, int y) {
+  return absl::StrCat(x, "_", y, ".bin");
+}
+
+// Written aside and renamed, so that readers never see a partial file.
+bool WriteFileAtomically(const std::string& filename,
+                         const std::string& content) {
+  const std::string tmp_filename = filename + ".tmp";
+  {
+    std::ofstream out(tmp_filename, std::ios::trunc);
+    if (!(out << content)) {
+      AERROR << "Failed to write " << tmp_filename;
+      return false;
+    }
+  }
+  if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    AERROR << "Failed to rename " << tmp_filename << " to " << filename;
+    return false;
+  }
+  return true;
+}
+
+bool IsEmpty(const Map& map) {
+  return map.lane_size() == 0 && map.junction_size() == 0 &&
+         map.crosswalk_size() == 0 && map.signal_size() == 0 &&
+         map.stop_sign_size() == 0 && map.yield_size() == 0 &&
+         map.clear_area_size() == 0 && map.speed_bump_size() == 0 &&
+         map.parking_space_size() == 0 && map.pnc_junction_size() == 0;
+}
+
+/**
+ * Gathers the elements of a tile from the whole map: those within range of
+ * the tile center, the elements these overlap with, and the roads of the
+ * lanes. Every overlap the tile refers to is in the tile.
+ */
+class TileExtractor {
+ public:
+  TileExtractor(const HDMapImpl& map, Map* tile) : map_(map), tile_(tile) {}
+
+  void Extract(const PointENU& center, double radius) {
+    std::vector<LaneInfoConstPtr> lanes;
+    map_.GetLanes(center, radius, &lanes);
+    for (const auto& lane : lanes) {
+      Add(lane->lane(), tile_->mutable_lane());
+    }
+    std::vector<JunctionInfoConstPtr> junctions;
+    map_.GetJunctions(center, radius, &junctions);
+    for (const auto& junction : junctions) {
+      Add(junction->junction(), tile_->mutable_junction());
+    }
+    std::vector<CrosswalkInfoConstPtr> crosswalks;
+    map_.GetCrosswalks(center, radius, &crosswalks);
+    for (const auto& crosswalk : crosswalks) {
+      Add(crosswalk->crosswalk(), tile_->mutable_crosswalk());
+    }
+    std::vector<SignalInfoConstPtr> signals;
+    map_.GetSignals(center, radius, &signals);
+    for (const auto& signal : signals) {
+      Add(signal->signal(), tile_->mutable_signal());
+    }
+    std::vector<StopSignInfoConstPtr> stop_signs;
+    map_.GetStopSigns(center, radius, &stop_signs);
+    for (const auto& stop_sign : stop_signs) {
+      Add(stop_sign->stop_sign(), tile_->mutable_stop_sign());
+    }
+    std::vector<YieldSignInfoConstPtr> yield_signs;
+    map_.GetYieldSigns(center, radius, &yield_signs);
+    for (const auto& yield_sign : yield_signs) {
+      Add(yield_sign->yield_sign(), tile_->mutable_yield());
+    }
+    std::vector<ClearAreaInfoConstPtr> clear_areas;
+    map_.GetClearAreas(center, radius, &clear_areas);
+    for (const auto& clear_area : clear_areas) {
+      Add(clear_area->clear_area(), tile_->mutable_clear_area());
+    }
+    std::vector<SpeedBumpInfoConstPtr> speed_bumps;
+    map_.GetSpeedBumps(center, radius, &speed_bumps);
+    for (const auto& speed_bump : speed_bumps) {
+      Add(speed_bump->speed_bump(), tile_->mutable_speed_bump());
+    }
+    std::vector<ParkingSpaceInfoConstPtr> parking_spaces;
+    map_.GetParkingSpaces(center, radius, &parking_spaces);
+    for (const auto& parking_space : parking_spaces) {
+      Add(parking_space->parking_space(), tile_->mutable_parking_space());
+    }
+    std::vector<PNCJunctionInfoConstPtr> pnc_junctions;
+    map_.GetPNCJunctions(center, radius, &pnc_junctions);
+    for (const auto& pnc_junction : pnc_junctions) {
+      Add(pnc_junction->pnc_junction(), tile_->mutable_pnc_junction());
+    }
+    range_ids_ = element_ids_;
+
+    // Elements within range keep all their overlaps, so the elements they
+    // overlap with are added too.
+    std::unordered_set<std::string> kept_overlap_ids(overlap_ids_.begin(),
+                                                     overlap_ids_.end());
+    for (const auto& overlap_id : kept_overlap_ids) {
+      const auto overlap = map_.GetOverlapById(CreateHDMapId(overlap_id));
+      if (overlap == nullptr) {
+        continue;
+      }
+      for (const auto& object : overlap->overlap().object()) {
+        AddById(object.id().id());
+      }
+    }
+    AddRoads();
+
+    // Overlaps of the added elements are kept if all their objects are in
+    // the tile, and dropped from the elements otherwise.
+    for (const auto& overlap_id : overlap_ids_) {
+      if (kept_overlap_ids.count(overlap_id) > 0) {
+        continue;
+      }
+      const auto overlap = map_.GetOverlapById(CreateHDMapId(overlap_id));
+      if (overlap == nullptr) {
+        continue;
+      }
+      bool complete = true;
+      for (const auto& object : overlap->overlap().object()) {
+        complete = complete && element_ids_.count(object.id().id()) > 0;
+      }
+      if (complete) {
+        kept_overlap_ids.insert(overlap_id);
+      }
+    }
+    for (const auto& overlap_id : kept_overlap_ids) {
+      const auto overlap = map_.GetOverlapById(CreateHDMapId(overlap_id));
+      if (overlap != nullptr) {
+        *tile_->add_overlap() = overlap->overlap();
+      }
+    }
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_lane());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_junction());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_crosswalk());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_signal());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_stop_sign());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_yield());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_clear_area());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_speed_bump());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_parking_space());
+    RemoveOverlapIds(kept_overlap_ids, tile_->mutable_pnc_junction());
+  }
+
+  // Elements within range of the tile center, complete with their overlaps.
+  const std::unordered_set<std::string>& range_ids() const {
+    return range_ids_;
+  }
+  const std::unordered_set<std::string>& element_ids() const {
+    return element_ids_;
+  }
+
+ private:
+  template <class Proto>
+  void Add(const Proto& element,
+           google::protobuf::RepeatedPtrField<Proto>* elements) {
+    if (!element_ids_.insert(element.id().id()).second) {
+      return;
+    }
+    *elements->Add() = element;
+    for (const auto& overlap_id : element.overlap_id()) {
+      overlap_ids_.push_back(overlap_id.id());
+    }
+  }
+
+  void AddById(const std::string& string_id) {
+    if (element_ids_.count(string_id) > 0) {
+      return;
+    }
+    const Id id = CreateHDMapId(string_id);
+    if (const auto lane = map_.GetLaneById(id)) {
+      Add(lane->lane(), tile_->mutable_lane());
+    } else if (const auto junction = map_.GetJunctionById(id)) {
+      Add(junction->junction(), tile_->mutable_junction());
+    } else if (const auto crosswalk = map_.GetCrosswalkById(id)) {
+      Add(crosswalk->crosswalk(), tile_->mutable_crosswalk());
+    } else if (const auto signal = map_.GetSignalById(id)) {
+      Add(signal->signal(), tile_->mutable_signal());
+    } else if (const auto stop_sign = map_.GetStopSignById(id)) {
+      Add(stop_sign->stop_sign(), tile_->mutable_stop_sign());
+    } else if (const auto yield_sign = map_.GetYieldSignById(id)) {
+      Add(yield_sign->yield_sign(), tile_->mutable_yield());
+    } else if (const auto clear_area = map_.GetClearAreaById(id)) {
+      Add(clear_area->clear_area(), tile_->mutable_clear_area());
+    } else if (const auto speed_bump = map_.GetSpeedBumpById(id)) {
+      Add(speed_bump->speed_bump(), tile_->mutable_speed_bump());
+    } else if (const auto parking_space = map_.GetParkingSpaceById(id)) {
+      Add(parking_space->parking_space(), tile_->mutable_parking_space());
+    } else if (const auto pnc_junction = map_.GetPNCJunctionById(id)) {
+      Add(pnc_junction->pnc_junction(), tile_->mutable_pnc_junction());
+    } else if (const auto rsu = map_.GetRSUById(id)) {
+      element_ids_.insert(string_id);
+      *tile_->add_rsu() = rsu->rsu();
+    }
+  }
+
+  // Roads of the lanes in the tile, with only those lanes in their sections.
+  void AddRoads() {
+    std::unordered_set<std::string> road_ids;
+    for (const auto& lane : tile_->lane()) {
+      const auto lane_info = map_.GetLaneById(lane.id());
+      if (lane_info == nullptr || lane_info->road_id().id().empty() ||
+          !road_ids.insert(lane_info->road_id().id()).second) {
+        continue;
+      }
+      const auto road_info = map_.GetRoadById(lane_info->road_id());
+      if (road_info == nullptr) {
+        continue;
+      }
+      Road* road = tile_->add_road();
+      *road = road_info->road();
+      for (auto& section : *road->mutable_section()) {
+        auto* lane_ids = section.mutable_lane_id();
+        lane_ids->erase(
+            std::remove_if(lane_ids->begin(), lane_ids->end(),
+                           [this](const Id& lane_id) {
+                             return element_ids_.count(lane_id.id()) == 0;
+                           }),
+            lane_ids->end());
+      }
+      if (road->has_junction_id()) {
+        AddById(road->junction_id().id());
+      }
+    }
+  }
+
+  template <class Proto>
+  static void RemoveOverlapIds(
+      const std::unordered_set<std::string>& kept_overlap_ids,
+      google::protobuf::RepeatedPtrField<Proto>* elements) {
+    for (auto& element : *elements) {
+      auto* overlap_ids = element.mutable_overlap_id();
+      overlap_ids->erase(
+          std::remove_if(overlap_ids->begin(), overlap_ids->end(),
+                         [&kept_overlap_ids](const Id& overlap_id) {
+                           return kept_overlap_ids.count(overlap_id.id()) ==
+                                  0;
+                         }),
+          overlap_ids->end());
+    }
+  }
+
+  const HDMapImpl& map_;
+  Map* tile_;
+  std::unordered_set<std::string> element_ids_;
+  std::unordered_set<std::string> range_ids_;
+  std::vector<std::string> overlap_ids_;
+};
+
+void ExpandBounds(const Vec2d& point, Vec2d* min_corner, Vec2d* max_corner) {
+  min_corner->set_x(std::fmin(min_corner->x(), point.x()));
+  min_corner->set_y(std::fmin(min_corner->y(), point.y()));
+  max_corner->set_x(std::fmax(max_corner->x(), point.x()));
+  max_corner->set_y(std::fmax(max_corner->y(), point.y()));
+}
+
+// Gives the elements taken from a tile shared ownership of the tile, which
+// holds the map protos they refer to.
+template <class T, class Tile>
+std::shared_ptr<const T> ShareTile(const std::shared_ptr<const Tile>& tile,
+                                   const std::shared_ptr<const T>& element) {
+  if (element == nullptr) {
+    return nullptr;
+  }
+  return std::shared_ptr<const T>(tile, element.get());
+}
+
+template <class T, class Tile>
+void ShareTile(const std::shared_ptr<const Tile>& tile,
+               std::vector<std::shared_ptr<const T>>* elements) {
+  for (auto& element : *elements) {
+    element = ShareTile(tile, element);
+  }
+}
+
+// The element of an id in a map, by the query of its type.
+template <class T>
+std::shared_ptr<const T> ElementById(const HDMapImpl& map, const Id& id);
+
+template <>
+LaneInfoConstPtr ElementById<LaneInfo>(const HDMapImpl& map, const Id& id) {
+  return map.GetLaneById(id);
+}
+
+template <>
+JunctionInfoConstPtr ElementById<JunctionInfo>(const HDMapImpl& map,
+                                               const Id& id) {
+  return map.GetJunctionById(id);
+}
+
+template <>
+SignalInfoConstPtr ElementById<SignalInfo>(const HDMapImpl& map, const Id& id) {
+  return map.GetSignalById(id);
+}
+
+template <>
+CrosswalkInfoConstPtr ElementById<CrosswalkInfo>(const HDMapImpl& map,
+                                                 const Id& id) {
+  return map.GetCrosswalkById(id);
+}
+
+template <>
+StopSignInfoConstPtr ElementById<StopSignInfo>(const HDMapImpl& map,
+                                               const Id& id) {
+  return map.GetStopSignById(id);
+}
+
+template <>
+YieldSignInfoConstPtr ElementById<YieldSignInfo>(const HDMapImpl& map,
+                                                 const Id& id) {
+  return map.GetYieldSignById(id);
+}
+
+template <>
+ClearAreaInfoConstPtr ElementById<ClearAreaInfo>(const HDMapImpl& map,
+                                                 const Id& id) {
+  return map.GetClearAreaById(id);
+}
+
+template <>
+SpeedBumpInfoConstPtr ElementById<SpeedBumpInfo>(const HDMapImpl& map,
+                                                 const Id& id) {
+  return map.GetSpeedBumpById(id);
+}
+
+template <>
+OverlapInfoConstPtr ElementById<OverlapInfo>(const HDMapImpl& map,
+                                             const Id& id) {
+  return map.GetOverlapById(id);
+}
+
+template <>
+RoadInfoConstPtr ElementById<RoadInfo>(const HDMapImpl& map, const Id& id) {
+  return map.GetRoadById(id);
+}
+
+template <>
+ParkingSpaceInfoConstPtr ElementById<ParkingSpaceInfo>(const HDMapImpl& map,
+                                                       const Id& id) {
+  return map.GetParkingSpaceById(id);
+}
+
+template <>
+PNCJunctionInfoConstPtr ElementById<PNCJunctionInfo>(const HDMapImpl& map,
+                                                     const Id& id) {
+  return map.GetPNCJunctionById(id);
+}
+
+template <>
+RSUInfoConstPtr ElementById<RSUInfo>(const HDMapImpl& map, const Id& id) {
+  return map.GetRSUById(id);
+}
+
+}  // namespace
+
+std::string TiledMapDirectory(const std::string& map_filename) {
+  const size_t slash = map_filename.rfind('/');
+  const size_t dot = map_filename.rfind('.');
+  if (dot == std::string::npos ||
+      (slash != std::string::npos && dot < slash)) {
+    return map_filename + "_tiles";
+  }
+  return map_filename.substr(0, dot) + "_tiles";
+}
+
+bool WriteTiledMap(const Map& map_proto, double tile_size, double margin,
+                   const std::string& directory) {
+  if (tile_size <= 0.0 || margin < 0.0) {
+    AERROR << "Invalid tile size " << tile_size << " or margin " << margin;
+    return false;
+  }
+  HDMapImpl map;
+  if (map.LoadMapFromProto(map_proto) != 0) {
+    AERROR << "Failed to load the map to split into tiles.";
+    return false;
+  }
+
+  // Tiles cover the lanes and junctions; other elements lie around them.
+  const double kInf = std::numeric_limits<double>::infinity();
+  Vec2d min_corner(kInf, kInf);
+  Vec2d max_corner(-kInf, -kInf);
+  for (const auto& lane : map_proto.lane()) {
+    for (const auto& segment : lane.central_curve().segment()) {
+      for (const auto& point : segment.line_segment().point()) {
+        ExpandBounds({point.x(), point.y()}, &min_corner, &max_corner);
+      }
+    }
+  }
+  for (const auto& junction : map_proto.junction()) {
+    for (const auto& point : junction.polygon().point()) {
+      ExpandBounds({point.x(), point.y()}, &min_corner, &max_corner);
+    }
+  }
+  if (min_corner.x() > max_corner.x()) {
+    AERROR << "The map has no lane or junction to split into tiles.";
+    return false;
+  }
+  if (!cyber::common::EnsureDirectory(directory)) {
+    AERROR << "Failed to create tile directory " << directory;
+    return false;
+  }
+
+  // The circle around the tile center covers the tile and its margin.
+  const double radius = tile_size * M_SQRT1_2 + margin;
+  std::ostringstream index;
+  index << std::setprecision(17) << tile_size << " " << margin << "\n";
+  const int min_x = static_cast<int>(std::floor(min_corner.x() / tile_size));
+  const int max_x = static_cast<int>(std::floor(max_corner.x() / tile_size));
+  const int min_y = static_cast<int>(std::floor(min_corner.y() / tile_size));
+  const int max_y = static_cast<int>(std::floor(max_corner.y() / tile_size));
+  // The tiles of every id are those the element is within range of, where
+  // it has all its overlaps, or else the first one holding it.
+  std::map<std::string, std::vector<std::pair<int, int>>> range_tiles;
+  std::map<std::string, std::pair<int, int>> first_tiles;
+  int num_tiles = 0;
+  for (int x = min_x; x <= max_x; ++x) {
+    for (int y = min_y; y <= max_y; ++y) {
+      Map tile;
+      *tile.mutable_header() = map_proto.header();
+      PointENU center;
+      center.set_x((x + 0.5) * tile_size);
+      center.set_y((y + 0.5) * tile_size);
+      TileExtractor extractor(map, &tile);
+      extractor.Extract(center, radius);
+      if (IsEmpty(tile)) {
+        continue;
+      }
+      const std::string filename =
+          absl::StrCat(directory, "/", TileFilename(x, y));
+      if (!cyber::common::SetProtoToBinaryFile(tile, filename)) {
+        AERROR << "Failed to write map tile " << filename;
+        return false;
+      }
+      index << x << " " << y << "\n";
+      ++num_tiles;
+
+      for (const auto& id : extractor.range_ids()) {
+        range_tiles[id].emplace_back(x, y);
+      }
+      for (const auto& id : extractor.element_ids()) {
+        first_tiles.emplace(id, std::make_pair(x, y));
+      }
+      for (const auto& overlap : tile.overlap()) {
+        first_tiles.emplace(overlap.id().id(), std::make_pair(x, y));
+      }
+      for (const auto& road : tile.road()) {
+        first_tiles.emplace(road.id().id(), std::make_pair(x, y));
+      }
+    }
+  }
+
+  std::ostringstream id_index;
+  for (const auto& first_tile : first_tiles) {
+    const auto range_tile = range_tiles.find(first_tile.first);
+    if (range_tile == range_tiles.end()) {
+      id_index << first_tile.second.first << " " << first_tile.second.second
+               << " 0 " << first_tile.first << "\n";
+      continue;
+    }
+    for (const auto& tile : range_tile->second) {
+      id_index << tile.first << " " << tile.second << " 1 "
+               << first_tile.first << "\n";
+    }
+  }
+  // The index is written last, so that it only lists written tiles.
+  if (!WriteFileAtomically(absl::StrCat(directory, "/", kIdIndexFilename),
+                           id_index.str()) ||
+      !WriteFileAtomically(absl::StrCat(directory, "/", kIndexFilename),
+                           index.str())) {
+    return false;
+  }
+  AINFO << "Split the map into " << num_tiles << " tiles of " << tile_size
+        << " m in " << directory;
+  return true;
+}
+
+TiledMap::~TiledMap() {
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    stop_ = true;
+  }
+  pending_cv_.notify_all();
+  if (loader_.joinable()) {
+    loader_.join();
+  }
+}
+
+bool TiledMap::Load(const std::string& directory) {
+  if (loader_.joinable()) {
+    AERROR << "Tiled map already loaded from " << directory_;
+    return false;
+  }
+  const std::string index_filename =
+      absl::StrCat(directory, "/", kIndexFilename);
+  std::ifstream index(index_filename);
+  if (!index) {
+    AERROR << "Failed to open tile index " << index_filename;
+    return false;
+  }
+  if (!(index >> tile_size_ >> margin_) || tile_size_ <= 0.0) {
+    AERROR << "Invalid tile index " << index_filename;
+    return false;
+  }
+  int x = 0;
+  int y = 0;
+  while (index >> x >> y) {
+    tile_keys_.insert(TileKey(x, y));
+  }
+  if (tile_keys_.empty()) {
+    AERROR << "No tile in tile index " << index_filename;
+    return false;
+  }
+  // Tile directories written before the id index only answer queries by id
+  // from the loaded tiles.
+  const std::string id_index_filename =
+      absl::StrCat(directory, "/", kIdIndexFilename);
+  std::ifstream id_index(id_index_filename);
+  int in_range = 0;
+  std::string id;
+  while (id_index >> x >> y >> in_range &&
+         std::getline(id_index >> std::ws, id)) {
+    IdTiles& id_tiles = id_tiles_[id];
+    id_tiles.keys.push_back(TileKey(x, y));
+    id_tiles.in_range = in_range != 0;
+  }
+  if (id_tiles_.empty()) {
+    AWARN << "No id index " << id_index_filename
+          << ", elements out of the loaded tiles are not found by id.";
+  }
+  directory_ = directory;
+  loader_ = std::thread(&TiledMap::LoadTiles, this);
+  AINFO << "Tiled map of " << tile_keys_.size() << " tiles of " << tile_size_
+        << " m in " << directory;
+  return true;
+}
+
+uint64_t TiledMap::TileKey(int x, int y) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+         static_cast<uint32_t>(y);
+}
+
+AABox2d TiledMap::TileBox(uint64_t key) const {
+  const int x = static_cast<int32_t>(key >> 32);
+  const int y = static_cast<int32_t>(key & 0xffffffffU);
+  return AABox2d(Vec2d(x * tile_size_, y * tile_size_),
+                 Vec2d((x + 1) * tile_size_, (y + 1) * tile_size_));
+}
+
+uint64_t TiledMap::TileKeyAt(const Vec2d& point) const {
+  return TileKey(static_cast<int>(std::floor(point.x() / tile_size_)),
+                 static_cast<int>(std::floor(point.y() / tile_size_)));
+}
+
+std::shared_ptr<const TiledMap::TileList> TiledMap::LoadedTiles() const {
+  if (!has_ego_pose_) {
+    AERROR_EVERY(100) << "Tiled map queried before any ego pose, set "
+                         "--use_tiled_map only for processes whose modules "
+                         "update the ego pose of the base map.";
+  }
+  std::lock_guard<std::mutex> lock(tiles_mutex_);
+  return tiles_;
+}
+
+void TiledMap::CheckWithinMargin(const char* query, double radius) const {
+  if (radius > margin_) {
+    AWARN_EVERY(100) << query << " within " << radius
+                     << " m is cut off at the tile margin of " << margin_
+                     << " m.";
+  }
+}
+
+size_t TiledMap::num_loaded_tiles() const { return LoadedTiles()->size(); }
+
+void TiledMap::UpdateEgoPose(const PointENU& position, double heading) {
+  has_ego_pose_ = true;
+  const Vec2d ego(position.x(), position.y());
+  const Vec2d ahead = ego + Vec2d::CreateUnitVec2d(heading) *
+                                FLAGS_map_tile_read_ahead_distance;
+  const double radius = FLAGS_map_tile_load_radius;
+
+  std::vector<std::pair<double, uint64_t>> candidates;
+  for (const Vec2d& center : {ego, ahead}) {
+    const int min_x =
+        static_cast<int>(std::floor((center.x() - radius) / tile_size_));
+    const int max_x =
+        static_cast<int>(std::floor((center.x() + radius) / tile_size_));
+    const int min_y =
+        static_cast<int>(std::floor((center.y() - radius) / tile_size_));
+    const int max_y =
+        static_cast<int>(std::floor((center.y() + radius) / tile_size_));
+    for (int x = min_x; x <= max_x; ++x) {
+      for (int y = min_y; y <= max_y; ++y) {
+        const uint64_t key = TileKey(x, y);
+        if (tile_keys_.count(key) == 0) {
+          continue;
+        }
+        const AABox2d box = TileBox(key);
+        if (box.DistanceTo(center) <= radius) {
+          candidates.emplace_back(box.DistanceTo(ego), key);
+        }
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  // Beyond the bound, the farthest tiles are not loaded at all.
+  const size_t max_loaded =
+      static_cast<size_t>(std::max(FLAGS_map_tile_max_loaded, 1));
+  std::unordered_set<uint64_t> wanted_tiles;
+  std::vector<uint64_t> ordered_tiles;
+  for (const auto& candidate : candidates) {
+    if (ordered_tiles.size() < max_loaded &&
+        wanted_tiles.insert(candidate.second).second) {
+      ordered_tiles.push_back(candidate.second);
+    }
+  }
+
+  const auto loaded = LoadedTiles();
+  std::unordered_set<uint64_t> loaded_tiles;
+  for (const auto& tile : *loaded) {
+    loaded_tiles.insert(tile->key);
+  }
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    ego_position_ = ego;
+    wanted_tiles_ = std::move(wanted_tiles);
+    pending_tiles_.clear();
+    for (const uint64_t key : ordered_tiles) {
+      if (loaded_tiles.count(key) == 0 && failed_tiles_.count(key) == 0) {
+        pending_tiles_.push_back(key);
+      }
+    }
+  }
+  pending_cv_.notify_all();
+
+  {
+    std::lock_guard<std::mutex> lock(tiles_mutex_);
+    auto tiles = std::make_shared<TileList>(*tiles_);
+    std::sort(tiles->begin(), tiles->end(),
+              [&ego](const TilePtr& a, const TilePtr& b) {
+                return a->box.DistanceTo(ego) < b->box.DistanceTo(ego);
+              });
+    tiles_ = tiles;
+  }
+  if (loaded->empty()) {
+    WaitForPendingTiles();
+  }
+}
+
+void TiledMap::WaitForPendingTiles() {
+  std::unique_lock<std::mutex> lock(pending_mutex_);
+  pending_cv_.wait(lock, [this] {
+    return stop_ || (pending_tiles_.empty() && !loading_);
+  });
+}
+
+void TiledMap::LoadTiles() {
+  while (true) {
+    uint64_t key = 0;
+    {
+      std::unique_lock<std::mutex> lock(pending_mutex_);
+      if (loading_) {
+        loading_ = false;
+        pending_cv_.notify_all();
+      }
+      pending_cv_.wait(lock,
+                       [this] { return stop_ || !pending_tiles_.empty(); });
+      if (stop_) {
+        return;
+      }
+      key = pending_tiles_.front();
+      pending_tiles_.erase(pending_tiles_.begin());
+      loading_ = true;
+    }
+    const auto loaded = LoadedTiles();
+    if (std::any_of(loaded->begin(), loaded->end(),
+                    [key](const TilePtr& tile) { return tile->key == key; })) {
+      continue;
+    }
+    const TilePtr tile = LoadTile(key);
+    if (tile == nullptr) {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      failed_tiles_.insert(key);
+      continue;
+    }
+    PublishTile(tile);
+  }
+}
+
+TiledMap::TilePtr TiledMap::LoadTile(uint64_t key) const {
+  const auto start_time = std::chrono::steady_clock::now();
+  auto tile = std::make_shared<Tile>();
+  tile->key = key;
+  tile->box = TileBox(key);
+  const std::string filename = absl::StrCat(
+      directory_, "/",
+      TileFilename(static_cast<int32_t>(key >> 32),
+                   static_cast<int32_t>(key & 0xffffffffU)));
+  if (tile->map.LoadMapFromFile(filename) != 0) {
+    AERROR << "Failed to load map tile " << filename;
+    return nullptr;
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start_time;
+  ADEBUG << "Loaded map tile " << filename << " in " << elapsed.count()
+         << " ms";
+  return tile;
+}
+
+void TiledMap::PublishTile(const TilePtr& tile) {
+  std::unordered_set<uint64_t> wanted_tiles;
+  Vec2d ego;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (wanted_tiles_.count(tile->key) == 0) {
+      // The ego moved away while the tile was loading.
+      return;
+    }
+    wanted_tiles = wanted_tiles_;
+    ego = ego_position_;
+  }
+
+  std::lock_guard<std::mutex> lock(tiles_mutex_);
+  auto tiles = std::make_shared<TileList>(*tiles_);
+  tiles->push_back(tile);
+  std::sort(tiles->begin(), tiles->end(),
+            [&ego](const TilePtr& a, const TilePtr& b) {
+              return a->box.DistanceTo(ego) < b->box.DistanceTo(ego);
+            });
+  // Tiles no longer wanted are evicted, farthest first, beyond the bound.
+  const size_t max_loaded =
+      static_cast<size_t>(std::max(FLAGS_map_tile_max_loaded, 1));
+  for (size_t i = tiles->size(); i > 0 && tiles->size() > max_loaded; --i) {
+    if (wanted_tiles.count((*tiles)[i - 1]->key) == 0) {
+      tiles->erase(tiles->begin() + (i - 1));
+    }
+  }
+  tiles_ = tiles;
+}
+
+std::vector<TiledMap::TilePtr> TiledMap::TilesNear(const Vec2d& point,
+                                                   double distance) const {
+  const auto loaded = LoadedTiles();
+  std::vector<std::pair<double, TilePtr>> near_tiles;
+  for (const auto& tile : *loaded) {
+    const double tile_distance = tile->box.DistanceTo(point);
+    if (tile_distance <= distance) {
+      near_tiles.emplace_back(tile_distance, tile);
+    }
+  }
+  std::stable_sort(near_tiles.begin(), near_tiles.end(),
+                   [](const std::pair<double, TilePtr>& a,
+                      const std::pair<double, TilePtr>& b) {
+                     return a.first < b.first;
+                   });
+  std::vector<TilePtr> tiles;
+  tiles.reserve(near_tiles.size());
+  for (const auto& near_tile : near_tiles) {
+    tiles.push_back(near_tile.second);
+  }
+  return tiles;
+}
+
+TiledMap::TilePtr TiledMap::TileAt(const PointENU& point) const {
+  const uint64_t key = TileKeyAt({point.x(), point.y()});
+  for (const auto& tile : *LoadedTiles()) {
+    if (tile->key == key) {
+      return tile;
+    }
+  }
+  return nullptr;
+}
+
+TiledMap::TilePtr TiledMap::TileOfId(const IdTiles& id_tiles,
+                                     const TileList& loaded) const {
+  const auto& keys = id_tiles.keys;
+  for (const auto& tile : loaded) {
+    if (std::find(keys.begin(), keys.end(), tile->key) != keys.end()) {
+      return tile;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(tiles_by_id_mutex_);
+  auto cached = std::find_if(
+      tiles_by_id_.begin(), tiles_by_id_.end(), [&keys](const TilePtr& tile) {
+        return std::find(keys.begin(), keys.end(), tile->key) != keys.end();
+      });
+  if (cached != tiles_by_id_.end()) {
+    std::rotate(tiles_by_id_.begin(), cached, cached + 1);
+    return tiles_by_id_.front();
+  }
+  if (keys.empty()) {
+    return nullptr;
+  }
+  const TilePtr tile = LoadTile(keys.front());
+  if (tile == nullptr) {
+    return nullptr;
+  }
+  tiles_by_id_.insert(tiles_by_id_.begin(), tile);
+  const size_t max_loaded =
+      static_cast<size_t>(std::max(FLAGS_map_tile_max_loaded, 1));
+  if (tiles_by_id_.size() > max_loaded) {
+    tiles_by_id_.pop_back();
+  }
+  return tile;
+}
+
+template <class T>
+TiledMap::TilePtr TiledMap::FindTile(const Id& id) const {
+  const auto loaded = LoadedTiles();
+  const auto id_tiles = id_tiles_.find(id.id());
+  // Any tile holding an element out of range of all tiles, or missing from
+  // the id index, is as good as another; tiles are in order of distance to
+  // the ego.
+  if (id_tiles == id_tiles_.end() || !id_tiles->second.in_range) {
+    for (const auto& tile : *loaded) {
+      if (ElementById<T>(tile->map, id) != nullptr) {
+        return tile;
+      }
+    }
+  }
+  // Elements within range of some tile are taken from one of these, which
+  // hold all their overlaps, even when another loaded tile holds them as
+  // the neighbours of its elements. Elements farther away, such as the lanes
+  // of a long routing, are read from their tile.
+  if (id_tiles == id_tiles_.end()) {
+    return nullptr;
+  }
+  const TilePtr tile = TileOfId(id_tiles->second, *loaded);
+  if (tile != nullptr && ElementById<T>(tile->map, id) != nullptr) {
+    return tile;
+  }
+  return nullptr;
+}
+
+template <class T>
+std::shared_ptr<const T> TiledMap::FindById(const Id& id) const {
+  const TilePtr tile = FindTile<T>(id);
+  if (tile == nullptr) {
+    return nullptr;
+  }
+  return ShareTile(tile, ElementById<T>(tile->map, id));
+}
+
+template <class T>
+std::shared_ptr<const T> TiledMap::CompleteElement(
+    const TilePtr& tile, const std::shared_ptr<const T>& element,
+    const TileList& loaded) const {
+  const auto id_tiles = id_tiles_.find(element->id().id());
+  if (id_tiles == id_tiles_.end() || !id_tiles->second.in_range ||
+      std::find(id_tiles->second.keys.begin(), id_tiles->second.keys.end(),
+                tile->key) != id_tiles->second.keys.end()) {
+    return ShareTile(tile, element);
+  }
+  const TilePtr complete_tile = TileOfId(id_tiles->second, loaded);
+  if (complete_tile != nullptr) {
+    const auto complete_element =
+        ElementById<T>(complete_tile->map, element->id());
+    if (complete_element != nullptr) {
+      return ShareTile(complete_tile, complete_element);
+    }
+  }
+  return ShareTile(tile, element);
+}
+
+template <class T, class Query>
+int TiledMap::CollectNear(
+    const PointENU& point, double distance, const Query& query,
+    std::vector<std::shared_ptr<const T>>* results) const {
+  if (results == nullptr) {
+    return -1;
+  }
+  results->clear();
+  const auto tiles = TilesNear({point.x(), point.y()}, distance);
+  if (tiles.empty()) {
+    return -1;
+  }
+  const auto loaded = LoadedTiles();
+  // Elements in several tiles are taken from the tile nearest to the point.
+  std::unordered_set<std::string> ids;
+  std::vector<std::shared_ptr<const T>> tile_results;
+  for (const auto& tile : tiles) {
+    if (query(tile->map, &tile_results) != 0) {
+      continue;
+    }
+    for (const auto& result : tile_results) {
+      if (ids.insert(result->id().id()).second) {
+        results->push_back(CompleteElement(tile, result, *loaded));
+      }
+    }
+  }
+  return 0;
+}
+
+LaneInfoConstPtr TiledMap::GetLaneById(const Id& id) const {
+  return FindById<LaneInfo>(id);
+}
+
+JunctionInfoConstPtr TiledMap::GetJunctionById(const Id& id) const {
+  return FindById<JunctionInfo>(id);
+}
+
+SignalInfoConstPtr TiledMap::GetSignalById(const Id& id) const {
+  return FindById<SignalInfo>(id);
+}
+
+CrosswalkInfoConstPtr TiledMap::GetCrosswalkById(const Id& id) const {
+  return FindById<CrosswalkInfo>(id);
+}
+
+StopSignInfoConstPtr TiledMap::GetStopSignById(const Id& id) const {
+  return FindById<StopSignInfo>(id);
+}
+
+YieldSignInfoConstPtr TiledMap::GetYieldSignById(const Id& id) const {
+  return FindById<YieldSignInfo>(id);
+}
+
+ClearAreaInfoConstPtr TiledMap::GetClearAreaById(const Id& id) const {
+  return FindById<ClearAreaInfo>(id);
+}
+
+SpeedBumpInfoConstPtr TiledMap::GetSpeedBumpById(const Id& id) const {
+  return FindById<SpeedBumpInfo>(id);
+}
+
+OverlapInfoConstPtr TiledMap::GetOverlapById(const Id& id) const {
+  return FindById<OverlapInfo>(id);
+}
+
+RoadInfoConstPtr TiledMap::GetRoadById(const Id& id) const {
+  return FindById<RoadInfo>(id);
+}
+
+ParkingSpaceInfoConstPtr TiledMap::GetParkingSpaceById(const Id& id) const {
+  return FindById<ParkingSpaceInfo>(id);
+}
+
+PNCJunctionInfoConstPtr TiledMap::GetPNCJunctionById(const Id& id) const {
+  return FindById<PNCJunctionInfo>(id);
+}
+
+RSUInfoConstPtr TiledMap::GetRSUById(const Id& id) const {
+  return FindById<RSUInfo>(id);
+}
+
+int TiledMap::GetLanes(const PointENU& point, double distance,
+                       std::vector<LaneInfoConstPtr>* lanes) const {
+  return CollectNear<LaneInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<LaneInfoConstPtr>* results) {
+        return map.GetLanes(point, distance, results);
+      },
+      lanes);
+}
+
+int TiledMap::GetJunctions(const PointENU& point, double distance,
+                           std::vector<JunctionInfoConstPtr>* junctions) const {
+  return CollectNear<JunctionInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<JunctionInfoConstPtr>* results) {
+        return map.GetJunctions(point, distance, results);
+      },
+      junctions);
+}
+
+int TiledMap::GetCrosswalks(
+    const PointENU& point, double distance,
+    std::vector<CrosswalkInfoConstPtr>* crosswalks) const {
+  return CollectNear<CrosswalkInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<CrosswalkInfoConstPtr>* results) {
+        return map.GetCrosswalks(point, distance, results);
+      },
+      crosswalks);
+}
+
+int TiledMap::GetSignals(const PointENU& point, double distance,
+                         std::vector<SignalInfoConstPtr>* signals) const {
+  return CollectNear<SignalInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<SignalInfoConstPtr>* results) {
+        return map.GetSignals(point, distance, results);
+      },
+      signals);
+}
+
+int TiledMap::GetStopSigns(
+    const PointENU& point, double distance,
+    std::vector<StopSignInfoConstPtr>* stop_signs) const {
+  return CollectNear<StopSignInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<StopSignInfoConstPtr>* results) {
+        return map.GetStopSigns(point, distance, results);
+      },
+      stop_signs);
+}
+
+int TiledMap::GetYieldSigns(
+    const PointENU& point, double distance,
+    std::vector<YieldSignInfoConstPtr>* yield_signs) const {
+  return CollectNear<YieldSignInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<YieldSignInfoConstPtr>* results) {
+        return map.GetYieldSigns(point, distance, results);
+      },
+      yield_signs);
+}
+
+int TiledMap::GetClearAreas(
+    const PointENU& point, double distance,
+    std::vector<ClearAreaInfoConstPtr>* clear_areas) const {
+  return CollectNear<ClearAreaInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<ClearAreaInfoConstPtr>* results) {
+        return map.GetClearAreas(point, distance, results);
+      },
+      clear_areas);
+}
+
+int TiledMap::GetSpeedBumps(
+    const PointENU& point, double distance,
+    std::vector<SpeedBumpInfoConstPtr>* speed_bumps) const {
+  return CollectNear<SpeedBumpInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<SpeedBumpInfoConstPtr>* results) {
+        return map.GetSpeedBumps(point, distance, results);
+      },
+      speed_bumps);
+}
+
+int TiledMap::GetRoads(const PointENU& point, double distance,
+                       std::vector<RoadInfoConstPtr>* roads) const {
+  return CollectNear<RoadInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<RoadInfoConstPtr>* results) {
+        return map.GetRoads(point, distance, results);
+      },
+      roads);
+}
+
+int TiledMap::GetParkingSpaces(
+    const PointENU& point, double distance,
+    std::vector<ParkingSpaceInfoConstPtr>* parking_spaces) const {
+  return CollectNear<ParkingSpaceInfo>(
+      point, distance,
+      [&](const HDMapImpl& map,
+          std::vector<ParkingSpaceInfoConstPtr>* results) {
+        return map.GetParkingSpaces(point, distance, results);
+      },
+      parking_spaces);
+}
+
+int TiledMap::GetPNCJunctions(
+    const PointENU& point, double distance,
+    std::vector<PNCJunctionInfoConstPtr>* pnc_junctions) const {
+  return CollectNear<PNCJunctionInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<PNCJunctionInfoConstPtr>* results) {
+        return map.GetPNCJunctions(point, distance, results);
+      },
+      pnc_junctions);
+}
+
+template <class Query>
+int TiledMap::FindNearestLane(const PointENU& point, double distance,
+                              const Query& query,
+                              LaneInfoConstPtr* nearest_lane,
+                              double* nearest_s, double* nearest_l) const {
+  if (nearest_lane == nullptr || nearest_s == nullptr || nearest_l == nullptr) {
+    return -1;
+  }
+  const Vec2d target(point.x(), point.y());
+  const auto loaded = LoadedTiles();
+  double min_distance = std::numeric_limits<double>::infinity();
+  // Every tile holds all the lanes within its box, so no tile farther than
+  // the nearest lane found holds a nearer one.
+  for (const auto& tile : TilesNear(target, distance)) {
+    if (tile->box.DistanceTo(target) > min_distance) {
+      break;
+    }
+    LaneInfoConstPtr lane;
+    double s = 0.0;
+    double l = 0.0;
+    if (query(tile->map, &lane, &s, &l) != 0 || lane == nullptr) {
+      continue;
+    }
+    const double lane_distance = lane->DistanceTo(target);
+    if (lane_distance < min_distance) {
+      min_distance = lane_distance;
+      *nearest_lane = CompleteElement(tile, lane, *loaded);
+      *nearest_s = s;
+      *nearest_l = l;
+    }
+  }
+  return min_distance < std::numeric_limits<double>::infinity() ? 0 : -1;
+}
+
+int TiledMap::GetNearestLane(const PointENU& point,
+                             LaneInfoConstPtr* nearest_lane, double* nearest_s,
+                             double* nearest_l) const {
+  return FindNearestLane(
+      point, std::numeric_limits<double>::infinity(),
+      [&point](const HDMapImpl& map, LaneInfoConstPtr* lane, double* s,
+               double* l) { return map.GetNearestLane(point, lane, s, l); },
+      nearest_lane, nearest_s, nearest_l);
+}
+
+int TiledMap::GetNearestLaneWithHeading(
+    const PointENU& point, const double distance, const double central_heading,
+    const double max_heading_difference, LaneInfoConstPtr* nearest_lane,
+    double* nearest_s, double* nearest_l) const {
+  return FindNearestLane(
+      point, distance,
+      [&](const HDMapImpl& map, LaneInfoConstPtr* lane, double* s, double* l) {
+        return map.GetNearestLaneWithHeading(point, distance, central_heading,
+                                             max_heading_difference, lane, s,
+                                             l);
+      },
+      nearest_lane, nearest_s, nearest_l);
+}
+
+int TiledMap::GetLanesWithHeading(const PointENU& point, const double distance,
+                                  const double central_heading,
+                                  const double max_heading_difference,
+                                  std::vector<LaneInfoConstPtr>* lanes) const {
+  return CollectNear<LaneInfo>(
+      point, distance,
+      [&](const HDMapImpl& map, std::vector<LaneInfoConstPtr>* results) {
+        return map.GetLanesWithHeading(point, distance, central_heading,
+                                       max_heading_difference, results);
+      },
+      lanes);
+}
+
+int TiledMap::GetRoadBoundaries(
+    const PointENU& point, double radius,
+    std::vector<RoadROIBoundaryPtr>* road_boundaries,
+    std::vector<JunctionBoundaryPtr>* junctions) const {
+  CheckWithinMargin("GetRoadBoundaries", radius);
+  const TilePtr tile = TileAt(point);
+  if (tile == nullptr) {
+    return -1;
+  }
+  const int status =
+      tile->map.GetRoadBoundaries(point, radius, road_boundaries, junctions);
+  for (auto& junction : *junctions) {
+    junction->junction_info = ShareTile(tile, junction->junction_info);
+  }
+  return status;
+}
+
+int TiledMap::GetRoadBoundaries(
+    const PointENU& point, double radius,
+    std::vector<RoadRoiPtr>* road_boundaries,
+    std::vector<JunctionInfoConstPtr>* junctions) const {
+  CheckWithinMargin("GetRoadBoundaries", radius);
+  const TilePtr tile = TileAt(point);
+  if (tile == nullptr) {
+    return -1;
+  }
+  const int status =
+      tile->map.GetRoadBoundaries(point, radius, road_boundaries, junctions);
+  if (junctions != nullptr) {
+    ShareTile(tile, junctions);
+  }
+  return status;
+}
+
+int TiledMap::GetRoi(const PointENU& point, double radius,
+                     std::vector<RoadRoiPtr>* roads_roi,
+                     std::vector<PolygonRoiPtr>* polygons_roi) const {
+  CheckWithinMargin("GetRoi", radius);
+  const TilePtr tile = TileAt(point);
+  if (tile == nullptr) {
+    return -1;
+  }
+  return tile->map.GetRoi(point, radius, roads_roi, polygons_roi);
+}
+
+int TiledMap::GetForwardNearestSignalsOnLane(
+    const PointENU& point, const double distance,
+    std::vector<SignalInfoConstPtr>* signals) const {
+  CheckWithinMargin("GetForwardNearestSignalsOnLane", distance);
+  const TilePtr tile = TileAt(point);
+  if (tile == nullptr) {
+    return -1;
+  }
+  const int status =
+      tile->map.GetForwardNearestSignalsOnLane(point, distance, signals);
+  ShareTile(tile, signals);
+  return status;
+}
+
+int TiledMap::GetStopSignAssociatedStopSigns(
+    const Id& id, std::vector<StopSignInfoConstPtr>* stop_signs) const {
+  const TilePtr tile = FindTile<StopSignInfo>(id);
+  if (tile == nullptr) {
+    return -1;
+  }
+  const int status = tile->map.GetStopSignAssociatedStopSigns(id, stop_signs);
+  ShareTile(tile, stop_signs);
+  return status;
+}
+
+int TiledMap::GetStopSignAssociatedLanes(
+    const Id& id, std::vector<LaneInfoConstPtr>* lanes) const {
+  const TilePtr tile = FindTile<StopSignInfo>(id);
+  if (tile == nullptr) {
+    return -1;
+  }
+  const int status = tile->map.GetStopSignAssociatedLanes(id, lanes);
+  ShareTile(tile, lanes);
+  return status;
+}
+
+int TiledMap::GetLocalMap(const PointENU& point,
+                          const std::pair<double, double>& range,
+                          Map* local_map) const {
+  CheckWithinMargin("GetLocalMap", std::hypot(range.first, range.second));
+  const TilePtr tile = TileAt(point);
+  if (tile == nullptr) {
+    return -1;
+  }
+  return tile->map.GetLocalMap(point, range, local_map);
+}
+
+int TiledMap::GetForwardNearestRSUs(const PointENU& point, double distance,
+                                    double central_heading,
+                                    double max_heading_difference,
+                                    std::vector<RSUInfoConstPtr>* rsus) const {
+  CheckWithinMargin("GetForwardNearestRSUs", distance);
+  const TilePtr tile = TileAt(point);
+  if (tile == nullptr) {
+    return -1;
+  }
+  const int status = tile->map.GetForwardNearestRSUs(
+      point, distance, central_heading, max_heading_difference, rsus);
+  ShareTile(tile, rsus);
+  return status;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,295 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A map split into square tiles, loaded and evicted around the ego.
+ *
+ * Every tile is a complete map of its own, holding all the elements that
+ * come within a margin of its square, along with the elements these overlap
+ * with. Tiles are loaded into their own HDMapImpl, with their own kd-trees,
+ * by a background thread, so that only the tiles around the ego position and
+ * ahead of it are in memory.
+ *
+ * The tile directory holds one binary map file per tile, named
+ * "<x>_<y>.bin" after the tile column and row, and an index file, "index",
+ * whose first line is "<tile size> <margin>" and whose other lines each list
+ * the "<x> <y>" of one tile, and an id index file, "ids", whose lines each
+ * give the "<x> <y> <in range> <id>" of a tile holding an element. An element
+ * is listed with every tile it is within range of, where it has all its
+ * overlaps, with <in range> 1, or else with the first tile holding it, as
+ * the neighbour of an element in range or as a road, with <in range> 0.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+#include "modules/map/proto/map.pb.h"
+
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @brief Tile directory of a map file, e.g. "dir/base_map_tiles" for
+ * "dir/base_map.bin".
+ */
+std::string TiledMapDirectory(const std::string& map_filename);
+
+/**
+ * @brief Splits a map into tiles, written to a tile directory.
+ * @param map_proto the map to split
+ * @param tile_size the side of the tiles, in meters
+ * @param margin the distance around a tile within which elements are
+ * included in it as well
+ * @param directory the tile directory
+ * @return true on success
+ */
+bool WriteTiledMap(const Map& map_proto, double tile_size, double margin,
+                   const std::string& directory);
+
+/**
+ * @class TiledMap
+ *
+ * @brief Map loaded tile by tile, which answers the queries of HDMap from the
+ * tiles in memory.
+ *
+ * Queries by range merge the results of the loaded tiles the range overlaps,
+ * and queries of the nearest lane those of the tiles it may lie in. Other
+ * queries, such as GetRoadBoundaries(), GetRoi() or GetLocalMap(), are
+ * answered by the tile the point is in, and are only complete within the
+ * tile margin: beyond it, they are cut off, with a warning. Until the first
+ * ego pose is given, no tile is loaded and all queries fail, with an error
+ * logged. Queries by id are answered by a tile the id index gives,
+ * a loaded one if any, or else one loaded on the calling thread, so that
+ * elements far from the ego, such as the lanes of a routing, are found as
+ * well. Elements a tile only holds as the neighbours of others, without the
+ * overlaps beyond the tile, are taken from such a tile too. Elements
+ * returned keep their tile in memory for as long as they are held; the
+ * elements they point to, such as their overlaps, are only valid while they
+ * are.
+ */
+class TiledMap {
+ public:
+  TiledMap() = default;
+  ~TiledMap();
+
+  /**
+   * @brief load the tile index and start loading tiles in the background.
+   * @param directory the tile directory
+   * @return true on success
+   */
+  bool Load(const std::string& directory);
+
+  /**
+   * @brief load the tiles around a new ego pose and ahead of it in the
+   * background, evicting the farthest ones beyond FLAGS_map_tile_max_loaded.
+   * Waits for the tiles only if none is loaded yet, as at startup.
+   * @param position the ego position
+   * @param heading the ego heading
+   */
+  void UpdateEgoPose(const apollo::common::PointENU& position,
+                     double heading);
+
+  /**
+   * @brief wait until the tiles requested by UpdateEgoPose() are loaded.
+   */
+  void WaitForPendingTiles();
+
+  size_t num_loaded_tiles() const;
+
+  LaneInfoConstPtr GetLaneById(const Id& id) const;
+  JunctionInfoConstPtr GetJunctionById(const Id& id) const;
+  SignalInfoConstPtr GetSignalById(const Id& id) const;
+  CrosswalkInfoConstPtr GetCrosswalkById(const Id& id) const;
+  StopSignInfoConstPtr GetStopSignById(const Id& id) const;
+  YieldSignInfoConstPtr GetYieldSignById(const Id& id) const;
+  ClearAreaInfoConstPtr GetClearAreaById(const Id& id) const;
+  SpeedBumpInfoConstPtr GetSpeedBumpById(const Id& id) const;
+  OverlapInfoConstPtr GetOverlapById(const Id& id) const;
+  RoadInfoConstPtr GetRoadById(const Id& id) const;
+  ParkingSpaceInfoConstPtr GetParkingSpaceById(const Id& id) const;
+  PNCJunctionInfoConstPtr GetPNCJunctionById(const Id& id) const;
+  RSUInfoConstPtr GetRSUById(const Id& id) const;
+
+  int GetLanes(const apollo::common::PointENU& point, double distance,
+               std::vector<LaneInfoConstPtr>* lanes) const;
+  int GetJunctions(const apollo::common::PointENU& point, double distance,
+                   std::vector<JunctionInfoConstPtr>* junctions) const;
+  int GetCrosswalks(const apollo::common::PointENU& point, double distance,
+                    std::vector<CrosswalkInfoConstPtr>* crosswalks) const;
+  int GetSignals(const apollo::common::PointENU& point, double distance,
+                 std::vector<SignalInfoConstPtr>* signals) const;
+  int GetStopSigns(const apollo::common::PointENU& point, double distance,
+                   std::vector<StopSignInfoConstPtr>* stop_signs) const;
+  int GetYieldSigns(const apollo::common::PointENU& point, double distance,
+                    std::vector<YieldSignInfoConstPtr>* yield_signs) const;
+  int GetClearAreas(const apollo::common::PointENU& point, double distance,
+                    std::vector<ClearAreaInfoConstPtr>* clear_areas) const;
+  int GetSpeedBumps(const apollo::common::PointENU& point, double distance,
+                    std::vector<SpeedBumpInfoConstPtr>* speed_bumps) const;
+  int GetRoads(const apollo::common::PointENU& point, double distance,
+               std::vector<RoadInfoConstPtr>* roads) const;
+  int GetParkingSpaces(
+      const apollo::common::PointENU& point, double distance,
+      std::vector<ParkingSpaceInfoConstPtr>* parking_spaces) const;
+  int GetPNCJunctions(
+      const apollo::common::PointENU& point, double distance,
+      std::vector<PNCJunctionInfoConstPtr>* pnc_junctions) const;
+  int GetNearestLane(const apollo::common::PointENU& point,
+                     LaneInfoConstPtr* nearest_lane, double* nearest_s,
+                     double* nearest_l) const;
+  int GetNearestLaneWithHeading(const apollo::common::PointENU& point,
+                                const double distance,
+                                const double central_heading,
+                                const double max_heading_difference,
+                                LaneInfoConstPtr* nearest_lane,
+                                double* nearest_s, double* nearest_l) const;
+  int GetLanesWithHeading(const apollo::common::PointENU& point,
+                          const double distance, const double central_heading,
+                          const double max_heading_difference,
+                          std::vector<LaneInfoConstPtr>* lanes) const;
+  int GetRoadBoundaries(const apollo::common::PointENU& point, double radius,
+                        std::vector<RoadROIBoundaryPtr>* road_boundaries,
+                        std::vector<JunctionBoundaryPtr>* junctions) const;
+  int GetRoadBoundaries(const apollo::common::PointENU& point, double radius,
+                        std::vector<RoadRoiPtr>* road_boundaries,
+                        std::vector<JunctionInfoConstPtr>* junctions) const;
+  int GetRoi(const apollo::common::PointENU& point, double radius,
+             std::vector<RoadRoiPtr>* roads_roi,
+             std::vector<PolygonRoiPtr>* polygons_roi) const;
+  int GetForwardNearestSignalsOnLane(
+      const apollo::common::PointENU& point, const double distance,
+      std::vector<SignalInfoConstPtr>* signals) const;
+  int GetStopSignAssociatedStopSigns(
+      const Id& id, std::vector<StopSignInfoConstPtr>* stop_signs) const;
+  int GetStopSignAssociatedLanes(const Id& id,
+                                 std::vector<LaneInfoConstPtr>* lanes) const;
+  int GetLocalMap(const apollo::common::PointENU& point,
+                  const std::pair<double, double>& range,
+                  Map* local_map) const;
+  int GetForwardNearestRSUs(const apollo::common::PointENU& point,
+                            double distance, double central_heading,
+                            double max_heading_difference,
+                            std::vector<RSUInfoConstPtr>* rsus) const;
+
+ private:
+  struct Tile {
+    uint64_t key = 0;
+    apollo::common::math::AABox2d box;
+    // Mutable only because GetRoi() of HDMapImpl is not const.
+    mutable HDMapImpl map;
+  };
+  using TilePtr = std::shared_ptr<const Tile>;
+  using TileList = std::vector<TilePtr>;
+
+  static uint64_t TileKey(int x, int y);
+  apollo::common::math::AABox2d TileBox(uint64_t key) const;
+  uint64_t TileKeyAt(const apollo::common::math::Vec2d& point) const;
+
+  // Loaded tiles the square of the given half size around the point
+  // overlaps, nearest first.
+  std::vector<TilePtr> TilesNear(const apollo::common::math::Vec2d& point,
+                                 double distance) const;
+  // Loaded tile the point is in, if any.
+  TilePtr TileAt(const apollo::common::PointENU& point) const;
+  // Loaded tiles, nearest to the ego first.
+  std::shared_ptr<const TileList> LoadedTiles() const;
+  // Warns of a query by the tile of its point reaching beyond the margin.
+  void CheckWithinMargin(const char* query, double radius) const;
+
+  // The tiles of an id in the id index.
+  struct IdTiles {
+    std::vector<uint64_t> keys;
+    // Whether the element has all its overlaps in these tiles, which other
+    // tiles may lack.
+    bool in_range = false;
+  };
+
+  // Tile of the id index for an id, taken from the loaded tiles or those
+  // loaded by id, or else loaded now.
+  TilePtr TileOfId(const IdTiles& id_tiles, const TileList& loaded) const;
+  // Tile holding an element with all its overlaps, as the id index gives,
+  // or else the first loaded tile, nearest to the ego first, holding it.
+  template <class T>
+  TilePtr FindTile(const Id& id) const;
+  template <class T>
+  std::shared_ptr<const T> FindById(const Id& id) const;
+  // The element found in a tile, or the same element from a tile of its id
+  // if the tile lacks some of its overlaps.
+  template <class T>
+  std::shared_ptr<const T> CompleteElement(
+      const TilePtr& tile, const std::shared_ptr<const T>& element,
+      const TileList& loaded) const;
+  template <class T, class Query>
+  int CollectNear(const apollo::common::PointENU& point, double distance,
+                  const Query& query,
+                  std::vector<std::shared_ptr<const T>>* results) const;
+  template <class Query>
+  int FindNearestLane(const apollo::common::PointENU& point, double distance,
+                      const Query& query, LaneInfoConstPtr* nearest_lane,
+                      double* nearest_s, double* nearest_l) const;
+
+  void LoadTiles();
+  TilePtr LoadTile(uint64_t key) const;
+  void PublishTile(const TilePtr& tile);
+
+ private:
+  std::string directory_;
+  double tile_size_ = 0.0;
+  double margin_ = 0.0;
+  std::unordered_set<uint64_t> tile_keys_;
+  std::unordered_map<std::string, IdTiles> id_tiles_;
+
+  // Tiles wanted around the last ego pose and those still to load, nearest
+  // first.
+  std::mutex pending_mutex_;
+  std::condition_variable pending_cv_;
+  std::unordered_set<uint64_t> wanted_tiles_;
+  std::vector<uint64_t> pending_tiles_;
+  std::unordered_set<uint64_t> failed_tiles_;
+  apollo::common::math::Vec2d ego_position_;
+  bool loading_ = false;
+  bool stop_ = false;
+  std::atomic<bool> has_ego_pose_{false};
+  std::thread loader_;
+
+  // The loaded tiles are replaced as a whole when a tile is loaded or
+  // evicted, so that queries only hold the lock to copy the pointer.
+  mutable std::mutex tiles_mutex_;
+  std::shared_ptr<const TileList> tiles_ = std::make_shared<TileList>();
+
+  // Tiles loaded by queries by id, most recently used first, up to
+  // FLAGS_map_tile_max_loaded of them.
+  mutable std::mutex tiles_by_id_mutex_;
+  mutable TileList tiles_by_id_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,238 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/hdmap/tiled_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
+#include "modules/common/configs/config_gflags.h"
+
+namespace {
+
+constexpr char kMapFilename[] = "modules/map/hdmap/test-data/base_map.bin";
+constexpr char kTileDirectory[] = "/tmp/tiled_map_test";
+
+}  // namespace
+
+namespace apollo {
+namespace hdmap {
+
+class TiledMapTest : public ::testing::Test {
+ public:
+  TiledMapTest() {
+    EXPECT_TRUE(cyber::common::GetProtoFromFile(kMapFilename, &map_proto_));
+    EXPECT_EQ(0, hdmap_impl_.LoadMapFromProto(map_proto_));
+    point_.set_x(586424.09);
+    point_.set_y(4140727.02);
+    point_.set_z(0.0);
+  }
+
+ protected:
+  static std::vector<std::string> Ids(
+      const std::vector<LaneInfoConstPtr>& lanes) {
+    std::vector<std::string> ids;
+    for (const auto& lane : lanes) {
+      ids.push_back(lane->id().id());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }
+
+  Map map_proto_;
+  HDMapImpl hdmap_impl_;
+  apollo::common::PointENU point_;
+};
+
+TEST_F(TiledMapTest, TiledMapDirectory) {
+  EXPECT_EQ("dir/base_map_tiles", TiledMapDirectory("dir/base_map.bin"));
+  EXPECT_EQ("dir.d/base_map_tiles", TiledMapDirectory("dir.d/base_map"));
+}
+
+TEST_F(TiledMapTest, QueriesMatchWholeMap) {
+  ASSERT_TRUE(WriteTiledMap(map_proto_, 50.0, 20.0, kTileDirectory));
+  TiledMap tiled_map;
+  ASSERT_TRUE(tiled_map.Load(kTileDirectory));
+  tiled_map.UpdateEgoPose(point_, 0.0);
+  tiled_map.WaitForPendingTiles();
+  EXPECT_GT(tiled_map.num_loaded_tiles(), 0U);
+
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<LaneInfoConstPtr> tiled_lanes;
+  for (const double distance : {1e-6, 5.0, 30.0}) {
+    EXPECT_EQ(0, hdmap_impl_.GetLanes(point_, distance, &lanes));
+    EXPECT_EQ(0, tiled_map.GetLanes(point_, distance, &tiled_lanes));
+    EXPECT_EQ(Ids(lanes), Ids(tiled_lanes));
+  }
+
+  LaneInfoConstPtr lane;
+  LaneInfoConstPtr tiled_lane;
+  double s = 0.0;
+  double l = 0.0;
+  double tiled_s = 0.0;
+  double tiled_l = 0.0;
+  EXPECT_EQ(0, hdmap_impl_.GetNearestLane(point_, &lane, &s, &l));
+  EXPECT_EQ(0,
+            tiled_map.GetNearestLane(point_, &tiled_lane, &tiled_s, &tiled_l));
+  EXPECT_EQ(lane->id().id(), tiled_lane->id().id());
+  EXPECT_NEAR(s, tiled_s, 1e-6);
+  EXPECT_NEAR(l, tiled_l, 1e-6);
+
+  EXPECT_NE(nullptr, tiled_map.GetLaneById(lane->id()));
+  Id unknown_id;
+  unknown_id.set_id("1");
+  EXPECT_EQ(nullptr, tiled_map.GetLaneById(unknown_id));
+}
+
+TEST_F(TiledMapTest, LoadedTilesAreBounded) {
+  ASSERT_TRUE(WriteTiledMap(map_proto_, 20.0, 10.0, kTileDirectory));
+  const int max_loaded = FLAGS_map_tile_max_loaded;
+  FLAGS_map_tile_max_loaded = 4;
+  {
+    TiledMap tiled_map;
+    ASSERT_TRUE(tiled_map.Load(kTileDirectory));
+    tiled_map.UpdateEgoPose(point_, 0.0);
+    tiled_map.WaitForPendingTiles();
+    EXPECT_GT(tiled_map.num_loaded_tiles(), 0U);
+    EXPECT_LE(tiled_map.num_loaded_tiles(), 4U);
+
+    LaneInfoConstPtr lane;
+    double s = 0.0;
+    double l = 0.0;
+    ASSERT_EQ(0, tiled_map.GetNearestLane(point_, &lane, &s, &l));
+    const std::string lane_id = lane->id().id();
+
+    // Lanes held stay valid once their tile is evicted.
+    apollo::common::PointENU far_point = point_;
+    far_point.set_x(point_.x() - 60.0);
+    tiled_map.UpdateEgoPose(far_point, M_PI);
+    tiled_map.WaitForPendingTiles();
+    EXPECT_LE(tiled_map.num_loaded_tiles(), 4U);
+    EXPECT_EQ(lane_id, lane->id().id());
+    EXPECT_GT(lane->total_length(), 0.0);
+  }
+  FLAGS_map_tile_max_loaded = max_loaded;
+}
+
+TEST_F(TiledMapTest, FindsLanesOutOfLoadedTilesById) {
+  ASSERT_TRUE(WriteTiledMap(map_proto_, 20.0, 10.0, kTileDirectory));
+  const int max_loaded = FLAGS_map_tile_max_loaded;
+  FLAGS_map_tile_max_loaded = 4;
+  {
+    TiledMap tiled_map;
+    ASSERT_TRUE(tiled_map.Load(kTileDirectory));
+    tiled_map.UpdateEgoPose(point_, 0.0);
+    tiled_map.WaitForPendingTiles();
+    EXPECT_LE(tiled_map.num_loaded_tiles(), 4U);
+
+    // The loaded tiles of 20 m lie within 60 m of the ego.
+    int num_far_lanes = 0;
+    for (const auto& lane : map_proto_.lane()) {
+      const auto lane_info = hdmap_impl_.GetLaneById(lane.id());
+      ASSERT_NE(nullptr, lane_info);
+      if (lane_info->DistanceTo({point_.x(), point_.y()}) < 100.0) {
+        continue;
+      }
+      ++num_far_lanes;
+      const auto tiled_lane = tiled_map.GetLaneById(lane.id());
+      ASSERT_NE(nullptr, tiled_lane) << lane.id().id();
+      EXPECT_EQ(lane.id().id(), tiled_lane->id().id());
+      EXPECT_NEAR(lane_info->total_length(), tiled_lane->total_length(),
+                  1e-6);
+      EXPECT_EQ(lane.overlap_id_size(), tiled_lane->lane().overlap_id_size());
+      for (const auto& overlap_id : tiled_lane->lane().overlap_id()) {
+        EXPECT_NE(nullptr, tiled_map.GetOverlapById(overlap_id));
+      }
+    }
+    EXPECT_GT(num_far_lanes, 0);
+    EXPECT_LE(tiled_map.num_loaded_tiles(), 4U);
+
+    Id unknown_id;
+    unknown_id.set_id("1");
+    EXPECT_EQ(nullptr, tiled_map.GetLaneById(unknown_id));
+  }
+  FLAGS_map_tile_max_loaded = max_loaded;
+}
+
+TEST_F(TiledMapTest, TakesLanesWithAllTheirOverlaps) {
+  ASSERT_TRUE(WriteTiledMap(map_proto_, 20.0, 10.0, kTileDirectory));
+
+  // A lane some tile only holds as the neighbour of its elements, with the
+  // overlaps beyond that tile dropped.
+  std::ifstream index(std::string(kTileDirectory) + "/index");
+  double tile_size = 0.0;
+  double margin = 0.0;
+  ASSERT_TRUE(index >> tile_size >> margin);
+  int x = 0;
+  int y = 0;
+  std::string lane_id;
+  apollo::common::PointENU tile_center;
+  while (lane_id.empty() && index >> x >> y) {
+    Map tile;
+    ASSERT_TRUE(cyber::common::GetProtoFromFile(
+        absl::StrCat(kTileDirectory, "/", x, "_", y, ".bin"), &tile));
+    for (const auto& lane : tile.lane()) {
+      const auto lane_info = hdmap_impl_.GetLaneById(lane.id());
+      ASSERT_NE(nullptr, lane_info);
+      if (lane.overlap_id_size() < lane_info->lane().overlap_id_size()) {
+        lane_id = lane.id().id();
+        tile_center.set_x((x + 0.5) * tile_size);
+        tile_center.set_y((y + 0.5) * tile_size);
+        break;
+      }
+    }
+  }
+  ASSERT_FALSE(lane_id.empty());
+  Id id;
+  id.set_id(lane_id);
+  const auto lane_info = hdmap_impl_.GetLaneById(id);
+
+  // The ego in that tile, which is then the nearest loaded one.
+  TiledMap tiled_map;
+  ASSERT_TRUE(tiled_map.Load(kTileDirectory));
+  tiled_map.UpdateEgoPose(tile_center, 0.0);
+  tiled_map.WaitForPendingTiles();
+
+  const auto tiled_lane = tiled_map.GetLaneById(id);
+  ASSERT_NE(nullptr, tiled_lane);
+  EXPECT_EQ(lane_info->lane().overlap_id_size(),
+            tiled_lane->lane().overlap_id_size());
+  EXPECT_EQ(lane_info->signals().size(), tiled_lane->signals().size());
+  EXPECT_EQ(lane_info->stop_signs().size(), tiled_lane->stop_signs().size());
+  EXPECT_EQ(lane_info->crosswalks().size(), tiled_lane->crosswalks().size());
+
+  std::vector<LaneInfoConstPtr> tiled_lanes;
+  const double distance =
+      lane_info->DistanceTo({tile_center.x(), tile_center.y()}) + 1.0;
+  ASSERT_EQ(0, tiled_map.GetLanes(tile_center, distance, &tiled_lanes));
+  const auto near_lane = std::find_if(
+      tiled_lanes.begin(), tiled_lanes.end(),
+      [&lane_id](const LaneInfoConstPtr& lane) {
+        return lane->id().id() == lane_id;
+      });
+  ASSERT_NE(tiled_lanes.end(), near_lane);
+  EXPECT_EQ(lane_info->lane().overlap_id_size(),
+            (*near_lane)->lane().overlap_id_size());
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -367,21 +367,19 @@ void Path::InitPoints() {
   unit_directions_.clear();
   unit_directions_.reserve(num_points_);
   double s = 0.0;
-  for (int i = 0; i < num_points_; ++i) {
+  for (int i = 0; i + 1 < num_points_; ++i) {
     accumulated_s_.push_back(s);
-    Vec2d heading;
-    if (i + 1 >= num_points_) {
-      heading = path_points_[i] - path_points_[i - 1];
-    } else {
-      segments_.emplace_back(path_points_[i], path_points_[i + 1]);
-      heading = path_points_[i + 1] - path_points_[i];
-      // TODO(All): use heading.length when all adjacent lanes are guarantee to
-      // be connected.
-      s += heading.Length();
-    }
-    heading.Normalize();
-    unit_directions_.push_back(heading);
+    segments_.emplace_back(path_points_[i], path_points_[i + 1]);
+    // Reuses the length and direction the segment computed; a heading too
+    // short to be normalized is kept as is.
+    const LineSegment2d& segment = segments_.back();
+    s += segment.length();
+    unit_directions_.push_back(segment.length() > kMathEpsilon
+                                   ? segment.unit_direction()
+                                   : path_points_[i + 1] - path_points_[i]);
   }
+  accumulated_s_.push_back(s);
+  unit_directions_.push_back(unit_directions_.back());
   length_ = s;
   num_sample_points_ = static_cast<int>(length_ / kSampleDistance) + 1;
   num_segments_ = num_points_ - 1;
@@ -759,28 +757,7 @@ bool Path::GetProjectionWithHueristicParams(const Vec2d& point,
     }
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
-  const auto prod = nearest_seg.ProductOntoUnit(point);
-  const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
-    *accumulate_s = std::min(proj, nearest_seg.length());
-    if (proj < 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
-    if (proj > 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else {
-    *accumulate_s = accumulated_s_[min_index] +
-                    std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-  }
+  ProjectOntoSegment(point, min_index, *min_distance, accumulate_s, lateral);
   return true;
 }
 
@@ -808,29 +785,113 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
     }
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
+  ProjectOntoSegment(point, min_index, *min_distance, accumulate_s, lateral);
+  return true;
+}
+
+bool Path::GetProjectionWithHint(const Vec2d& point, int* hint_index,
+                                 double* accumulate_s, double* lateral,
+                                 double* min_distance) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (hint_index == nullptr || accumulate_s == nullptr || lateral == nullptr ||
+      min_distance == nullptr) {
+    return false;
+  }
+  CHECK_GE(num_points_, 2);
+
+  // Walks from the hint down the distance to a local minimum.
+  const int start_index = std::max(0, std::min(*hint_index, num_segments_ - 1));
+  int min_index = start_index;
+  double min_distance_square = segments_[min_index].DistanceSquareTo(point);
+  for (int i = start_index + 1; i < num_segments_; ++i) {
+    const double distance_square = segments_[i].DistanceSquareTo(point);
+    if (distance_square >= min_distance_square) {
+      break;
+    }
+    min_index = i;
+    min_distance_square = distance_square;
+  }
+  for (int i = start_index - 1; i >= 0 && min_index <= start_index; --i) {
+    const double distance_square = segments_[i].DistanceSquareTo(point);
+    if (distance_square >= min_distance_square) {
+      break;
+    }
+    min_index = i;
+    min_distance_square = distance_square;
+  }
+
+  // Then checks the rest of the path for a nearer segment. Every point of the
+  // path within ds along it from a path point p is within ds of p, so the
+  // segments too close along the path to a point far from the query point
+  // are farther than the nearest segment and are skipped.
+  const int local_min_index = min_index;
+  *min_distance = std::sqrt(min_distance_square);
+  const auto update_min = [&](const int index) {
+    const double distance_square = segments_[index].DistanceSquareTo(point);
+    if (distance_square < min_distance_square ||
+        (distance_square == min_distance_square && index < min_index)) {
+      min_index = index;
+      min_distance_square = distance_square;
+      *min_distance = std::sqrt(min_distance_square);
+    }
+  };
+  for (int i = local_min_index + 1; i < num_segments_;) {
+    update_min(i);
+    // Segments ending before s_limit are farther than the nearest one.
+    const double s_limit = accumulated_s_[i + 1] +
+                           point.DistanceTo(path_points_[i + 1]) -
+                           *min_distance - kMathEpsilon;
+    const int next_index = static_cast<int>(
+        std::lower_bound(accumulated_s_.begin() + i + 2, accumulated_s_.end(),
+                         s_limit) -
+        accumulated_s_.begin() - 1);
+    i = std::max(i + 1, next_index);
+  }
+  for (int i = local_min_index - 1; i >= 0;) {
+    update_min(i);
+    // Segments starting after s_limit are farther than the nearest one.
+    const double s_limit = accumulated_s_[i] -
+                           point.DistanceTo(path_points_[i]) + *min_distance +
+                           kMathEpsilon;
+    const int next_index = static_cast<int>(
+        std::upper_bound(accumulated_s_.begin(), accumulated_s_.begin() + i,
+                         s_limit) -
+        accumulated_s_.begin() - 1);
+    i = std::min(i - 1, next_index);
+  }
+
+  *hint_index = min_index;
+  ProjectOntoSegment(point, min_index, *min_distance, accumulate_s, lateral);
+  return true;
+}
+
+void Path::ProjectOntoSegment(const Vec2d& point, const int index,
+                              const double distance, double* accumulate_s,
+                              double* lateral) const {
+  const auto& nearest_seg = segments_[index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
   const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
+  if (index == 0) {
     *accumulate_s = std::min(proj, nearest_seg.length());
     if (proj < 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * distance;
     }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
+  } else if (index == num_segments_ - 1) {
+    *accumulate_s = accumulated_s_[index] + std::max(0.0, proj);
     if (proj > 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * distance;
     }
   } else {
-    *accumulate_s = accumulated_s_[min_index] +
+    *accumulate_s = accumulated_s_[index] +
                     std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+    *lateral = (prod > 0.0 ? 1 : -1) * distance;
   }
-  return true;
 }
 
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
@@ -260,6 +260,13 @@ class Path {
                      double* lateral) const;
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
+  // Same projection as GetProjection() without path approximation, searched
+  // from the segment at hint_index, which is set to the segment of the
+  // projection. It is fast when the hint is the segment of a nearby point,
+  // such as the previous one of points moving along the path.
+  bool GetProjectionWithHint(const common::math::Vec2d& point, int* hint_index,
+                             double* accumulate_s, double* lateral,
+                             double* min_distance) const;
 
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
@@ -340,6 +347,9 @@ class Path {
   void InitOverlaps();
 
   double GetSample(const std::vector<double>& samples, const double s) const;
+  void ProjectOntoSegment(const common::math::Vec2d& point, const int index,
+                          const double distance, double* accumulate_s,
+                          double* lateral) const;
 
   using GetOverlapFromLaneFunc =
       std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
@@ -648,6 +648,50 @@ TEST(TestSuite, hdmap_s_path) {
   }
 }
 
+TEST(TestSuite, hdmap_path_get_projection_with_hint) {
+  // A path turning back along itself, with the query points moving along it.
+  std::vector<MapPathPoint> points;
+  const double kRadius = 5.0;
+  for (int i = 0; i <= 40; ++i) {
+    points.push_back(MakeMapPathPoint(i * 0.5, 0.0));
+  }
+  for (int i = 1; i < 20; ++i) {
+    const double p = -M_PI_2 + M_PI * static_cast<double>(i) / 20.0;
+    points.push_back(
+        MakeMapPathPoint(20.0 + kRadius * cos(p), kRadius * (sin(p) + 1.0)));
+  }
+  for (int i = 40; i >= 0; --i) {
+    points.push_back(MakeMapPathPoint(i * 0.5, 2.0 * kRadius));
+  }
+  const Path path(points, {});
+
+  int hint_index = 0;
+  for (int i = 0; i < 1000; ++i) {
+    const double s = RandomDouble(-5.0, path.length() + 5.0);
+    const MapPathPoint point = path.GetSmoothPoint(s);
+    const Vec2d query(point.x() + RandomDouble(-6.0, 6.0),
+                      point.y() + RandomDouble(-6.0, 6.0));
+    if (i % 100 == 0) {
+      hint_index = RandomInt(-10, path.num_segments() + 10);
+    }
+    double expected_s = 0.0;
+    double expected_l = 0.0;
+    double expected_distance = 0.0;
+    EXPECT_TRUE(path.GetProjection(query, &expected_s, &expected_l,
+                                   &expected_distance));
+    double accumulate_s = 0.0;
+    double lateral = 0.0;
+    double distance = 0.0;
+    EXPECT_TRUE(path.GetProjectionWithHint(query, &hint_index, &accumulate_s,
+                                           &lateral, &distance));
+    EXPECT_DOUBLE_EQ(expected_s, accumulate_s);
+    EXPECT_DOUBLE_EQ(expected_l, lateral);
+    EXPECT_DOUBLE_EQ(expected_distance, distance);
+    EXPECT_GE(hint_index, 0);
+    EXPECT_LT(hint_index, path.num_segments());
+  }
+}
+
 TEST(TestSuite, hdmap_path_get_smooth_point) {
   const double kRadius = 50.0;
   const int kNumSegments = 100;
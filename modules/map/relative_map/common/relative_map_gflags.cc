@@ -32,3 +32,6 @@ DEFINE_bool(enable_cyclic_rerouting, false,
 
 DEFINE_bool(relative_map_generate_left_boundray, true,
             "Generate left boundary for detected lanes.");
+
+DEFINE_bool(enable_multi_thread_in_relative_map, true,
+            "Convert the navigation lines into navigation paths in parallel.");
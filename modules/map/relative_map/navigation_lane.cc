@@ -22,11 +22,13 @@
 #include "modules/map/relative_map/navigation_lane.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 #include <string>
 
 #include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/util/util.h"
@@ -152,6 +154,11 @@ void NavigationLane::UpdateNavigationInfo(
     const NavigationInfo &navigation_path) {
   navigation_info_ = navigation_path;
   last_project_index_map_.clear();
+  navigation_line_caches_.clear();
+  navigation_line_caches_.resize(navigation_info_.navigation_path_size());
+  for (auto &cache : navigation_line_caches_) {
+    cache.navi_path = std::make_shared<NavigationPath>();
+  }
   navigation_path_list_.clear();
   current_navi_path_tuple_ = std::make_tuple(-1, -1.0, -1.0, nullptr);
   if (FLAGS_enable_cyclic_rerouting) {
@@ -188,17 +195,43 @@ bool NavigationLane::GeneratePath() {
   // priority: merge > navigation line > perception lane marker
   if (config_.lane_source() == NavigationLaneConfig::OFFLINE_GENERATED &&
       navigation_line_num > 0) {
-    // Generate multiple navigation paths based on navigation lines.
-    // Don't worry about efficiency because the total number of navigation lines
-    // will not exceed 10 at most.
+    // Generate multiple navigation paths based on navigation lines, updating
+    // those of the last cycle. The lines are independent of each other, so
+    // they are processed in parallel, and the projection indices are recorded
+    // afterwards.
+    if (FLAGS_enable_multi_thread_in_relative_map && navigation_line_num > 1) {
+      std::vector<std::future<void>> results;
+      for (int i = 0; i < navigation_line_num; ++i) {
+        results.emplace_back(
+            cyber::Async(&NavigationLane::UpdateNavigationLineCache, this, i,
+                         &navigation_line_caches_[i]));
+      }
+      for (auto &result : results) {
+        result.get();
+      }
+    } else {
+      for (int i = 0; i < navigation_line_num; ++i) {
+        UpdateNavigationLineCache(i, &navigation_line_caches_[i]);
+      }
+    }
     for (int i = 0; i < navigation_line_num; ++i) {
-      auto current_navi_path = std::make_shared<NavigationPath>();
-      auto *path = current_navi_path->mutable_path();
-      if (ConvertNavigationLineToPath(i, path)) {
-        current_navi_path->set_path_priority(
+      const auto &cache = navigation_line_caches_[i];
+      if (!cache.has_path) {
+        continue;
+      }
+      const int current_project_index = cache.proj_index_pair.first;
+      if (current_project_index < 0 ||
+          current_project_index >=
+              navigation_info_.navigation_path(i).path().path_point_size()) {
+        last_project_index_map_.erase(i);
+      } else {
+        last_project_index_map_[i] = cache.proj_index_pair;
+      }
+      if (cache.converted) {
+        cache.navi_path->set_path_priority(
             navigation_info_.navigation_path(i).path_priority());
         navigation_path_list_.emplace_back(
-            i, default_left_width_, default_right_width_, current_navi_path);
+            i, default_left_width_, default_right_width_, cache.navi_path);
       }
     }
 
@@ -239,8 +272,18 @@ bool NavigationLane::GeneratePath() {
     }
 
     // Merge current navigation path where the vehicle is located with perceived
-    // lane markers.
-    auto *path = std::get<3>(current_navi_path_tuple_)->mutable_path();
+    // lane markers. The merge is done on a copy, since the navigation path is
+    // also the cached one of its navigation line.
+    const auto &cached_navi_path = std::get<3>(current_navi_path_tuple_);
+    auto merged_navi_path = std::make_shared<NavigationPath>(*cached_navi_path);
+    for (auto &navi_path_tuple : navigation_path_list_) {
+      if (std::get<0>(navi_path_tuple) ==
+          std::get<0>(current_navi_path_tuple_)) {
+        std::get<3>(navi_path_tuple) = merged_navi_path;
+      }
+    }
+    std::get<3>(current_navi_path_tuple_) = merged_navi_path;
+    auto *path = merged_navi_path->mutable_path();
     MergeNavigationLineAndLaneMarker(std::get<0>(current_navi_path_tuple_),
                                      path);
 
@@ -448,10 +491,32 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
     // path is empty
     return false;
   }
-  path->set_name(absl::StrCat("Path from navigation line index ", line_index));
   const auto &navigation_path =
       navigation_info_.navigation_path(line_index).path();
   auto proj_index_pair = UpdateProjectionIndex(navigation_path, line_index);
+  const int current_project_index = proj_index_pair.first;
+  if (current_project_index < 0 ||
+      current_project_index >= navigation_path.path_point_size()) {
+    last_project_index_map_.erase(line_index);
+  } else {
+    last_project_index_map_[line_index] = proj_index_pair;
+  }
+  int start_index = -1;
+  int end_index = -1;
+  return ConvertNavigationLineToPath(line_index, proj_index_pair, &start_index,
+                                     &end_index, path);
+}
+
+bool NavigationLane::ConvertNavigationLineToPath(
+    const int line_index, const ProjIndexPair &proj_index_pair,
+    int *const start_index, int *const end_index,
+    common::Path *const path) const {
+  CHECK_NOTNULL(start_index);
+  CHECK_NOTNULL(end_index);
+  CHECK_NOTNULL(path);
+  path->set_name(absl::StrCat("Path from navigation line index ", line_index));
+  const auto &navigation_path =
+      navigation_info_.navigation_path(line_index).path();
   // Can't find a proper projection index in the "line_index" lane according to
   // current vehicle position.
   int current_project_index = proj_index_pair.first;
@@ -459,34 +524,32 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
       current_project_index >= navigation_path.path_point_size()) {
     AERROR << "Invalid projection index " << current_project_index
            << " in line " << line_index;
-    last_project_index_map_.erase(line_index);
     return false;
-  } else {
-    last_project_index_map_[line_index] = proj_index_pair;
   }
 
-  // offset between the current vehicle state and navigation line
+  // offset between the current vehicle state and navigation line. The
+  // rotation is that of common::math::RotateVector2d(), with its sine and
+  // cosine computed once.
   const double dx = -original_pose_.position().x();
   const double dy = -original_pose_.position().y();
-  auto enu_to_flu_func = [this, dx, dy](const double enu_x, const double enu_y,
-                                        const double enu_theta, double *flu_x,
-                                        double *flu_y, double *flu_theta) {
-    if (flu_x != nullptr && flu_y != nullptr) {
-      Eigen::Vector2d flu_coordinate = common::math::RotateVector2d(
-          {enu_x + dx, enu_y + dy}, -original_pose_.heading());
-
-      *flu_x = flu_coordinate.x();
-      *flu_y = flu_coordinate.y();
-    }
-
-    if (flu_theta != nullptr) {
-      *flu_theta = common::math::NormalizeAngle(
-          common::math::NormalizeAngle(enu_theta) - original_pose_.heading());
-    }
+  const double cos_heading = std::cos(-original_pose_.heading());
+  const double sin_heading = std::sin(-original_pose_.heading());
+  auto enu_to_flu_func = [this, dx, dy, cos_heading, sin_heading](
+                             const common::PathPoint &enu_point,
+                             const double accumulated_s,
+                             common::PathPoint *flu_point) {
+    const double x = enu_point.x() + dx;
+    const double y = enu_point.y() + dy;
+    flu_point->set_x(cos_heading * x - sin_heading * y);
+    flu_point->set_y(sin_heading * x + cos_heading * y);
+    flu_point->set_theta(common::math::NormalizeAngle(
+        common::math::NormalizeAngle(enu_point.theta()) -
+        original_pose_.heading()));
+    flu_point->set_s(accumulated_s);
   };
 
   auto gen_navi_path_loop_func =
-      [this, &navigation_path, &enu_to_flu_func](
+      [&navigation_path, &enu_to_flu_func](
           const int start, const int end, const double ref_s_base,
           const double max_length, common::Path *path) {
         CHECK_NOTNULL(path);
@@ -494,19 +557,9 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
         for (int i = start; i < end; ++i) {
           auto *point = path->add_path_point();
           point->CopyFrom(navigation_path.path_point(i));
-
-          double flu_x = 0.0;
-          double flu_y = 0.0;
-          double flu_theta = 0.0;
-          enu_to_flu_func(point->x(), point->y(), point->theta(), &flu_x,
-                          &flu_y, &flu_theta);
-
-          point->set_x(flu_x);
-          point->set_y(flu_y);
-          point->set_theta(flu_theta);
           const double accumulated_s =
               navigation_path.path_point(i).s() - ref_s + ref_s_base;
-          point->set_s(accumulated_s);
+          enu_to_flu_func(navigation_path.path_point(i), accumulated_s, point);
 
           if (accumulated_s > max_length) {
             break;
@@ -537,6 +590,10 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
              << "the current_project_index is: " << current_project_index
              << " for the navigation line: " << line_index;
 
+      // A stitched path holds two ranges of points, so it is generated anew.
+      path->clear_path_point();
+      *start_index = -1;
+      *end_index = -1;
       double length = navigation_path.path_point(stitch_start_index).s() -
                       navigation_path.path_point(current_project_index).s();
       gen_navi_path_loop_func(std::max(0, current_project_index - 3),
@@ -554,15 +611,76 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
   if (dist < 20) {
     return false;
   }
-  gen_navi_path_loop_func(std::max(0, current_project_index - 3),
-                          navigation_path.path_point_size(), 0.0,
-                          config_.max_len_from_navigation_line(), path);
+
+  // The path holds the points from "start" up to the first one farther than
+  // the maximum length from it, that one included.
+  const int size = navigation_path.path_point_size();
+  const int start = std::max(0, current_project_index - 3);
+  const double ref_s = navigation_path.path_point(start).s();
+  const double max_length = config_.max_len_from_navigation_line();
+  const bool has_points = *start_index >= 0 && start >= *start_index &&
+                          start < *end_index && *end_index <= size;
+  int end = start;
+  // When the path starts farther along the line than in the last cycle, no
+  // point before the last end is farther than the maximum length from it.
+  if (has_points && ref_s >= navigation_path.path_point(*start_index).s()) {
+    end = std::max(start, *end_index - 1);
+  }
+  while (end < size && !(navigation_path.path_point(end).s() - ref_s >
+                         max_length)) {
+    ++end;
+  }
+  end = std::min(size, end + 1);
+
+  // Remove the points the vehicle has passed and those now out of range, and
+  // append the points coming into range, which are the only ones copied from
+  // the navigation line.
+  auto *path_points = path->mutable_path_point();
+  if (!has_points) {
+    path_points->Clear();
+    *start_index = start;
+    *end_index = start;
+  }
+  if (start > *start_index) {
+    path_points->DeleteSubrange(0, start - *start_index);
+  }
+  if (end < *end_index) {
+    path_points->DeleteSubrange(end - start, *end_index - end);
+  }
+  for (int i = std::max(start, *end_index); i < end; ++i) {
+    path_points->Add()->CopyFrom(navigation_path.path_point(i));
+  }
+  *start_index = start;
+  *end_index = end;
+
+  for (int i = start; i < end; ++i) {
+    enu_to_flu_func(navigation_path.path_point(i),
+                    navigation_path.path_point(i).s() - ref_s,
+                    path_points->Mutable(i - start));
+  }
   return true;
 }
 
+void NavigationLane::UpdateNavigationLineCache(
+    const int line_index, NavigationLineCache *const cache) const {
+  CHECK_NOTNULL(cache);
+  cache->converted = false;
+  cache->has_path =
+      navigation_info_.navigation_path(line_index).has_path() &&
+      navigation_info_.navigation_path(line_index).path().path_point_size() > 0;
+  if (!cache->has_path) {
+    return;
+  }
+  cache->proj_index_pair = UpdateProjectionIndex(
+      navigation_info_.navigation_path(line_index).path(), line_index);
+  cache->converted = ConvertNavigationLineToPath(
+      line_index, cache->proj_index_pair, &cache->start_index,
+      &cache->end_index, cache->navi_path->mutable_path());
+}
+
 // project adc_state_ onto path
-ProjIndexPair NavigationLane::UpdateProjectionIndex(const common::Path &path,
-                                                    const int line_index) {
+ProjIndexPair NavigationLane::UpdateProjectionIndex(
+    const common::Path &path, const int line_index) const {
   if (path.path_point_size() < 2) {
     return std::make_pair(-1, std::numeric_limits<double>::max());
   }
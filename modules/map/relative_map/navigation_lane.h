@@ -26,6 +26,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
@@ -233,6 +234,30 @@ class NavigationLane {
   bool ConvertNavigationLineToPath(const int line_index,
                                    common::Path* const path);
 
+  /**
+   * @brief Convert a navigation line into a navigation line segment, given
+   * the projection of the vehicle onto it. If the segment already holds the
+   * navigation line points of a previous conversion, only the points the
+   * vehicle has passed are removed and the points coming into range are
+   * appended, before all of them are converted into local coordinates. The
+   * function does not modify the object, so that navigation lines may be
+   * converted in parallel.
+   * @param line_index The index of the navigation line segment vector.
+   * @param proj_index_pair The projection index pair of the vehicle in the
+   * navigation line.
+   * @param start_index The index of the first navigation line point in the
+   * segment, or a negative value if the segment holds no single range of
+   * points. Updated with the new range.
+   * @param end_index The index after the last navigation line point in the
+   * segment. Updated with the new range.
+   * @param path The converted navigation line segment.
+   * @return True if a suitable path is created; false otherwise.
+   */
+  bool ConvertNavigationLineToPath(const int line_index,
+                                   const ProjIndexPair& proj_index_pair,
+                                   int* const start_index, int* const end_index,
+                                   common::Path* const path) const;
+
   /**
    * @brief Merge the navigation line segment of the vehicle's current lane and
    * the perceived lane centerline.
@@ -253,7 +278,7 @@ class NavigationLane {
    * @return Updated projection index pair.
    */
   ProjIndexPair UpdateProjectionIndex(const common::Path& path,
-                                      const int line_index);
+                                      const int line_index) const;
 
   /**
    * @brief If an entire navigation line is a cyclic/circular
@@ -264,6 +289,34 @@ class NavigationLane {
    */
   void UpdateStitchIndexInfo();
 
+  // The navigation path converted from a navigation line, which is kept from
+  // one cycle to the next and updated at its ends as the vehicle moves.
+  struct NavigationLineCache {
+    // Shared with navigation_path_list_ until the next cycle.
+    std::shared_ptr<NavigationPath> navi_path;
+    // The range of the navigation line points in navi_path, which holds no
+    // single range when start_index < 0.
+    int start_index = -1;
+    int end_index = -1;
+    // Whether the navigation line has points to project the vehicle onto.
+    bool has_path = false;
+    // The projection of the vehicle in this cycle.
+    ProjIndexPair proj_index_pair;
+    // Whether navi_path was converted in this cycle.
+    bool converted = false;
+  };
+
+  /**
+   * @brief Project the vehicle onto a navigation line and update the cached
+   * navigation path converted from it. Only the cache is modified, so that
+   * navigation lines may be updated in parallel.
+   * @param line_index The index of the navigation line segment vector.
+   * @param cache The cache of the navigation line.
+   * @return None.
+   */
+  void UpdateNavigationLineCache(const int line_index,
+                                 NavigationLineCache* const cache) const;
+
  private:
   // the configuration information required by the `NavigationLane`
   NavigationLaneConfig config_;
@@ -300,6 +353,9 @@ class NavigationLane {
   // value: stitching index pair in the "key" line.
   std::unordered_map<int, StitchIndexPair> stitch_index_map_;
 
+  // the caches of the navigation lines, indexed by line index.
+  std::vector<NavigationLineCache> navigation_line_caches_;
+
   // in world coordination: ENU
   localization::Pose original_pose_;
   common::VehicleStateProvider* vehicle_state_provider_ = nullptr;
@@ -21,6 +21,8 @@
 
 #include "modules/map/relative_map/navigation_lane.h"
 
+#include <cmath>
+
 #include "cyber/common/file.h"
 #include "gtest/gtest.h"
 #include "modules/canbus/proto/chassis.pb.h"
@@ -226,5 +228,55 @@ TEST_F(NavigationLaneTest, GenerateThreeLaneMap) {
   }
 }
 
+TEST_F(NavigationLaneTest, UpdateMapWhileMoving) {
+  navigation_line_filenames_.emplace_back(data_file_dir_ + "left.smoothed");
+  navigation_line_filenames_.emplace_back(data_file_dir_ + "middle.smoothed");
+  navigation_line_filenames_.emplace_back(data_file_dir_ + "right.smoothed");
+  EXPECT_TRUE(
+      GenerateNavigationInfo(navigation_line_filenames_, &navigation_info_));
+  navigation_lane_.UpdateNavigationInfo(navigation_info_);
+  EXPECT_TRUE(navigation_lane_.GeneratePath());
+
+  // Move the vehicle forward, so that the navigation paths of the last cycle
+  // are updated at their ends, and compare them with those generated anew.
+  localization::LocalizationEstimate localization;
+  canbus::Chassis chassis;
+  EXPECT_TRUE(cyber::common::GetProtoFromFile(
+      data_file_dir_ + "localization_info.pb.txt", &localization));
+  EXPECT_TRUE(cyber::common::GetProtoFromFile(
+      data_file_dir_ + "chassis_info.pb.txt", &chassis));
+  auto* pose = localization.mutable_pose();
+  for (int i = 0; i < 5; ++i) {
+    pose->mutable_position()->set_x(pose->position().x() +
+                                    3.0 * std::cos(pose->heading()));
+    pose->mutable_position()->set_y(pose->position().y() +
+                                    3.0 * std::sin(pose->heading()));
+    vehicle_state_provider_->Update(localization, chassis);
+    EXPECT_TRUE(navigation_lane_.GeneratePath());
+  }
+  MapMsg map_msg;
+  EXPECT_TRUE(navigation_lane_.CreateMap(map_param_, &map_msg));
+
+  NavigationLane navigation_lane;
+  RelativeMapConfig config;
+  EXPECT_TRUE(cyber::common::GetProtoFromFile(
+      FLAGS_relative_map_config_filename, &config));
+  navigation_lane.SetConfig(config.navigation_lane());
+  navigation_lane.SetVehicleStateProvider(vehicle_state_provider_.get());
+  navigation_lane.SetDefaultWidth(map_param_.default_left_width(),
+                                  map_param_.default_right_width());
+  navigation_lane.UpdateNavigationInfo(navigation_info_);
+  EXPECT_TRUE(navigation_lane.GeneratePath());
+  MapMsg expected_map_msg;
+  EXPECT_TRUE(navigation_lane.CreateMap(map_param_, &expected_map_msg));
+
+  EXPECT_EQ(expected_map_msg.hdmap().lane_size(), map_msg.hdmap().lane_size());
+  for (const auto& item : expected_map_msg.navigation_path()) {
+    const auto iter = map_msg.navigation_path().find(item.first);
+    ASSERT_TRUE(iter != map_msg.navigation_path().end()) << item.first;
+    EXPECT_EQ(item.second.DebugString(), iter->second.DebugString());
+  }
+}
+
 }  // namespace relative_map
 }  // namespace apollo
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Replays a record of a navigation mode drive into the relative map, which
+// creates a map at the loop rate of the relative_map node in record time, and
+// measures how long the map creations take. Compare runs with
+// --enable_multi_thread_in_relative_map on and off.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "cyber/record/record_reader.h"
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/vehicle_state/vehicle_state_provider.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/map/relative_map/common/relative_map_gflags.h"
+#include "modules/map/relative_map/proto/navigation.pb.h"
+#include "modules/map/relative_map/relative_map.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
+
+DEFINE_string(record_file, "",
+              "Record of a navigation mode drive, with the navigation, "
+              "localization, chassis and perception obstacle channels.");
+DEFINE_int32(iterations, 3, "Passes over the record.");
+
+namespace apollo {
+namespace relative_map {
+
+namespace {
+
+// Returns the milliseconds spent in each map creation of a pass.
+std::vector<double> ReplayRecord(const std::string& filename) {
+  auto vehicle_state_provider =
+      std::make_shared<common::VehicleStateProvider>();
+  RelativeMap relative_map;
+  std::vector<double> process_ms;
+  if (!relative_map.Init(vehicle_state_provider.get()).ok()) {
+    AERROR << "Failed to init the relative map.";
+    return process_ms;
+  }
+
+  const uint64_t period_ns = 1000000000ULL / FLAGS_relative_map_loop_rate;
+  uint64_t next_process_time = 0;
+  bool has_navigation = false;
+  bool has_localization = false;
+  cyber::record::RecordReader reader(filename);
+  cyber::record::RecordMessage message;
+  while (reader.ReadMessage(&message)) {
+    if (message.channel_name == FLAGS_navigation_topic) {
+      NavigationInfo navigation_info;
+      if (navigation_info.ParseFromString(message.content)) {
+        relative_map.OnNavigationInfo(navigation_info);
+        has_navigation = true;
+      }
+    } else if (message.channel_name == FLAGS_localization_topic) {
+      localization::LocalizationEstimate localization;
+      if (localization.ParseFromString(message.content)) {
+        relative_map.OnLocalization(localization);
+        has_localization = true;
+      }
+    } else if (message.channel_name == FLAGS_chassis_topic) {
+      canbus::Chassis chassis;
+      if (chassis.ParseFromString(message.content)) {
+        relative_map.OnChassis(chassis);
+      }
+    } else if (message.channel_name == FLAGS_perception_obstacle_topic) {
+      perception::PerceptionObstacles perception_obstacles;
+      if (perception_obstacles.ParseFromString(message.content)) {
+        relative_map.OnPerception(perception_obstacles);
+      }
+    }
+
+    if (!has_navigation || !has_localization ||
+        message.time < next_process_time) {
+      continue;
+    }
+    next_process_time = message.time + period_ns;
+    MapMsg map_msg;
+    const auto start = std::chrono::steady_clock::now();
+    relative_map.Process(&map_msg);
+    process_ms.push_back(std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - start)
+                             .count());
+  }
+  return process_ms;
+}
+
+}  // namespace
+
+int Run() {
+  for (int i = 0; i < FLAGS_iterations; ++i) {
+    std::vector<double> process_ms = ReplayRecord(FLAGS_record_file);
+    if (process_ms.empty()) {
+      AERROR << "No map was created from " << FLAGS_record_file;
+      return -1;
+    }
+    double total_ms = 0.0;
+    for (const double ms : process_ms) {
+      total_ms += ms;
+    }
+    std::sort(process_ms.begin(), process_ms.end());
+    AINFO << "Pass " << i << ": " << process_ms.size() << " maps, mean "
+          << total_ms / static_cast<double>(process_ms.size())
+          << " ms, median " << process_ms[process_ms.size() / 2]
+          << " ms, p99 " << process_ms[process_ms.size() * 99 / 100]
+          << " ms, max " << process_ms.back() << " ms";
+  }
+  return 0;
+}
+
+}  // namespace relative_map
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+  FLAGS_alsologtostderr = true;
+  FLAGS_use_navigation_mode = true;
+  return apollo::relative_map::Run();
+}
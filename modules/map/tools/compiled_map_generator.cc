@@ -0,0 +1,83 @@
+/* Copyright 2020 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "gflags/gflags.h"
+
+#include "absl/strings/match.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/adapter/opendrive_adapter.h"
+#include "modules/map/hdmap/compiled_map.h"
+#include "modules/map/hdmap/hdmap_common.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/proto/map.pb.h"
+
+/**
+ * A map tool to compile the lane index of a map, which HDMap then maps in
+ * place of building it at load time.
+ */
+
+DEFINE_string(map_file, "",
+              "Map file to compile, the base map of map_dir if empty.");
+DEFINE_string(output_file, "",
+              "Compiled map file, next to the map file if empty.");
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const std::string map_filename =
+      FLAGS_map_file.empty() ? apollo::hdmap::BaseMapFile() : FLAGS_map_file;
+  apollo::hdmap::Map pb_map;
+  const bool loaded =
+      absl::EndsWith(map_filename, ".xml")
+          ? apollo::hdmap::adapter::OpendriveAdapter::LoadData(map_filename,
+                                                               &pb_map)
+          : apollo::cyber::common::GetProtoFromFile(map_filename, &pb_map);
+  if (!loaded) {
+    AERROR << "Failed to load map from " << map_filename;
+    return -1;
+  }
+  AINFO << "Loaded map from " << map_filename;
+
+  // Lanes are added in map order, the order HDMapImpl checks them in.
+  apollo::hdmap::CompiledMapBuilder builder;
+  for (const auto &lane : pb_map.lane()) {
+    const apollo::hdmap::LaneInfo lane_info(lane);
+    if (!builder.AddLane(lane.id().id(), lane_info.points())) {
+      AERROR << "Failed to compile lane " << lane.id().id();
+      return -1;
+    }
+  }
+
+  const std::string output_file =
+      FLAGS_output_file.empty()
+          ? apollo::hdmap::CompiledMapFilename(map_filename)
+          : FLAGS_output_file;
+  if (!builder.Write(output_file)) {
+    AERROR << "Failed to write compiled map " << output_file;
+    return -1;
+  }
+
+  apollo::hdmap::CompiledMap compiled_map;
+  ACHECK(compiled_map.Load(output_file))
+      << "Failed to load generated compiled map";
+  ACHECK(compiled_map.fingerprint() == builder.fingerprint());
+
+  AINFO << "Successfully compiled " << map_filename << " to " << output_file;
+  return 0;
+}
@@ -0,0 +1,191 @@
+/* Copyright 2020 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/map/hdmap/hdmap_common.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/proto/map.pb.h"
+
+/**
+ * A map tool to benchmark the flat AABoxKDTree2d against the pointer-linked
+ * AABoxKDTree2dNode, on the lane segments of a real map, built with the
+ * parameters of HDMapImpl and queried around points sampled on its lanes.
+ */
+
+DEFINE_string(map_file, "",
+              "Map file to benchmark on, the base map of map_dir if empty.");
+DEFINE_int32(num_queries, 100000, "Number of query points.");
+DEFINE_double(query_radius, 5.0, "Radius of the range queries, in meters.");
+DEFINE_double(query_offset, 10.0,
+              "Maximum offset of the query points from the lanes, in meters.");
+
+namespace {
+
+using apollo::common::math::AABoxKDTree2d;
+using apollo::common::math::AABoxKDTree2dNode;
+using apollo::common::math::AABoxKDTreeParams;
+using apollo::common::math::Vec2d;
+using apollo::hdmap::LaneInfo;
+using apollo::hdmap::LaneSegmentBox;
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const std::string map_filename =
+      FLAGS_map_file.empty() ? apollo::hdmap::BaseMapFile() : FLAGS_map_file;
+  apollo::hdmap::Map pb_map;
+  if (!apollo::cyber::common::GetProtoFromFile(map_filename, &pb_map)) {
+    AERROR << "Failed to load map from " << map_filename;
+    return -1;
+  }
+
+  std::vector<std::unique_ptr<LaneInfo>> lanes;
+  std::vector<LaneSegmentBox> boxes;
+  for (const auto &lane : pb_map.lane()) {
+    lanes.emplace_back(new LaneInfo(lane));
+  }
+  for (const auto &lane : lanes) {
+    for (size_t id = 0; id < lane->segments().size(); ++id) {
+      const auto &segment = lane->segments()[id];
+      boxes.emplace_back(
+          apollo::common::math::AABox2d(segment.start(), segment.end()),
+          lane.get(), &segment, static_cast<int>(id));
+    }
+  }
+  if (boxes.empty()) {
+    AERROR << "No lane segment in " << map_filename;
+    return -1;
+  }
+  AINFO << "Loaded " << lanes.size() << " lanes, " << boxes.size()
+        << " segments from " << map_filename;
+
+  // The parameters of the lane segment kd-tree of HDMapImpl.
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;
+  params.max_leaf_size = 16;
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<const LaneSegmentBox *> box_ptrs;
+  for (const auto &box : boxes) {
+    box_ptrs.push_back(&box);
+  }
+  const AABoxKDTree2dNode<LaneSegmentBox> node_kdtree(box_ptrs, params, 0);
+  AINFO << "Built node kd-tree in " << MillisecondsSince(start) << " ms";
+  start = std::chrono::steady_clock::now();
+  const AABoxKDTree2d<LaneSegmentBox> kdtree(boxes, params);
+  AINFO << "Built flat kd-tree in " << MillisecondsSince(start) << " ms";
+
+  // Query points around the lanes, in the order of the segments they are
+  // sampled from, so that consecutive points are close as along a path.
+  std::mt19937 random_engine(0);
+  std::uniform_int_distribution<size_t> box_distribution(0, boxes.size() - 1);
+  std::uniform_real_distribution<double> offset_distribution(
+      -FLAGS_query_offset, FLAGS_query_offset);
+  std::vector<size_t> box_indices(FLAGS_num_queries);
+  for (auto &index : box_indices) {
+    index = box_distribution(random_engine);
+  }
+  std::sort(box_indices.begin(), box_indices.end());
+  std::vector<Vec2d> points;
+  for (const size_t index : box_indices) {
+    points.push_back(boxes[index].aabox().center() +
+                     Vec2d(offset_distribution(random_engine),
+                           offset_distribution(random_engine)));
+  }
+
+  size_t node_count = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto &point : points) {
+    node_count += node_kdtree.GetObjects(point, FLAGS_query_radius).size();
+  }
+  const double node_objects_ms = MillisecondsSince(start);
+  size_t count = 0;
+  std::vector<const LaneSegmentBox *> objects;
+  start = std::chrono::steady_clock::now();
+  for (const auto &point : points) {
+    kdtree.GetObjects(point, FLAGS_query_radius, &objects);
+    count += objects.size();
+  }
+  const double objects_ms = MillisecondsSince(start);
+  ACHECK(count == node_count) << "range queries differ: " << count << " vs "
+                              << node_count;
+  AINFO << "GetObjects: node " << node_objects_ms << " ms, flat "
+        << objects_ms << " ms, " << count << " objects";
+
+  double node_distance = 0.0;
+  start = std::chrono::steady_clock::now();
+  for (const auto &point : points) {
+    node_distance += node_kdtree.GetNearestObject(point)->DistanceTo(point);
+  }
+  const double node_nearest_ms = MillisecondsSince(start);
+  double distance = 0.0;
+  start = std::chrono::steady_clock::now();
+  for (const auto &point : points) {
+    distance += kdtree.GetNearestObject(point)->DistanceTo(point);
+  }
+  const double nearest_ms = MillisecondsSince(start);
+  double batch_distance = 0.0;
+  start = std::chrono::steady_clock::now();
+  const auto nearest_objects = kdtree.GetNearestObjects(points);
+  for (size_t i = 0; i < points.size(); ++i) {
+    batch_distance += nearest_objects[i]->DistanceTo(points[i]);
+  }
+  const double batch_nearest_ms = MillisecondsSince(start);
+  AINFO << "GetNearestObject: node " << node_nearest_ms << " ms, flat "
+        << nearest_ms << " ms, flat batch " << batch_nearest_ms
+        << " ms, mean distances " << node_distance / points.size() << " "
+        << distance / points.size() << " " << batch_distance / points.size();
+
+  const std::vector<double> radii = {FLAGS_query_radius / 2.0,
+                                     FLAGS_query_radius,
+                                     FLAGS_query_radius * 2.0};
+  start = std::chrono::steady_clock::now();
+  for (const auto &point : points) {
+    for (const double radius : radii) {
+      kdtree.GetObjects(point, radius, &objects);
+    }
+  }
+  const double radii_ms = MillisecondsSince(start);
+  std::vector<std::vector<const LaneSegmentBox *>> radii_objects;
+  start = std::chrono::steady_clock::now();
+  for (const auto &point : points) {
+    kdtree.GetObjects(point, radii, &radii_objects);
+  }
+  AINFO << "GetObjects of " << radii.size() << " radii: one by one "
+        << radii_ms << " ms, batch " << MillisecondsSince(start) << " ms";
+  return 0;
+}
@@ -0,0 +1,75 @@
+/* Copyright 2020 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+#include "gflags/gflags.h"
+
+#include "absl/strings/match.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/adapter/opendrive_adapter.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/hdmap/tiled_map.h"
+#include "modules/map/proto/map.pb.h"
+
+/**
+ * A map tool to split a map into tiles, which the base map of planning and
+ * prediction then loads around the ego pose when --use_tiled_map is set.
+ */
+
+DEFINE_string(map_file, "",
+              "Map file to split, the base map of map_dir if empty.");
+DEFINE_string(output_dir, "",
+              "Tile directory, next to the map file if empty.");
+DEFINE_double(tile_size, 500.0, "Side of the map tiles, in meters.");
+DEFINE_double(tile_margin, 100.0,
+              "Distance around a tile within which map elements are included "
+              "in it as well, in meters.");
+
+int main(int argc, char *argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const std::string map_filename =
+      FLAGS_map_file.empty() ? apollo::hdmap::BaseMapFile() : FLAGS_map_file;
+  apollo::hdmap::Map pb_map;
+  const bool loaded =
+      absl::EndsWith(map_filename, ".xml")
+          ? apollo::hdmap::adapter::OpendriveAdapter::LoadData(map_filename,
+                                                               &pb_map)
+          : apollo::cyber::common::GetProtoFromFile(map_filename, &pb_map);
+  if (!loaded) {
+    AERROR << "Failed to load map from " << map_filename;
+    return -1;
+  }
+  AINFO << "Loaded map from " << map_filename;
+
+  const std::string output_dir =
+      FLAGS_output_dir.empty()
+          ? apollo::hdmap::TiledMapDirectory(map_filename)
+          : FLAGS_output_dir;
+  if (!apollo::hdmap::WriteTiledMap(pb_map, FLAGS_tile_size, FLAGS_tile_margin,
+                                    output_dir)) {
+    AERROR << "Failed to write tiled map " << output_dir;
+    return -1;
+  }
+
+  apollo::hdmap::TiledMap tiled_map;
+  ACHECK(tiled_map.Load(output_dir)) << "Failed to load generated tiled map";
+
+  AINFO << "Successfully split " << map_filename << " into " << output_dir;
+  return 0;
+}
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
@@ -69,7 +70,6 @@ bool HDMapInput::Reset() {
 }
 
 bool HDMapInput::InitHDMap() {
-  hdmap_.reset(new apollo::hdmap::HDMap());
   const std::string model_name = "HDMapInput";
   const lib::ModelConfig* model_config = nullptr;
   if (!lib::ConfigManager::Instance()->GetModelConfig(model_name,
@@ -82,11 +82,6 @@ bool HDMapInput::InitHDMap() {
     hdmap_sample_step_ = 5;
   }
 
-  // TO DO: Decide which map to use
-  // Option 1: Use global hdmap_ = apollo::hdmap::HDMapUtil::BaseMapPtr();
-  // hdmap_ = apollo::hdmap::HDMapUtil::BaseMapPtr();
-
-  // Option2: Load own map with different hdmap_sample_step_
   // Load hdmap path from global_flagfile.txt
   hdmap_file_ = absl::StrCat(FLAGS_map_dir, "/base_map.bin");
   AINFO << "hdmap_file_: " << hdmap_file_;
@@ -94,10 +89,27 @@ bool HDMapInput::InitHDMap() {
     AERROR << "Failed to find hadmap file: " << hdmap_file_;
     return false;
   }
-  if (hdmap_->LoadMapFromFile(hdmap_file_) != 0) {
+
+  // Share the base map with the other modules of the process when it is
+  // loaded from the same file, instead of loading a second copy of it.
+  if (!FLAGS_use_navigation_mode &&
+      apollo::hdmap::BaseMapFile() == hdmap_file_) {
+    hdmap_ = apollo::hdmap::HDMapUtil::BaseMapPtr();
+    if (hdmap_ != nullptr) {
+      own_hdmap_.reset();
+      AINFO << "Use base map: " << hdmap_file_;
+      return true;
+    }
+  }
+
+  // Loaded aside, so that hdmap_ keeps pointing to a live map on failure.
+  auto hdmap = std::make_unique<apollo::hdmap::HDMap>();
+  if (hdmap->LoadMapFromFile(hdmap_file_) != 0) {
     AERROR << "Failed to load hadmap file: " << hdmap_file_;
     return false;
   }
+  own_hdmap_ = std::move(hdmap);
+  hdmap_ = own_hdmap_.get();
 
   AINFO << "Load hdmap file: " << hdmap_file_;
   return true;
@@ -107,7 +119,7 @@ bool HDMapInput::GetRoiHDMapStruct(
     const base::PointD& pointd, const double distance,
     std::shared_ptr<base::HdmapStruct> hdmap_struct_ptr) {
   lib::MutexLock lock(&mutex_);
-  if (hdmap_.get() == nullptr) {
+  if (hdmap_ == nullptr) {
     AERROR << "hdmap is not available";
     return false;
   }
@@ -411,7 +423,7 @@ bool HDMapInput::GetSignals(const Eigen::Vector3d& pointd,
                             double forward_distance,
                             std::vector<apollo::hdmap::Signal>* signals) {
   lib::MutexLock lock(&mutex_);
-  if (hdmap_.get() == nullptr) {
+  if (hdmap_ == nullptr) {
     AERROR << "hdmap is not available";
     return false;
   }
@@ -79,7 +79,9 @@ class HDMapInput {
 
   bool inited_ = false;
   lib::Mutex mutex_;
-  std::unique_ptr<apollo::hdmap::HDMap> hdmap_;
+  // Either the process wide base map or own_hdmap_.
+  const apollo::hdmap::HDMap* hdmap_ = nullptr;
+  std::unique_ptr<apollo::hdmap::HDMap> own_hdmap_;
   int hdmap_sample_step_ = 5;
   std::string hdmap_file_;
 
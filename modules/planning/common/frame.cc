@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
@@ -158,7 +159,7 @@ void Frame::UpdateReferenceLinePriority(
 
 bool Frame::CreateReferenceLineInfo(
     const std::list<ReferenceLine> &reference_lines,
-    const std::list<hdmap::RouteSegments> &segments) {
+    const std::list<hdmap::RouteSegments> &segments, const Frame *last_frame) {
   reference_line_info_.clear();
   auto ref_line_iter = reference_lines.begin();
   auto segments_iter = segments.begin();
@@ -191,7 +192,12 @@ bool Frame::CreateReferenceLineInfo(
 
   bool has_valid_reference_line = false;
   for (auto &ref_info : reference_line_info_) {
-    if (!ref_info.Init(obstacles())) {
+    const auto last_reference_line =
+        last_frame == nullptr
+            ? ReferenceLineInfo::LastReferenceLine()
+            : ReferenceLineInfo::FindLastReferenceLine(
+                  ref_info.reference_line(), last_frame->reference_line_info());
+    if (!ref_info.Init(obstacles(), last_reference_line)) {
       AERROR << "Failed to init reference line";
     } else {
       has_valid_reference_line = true;
@@ -323,14 +329,14 @@ Status Frame::Init(
     const std::list<ReferenceLine> &reference_lines,
     const std::list<hdmap::RouteSegments> &segments,
     const std::vector<routing::LaneWaypoint> &future_route_waypoints,
-    const EgoInfo *ego_info) {
+    const EgoInfo *ego_info, const Frame *last_frame) {
   // TODO(QiL): refactor this to avoid redundant nullptr checks in scenarios.
   auto status = InitFrameData(vehicle_state_provider, ego_info);
   if (!status.ok()) {
     AERROR << "failed to init frame:" << status.ToString();
     return status;
   }
-  if (!CreateReferenceLineInfo(reference_lines, segments)) {
+  if (!CreateReferenceLineInfo(reference_lines, segments, last_frame)) {
     const std::string msg = "Failed to init reference line info.";
     AERROR << msg;
     return Status(ErrorCode::PLANNING_ERROR, msg);
@@ -359,13 +365,12 @@ Status Frame::InitFrameData(
          << FLAGS_align_prediction_time;
 
   if (FLAGS_align_prediction_time) {
-    auto prediction = *(local_view_.prediction_obstacles);
-    AlignPredictionTime(vehicle_state_.timestamp(), &prediction);
-    local_view_.prediction_obstacles->CopyFrom(prediction);
+    AlignPredictionTime(vehicle_state_.timestamp(),
+                        local_view_.prediction_obstacles.get());
   }
   for (auto &ptr :
        Obstacle::CreateObstacles(*local_view_.prediction_obstacles)) {
-    AddObstacle(*ptr);
+    AddObstacle(std::move(*ptr));
   }
   if (planning_start_point_.v() < 1e-3) {
     const auto *collision_obstacle = FindCollisionObstacle(ego_info);
@@ -468,8 +473,9 @@ void Frame::AlignPredictionTime(const double planning_start_time,
 
 Obstacle *Frame::Find(const std::string &id) { return obstacles_.Find(id); }
 
-void Frame::AddObstacle(const Obstacle &obstacle) {
-  obstacles_.Add(obstacle.Id(), obstacle);
+void Frame::AddObstacle(Obstacle &&obstacle) {
+  const std::string id = obstacle.Id();
+  obstacles_.Add(id, std::move(obstacle));
 }
 
 void Frame::ReadTrafficLights() {
@@ -75,12 +75,18 @@ class Frame {
 
   const common::TrajectoryPoint &PlanningStartPoint() const;
 
+  /**
+   * @brief Init the frame.
+   * @param last_frame The last frame, if any. The reference line infos on
+   * parts of the same reference lines as its own reuse the projections of the
+   * obstacles that have not moved since.
+   */
   common::Status Init(
       const common::VehicleStateProvider *vehicle_state_provider,
       const std::list<ReferenceLine> &reference_lines,
       const std::list<hdmap::RouteSegments> &segments,
       const std::vector<routing::LaneWaypoint> &future_route_waypoints,
-      const EgoInfo *ego_info);
+      const EgoInfo *ego_info, const Frame *last_frame);
 
   common::Status InitForOpenSpace(
       const common::VehicleStateProvider *vehicle_state_provider,
@@ -188,7 +194,8 @@ class Frame {
       const EgoInfo *ego_info);
 
   bool CreateReferenceLineInfo(const std::list<ReferenceLine> &reference_lines,
-                               const std::list<hdmap::RouteSegments> &segments);
+                               const std::list<hdmap::RouteSegments> &segments,
+                               const Frame *last_frame);
 
   /**
    * Find an obstacle that collides with ADC (Autonomous Driving Car) if
@@ -204,7 +211,7 @@ class Frame {
   const Obstacle *CreateStaticVirtualObstacle(const std::string &id,
                                               const common::math::Box2d &box);
 
-  void AddObstacle(const Obstacle &obstacle);
+  void AddObstacle(Obstacle &&obstacle);
 
   void ReadTrafficLights();
 
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
@@ -56,6 +57,26 @@ class IndexedList {
     }
   }
 
+  /**
+   * @brief move object into the container. If the id is already exist,
+   * overwrite the object in the container.
+   * @param id the id of the object
+   * @param object the object to be moved to the container.
+   * @return The pointer to the object in the container.
+   */
+  T* Add(const I id, T&& object) {
+    auto obs = Find(id);
+    if (obs) {
+      AWARN << "object " << id << " is already in container";
+      *obs = std::move(object);
+      return obs;
+    } else {
+      auto* ptr = &object_dict_.emplace(id, std::move(object)).first->second;
+      object_list_.push_back(ptr);
+      return ptr;
+    }
+  }
+
   /**
    * @brief Find object by id in the container
    * @param id the id of the object
@@ -113,6 +134,11 @@ class ThreadSafeIndexedList : public IndexedList<I, T> {
     return IndexedList<I, T>::Add(id, object);
   }
 
+  T* Add(const I id, T&& object) {
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    return IndexedList<I, T>::Add(id, std::move(object));
+  }
+
   T* Find(const I id) {
     boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
     return IndexedList<I, T>::Find(id);
@@ -20,6 +20,9 @@
 
 #include "modules/planning/common/indexed_list.h"
 
+#include <string>
+#include <utility>
+
 #include "gtest/gtest.h"
 #include "modules/common/util/util.h"
 
@@ -50,6 +53,20 @@ TEST(IndexedList, Add_ConstRef) {
   }
 }
 
+TEST(IndexedList, Add_RValue) {
+  StringIndexedList object;
+  std::string one = "one";
+  ASSERT_NE(nullptr, object.Add(1, std::move(one)));
+  std::string one_again = "one_again";
+  auto* added = object.Add(1, std::move(one_again));
+  ASSERT_NE(nullptr, added);
+  ASSERT_EQ(added, object.Find(1));
+  ASSERT_EQ("one_again", *added);
+  const auto& items = object.Items();
+  ASSERT_EQ(1, items.size());
+  ASSERT_EQ("one_again", *items[0]);
+}
+
 TEST(IndexedList, Find) {
   StringIndexedList object;
   object.Add(1, "one");
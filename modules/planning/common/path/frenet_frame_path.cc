@@ -24,6 +24,7 @@
 
 #include "cyber/common/log.h"
 #include "modules/common/math/linear_interpolation.h"
+#include "modules/common/math/search.h"
 
 namespace apollo {
 namespace planning {
@@ -73,6 +74,22 @@ FrenetFramePoint FrenetFramePath::GetNearestPoint(const SLBoundary& sl) const {
 FrenetFramePoint FrenetFramePath::EvaluateByS(const double s) const {
   CHECK_GT(size(), 1U);
   auto it_lower = std::lower_bound(begin(), end(), s, LowerBoundComparator);
+  return Interpolate(it_lower, s);
+}
+
+FrenetFramePoint FrenetFramePath::EvaluateByS(const double s,
+                                              size_t* hint_index) const {
+  CHECK_GT(size(), 1U);
+  CHECK_NOTNULL(hint_index);
+  auto it_lower = common::math::LowerBoundWithHint(
+      begin(), end(), begin() + std::min(*hint_index, size()), s,
+      LowerBoundComparator);
+  *hint_index = std::distance(begin(), it_lower);
+  return Interpolate(it_lower, s);
+}
+
+FrenetFramePoint FrenetFramePath::Interpolate(const_iterator it_lower,
+                                              const double s) const {
   if (it_lower == begin()) {
     return front();
   } else if (it_lower == end()) {
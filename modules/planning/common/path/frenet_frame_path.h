@@ -36,6 +36,13 @@ class FrenetFramePath : public std::vector<common::FrenetFramePoint> {
 
   double Length() const;
   common::FrenetFramePoint EvaluateByS(const double s) const;
+  /**
+   * @brief Same as EvaluateByS(), searched from the point at hint_index, which
+   * is set to the index of the point found. Evaluations at nearby s, such as
+   * increasing ones, are faster with the same hint.
+   */
+  common::FrenetFramePoint EvaluateByS(const double s,
+                                       size_t *hint_index) const;
 
   /**
    * @brief Get the FrenetFramePoint that is within SLBoundary, or the one with
@@ -44,6 +51,9 @@ class FrenetFramePath : public std::vector<common::FrenetFramePoint> {
   common::FrenetFramePoint GetNearestPoint(const SLBoundary &sl) const;
 
  private:
+  common::FrenetFramePoint Interpolate(const_iterator it_lower,
+                                       const double s) const;
+
   static bool LowerBoundComparator(const common::FrenetFramePoint &p,
                                    const double s) {
     return p.s() < s;
@@ -115,5 +115,23 @@ TEST_F(FrenetFramePathTest, GetNearestPoint) {
   }
 }
 
+TEST_F(FrenetFramePathTest, EvaluateBySWithHint) {
+  size_t hint_index = 0;
+  for (double s = 0.0; s < 11.0; s += 0.1) {
+    const auto expected = path_->EvaluateByS(s);
+    const auto point = path_->EvaluateByS(s, &hint_index);
+    EXPECT_DOUBLE_EQ(expected.s(), point.s());
+    EXPECT_DOUBLE_EQ(expected.l(), point.l());
+    EXPECT_DOUBLE_EQ(expected.dl(), point.dl());
+    EXPECT_DOUBLE_EQ(expected.ddl(), point.ddl());
+  }
+  EXPECT_EQ(path_->size(), hint_index);
+
+  const auto point = path_->EvaluateByS(4.5, &hint_index);
+  EXPECT_DOUBLE_EQ(point.s(), 4.5);
+  EXPECT_DOUBLE_EQ(point.l(), -0.5);
+  EXPECT_EQ(4, hint_index);
+}
+
 }  // namespace planning
 }  // namespace apollo
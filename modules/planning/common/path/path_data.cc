@@ -21,11 +21,13 @@
 #include "modules/planning/common/path/path_data.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "cyber/common/log.h"
 #include "modules/common/math/cartesian_frenet_conversion.h"
+#include "modules/common/math/fast_math.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/common/util/string_util.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -172,7 +174,16 @@ std::string PathData::DebugString() const {
 
 bool PathData::SLToXY(const FrenetFramePath &frenet_path,
                       DiscretizedPath *const discretized_path) {
-  std::vector<common::PathPoint> path_points;
+  std::vector<common::math::Vec2d> cartesian_points;
+  std::vector<ReferencePoint> ref_points;
+  cartesian_points.reserve(frenet_path.size());
+  ref_points.reserve(frenet_path.size());
+  // The headings are computed in one batch, as in
+  // CartesianFrenetConverter::CalculateTheta().
+  std::vector<double> heading_ys;
+  std::vector<double> heading_xs;
+  heading_ys.reserve(frenet_path.size());
+  heading_xs.reserve(frenet_path.size());
   for (const common::FrenetFramePoint &frenet_point : frenet_path) {
     const common::SLPoint sl_point =
         PointFactory::ToSLPoint(frenet_point.s(), frenet_point.l());
@@ -181,11 +192,23 @@ bool PathData::SLToXY(const FrenetFramePath &frenet_path,
       AERROR << "Fail to convert sl point to xy point";
       return false;
     }
-    const ReferencePoint ref_point =
-        reference_line_->GetReferencePoint(frenet_point.s());
-    const double theta = CartesianFrenetConverter::CalculateTheta(
-        ref_point.heading(), ref_point.kappa(), frenet_point.l(),
-        frenet_point.dl());
+    cartesian_points.push_back(cartesian_point);
+    ref_points.push_back(reference_line_->GetReferencePoint(frenet_point.s()));
+    heading_ys.push_back(frenet_point.dl());
+    heading_xs.push_back(1 - frenet_point.l() * ref_points.back().kappa());
+  }
+  std::vector<double> thetas;
+  common::math::FastAtan2(heading_ys, heading_xs, &thetas);
+  for (size_t i = 0; i < thetas.size(); ++i) {
+    thetas[i] += ref_points[i].heading();
+  }
+  common::math::FastNormalizeAngles(&thetas);
+
+  std::vector<common::PathPoint> path_points;
+  for (size_t i = 0; i < frenet_path.size(); ++i) {
+    const common::FrenetFramePoint &frenet_point = frenet_path[i];
+    const common::math::Vec2d &cartesian_point = cartesian_points[i];
+    const ReferencePoint &ref_point = ref_points[i];
     ADEBUG << "frenet_point: " << frenet_point.ShortDebugString();
     const double kappa = CartesianFrenetConverter::CalculateKappa(
         ref_point.kappa(), ref_point.dkappa(), frenet_point.l(),
@@ -201,7 +224,7 @@ bool PathData::SLToXY(const FrenetFramePath &frenet_path,
     }
     path_points.push_back(PointFactory::ToPathPoint(cartesian_point.x(),
                                                     cartesian_point.y(), 0.0, s,
-                                                    theta, kappa, dkappa));
+                                                    thetas[i], kappa, dkappa));
   }
   *discretized_path = DiscretizedPath(std::move(path_points));
 
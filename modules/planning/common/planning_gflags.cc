@@ -148,6 +148,9 @@ DEFINE_double(look_forward_extend_distance, 50,
 DEFINE_double(reference_line_stitch_overlap_distance, 20,
               "The overlap distance with the existing reference line when "
               "stitching the existing reference line");
+DEFINE_int32(reference_line_smoothing_cache_size, 8,
+             "The number of smoothed reference lines kept to extend route "
+             "segments which are not connected to the last reference lines");
 
 DEFINE_bool(enable_smooth_reference_line, true,
             "enable smooth the map reference line");
@@ -320,6 +323,12 @@ DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_path_planning, false,
+            "Enable multiple thread to generate the candidate path boundaries "
+            "and optimize the candidate paths.");
+DEFINE_bool(enable_multi_thread_in_lattice_evaluation, false,
+            "Enable multiple thread to evaluate the longitudinal and lateral "
+            "trajectories in the lattice planner.");
 
 /// Lattice Planner
 DEFINE_double(numerical_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -61,6 +61,7 @@ DECLARE_double(rtk_trajectory_resolution);
 DECLARE_bool(enable_reference_line_stitching);
 DECLARE_double(look_forward_extend_distance);
 DECLARE_double(reference_line_stitch_overlap_distance);
+DECLARE_int32(reference_line_smoothing_cache_size);
 
 DECLARE_bool(enable_smooth_reference_line);
 
@@ -154,6 +155,8 @@ DECLARE_bool(enable_sqp_solver);
 /// thread pool
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_path_planning);
+DECLARE_bool(enable_multi_thread_in_lattice_evaluation);
 
 DECLARE_double(numerical_epsilon);
 DECLARE_double(default_cruise_speed);
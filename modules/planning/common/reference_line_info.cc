@@ -21,6 +21,7 @@
 #include "modules/planning/common/reference_line_info.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "absl/strings/str_cat.h"
 #include "cyber/task/task.h"
@@ -44,6 +45,62 @@ using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 using apollo::common::util::PointFactory;
 
+namespace {
+
+// The perception SL boundary of an obstacle in the reference line info of the
+// last frame on the same reference line, shifted to the s of this one, if its
+// perception bounding box is the same, which is the one the projection would
+// give. The boundary must keep away from where either line ends before the
+// other by more than its lateral distance to the lines, so that their nearest
+// segments are shared unless the line turns back on itself that close.
+bool LastPerceptionSlBoundary(
+    const Obstacle* obstacle,
+    const ReferenceLineInfo::LastReferenceLine& last_reference_line,
+    SLBoundary* perception_sl_boundary) {
+  if (obstacle == nullptr ||
+      last_reference_line.reference_line_info == nullptr) {
+    return false;
+  }
+  const Obstacle* last_obstacle =
+      last_reference_line.reference_line_info->path_decision().Find(
+          obstacle->Id());
+  // The boundary has no points if the projection failed.
+  if (last_obstacle == nullptr ||
+      last_obstacle->PerceptionSLBoundary().boundary_point().empty()) {
+    return false;
+  }
+  const Box2d& box = obstacle->PerceptionBoundingBox();
+  const Box2d& last_box = last_obstacle->PerceptionBoundingBox();
+  if (box.center_x() != last_box.center_x() ||
+      box.center_y() != last_box.center_y() ||
+      box.heading() != last_box.heading() ||
+      box.length() != last_box.length() || box.width() != last_box.width()) {
+    return false;
+  }
+  const SLBoundary& last_sl_boundary = last_obstacle->PerceptionSLBoundary();
+  const double s_offset = last_reference_line.s_offset;
+  const double margin = std::fmax(std::fabs(last_sl_boundary.start_l()),
+                                  std::fabs(last_sl_boundary.end_l())) +
+                        common::math::kMathEpsilon;
+  if (last_sl_boundary.start_s() - s_offset - margin <
+          last_reference_line.start_s ||
+      last_sl_boundary.end_s() - s_offset + margin >
+          last_reference_line.end_s) {
+    return false;
+  }
+  *perception_sl_boundary = last_sl_boundary;
+  if (s_offset != 0.0) {
+    perception_sl_boundary->set_start_s(last_sl_boundary.start_s() - s_offset);
+    perception_sl_boundary->set_end_s(last_sl_boundary.end_s() - s_offset);
+    for (auto& point : *perception_sl_boundary->mutable_boundary_point()) {
+      point.set_s(point.s() - s_offset);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 std::unordered_map<std::string, bool>
     ReferenceLineInfo::junction_right_of_way_map_;
 
@@ -56,7 +113,50 @@ ReferenceLineInfo::ReferenceLineInfo(const common::VehicleState& vehicle_state,
       reference_line_(reference_line),
       lanes_(segments) {}
 
-bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
+ReferenceLineInfo::LastReferenceLine ReferenceLineInfo::FindLastReferenceLine(
+    const ReferenceLine& reference_line,
+    const std::list<ReferenceLineInfo>& last_reference_line_infos) {
+  LastReferenceLine last_reference_line;
+  const auto& points = reference_line.reference_points();
+  if (points.empty()) {
+    return last_reference_line;
+  }
+  const auto same_xy = [](const ReferencePoint& point,
+                          const ReferencePoint& last_point) {
+    return point.x() == last_point.x() && point.y() == last_point.y();
+  };
+  for (const auto& last_ref_info : last_reference_line_infos) {
+    const auto& last_points =
+        last_ref_info.reference_line().reference_points();
+    const auto first = std::find_if(
+        last_points.begin(), last_points.end(),
+        [&](const ReferencePoint& point) { return same_xy(points[0], point); });
+    const size_t first_index = std::distance(last_points.begin(), first);
+    const size_t num_points =
+        std::min(points.size(), last_points.size() - first_index);
+    if (num_points < 2 ||
+        !std::equal(points.begin(), points.begin() + num_points, first,
+                    same_xy)) {
+      continue;
+    }
+    last_reference_line.reference_line_info = &last_ref_info;
+    last_reference_line.s_offset =
+        last_ref_info.reference_line().map_path().accumulated_s()[first_index];
+    if (first_index > 0) {
+      last_reference_line.start_s = 0.0;
+    }
+    if (num_points < points.size() ||
+        first_index + num_points < last_points.size()) {
+      last_reference_line.end_s =
+          reference_line.map_path().accumulated_s()[num_points - 1];
+    }
+    return last_reference_line;
+  }
+  return last_reference_line;
+}
+
+bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles,
+                             const LastReferenceLine& last_reference_line) {
   const auto& param = VehicleConfigHelper::GetConfig().vehicle_param();
   // stitching point
   const auto& path_point = adc_planning_point_.path_point();
@@ -93,7 +193,7 @@ bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
     return false;
   }
   is_on_reference_line_ = reference_line_.IsOnLane(adc_sl_boundary_);
-  if (!AddObstacles(obstacles)) {
+  if (!AddObstacles(obstacles, last_reference_line)) {
     AERROR << "Failed to add obstacles to reference line";
     return false;
   }
@@ -354,6 +454,11 @@ bool ReferenceLineInfo::AddObstacleHelper(
 
 // AddObstacle is thread safe
 Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
+  return AddObstacle(obstacle, nullptr);
+}
+
+Obstacle* ReferenceLineInfo::AddObstacle(
+    const Obstacle* obstacle, const SLBoundary* perception_sl_boundary) {
   if (!obstacle) {
     AERROR << "The provided obstacle is empty";
     return nullptr;
@@ -364,13 +469,17 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
     return nullptr;
   }
 
-  SLBoundary perception_sl;
-  if (!reference_line_.GetSLBoundary(obstacle->PerceptionBoundingBox(),
-                                     &perception_sl)) {
-    AERROR << "Failed to get sl boundary for obstacle: " << obstacle->Id();
-    return mutable_obstacle;
+  if (perception_sl_boundary != nullptr) {
+    mutable_obstacle->SetPerceptionSlBoundary(*perception_sl_boundary);
+  } else {
+    SLBoundary perception_sl;
+    if (!reference_line_.GetSLBoundary(obstacle->PerceptionBoundingBox(),
+                                       &perception_sl)) {
+      AERROR << "Failed to get sl boundary for obstacle: " << obstacle->Id();
+      return mutable_obstacle;
+    }
+    mutable_obstacle->SetPerceptionSlBoundary(perception_sl);
   }
-  mutable_obstacle->SetPerceptionSlBoundary(perception_sl);
   mutable_obstacle->CheckLaneBlocking(reference_line_);
   if (mutable_obstacle->IsLaneBlocking()) {
     ADEBUG << "obstacle [" << obstacle->Id() << "] is lane blocking.";
@@ -402,11 +511,29 @@ Obstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
 
 bool ReferenceLineInfo::AddObstacles(
     const std::vector<const Obstacle*>& obstacles) {
+  return AddObstacles(obstacles, LastReferenceLine());
+}
+
+bool ReferenceLineInfo::AddObstacles(
+    const std::vector<const Obstacle*>& obstacles,
+    const LastReferenceLine& last_reference_line) {
+  std::vector<SLBoundary> last_sl_boundaries(obstacles.size());
+  std::vector<const SLBoundary*> perception_sl_boundaries(obstacles.size(),
+                                                          nullptr);
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    if (LastPerceptionSlBoundary(obstacles[i], last_reference_line,
+                                 &last_sl_boundaries[i])) {
+      perception_sl_boundaries[i] = &last_sl_boundaries[i];
+    }
+  }
   if (FLAGS_use_multi_thread_to_add_obstacles) {
     std::vector<std::future<Obstacle*>> results;
-    for (const auto* obstacle : obstacles) {
-      results.push_back(
-          cyber::Async(&ReferenceLineInfo::AddObstacle, this, obstacle));
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+      const auto* obstacle = obstacles[i];
+      const auto* perception_sl_boundary = perception_sl_boundaries[i];
+      results.push_back(cyber::Async([this, obstacle, perception_sl_boundary] {
+        return AddObstacle(obstacle, perception_sl_boundary);
+      }));
     }
     for (auto& result : results) {
       if (!result.get()) {
@@ -415,9 +542,9 @@ bool ReferenceLineInfo::AddObstacles(
       }
     }
   } else {
-    for (const auto* obstacle : obstacles) {
-      if (!AddObstacle(obstacle)) {
-        AERROR << "Failed to add obstacle " << obstacle->Id();
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+      if (!AddObstacle(obstacles[i], perception_sl_boundaries[i])) {
+        AERROR << "Failed to add obstacle " << obstacles[i]->Id();
         return false;
       }
     }
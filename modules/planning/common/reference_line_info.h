@@ -28,6 +28,7 @@
 #include <utility>
 #include <vector>
 
+#include "gtest/gtest_prod.h"
 #include "modules/common/proto/drive_state.pb.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
@@ -61,7 +62,39 @@ class ReferenceLineInfo {
                     const ReferenceLine& reference_line,
                     const hdmap::RouteSegments& segments);
 
-  bool Init(const std::vector<const Obstacle*>& obstacles);
+  /**
+   * @brief The reference line info of the last frame whose reference line
+   * has the same points as this one from s_offset on, as when the same
+   * reference line is segmented around the moving ego.
+   */
+  struct LastReferenceLine {
+    const ReferenceLineInfo* reference_line_info = nullptr;
+    // s on the last reference line of the start of this one.
+    double s_offset = 0.0;
+    // Range of s on this reference line past which one of the lines ends
+    // before the other, so that the projections may differ.
+    double start_s = std::numeric_limits<double>::lowest();
+    double end_s = std::numeric_limits<double>::max();
+  };
+
+  /**
+   * @brief Finds the reference line info of the last frame whose reference
+   * line has the same points as the given one from where the given one
+   * starts. Reference lines are segmented around the ego every frame, so
+   * that they start further along the same reference line as the ego moves.
+   */
+  static LastReferenceLine FindLastReferenceLine(
+      const ReferenceLine& reference_line,
+      const std::list<ReferenceLineInfo>& last_reference_line_infos);
+
+  /**
+   * @brief Init the reference line info with the obstacles of the frame.
+   * @param last_reference_line The reference line info of the last frame on
+   * the same reference line, if any, whose perception SL boundaries are
+   * reused for the obstacles that have not moved.
+   */
+  bool Init(const std::vector<const Obstacle*>& obstacles,
+            const LastReferenceLine& last_reference_line);
 
   bool AddObstacles(const std::vector<const Obstacle*>& obstacles);
   Obstacle* AddObstacle(const Obstacle* obstacle);
@@ -274,6 +307,15 @@ class ReferenceLineInfo {
 
   bool AddObstacleHelper(const std::shared_ptr<Obstacle>& obstacle);
 
+  FRIEND_TEST(ReferenceLineInfoTest, ReusesPerceptionSlBoundaries);
+  bool AddObstacles(const std::vector<const Obstacle*>& obstacles,
+                    const LastReferenceLine& last_reference_line);
+
+  // Adds the obstacle with its perception SL boundary if given, or projects
+  // its perception bounding box.
+  Obstacle* AddObstacle(const Obstacle* obstacle,
+                        const SLBoundary* perception_sl_boundary);
+
   bool GetFirstOverlap(const std::vector<hdmap::PathOverlap>& path_overlaps,
                        hdmap::PathOverlap* path_overlap);
 
@@ -20,7 +20,11 @@
 
 #include "modules/planning/common/reference_line_info.h"
 
+#include <cmath>
+#include <list>
+
 #include "gtest/gtest.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/planning/proto/planning.pb.h"
 
 namespace apollo {
@@ -49,5 +53,105 @@ TEST_F(ReferenceLineInfoTest, BasicTest) {
             ADCTrajectory::SPEED_FALLBACK);
 }
 
+TEST_F(ReferenceLineInfoTest, ReusesPerceptionSlBoundaries) {
+  // Points every meter along an arc of 200 m radius, of which the last and
+  // the current reference lines keep those around the ego, 20 m further on
+  // in the current one.
+  static constexpr double kRadius = 200.0;
+  std::vector<ReferencePoint> points;
+  for (int i = 0; i < 300; ++i) {
+    const double theta = i / kRadius;
+    points.emplace_back(
+        hdmap::MapPathPoint({kRadius * std::sin(theta),
+                             kRadius * (1.0 - std::cos(theta))},
+                            theta),
+        1.0 / kRadius, 0.0);
+  }
+  const ReferenceLine last_line(
+      std::vector<ReferencePoint>(points.begin(), points.begin() + 250));
+  const ReferenceLine line(
+      std::vector<ReferencePoint>(points.begin() + 20, points.begin() + 280));
+
+  common::VehicleState vehicle_state;
+  common::TrajectoryPoint adc_planning_point;
+  const hdmap::RouteSegments segments;
+  std::list<ReferenceLineInfo> last_reference_line_infos;
+  last_reference_line_infos.emplace_back(vehicle_state, adc_planning_point,
+                                         last_line, segments);
+
+  // A car 3 m to the left of the arc, 100 m along it.
+  perception::PerceptionObstacle perception_obstacle;
+  perception_obstacle.set_id(1);
+  const double theta = 100.0 / kRadius;
+  perception_obstacle.mutable_position()->set_x((kRadius - 3.0) *
+                                                std::sin(theta));
+  perception_obstacle.mutable_position()->set_y(
+      kRadius - (kRadius - 3.0) * std::cos(theta));
+  perception_obstacle.set_theta(theta);
+  perception_obstacle.set_length(4.5);
+  perception_obstacle.set_width(2.0);
+  const Obstacle obstacle("1", perception_obstacle,
+                          prediction::ObstaclePriority::NORMAL, false);
+  ASSERT_TRUE(last_reference_line_infos.front().AddObstacles({&obstacle}));
+
+  const auto last_reference_line = ReferenceLineInfo::FindLastReferenceLine(
+      line, last_reference_line_infos);
+  ASSERT_EQ(&last_reference_line_infos.front(),
+            last_reference_line.reference_line_info);
+  EXPECT_NEAR(20.0, last_reference_line.s_offset, 1e-2);
+
+  SLBoundary projected;
+  ASSERT_TRUE(line.GetSLBoundary(obstacle.PerceptionBoundingBox(), &projected));
+  ReferenceLineInfo reference_line_info(vehicle_state, adc_planning_point, line,
+                                        segments);
+  ASSERT_TRUE(
+      reference_line_info.AddObstacles({&obstacle}, last_reference_line));
+  const SLBoundary& reused =
+      reference_line_info.path_decision()->Find("1")->PerceptionSLBoundary();
+  EXPECT_NEAR(projected.start_s(), reused.start_s(), 1e-6);
+  EXPECT_NEAR(projected.end_s(), reused.end_s(), 1e-6);
+  EXPECT_NEAR(projected.start_l(), reused.start_l(), 1e-6);
+  EXPECT_NEAR(projected.end_l(), reused.end_l(), 1e-6);
+  ASSERT_EQ(projected.boundary_point_size(), reused.boundary_point_size());
+  for (int i = 0; i < projected.boundary_point_size(); ++i) {
+    EXPECT_NEAR(projected.boundary_point(i).s(), reused.boundary_point(i).s(),
+                1e-6);
+    EXPECT_NEAR(projected.boundary_point(i).l(), reused.boundary_point(i).l(),
+                1e-6);
+  }
+
+  // The boundary is taken from the last frame, not projected again.
+  Obstacle* last_obstacle =
+      last_reference_line_infos.front().path_decision()->Find("1");
+  SLBoundary marked = last_obstacle->PerceptionSLBoundary();
+  marked.set_start_l(marked.start_l() - 0.5);
+  last_obstacle->SetPerceptionSlBoundary(marked);
+  ReferenceLineInfo marked_reference_line_info(
+      vehicle_state, adc_planning_point, line, segments);
+  ASSERT_TRUE(marked_reference_line_info.AddObstacles({&obstacle},
+                                                      last_reference_line));
+  EXPECT_DOUBLE_EQ(marked.start_l(), marked_reference_line_info.path_decision()
+                                         ->Find("1")
+                                         ->PerceptionSLBoundary()
+                                         .start_l());
+
+  // A moved obstacle is projected again.
+  perception_obstacle.mutable_position()->set_x(
+      perception_obstacle.position().x() + 0.1);
+  const Obstacle moved_obstacle("1", perception_obstacle,
+                                prediction::ObstaclePriority::NORMAL, false);
+  ReferenceLineInfo moved_reference_line_info(vehicle_state, adc_planning_point,
+                                              line, segments);
+  ASSERT_TRUE(moved_reference_line_info.AddObstacles({&moved_obstacle},
+                                                     last_reference_line));
+  ASSERT_TRUE(line.GetSLBoundary(moved_obstacle.PerceptionBoundingBox(),
+                                 &projected));
+  EXPECT_DOUBLE_EQ(projected.start_l(),
+                   moved_reference_line_info.path_decision()
+                       ->Find("1")
+                       ->PerceptionSLBoundary()
+                       .start_l());
+}
+
 }  // namespace planning
 }  // namespace apollo
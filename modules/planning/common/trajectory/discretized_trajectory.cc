@@ -20,10 +20,12 @@
 
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/linear_interpolation.h"
+#include "modules/common/math/search.h"
 #include "modules/planning/common/planning_context.h"
 
 namespace apollo {
@@ -50,7 +52,25 @@ TrajectoryPoint DiscretizedTrajectory::Evaluate(
   };
 
   auto it_lower = std::lower_bound(begin(), end(), relative_time, comp);
+  return Interpolate(it_lower, relative_time);
+}
+
+TrajectoryPoint DiscretizedTrajectory::Evaluate(const double relative_time,
+                                                size_t* hint_index) const {
+  CHECK_NOTNULL(hint_index);
+  auto comp = [](const TrajectoryPoint& p, const double relative_time) {
+    return p.relative_time() < relative_time;
+  };
+
+  auto it_lower = common::math::LowerBoundWithHint(
+      begin(), end(), begin() + std::min(*hint_index, size()), relative_time,
+      comp);
+  *hint_index = std::distance(begin(), it_lower);
+  return Interpolate(it_lower, relative_time);
+}
 
+TrajectoryPoint DiscretizedTrajectory::Interpolate(
+    const_iterator it_lower, const double relative_time) const {
   if (it_lower == begin()) {
     return front();
   } else if (it_lower == end()) {
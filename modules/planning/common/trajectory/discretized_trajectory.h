@@ -54,6 +54,14 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
 
   virtual common::TrajectoryPoint Evaluate(const double relative_time) const;
 
+  /**
+   * @brief Same as Evaluate(), searched from the point at hint_index, which is
+   * set to the index of the point found. Evaluations at nearby times, such as
+   * increasing ones, are faster with the same hint.
+   */
+  common::TrajectoryPoint Evaluate(const double relative_time,
+                                   size_t* hint_index) const;
+
   virtual size_t QueryLowerBoundPoint(const double relative_time,
                                       const double epsilon = 1.0e-5) const;
 
@@ -79,6 +87,10 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
   size_t NumOfPoints() const;
 
   virtual void Clear();
+
+ private:
+  common::TrajectoryPoint Interpolate(const_iterator it_lower,
+                                      const double relative_time) const;
 };
 
 inline size_t DiscretizedTrajectory::NumOfPoints() const { return size(); }
@@ -52,5 +52,27 @@ TEST(basic_test, DiscretizedTrajectory) {
   EXPECT_EQ(discretized_trajectory.NumOfPoints(), 121);
 }
 
+TEST(basic_test, EvaluateWithHint) {
+  const std::string path_of_standard_trajectory =
+      "modules/planning/testdata/trajectory_data/standard_trajectory.pb.txt";
+  ADCTrajectory trajectory;
+  EXPECT_TRUE(cyber::common::GetProtoFromFile(path_of_standard_trajectory,
+                                              &trajectory));
+  DiscretizedTrajectory discretized_trajectory(trajectory);
+  size_t hint_index = 0;
+  for (double t = -1.0; t < 9.0; t += 0.05) {
+    const auto expected = discretized_trajectory.Evaluate(t);
+    const auto p = discretized_trajectory.Evaluate(t, &hint_index);
+    EXPECT_DOUBLE_EQ(expected.path_point().x(), p.path_point().x());
+    EXPECT_DOUBLE_EQ(expected.path_point().y(), p.path_point().y());
+    EXPECT_DOUBLE_EQ(expected.relative_time(), p.relative_time());
+  }
+  EXPECT_EQ(discretized_trajectory.NumOfPoints(), hint_index);
+
+  const auto p1 = discretized_trajectory.Evaluate(4.0, &hint_index);
+  EXPECT_DOUBLE_EQ(p1.path_point().x(), 587263.01182131236);
+  EXPECT_DOUBLE_EQ(p1.path_point().y(), 4140966.5720794979);
+}
+
 }  // namespace planning
 }  // namespace apollo
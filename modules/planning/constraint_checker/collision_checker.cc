@@ -43,7 +43,9 @@ CollisionChecker::CollisionChecker(
     const double ego_vehicle_d,
     const std::vector<PathPoint>& discretized_reference_line,
     const ReferenceLineInfo* ptr_reference_line_info,
-    const std::shared_ptr<PathTimeGraph>& ptr_path_time_graph) {
+    const std::shared_ptr<PathTimeGraph>& ptr_path_time_graph)
+    : predicted_bounding_rectangles_(
+          common::VehicleConfigHelper::GetConfig().vehicle_param().length()) {
   ptr_reference_line_info_ = ptr_reference_line_info;
   ptr_path_time_graph_ = ptr_path_time_graph;
   BuildPredictedEnvironment(obstacles, ego_vehicle_s, ego_vehicle_d,
@@ -85,7 +87,7 @@ bool CollisionChecker::InCollision(
 bool CollisionChecker::InCollision(
     const DiscretizedTrajectory& discretized_trajectory) {
   CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+           predicted_bounding_rectangles_.num_slices());
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
@@ -104,10 +106,8 @@ bool CollisionChecker::InCollision(
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+    if (predicted_bounding_rectangles_.HasOverlap(i, ego_box)) {
+      return true;
     }
   }
   return false;
@@ -117,7 +117,7 @@ void CollisionChecker::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles, const double ego_vehicle_s,
     const double ego_vehicle_d,
     const std::vector<PathPoint>& discretized_reference_line) {
-  ACHECK(predicted_bounding_rectangles_.empty());
+  ACHECK(predicted_bounding_rectangles_.num_slices() == 0);
 
   // If the ego vehicle is in lane,
   // then, ignore all obstacles from the same lane.
@@ -149,7 +149,7 @@ void CollisionChecker::BuildPredictedEnvironment(
       box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
       predicted_env.push_back(std::move(box));
     }
-    predicted_bounding_rectangles_.push_back(std::move(predicted_env));
+    predicted_bounding_rectangles_.AddSlice(std::move(predicted_env));
     relative_time += FLAGS_trajectory_time_resolution;
   }
 }
@@ -27,6 +27,7 @@
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/constraint_checker/occupancy_slices.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
 
 namespace apollo {
@@ -64,7 +65,9 @@ class CollisionChecker {
  private:
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+  // The inflated boxes of the obstacles at each time step of a trajectory,
+  // in cells as long as the ego vehicle, so that an ego box covers a few.
+  OccupancySlices predicted_bounding_rectangles_;
 };
 
 }  // namespace planning
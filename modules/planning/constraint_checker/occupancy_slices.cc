@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/occupancy_slices.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+
+namespace {
+
+constexpr int kMaxNumCellsPerSide = 64;
+
+}  // namespace
+
+OccupancySlices::OccupancySlices(const double cell_size)
+    : cell_size_(cell_size) {
+  CHECK_GT(cell_size_, 0.0);
+}
+
+void OccupancySlices::AddSlice(std::vector<Box2d> boxes) {
+  slices_.emplace_back();
+  Slice& slice = slices_.back();
+  slice.boxes = std::move(boxes);
+  if (slice.boxes.empty()) {
+    return;
+  }
+
+  slice.min_x = slice.boxes.front().min_x();
+  slice.max_x = slice.boxes.front().max_x();
+  slice.min_y = slice.boxes.front().min_y();
+  slice.max_y = slice.boxes.front().max_y();
+  for (const Box2d& box : slice.boxes) {
+    slice.min_x = std::min(slice.min_x, box.min_x());
+    slice.max_x = std::max(slice.max_x, box.max_x());
+    slice.min_y = std::min(slice.min_y, box.min_y());
+    slice.max_y = std::max(slice.max_y, box.max_y());
+  }
+  const double cell_size =
+      std::max({cell_size_, (slice.max_x - slice.min_x) / kMaxNumCellsPerSide,
+                (slice.max_y - slice.min_y) / kMaxNumCellsPerSide});
+  slice.inverse_cell_size = 1.0 / cell_size;
+  slice.num_cells_x =
+      static_cast<int>((slice.max_x - slice.min_x) * slice.inverse_cell_size) +
+      1;
+  slice.num_cells_y =
+      static_cast<int>((slice.max_y - slice.min_y) * slice.inverse_cell_size) +
+      1;
+
+  // Bucket the boxes by the cells their bounding boxes cover.
+  slice.cell_begins.assign(slice.num_cells_x * slice.num_cells_y + 1, 0);
+  for (const Box2d& box : slice.boxes) {
+    const int max_x = slice.CellX(box.max_x());
+    const int max_y = slice.CellY(box.max_y());
+    for (int x = slice.CellX(box.min_x()); x <= max_x; ++x) {
+      for (int y = slice.CellY(box.min_y()); y <= max_y; ++y) {
+        ++slice.cell_begins[x * slice.num_cells_y + y + 1];
+      }
+    }
+  }
+  for (size_t i = 1; i < slice.cell_begins.size(); ++i) {
+    slice.cell_begins[i] += slice.cell_begins[i - 1];
+  }
+  slice.box_indices.resize(slice.cell_begins.back());
+  std::vector<size_t> cell_ends(slice.cell_begins.begin(),
+                                slice.cell_begins.end() - 1);
+  for (size_t i = 0; i < slice.boxes.size(); ++i) {
+    const Box2d& box = slice.boxes[i];
+    const int max_x = slice.CellX(box.max_x());
+    const int max_y = slice.CellY(box.max_y());
+    for (int x = slice.CellX(box.min_x()); x <= max_x; ++x) {
+      for (int y = slice.CellY(box.min_y()); y <= max_y; ++y) {
+        slice.box_indices[cell_ends[x * slice.num_cells_y + y]++] = i;
+      }
+    }
+  }
+}
+
+const std::vector<Box2d>& OccupancySlices::boxes(
+    const size_t slice_index) const {
+  CHECK_LT(slice_index, slices_.size());
+  return slices_[slice_index].boxes;
+}
+
+bool OccupancySlices::HasOverlap(const size_t slice_index,
+                                 const Box2d& box) const {
+  CHECK_LT(slice_index, slices_.size());
+  const Slice& slice = slices_[slice_index];
+  if (slice.boxes.empty() || box.max_x() < slice.min_x ||
+      box.min_x() > slice.max_x || box.max_y() < slice.min_y ||
+      box.min_y() > slice.max_y) {
+    return false;
+  }
+  const int max_x = slice.CellX(box.max_x());
+  const int max_y = slice.CellY(box.max_y());
+  for (int x = slice.CellX(box.min_x()); x <= max_x; ++x) {
+    for (int y = slice.CellY(box.min_y()); y <= max_y; ++y) {
+      const int cell = x * slice.num_cells_y + y;
+      for (size_t i = slice.cell_begins[cell]; i < slice.cell_begins[cell + 1];
+           ++i) {
+        const Box2d& other = slice.boxes[slice.box_indices[i]];
+        // Two boxes whose bounding boxes overlap share the cell of the lower
+        // corner of the overlap, which is the only cell they are checked in.
+        if (slice.CellX(std::max(box.min_x(), other.min_x())) != x ||
+            slice.CellY(std::max(box.min_y(), other.min_y())) != y) {
+          continue;
+        }
+        if (box.HasOverlap(other)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// The cells of the coordinates out of the grid are those of its edges, which
+// keeps the cells in the order of the coordinates.
+int OccupancySlices::Slice::CellX(const double x) const {
+  const int cell = static_cast<int>((x - min_x) * inverse_cell_size);
+  return std::max(0, std::min(cell, num_cells_x - 1));
+}
+
+int OccupancySlices::Slice::CellY(const double y) const {
+  const int cell = static_cast<int>((y - min_y) * inverse_cell_size);
+  return std::max(0, std::min(cell, num_cells_y - 1));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class OccupancySlices
+ * @brief The boxes occupied by the obstacles at a sequence of time steps.
+ * The boxes of each step are indexed by the cells of a uniform grid that
+ * their axis-aligned bounding boxes cover, so that a box is only checked
+ * against the boxes sharing a cell with it. A single slice indexes static
+ * obstacles.
+ */
+class OccupancySlices {
+ public:
+  explicit OccupancySlices(const double cell_size);
+
+  /**
+   * @brief Appends the boxes occupied at the next time step.
+   */
+  void AddSlice(std::vector<common::math::Box2d> boxes);
+
+  size_t num_slices() const { return slices_.size(); }
+
+  const std::vector<common::math::Box2d>& boxes(
+      const size_t slice_index) const;
+
+  /**
+   * @brief Whether a box overlaps any box of a slice, as Box2d::HasOverlap
+   * checks each of them.
+   */
+  bool HasOverlap(const size_t slice_index,
+                  const common::math::Box2d& box) const;
+
+ private:
+  struct Slice {
+    std::vector<common::math::Box2d> boxes;
+    // The grid over the bounding boxes of the boxes. Its cells are at least
+    // cell_size long, and longer when the boxes are far apart, which bounds
+    // the number of cells.
+    double inverse_cell_size = 0.0;
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+    int num_cells_x = 0;
+    int num_cells_y = 0;
+    // The boxes of the i-th cell, numbered along y first, are
+    // box_indices[cell_begins[i], cell_begins[i + 1]).
+    std::vector<size_t> cell_begins;
+    std::vector<size_t> box_indices;
+
+    int CellX(const double x) const;
+    int CellY(const double y) const;
+  };
+
+ private:
+  double cell_size_ = 1.0;
+  std::vector<Slice> slices_;
+};
+
+}  // namespace planning
+}  // namespace apollo
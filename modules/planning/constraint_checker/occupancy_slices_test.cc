@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/occupancy_slices.h"
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+class RandomBoxes {
+ public:
+  explicit RandomBoxes(const unsigned int seed) : engine_(seed) {}
+
+  Box2d Box(const double center_range, const double max_length) {
+    std::uniform_real_distribution<double> center(-center_range, center_range);
+    std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+    std::uniform_real_distribution<double> length(0.1, max_length);
+    return Box2d(Vec2d(center(engine_), center(engine_)), heading(engine_),
+                 length(engine_), length(engine_));
+  }
+
+  std::vector<Box2d> Boxes(const size_t num_boxes, const double center_range,
+                           const double max_length) {
+    std::vector<Box2d> boxes;
+    for (size_t i = 0; i < num_boxes; ++i) {
+      boxes.push_back(Box(center_range, max_length));
+    }
+    return boxes;
+  }
+
+ private:
+  std::mt19937 engine_;
+};
+
+bool HasOverlapByScan(const std::vector<Box2d>& boxes, const Box2d& box) {
+  for (const Box2d& other : boxes) {
+    if (box.HasOverlap(other)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Checks the grid of each slice against a scan over all of its boxes, with
+// queries spread over twice the range of the slices, so that some lie
+// outside of their bounds.
+void ExpectSameAsScan(const OccupancySlices& slices, const double query_range,
+                      RandomBoxes* random_boxes) {
+  int num_overlaps = 0;
+  for (size_t i = 0; i < slices.num_slices(); ++i) {
+    for (int k = 0; k < 2000; ++k) {
+      const Box2d box = random_boxes->Box(2.0 * query_range, 6.0);
+      const bool expected = HasOverlapByScan(slices.boxes(i), box);
+      EXPECT_EQ(expected, slices.HasOverlap(i, box))
+          << "slice " << i << ", box " << box.DebugString();
+      num_overlaps += expected ? 1 : 0;
+    }
+  }
+  // Both answers are exercised.
+  EXPECT_GT(num_overlaps, 0);
+}
+
+}  // namespace
+
+TEST(OccupancySlicesTest, MatchesScanForCellSizes) {
+  for (const double cell_size : {0.5, 2.0, 10.0, 100.0}) {
+    RandomBoxes random_boxes(static_cast<unsigned int>(cell_size * 10.0));
+    OccupancySlices slices(cell_size);
+    for (int i = 0; i < 5; ++i) {
+      slices.AddSlice(random_boxes.Boxes(30, 30.0, 5.0));
+    }
+    ASSERT_EQ(5U, slices.num_slices());
+    ExpectSameAsScan(slices, 30.0, &random_boxes);
+  }
+}
+
+TEST(OccupancySlicesTest, MatchesScanForFarApartBoxes) {
+  // The boxes spread over kilometers, which coarsens the grid beyond the
+  // cell size, with most cells empty.
+  RandomBoxes random_boxes(7);
+  OccupancySlices slices(0.5);
+  for (int i = 0; i < 3; ++i) {
+    std::vector<Box2d> boxes = random_boxes.Boxes(20, 20.0, 5.0);
+    boxes.emplace_back(Vec2d(5000.0, -3000.0), 0.3, 4.0, 2.0);
+    boxes.emplace_back(Vec2d(-4000.0, 2000.0), -1.2, 4.0, 2.0);
+    slices.AddSlice(std::move(boxes));
+  }
+  ExpectSameAsScan(slices, 20.0, &random_boxes);
+
+  EXPECT_TRUE(
+      slices.HasOverlap(0, Box2d(Vec2d(5001.0, -3000.0), 0.0, 2.0, 2.0)));
+  EXPECT_TRUE(
+      slices.HasOverlap(2, Box2d(Vec2d(-4000.0, 2000.5), 1.0, 2.0, 2.0)));
+  EXPECT_FALSE(
+      slices.HasOverlap(1, Box2d(Vec2d(1000.0, 1000.0), 0.0, 2.0, 2.0)));
+}
+
+TEST(OccupancySlicesTest, EmptySlices) {
+  RandomBoxes random_boxes(11);
+  OccupancySlices slices(1.0);
+  slices.AddSlice({});
+  slices.AddSlice(random_boxes.Boxes(10, 10.0, 5.0));
+  slices.AddSlice({});
+  ASSERT_EQ(3U, slices.num_slices());
+  for (int k = 0; k < 1000; ++k) {
+    const Box2d box = random_boxes.Box(20.0, 6.0);
+    EXPECT_FALSE(slices.HasOverlap(0, box));
+    EXPECT_FALSE(slices.HasOverlap(2, box));
+    EXPECT_EQ(HasOverlapByScan(slices.boxes(1), box),
+              slices.HasOverlap(1, box));
+  }
+}
+
+TEST(OccupancySlicesTest, QueriesOutsideOfSliceBounds) {
+  OccupancySlices slices(1.0);
+  slices.AddSlice({Box2d(Vec2d(0.0, 0.0), 0.0, 4.0, 2.0),
+                   Box2d(Vec2d(10.0, 5.0), M_PI_4, 4.0, 2.0)});
+  // Beyond each side of the bounds.
+  EXPECT_FALSE(slices.HasOverlap(0, Box2d(Vec2d(-5.0, 0.0), 0.0, 2.0, 2.0)));
+  EXPECT_FALSE(slices.HasOverlap(0, Box2d(Vec2d(20.0, 5.0), 0.0, 2.0, 2.0)));
+  EXPECT_FALSE(slices.HasOverlap(0, Box2d(Vec2d(0.0, -5.0), 0.0, 2.0, 2.0)));
+  EXPECT_FALSE(slices.HasOverlap(0, Box2d(Vec2d(10.0, 15.0), 0.0, 2.0, 2.0)));
+  // Reaching in from outside of the bounds, in the clamped edge cells.
+  EXPECT_TRUE(slices.HasOverlap(0, Box2d(Vec2d(-2.5, 0.0), 0.0, 2.0, 2.0)));
+  EXPECT_TRUE(slices.HasOverlap(0, Box2d(Vec2d(0.0, -1.5), 0.0, 2.0, 2.0)));
+  // Covering all of the bounds.
+  EXPECT_TRUE(slices.HasOverlap(0, Box2d(Vec2d(5.0, 3.0), 0.0, 40.0, 40.0)));
+  // Within the bounds, between the boxes.
+  EXPECT_FALSE(slices.HasOverlap(0, Box2d(Vec2d(5.0, 2.5), 0.0, 1.0, 1.0)));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -21,9 +21,11 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory1d/piecewise_acceleration_trajectory1d.h"
@@ -74,19 +76,71 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
-    for (const auto& lat_trajectory : lat_trajectories) {
+    lon_trajectories_.push_back(lon_trajectory);
+  }
+  lat_trajectories_ = lat_trajectories;
+
+  // The s values of the lateral offset cost up to the longest evaluation
+  // horizon; a longitudinal trajectory evaluates the ones within its horizon.
+  std::vector<double> s_values;
+  for (double s = 0.0; s < FLAGS_speed_lon_decision_horizon;
+       s += FLAGS_trajectory_space_resolution) {
+    s_values.emplace_back(s);
+  }
+
+  // Evaluate the costs of each 1d trajectory once for all of its pairs.
+  lon_costs_.resize(lon_trajectories_.size());
+  lat_costs_.resize(lat_trajectories_.size());
+  if (FLAGS_enable_multi_thread_in_lattice_evaluation) {
+    std::vector<std::future<void>> results;
+    for (size_t i = 0; i < lon_trajectories_.size(); ++i) {
+      results.push_back(cyber::Async([&, i]() {
+        lon_costs_[i] =
+            EvaluateLon(planning_target, lon_trajectories_[i], s_values);
+      }));
+    }
+    for (size_t i = 0; i < lat_trajectories_.size(); ++i) {
+      results.push_back(cyber::Async([&, i]() {
+        lat_costs_[i] = EvaluateLat(lat_trajectories_[i], s_values);
+      }));
+    }
+    for (auto& result : results) {
+      result.get();
+    }
+  } else {
+    for (size_t i = 0; i < lon_trajectories_.size(); ++i) {
+      lon_costs_[i] =
+          EvaluateLon(planning_target, lon_trajectories_[i], s_values);
+    }
+    for (size_t i = 0; i < lat_trajectories_.size(); ++i) {
+      lat_costs_[i] = EvaluateLat(lat_trajectories_[i], s_values);
+    }
+  }
+
+  // Queue the pairs by the lower bounds of their costs, so that the lateral
+  // comfort cost is only evaluated for the pairs reaching the top.
+  std::vector<PairCost> pair_costs;
+  pair_costs.reserve(lon_costs_.size() * lat_costs_.size());
+  for (size_t i = 0; i < lon_costs_.size(); ++i) {
+    for (size_t j = 0; j < lat_costs_.size(); ++j) {
       /**
        * The validity of the code needs to be verified.
-      if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
-                                                         *lon_trajectory)) {
+      if (!ConstraintChecker1d::IsValidLateralTrajectory(
+              *lat_trajectories_[j], *lon_trajectories_[i])) {
         continue;
       }
       */
-      double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
-      cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
-                          cost);
+      PairCost pair_cost;
+      pair_cost.lon_index = i;
+      pair_cost.lat_index = j;
+      pair_cost.cost = EvaluateLowerBound(lon_costs_[i], lat_costs_[j]);
+      pair_costs.push_back(pair_cost);
     }
   }
+  cost_queue_ =
+      std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>(
+          CostComparator(), std::move(pair_costs));
+  EvaluateTopPair();
   ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
 }
 
@@ -103,24 +157,40 @@ TrajectoryEvaluator::next_top_trajectory_pair() {
   ACHECK(has_more_trajectory_pairs());
   auto top = cost_queue_.top();
   cost_queue_.pop();
-  return top.first;
+  EvaluateTopPair();
+  return Trajectory1dPair(lon_trajectories_[top.lon_index],
+                          lat_trajectories_[top.lat_index]);
 }
 
 double TrajectoryEvaluator::top_trajectory_pair_cost() const {
-  return cost_queue_.top().second;
+  return cost_queue_.top().cost;
+}
+
+void TrajectoryEvaluator::EvaluateTopPair() {
+  // The lateral comfort cost is not negative, so the pair at the top with its
+  // full cost costs no more than any other pair.
+  while (!cost_queue_.empty() && cost_queue_.top().is_lower_bound) {
+    PairCost pair_cost = cost_queue_.top();
+    cost_queue_.pop();
+    pair_cost.cost += LatComfortCost(lon_costs_[pair_cost.lon_index],
+                                     lat_trajectories_[pair_cost.lat_index]) *
+                      FLAGS_weight_lat_comfort;
+    pair_cost.is_lower_bound = false;
+    cost_queue_.push(pair_cost);
+  }
 }
 
-double TrajectoryEvaluator::Evaluate(
+TrajectoryEvaluator::LonTrajectoryCost TrajectoryEvaluator::EvaluateLon(
     const PlanningTarget& planning_target,
     const PtrTrajectory1d& lon_trajectory,
-    const PtrTrajectory1d& lat_trajectory,
-    std::vector<double>* cost_components) const {
+    const std::vector<double>& s_values) const {
   // Costs:
   // 1. Cost of missing the objective, e.g., cruise, stop, etc.
   // 2. Cost of longitudinal jerk
   // 3. Cost of longitudinal collision
   // 4. Cost of lateral offsets
   // 5. Cost of lateral comfort
+  LonTrajectoryCost lon_cost;
 
   // Longitudinal costs
   double lon_objective_cost =
@@ -132,42 +202,42 @@ double TrajectoryEvaluator::Evaluate(
 
   double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
 
+  lon_cost.cost =
+      lon_objective_cost * FLAGS_weight_lon_objective +
+      lon_jerk_cost * FLAGS_weight_lon_jerk +
+      lon_collision_cost * FLAGS_weight_lon_collision +
+      centripetal_acc_cost * FLAGS_weight_centripetal_acceleration;
+
   // decides the longitudinal evaluation horizon for lateral trajectories.
   double evaluation_horizon =
       std::min(FLAGS_speed_lon_decision_horizon,
                lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
-  std::vector<double> s_values;
-  for (double s = 0.0; s < evaluation_horizon;
-       s += FLAGS_trajectory_space_resolution) {
-    s_values.emplace_back(s);
-  }
-
-  // Lateral costs
-  double lat_offset_cost = LatOffsetCost(lat_trajectory, s_values);
+  lon_cost.num_s_values = static_cast<size_t>(
+      std::distance(s_values.begin(),
+                    std::lower_bound(s_values.begin(), s_values.end(),
+                                     evaluation_horizon)));
 
-  double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
-
-  if (cost_components != nullptr) {
-    cost_components->emplace_back(lon_objective_cost);
-    cost_components->emplace_back(lon_jerk_cost);
-    cost_components->emplace_back(lon_collision_cost);
-    cost_components->emplace_back(lat_offset_cost);
+  // The states sampled for the lateral comfort costs.
+  for (double t = 0.0; t < FLAGS_trajectory_time_length;
+       t += FLAGS_trajectory_time_resolution) {
+    lon_cost.s.push_back(lon_trajectory->Evaluate(0, t));
+    lon_cost.s_dot.push_back(lon_trajectory->Evaluate(1, t));
+    lon_cost.s_dotdot.push_back(lon_trajectory->Evaluate(2, t));
   }
-
-  return lon_objective_cost * FLAGS_weight_lon_objective +
-         lon_jerk_cost * FLAGS_weight_lon_jerk +
-         lon_collision_cost * FLAGS_weight_lon_collision +
-         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
-         lat_offset_cost * FLAGS_weight_lat_offset +
-         lat_comfort_cost * FLAGS_weight_lat_comfort;
+  return lon_cost;
 }
 
-double TrajectoryEvaluator::LatOffsetCost(
+TrajectoryEvaluator::LatTrajectoryCost TrajectoryEvaluator::EvaluateLat(
     const PtrTrajectory1d& lat_trajectory,
     const std::vector<double>& s_values) const {
+  LatTrajectoryCost lat_cost;
+  lat_cost.offset_cost_sqr_sums.reserve(s_values.size() + 1);
+  lat_cost.offset_cost_abs_sums.reserve(s_values.size() + 1);
   double lat_offset_start = lat_trajectory->Evaluate(0, 0.0);
   double cost_sqr_sum = 0.0;
   double cost_abs_sum = 0.0;
+  lat_cost.offset_cost_sqr_sums.push_back(cost_sqr_sum);
+  lat_cost.offset_cost_abs_sums.push_back(cost_abs_sum);
   for (const auto& s : s_values) {
     double lat_offset = lat_trajectory->Evaluate(0, s);
     double cost = lat_offset / FLAGS_lat_offset_bound;
@@ -178,19 +248,36 @@ double TrajectoryEvaluator::LatOffsetCost(
       cost_sqr_sum += cost * cost * FLAGS_weight_same_side_offset;
       cost_abs_sum += std::fabs(cost) * FLAGS_weight_same_side_offset;
     }
+    lat_cost.offset_cost_sqr_sums.push_back(cost_sqr_sum);
+    lat_cost.offset_cost_abs_sums.push_back(cost_abs_sum);
   }
-  return cost_sqr_sum / (cost_abs_sum + FLAGS_numerical_epsilon);
+  return lat_cost;
+}
+
+double TrajectoryEvaluator::EvaluateLowerBound(
+    const LonTrajectoryCost& lon_cost,
+    const LatTrajectoryCost& lat_cost) const {
+  // Lateral costs
+  double lat_offset_cost = LatOffsetCost(lat_cost, lon_cost.num_s_values);
+
+  return lon_cost.cost + lat_offset_cost * FLAGS_weight_lat_offset;
+}
+
+double TrajectoryEvaluator::LatOffsetCost(const LatTrajectoryCost& lat_cost,
+                                          const size_t num_s_values) const {
+  return lat_cost.offset_cost_sqr_sums[num_s_values] /
+         (lat_cost.offset_cost_abs_sums[num_s_values] +
+          FLAGS_numerical_epsilon);
 }
 
 double TrajectoryEvaluator::LatComfortCost(
-    const PtrTrajectory1d& lon_trajectory,
+    const LonTrajectoryCost& lon_cost,
     const PtrTrajectory1d& lat_trajectory) const {
   double max_cost = 0.0;
-  for (double t = 0.0; t < FLAGS_trajectory_time_length;
-       t += FLAGS_trajectory_time_resolution) {
-    double s = lon_trajectory->Evaluate(0, t);
-    double s_dot = lon_trajectory->Evaluate(1, t);
-    double s_dotdot = lon_trajectory->Evaluate(2, t);
+  for (size_t i = 0; i < lon_cost.s.size(); ++i) {
+    double s = lon_cost.s[i];
+    double s_dot = lon_cost.s_dot[i];
+    double s_dotdot = lon_cost.s_dotdot[i];
 
     double relative_s = s - init_s_[0];
     double l_prime = lat_trajectory->Evaluate(1, relative_s);
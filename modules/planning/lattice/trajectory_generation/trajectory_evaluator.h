@@ -20,12 +20,14 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
 
+#include "gtest/gtest_prod.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
 #include "modules/planning/math/curve1d/curve1d.h"
 #include "modules/planning/proto/lattice_structure.pb.h"
@@ -35,17 +37,6 @@ namespace apollo {
 namespace planning {
 
 class TrajectoryEvaluator {
-  // normal use
-  typedef std::pair<
-      std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>, double>
-      PairCost;
-
-  // auto tuning
-  typedef std::pair<
-      std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>,
-      std::pair<std::vector<double>, double>>
-      PairCostWithComponents;
-
  public:
   TrajectoryEvaluator(
       const std::array<double, 3>& init_s,
@@ -66,18 +57,57 @@ class TrajectoryEvaluator {
 
   double top_trajectory_pair_cost() const;
 
-  std::vector<double> top_trajectory_pair_component_cost() const;
-
  private:
-  double Evaluate(const PlanningTarget& planning_target,
-                  const std::shared_ptr<Curve1d>& lon_trajectory,
-                  const std::shared_ptr<Curve1d>& lat_trajectory,
-                  std::vector<double>* cost_components = nullptr) const;
+  FRIEND_TEST(TrajectoryEvaluatorTest, LazyQueueMatchesEagerEvaluation);
+
+  // The costs of a longitudinal trajectory, which are shared by all its
+  // pairs, with its samples at the time resolution.
+  struct LonTrajectoryCost {
+    // The weighted sum of the longitudinal costs.
+    double cost = 0.0;
+    // The number of the s values of the lateral offset cost within its
+    // evaluation horizon.
+    size_t num_s_values = 0;
+    std::vector<double> s;
+    std::vector<double> s_dot;
+    std::vector<double> s_dotdot;
+  };
+
+  // The sums of the lateral offset cost of a lateral trajectory over the
+  // first n s values, for every n.
+  struct LatTrajectoryCost {
+    std::vector<double> offset_cost_sqr_sums;
+    std::vector<double> offset_cost_abs_sums;
+  };
+
+  // A pair of trajectories in the queue. Its cost is a lower bound until the
+  // pair is at the top, where the lateral comfort cost is added.
+  struct PairCost {
+    size_t lon_index = 0;
+    size_t lat_index = 0;
+    double cost = 0.0;
+    bool is_lower_bound = true;
+  };
+
+  LonTrajectoryCost EvaluateLon(const PlanningTarget& planning_target,
+                                const std::shared_ptr<Curve1d>& lon_trajectory,
+                                const std::vector<double>& s_values) const;
+
+  LatTrajectoryCost EvaluateLat(const std::shared_ptr<Curve1d>& lat_trajectory,
+                                const std::vector<double>& s_values) const;
+
+  // The cost of a pair without the lateral comfort cost, which is a lower
+  // bound of its cost.
+  double EvaluateLowerBound(const LonTrajectoryCost& lon_cost,
+                            const LatTrajectoryCost& lat_cost) const;
 
-  double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
-                       const std::vector<double>& s_values) const;
+  // Evaluates the pairs at the top until the top pair has its full cost.
+  void EvaluateTopPair();
 
-  double LatComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory,
+  double LatOffsetCost(const LatTrajectoryCost& lat_cost,
+                       const size_t num_s_values) const;
+
+  double LatComfortCost(const LonTrajectoryCost& lon_cost,
                         const std::shared_ptr<Curve1d>& lat_trajectory) const;
 
   double LonComfortCost(const std::shared_ptr<Curve1d>& lon_trajectory) const;
@@ -101,13 +131,19 @@ class TrajectoryEvaluator {
   struct CostComparator
       : public std::binary_function<const PairCost&, const PairCost&, bool> {
     bool operator()(const PairCost& left, const PairCost& right) const {
-      return left.second > right.second;
+      return left.cost > right.cost;
     }
   };
 
   std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
       cost_queue_;
 
+  std::vector<std::shared_ptr<Curve1d>> lon_trajectories_;
+  std::vector<LonTrajectoryCost> lon_costs_;
+
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories_;
+  std::vector<LatTrajectoryCost> lat_costs_;
+
   std::shared_ptr<PathTimeGraph> path_time_graph_;
 
   std::shared_ptr<std::vector<apollo::common::PathPoint>> reference_line_;
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+#include "gtest/gtest.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(TrajectoryEvaluatorTest, LazyQueueMatchesEagerEvaluation) {
+  const std::array<double, 3> init_s = {0.0, 10.0, 0.0};
+  const std::array<double, 3> init_d = {0.5, 0.0, 0.0};
+  PlanningTarget planning_target;
+  planning_target.set_cruise_speed(12.0);
+
+  // Cruising at several speeds, and shifting to several lateral offsets.
+  std::vector<std::shared_ptr<Curve1d>> lon_trajectories;
+  for (const double end_v : {6.0, 8.0, 10.0, 12.0, 14.0}) {
+    for (const double t : {4.0, 6.0, 8.0}) {
+      lon_trajectories.push_back(
+          std::make_shared<LatticeTrajectory1d>(std::shared_ptr<Curve1d>(
+              new QuarticPolynomialCurve1d(init_s, {end_v, 0.0}, t))));
+    }
+  }
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories;
+  for (const double end_l : {-1.0, -0.5, 0.0, 0.5, 1.0}) {
+    for (const double s : {20.0, 40.0, 60.0}) {
+      lat_trajectories.push_back(
+          std::make_shared<LatticeTrajectory1d>(std::shared_ptr<Curve1d>(
+              new QuinticPolynomialCurve1d(init_d, {end_l, 0.0, 0.0}, s))));
+    }
+  }
+
+  auto reference_line = std::make_shared<std::vector<common::PathPoint>>();
+  for (int i = 0; i <= 200; ++i) {
+    common::PathPoint point;
+    point.set_x(static_cast<double>(i));
+    point.set_s(static_cast<double>(i));
+    reference_line->push_back(point);
+  }
+  auto path_time_graph = std::make_shared<PathTimeGraph>(
+      std::vector<const Obstacle*>(), *reference_line, nullptr, 0.0, 200.0,
+      0.0, FLAGS_trajectory_time_length, init_d);
+
+  TrajectoryEvaluator evaluator(init_s, planning_target, lon_trajectories,
+                                lat_trajectories, path_time_graph,
+                                reference_line);
+
+  // The full cost of every pair, as the eager evaluation queued them.
+  std::vector<std::tuple<double, size_t, size_t>> eager_costs;
+  for (size_t i = 0; i < evaluator.lon_trajectories_.size(); ++i) {
+    for (size_t j = 0; j < evaluator.lat_trajectories_.size(); ++j) {
+      const double cost =
+          evaluator.EvaluateLowerBound(evaluator.lon_costs_[i],
+                                       evaluator.lat_costs_[j]) +
+          evaluator.LatComfortCost(evaluator.lon_costs_[i],
+                                   evaluator.lat_trajectories_[j]) *
+              FLAGS_weight_lat_comfort;
+      eager_costs.emplace_back(cost, i, j);
+    }
+  }
+  std::sort(eager_costs.begin(), eager_costs.end());
+  ASSERT_FALSE(eager_costs.empty());
+  ASSERT_EQ(eager_costs.size(), evaluator.num_of_trajectory_pairs());
+
+  std::map<const Curve1d*, size_t> lon_indices;
+  for (size_t i = 0; i < evaluator.lon_trajectories_.size(); ++i) {
+    lon_indices[evaluator.lon_trajectories_[i].get()] = i;
+  }
+  std::map<const Curve1d*, size_t> lat_indices;
+  for (size_t j = 0; j < evaluator.lat_trajectories_.size(); ++j) {
+    lat_indices[evaluator.lat_trajectories_[j].get()] = j;
+  }
+
+  for (size_t k = 0; k < eager_costs.size(); ++k) {
+    ASSERT_TRUE(evaluator.has_more_trajectory_pairs());
+    EXPECT_DOUBLE_EQ(std::get<0>(eager_costs[k]),
+                     evaluator.top_trajectory_pair_cost());
+    const auto pair = evaluator.next_top_trajectory_pair();
+    // Pairs of equal costs may come in either order.
+    const bool tied =
+        (k > 0 && std::get<0>(eager_costs[k - 1]) ==
+                      std::get<0>(eager_costs[k])) ||
+        (k + 1 < eager_costs.size() &&
+         std::get<0>(eager_costs[k + 1]) == std::get<0>(eager_costs[k]));
+    if (!tied) {
+      EXPECT_EQ(std::get<1>(eager_costs[k]), lon_indices[pair.first.get()]);
+      EXPECT_EQ(std::get<2>(eager_costs[k]), lat_indices[pair.second.get()]);
+    }
+  }
+  EXPECT_FALSE(evaluator.has_more_trajectory_pairs());
+}
+
+}  // namespace planning
+}  // namespace apollo
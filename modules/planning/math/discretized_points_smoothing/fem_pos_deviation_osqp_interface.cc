@@ -27,6 +27,15 @@
 namespace apollo {
 namespace planning {
 
+FemPosDeviationOsqpInterface::~FemPosDeviationOsqpInterface() {
+  CleanupWorkspace();
+}
+
+void FemPosDeviationOsqpInterface::Reset() {
+  CleanupWorkspace();
+  last_deviations_.clear();
+}
+
 bool FemPosDeviationOsqpInterface::Solve() {
   // Sanity Check
   if (ref_points_.empty()) {
@@ -54,75 +63,46 @@ bool FemPosDeviationOsqpInterface::Solve() {
   num_of_variables_ = num_of_points_ * 2;
   num_of_constraints_ = num_of_variables_;
 
-  // Calculate kernel
-  std::vector<c_float> P_data;
-  std::vector<c_int> P_indices;
-  std::vector<c_int> P_indptr;
-  CalculateKernel(&P_data, &P_indices, &P_indptr);
-
-  // Calculate affine constraints
-  std::vector<c_float> A_data;
-  std::vector<c_int> A_indices;
-  std::vector<c_int> A_indptr;
-  std::vector<c_float> lower_bounds;
-  std::vector<c_float> upper_bounds;
-  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
-                            &upper_bounds);
-
   // Calculate offset
-  std::vector<c_float> q;
-  CalculateOffset(&q);
+  CalculateOffset(&q_);
+
+  // Calculate bounds of affine constraints
+  CalculateBounds(&lower_bounds_, &upper_bounds_);
 
   // Set primal warm start
-  std::vector<c_float> primal_warm_start;
-  SetPrimalWarmStart(&primal_warm_start);
+  SetPrimalWarmStart(&primal_warm_start_);
 
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
+  // P and A only depend on the setup, which keeps the workspace
+  bool setup_reused = work_ != nullptr && HasSameSetup();
+  if (setup_reused && !UpdateWorkspace()) {
+    AERROR << "Failed to update the OSQP workspace, set it up again.";
+    setup_reused = false;
+  }
+  if (!setup_reused && !SetupWorkspace()) {
+    AERROR << "Failed to set up the OSQP workspace.";
+    Reset();
+    return false;
+  }
 
-  // Define Solver settings
-  osqp_set_default_settings(settings);
-  settings->max_iter = max_iter_;
-  settings->time_limit = time_limit_;
-  settings->verbose = verbose_;
-  settings->scaled_termination = scaled_termination_;
-  settings->warm_start = warm_start_;
-
-  OSQPWorkspace* work = nullptr;
-
-  bool res = OptimizeWithOsqp(num_of_variables_, lower_bounds.size(), &P_data,
-                              &P_indices, &P_indptr, &A_data, &A_indices,
-                              &A_indptr, &lower_bounds, &upper_bounds, &q,
-                              &primal_warm_start, data, &work, settings);
-  if (res == false || work == nullptr || work->solution == nullptr) {
+  if (!OptimizeWithOsqp()) {
     AERROR << "Failed to find solution.";
-    // Cleanup
-    osqp_cleanup(work);
-    c_free(data->A);
-    c_free(data->P);
-    c_free(data);
-    c_free(settings);
-
+    // The iterates of a failed solve are no start for the next one
+    Reset();
     return false;
   }
 
   // Extract primal results
   x_.resize(num_of_points_);
   y_.resize(num_of_points_);
+  last_deviations_.resize(num_of_variables_);
   for (int i = 0; i < num_of_points_; ++i) {
     int index = i * 2;
-    x_.at(i) = work->solution->x[index];
-    y_.at(i) = work->solution->x[index + 1];
+    x_.at(i) = work_->solution->x[index];
+    y_.at(i) = work_->solution->x[index + 1];
+    last_deviations_[index] = x_[i] - ref_points_[i].first;
+    last_deviations_[index + 1] = y_[i] - ref_points_[i].second;
   }
 
-  // Cleanup
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
-
   return true;
 }
 
@@ -225,17 +205,17 @@ void FemPosDeviationOsqpInterface::CalculateKernel(
 }
 
 void FemPosDeviationOsqpInterface::CalculateOffset(std::vector<c_float>* q) {
+  q->resize(num_of_variables_);
   for (int i = 0; i < num_of_points_; ++i) {
     const auto& ref_point_xy = ref_points_[i];
-    q->push_back(-2.0 * weight_ref_deviation_ * ref_point_xy.first);
-    q->push_back(-2.0 * weight_ref_deviation_ * ref_point_xy.second);
+    (*q)[2 * i] = -2.0 * weight_ref_deviation_ * ref_point_xy.first;
+    (*q)[2 * i + 1] = -2.0 * weight_ref_deviation_ * ref_point_xy.second;
   }
 }
 
 void FemPosDeviationOsqpInterface::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
-    std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
-    std::vector<c_float>* upper_bounds) {
+    std::vector<c_int>* A_indptr) {
   int ind_A = 0;
   for (int i = 0; i < num_of_variables_; ++i) {
     A_data->push_back(1.0);
@@ -244,62 +224,144 @@ void FemPosDeviationOsqpInterface::CalculateAffineConstraint(
     ++ind_A;
   }
   A_indptr->push_back(ind_A);
+}
 
+void FemPosDeviationOsqpInterface::CalculateBounds(
+    std::vector<c_float>* lower_bounds, std::vector<c_float>* upper_bounds) {
+  lower_bounds->resize(num_of_constraints_);
+  upper_bounds->resize(num_of_constraints_);
   for (int i = 0; i < num_of_points_; ++i) {
     const auto& ref_point_xy = ref_points_[i];
-    upper_bounds->push_back(ref_point_xy.first + bounds_around_refs_[i]);
-    upper_bounds->push_back(ref_point_xy.second + bounds_around_refs_[i]);
-    lower_bounds->push_back(ref_point_xy.first - bounds_around_refs_[i]);
-    lower_bounds->push_back(ref_point_xy.second - bounds_around_refs_[i]);
+    (*upper_bounds)[i * 2] = ref_point_xy.first + bounds_around_refs_[i];
+    (*upper_bounds)[i * 2 + 1] = ref_point_xy.second + bounds_around_refs_[i];
+    (*lower_bounds)[i * 2] = ref_point_xy.first - bounds_around_refs_[i];
+    (*lower_bounds)[i * 2 + 1] = ref_point_xy.second - bounds_around_refs_[i];
   }
 }
 
 void FemPosDeviationOsqpInterface::SetPrimalWarmStart(
     std::vector<c_float>* primal_warm_start) {
   CHECK_EQ(ref_points_.size(), static_cast<size_t>(num_of_points_));
-  for (const auto& ref_point_xy : ref_points_) {
-    primal_warm_start->push_back(ref_point_xy.first);
-    primal_warm_start->push_back(ref_point_xy.second);
+  primal_warm_start->resize(num_of_variables_);
+  for (int i = 0; i < num_of_points_; ++i) {
+    (*primal_warm_start)[2 * i] = ref_points_[i].first;
+    (*primal_warm_start)[2 * i + 1] = ref_points_[i].second;
+  }
+
+  // Start from the deviations of the last solution while it has as many
+  // points. Unlike the points, they are kept by the translation of the
+  // normalization and change little as the points move along the lanes.
+  if (last_deviations_.size() == primal_warm_start->size()) {
+    for (int i = 0; i < num_of_variables_; ++i) {
+      (*primal_warm_start)[i] += last_deviations_[i];
+    }
   }
 }
 
-bool FemPosDeviationOsqpInterface::OptimizeWithOsqp(
-    const size_t kernel_dim, const size_t num_affine_constraint,
-    std::vector<c_float>* P_data, std::vector<c_int>* P_indices,
-    std::vector<c_int>* P_indptr, std::vector<c_float>* A_data,
-    std::vector<c_int>* A_indices, std::vector<c_int>* A_indptr,
-    std::vector<c_float>* lower_bounds, std::vector<c_float>* upper_bounds,
-    std::vector<c_float>* q, std::vector<c_float>* primal_warm_start,
-    OSQPData* data, OSQPWorkspace** work, OSQPSettings* settings) {
-  CHECK_EQ(lower_bounds->size(), upper_bounds->size());
-
-  data->n = kernel_dim;
-  data->m = num_affine_constraint;
-  data->P = csc_matrix(data->n, data->n, P_data->size(), P_data->data(),
-                       P_indices->data(), P_indptr->data());
-  data->q = q->data();
-  data->A = csc_matrix(data->m, data->n, A_data->size(), A_data->data(),
-                       A_indices->data(), A_indptr->data());
-  data->l = lower_bounds->data();
-  data->u = upper_bounds->data();
-
-  *work = osqp_setup(data, settings);
-  // osqp_setup(work, data, settings);
-
-  osqp_warm_start_x(*work, primal_warm_start->data());
+bool FemPosDeviationOsqpInterface::HasSameSetup() const {
+  return workspace_setup_.num_of_points == num_of_points_ &&
+         workspace_setup_.weight_fem_pos_deviation ==
+             weight_fem_pos_deviation_ &&
+         workspace_setup_.weight_path_length == weight_path_length_ &&
+         workspace_setup_.weight_ref_deviation == weight_ref_deviation_ &&
+         workspace_setup_.max_iter == max_iter_ &&
+         workspace_setup_.time_limit == time_limit_ &&
+         workspace_setup_.verbose == verbose_ &&
+         workspace_setup_.scaled_termination == scaled_termination_ &&
+         workspace_setup_.warm_start == warm_start_;
+}
+
+bool FemPosDeviationOsqpInterface::SetupWorkspace() {
+  CleanupWorkspace();
+
+  // Calculate kernel
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+
+  // Calculate affine constraints
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr);
+
+  CHECK_EQ(lower_bounds_.size(), upper_bounds_.size());
+
+  // osqp_setup copies the data into the workspace
+  OSQPData data;
+  data.n = num_of_variables_;
+  data.m = num_of_constraints_;
+  data.P = csc_matrix(data.n, data.n, P_data.size(), P_data.data(),
+                      P_indices.data(), P_indptr.data());
+  data.q = q_.data();
+  data.A = csc_matrix(data.m, data.n, A_data.size(), A_data.data(),
+                      A_indices.data(), A_indptr.data());
+  data.l = lower_bounds_.data();
+  data.u = upper_bounds_.data();
+
+  // Define Solver settings
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.max_iter = max_iter_;
+  settings.time_limit = time_limit_;
+  settings.verbose = verbose_;
+  settings.scaled_termination = scaled_termination_;
+  settings.warm_start = warm_start_;
+
+  work_ = osqp_setup(&data, &settings);
+  // csc_matrix only allocates the struct around the arrays
+  c_free(data.P);
+  c_free(data.A);
+  if (work_ == nullptr) {
+    return false;
+  }
+
+  workspace_setup_.num_of_points = num_of_points_;
+  workspace_setup_.weight_fem_pos_deviation = weight_fem_pos_deviation_;
+  workspace_setup_.weight_path_length = weight_path_length_;
+  workspace_setup_.weight_ref_deviation = weight_ref_deviation_;
+  workspace_setup_.max_iter = max_iter_;
+  workspace_setup_.time_limit = time_limit_;
+  workspace_setup_.verbose = verbose_;
+  workspace_setup_.scaled_termination = scaled_termination_;
+  workspace_setup_.warm_start = warm_start_;
+  return true;
+}
+
+bool FemPosDeviationOsqpInterface::UpdateWorkspace() {
+  return osqp_update_lin_cost(work_, q_.data()) == 0 &&
+         osqp_update_bounds(work_, lower_bounds_.data(),
+                            upper_bounds_.data()) == 0;
+}
+
+void FemPosDeviationOsqpInterface::CleanupWorkspace() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+}
+
+bool FemPosDeviationOsqpInterface::OptimizeWithOsqp() {
+  osqp_warm_start_x(work_, primal_warm_start_.data());
 
   // Solve Problem
-  osqp_solve(*work);
+  osqp_solve(work_);
 
-  auto status = (*work)->info->status_val;
+  auto status = work_->info->status_val;
 
   if (status < 0) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work_->info->status;
     return false;
   }
 
   if (status != 1 && status != 2) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work_->info->status;
+    return false;
+  }
+
+  if (work_->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
     return false;
   }
 
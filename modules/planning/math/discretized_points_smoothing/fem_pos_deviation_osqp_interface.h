@@ -28,11 +28,23 @@
 namespace apollo {
 namespace planning {
 
+/*
+ * @brief:
+ * The OSQP workspace of the problem is kept across Solve() calls. While the
+ * number of points, the weights and the settings stay the same, P and A keep
+ * their values and only q and the bounds are updated, so the matrix is
+ * neither set up nor factorized again. Each solve starts from the deviations
+ * of the last solution from its reference points.
+ */
 class FemPosDeviationOsqpInterface {
  public:
   FemPosDeviationOsqpInterface() = default;
 
-  virtual ~FemPosDeviationOsqpInterface() = default;
+  virtual ~FemPosDeviationOsqpInterface();
+
+  FemPosDeviationOsqpInterface(const FemPosDeviationOsqpInterface&) = delete;
+  FemPosDeviationOsqpInterface& operator=(
+      const FemPosDeviationOsqpInterface&) = delete;
 
   void set_ref_points(
       const std::vector<std::pair<double, double>>& ref_points) {
@@ -69,6 +81,12 @@ class FemPosDeviationOsqpInterface {
 
   bool Solve();
 
+  /**
+   * @brief Drops the workspace and the last solution, so that the next
+   * problem is set up again and starts from its reference points.
+   */
+  void Reset();
+
   const std::vector<double>& opt_x() const { return x_; }
 
   const std::vector<double>& opt_y() const { return y_; }
@@ -82,20 +100,22 @@ class FemPosDeviationOsqpInterface {
 
   void CalculateAffineConstraint(std::vector<c_float>* A_data,
                                  std::vector<c_int>* A_indices,
-                                 std::vector<c_int>* A_indptr,
-                                 std::vector<c_float>* lower_bounds,
-                                 std::vector<c_float>* upper_bounds);
+                                 std::vector<c_int>* A_indptr);
+
+  void CalculateBounds(std::vector<c_float>* lower_bounds,
+                       std::vector<c_float>* upper_bounds);
 
   void SetPrimalWarmStart(std::vector<c_float>* primal_warm_start);
 
-  bool OptimizeWithOsqp(
-      const size_t kernel_dim, const size_t num_affine_constraint,
-      std::vector<c_float>* P_data, std::vector<c_int>* P_indices,
-      std::vector<c_int>* P_indptr, std::vector<c_float>* A_data,
-      std::vector<c_int>* A_indices, std::vector<c_int>* A_indptr,
-      std::vector<c_float>* lower_bounds, std::vector<c_float>* upper_bounds,
-      std::vector<c_float>* q, std::vector<c_float>* primal_warm_start,
-      OSQPData* data, OSQPWorkspace** work, OSQPSettings* settings);
+  bool HasSameSetup() const;
+
+  bool SetupWorkspace();
+
+  bool UpdateWorkspace();
+
+  void CleanupWorkspace();
+
+  bool OptimizeWithOsqp();
 
  private:
   // Reference points and deviation bounds
@@ -119,6 +139,31 @@ class FemPosDeviationOsqpInterface {
   int num_of_variables_ = 0;
   int num_of_constraints_ = 0;
 
+  // The problem the workspace is set up for
+  struct WorkspaceSetup {
+    int num_of_points = 0;
+    double weight_fem_pos_deviation = 0.0;
+    double weight_path_length = 0.0;
+    double weight_ref_deviation = 0.0;
+    int max_iter = 0;
+    double time_limit = 0.0;
+    bool verbose = false;
+    bool scaled_termination = false;
+    bool warm_start = false;
+  };
+
+  OSQPWorkspace* work_ = nullptr;
+  WorkspaceSetup workspace_setup_;
+
+  // Vectors of the problem, kept to save their allocations
+  std::vector<c_float> q_;
+  std::vector<c_float> lower_bounds_;
+  std::vector<c_float> upper_bounds_;
+  std::vector<c_float> primal_warm_start_;
+
+  // Deviations of the last solution from its reference points
+  std::vector<c_float> last_deviations_;
+
   // Optimized_result
   std::vector<double> x_;
   std::vector<double> y_;
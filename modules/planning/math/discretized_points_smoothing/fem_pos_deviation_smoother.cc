@@ -25,8 +25,6 @@
 
 #include "cyber/common/log.h"
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_ipopt_interface.h"
-#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_osqp_interface.h"
-#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_sqp_osqp_interface.h"
 
 namespace apollo {
 namespace planning {
@@ -59,7 +57,7 @@ bool FemPosDeviationSmoother::QpWithOsqp(
     return false;
   }
 
-  FemPosDeviationOsqpInterface solver;
+  FemPosDeviationOsqpInterface& solver = qp_solver_;
 
   solver.set_weight_fem_pos_deviation(config_.weight_fem_pos_deviation());
   solver.set_weight_path_length(config_.weight_path_length());
@@ -92,7 +90,7 @@ bool FemPosDeviationSmoother::SqpWithOsqp(
     return false;
   }
 
-  FemPosDeviationSqpOsqpInterface solver;
+  FemPosDeviationSqpOsqpInterface& solver = sqp_solver_;
 
   solver.set_weight_fem_pos_deviation(config_.weight_fem_pos_deviation());
   solver.set_weight_path_length(config_.weight_path_length());
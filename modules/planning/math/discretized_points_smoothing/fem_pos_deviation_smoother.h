@@ -23,6 +23,8 @@
 #include <utility>
 #include <vector>
 
+#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_osqp_interface.h"
+#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_sqp_osqp_interface.h"
 #include "modules/planning/proto/math/fem_pos_deviation_smoother_config.pb.h"
 
 namespace apollo {
@@ -42,6 +44,9 @@ namespace planning {
  *
  * Given an initial set of points from 0 to k-1,  The goal is to find a set of
  * points which makes the line P(start), P0, P(1) ... P(k-1) "smooth".
+ *
+ * The OSQP interfaces are kept across the calls of a smoother, which keeps
+ * their workspaces while the number of points stays the same.
  */
 
 class FemPosDeviationSmoother {
@@ -66,6 +71,8 @@ class FemPosDeviationSmoother {
 
  private:
   FemPosDeviationSmootherConfig config_;
+  FemPosDeviationOsqpInterface qp_solver_;
+  FemPosDeviationSqpOsqpInterface sqp_solver_;
 };
 }  // namespace planning
 }  // namespace apollo
@@ -28,6 +28,15 @@
 namespace apollo {
 namespace planning {
 
+FemPosDeviationSqpOsqpInterface::~FemPosDeviationSqpOsqpInterface() {
+  CleanupWorkspace();
+}
+
+void FemPosDeviationSqpOsqpInterface::Reset() {
+  CleanupWorkspace();
+  last_deviations_.clear();
+}
+
 bool FemPosDeviationSqpOsqpInterface::Solve() {
   // Sanity Check
   if (ref_points_.empty()) {
@@ -62,70 +71,47 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
       num_of_variable_constraints_ + num_of_curvature_constraints_;
 
   // Set primal warm start
-  std::vector<c_float> primal_warm_start;
-  SetPrimalWarmStart(ref_points_, &primal_warm_start);
-
-  // Calculate kernel
-  std::vector<c_float> P_data;
-  std::vector<c_int> P_indices;
-  std::vector<c_int> P_indptr;
-  CalculateKernel(&P_data, &P_indices, &P_indptr);
+  slack_.assign(num_of_slack_variables_, 0.0);
+  SetPrimalWarmStart(ref_points_, &primal_warm_start_);
+
+  // Start from the last solution moved along with the reference points, while
+  // it has as many points
+  if (last_deviations_.size() == primal_warm_start_.size()) {
+    for (int i = 0; i < num_of_variables_; ++i) {
+      primal_warm_start_[i] += last_deviations_[i];
+    }
+  }
 
   // Calculate offset
-  std::vector<c_float> q;
-  CalculateOffset(&q);
-
-  // Calculate affine constraints
-  std::vector<c_float> A_data;
-  std::vector<c_int> A_indices;
-  std::vector<c_int> A_indptr;
-  std::vector<c_float> lower_bounds;
-  std::vector<c_float> upper_bounds;
-  CalculateAffineConstraint(ref_points_, &A_data, &A_indices, &A_indptr,
-                            &lower_bounds, &upper_bounds);
-
-  // Load matrices and vectors into OSQPData
-  OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  data->n = num_of_variables_;
-  data->m = num_of_constraints_;
-  data->P = csc_matrix(data->n, data->n, P_data.size(), P_data.data(),
-                       P_indices.data(), P_indptr.data());
-  data->q = q.data();
-  data->A = csc_matrix(data->m, data->n, A_data.size(), A_data.data(),
-                       A_indices.data(), A_indptr.data());
-  data->l = lower_bounds.data();
-  data->u = upper_bounds.data();
-
-  // Define osqp solver settings
-  OSQPSettings* settings =
-      reinterpret_cast<OSQPSettings*>(c_malloc(sizeof(OSQPSettings)));
-  osqp_set_default_settings(settings);
-  settings->max_iter = max_iter_;
-  settings->time_limit = time_limit_;
-  settings->verbose = verbose_;
-  settings->scaled_termination = scaled_termination_;
-  settings->warm_start = warm_start_;
-  settings->polish = true;
-  settings->eps_abs = 1e-5;
-  settings->eps_rel = 1e-5;
-  settings->eps_prim_inf = 1e-5;
-  settings->eps_dual_inf = 1e-5;
-
-  // Define osqp workspace
-  OSQPWorkspace* work = nullptr;
-  // osqp_setup(&work, data, settings);
-  work = osqp_setup(data, settings);
+  CalculateOffset(&q_);
+
+  // Calculate affine constraints, linearized around the reference points
+  CalculateLinearizedFemPosParams(ref_points_, &linearized_params_);
+  CalculateBounds(linearized_params_, &lower_bounds_, &upper_bounds_);
+
+  // The sparsity of P and A only depends on the setup, which keeps the
+  // workspace
+  bool setup_reused = work_ != nullptr && HasSameSetup();
+  if (setup_reused) {
+    CalculateAffineConstraintData(linearized_params_, &A_data_);
+    if (!UpdateWorkspace()) {
+      AERROR << "Failed to update the OSQP workspace, set it up again.";
+      setup_reused = false;
+    }
+  }
+  if (!setup_reused && !SetupWorkspace()) {
+    AERROR << "Failed to set up the OSQP workspace.";
+    Reset();
+    return false;
+  }
 
   // Initial solution
-  bool initial_solve_res = OptimizeWithOsqp(primal_warm_start, &work);
+  bool initial_solve_res = OptimizeWithOsqp(primal_warm_start_);
 
   if (!initial_solve_res) {
     AERROR << "initial iteration solving fails";
-    osqp_cleanup(work);
-    c_free(data->A);
-    c_free(data->P);
-    c_free(data);
-    c_free(settings);
+    // The iterates of a failed solve are no start for the next one
+    Reset();
     return false;
   }
 
@@ -134,35 +120,30 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
   int pen_itr = 0;
   double ctol = 0.0;
   double original_slack_penalty = weight_curvature_constraint_slack_var_;
-  double last_fvalue = work->info->obj_val;
+  double last_fvalue = work_->info->obj_val;
 
   while (pen_itr < sqp_pen_max_iter_) {
     int sub_itr = 1;
     bool fconverged = false;
 
     while (sub_itr < sqp_sub_max_iter_) {
-      SetPrimalWarmStart(opt_xy_, &primal_warm_start);
-      CalculateOffset(&q);
-      CalculateAffineConstraint(opt_xy_, &A_data, &A_indices, &A_indptr,
-                                &lower_bounds, &upper_bounds);
-      osqp_update_lin_cost(work, q.data());
-      osqp_update_A(work, A_data.data(), OSQP_NULL, A_data.size());
-      osqp_update_bounds(work, lower_bounds.data(), upper_bounds.data());
-
-      bool iterative_solve_res = OptimizeWithOsqp(primal_warm_start, &work);
+      SetPrimalWarmStart(opt_xy_, &primal_warm_start_);
+      CalculateOffset(&q_);
+      CalculateLinearizedFemPosParams(opt_xy_, &linearized_params_);
+      CalculateAffineConstraintData(linearized_params_, &A_data_);
+      CalculateBounds(linearized_params_, &lower_bounds_, &upper_bounds_);
+
+      bool iterative_solve_res =
+          UpdateWorkspace() && OptimizeWithOsqp(primal_warm_start_);
       if (!iterative_solve_res) {
         AERROR << "iteration at " << sub_itr
                << ", solving fails with max sub iter " << sqp_sub_max_iter_;
         weight_curvature_constraint_slack_var_ = original_slack_penalty;
-        osqp_cleanup(work);
-        c_free(data->A);
-        c_free(data->P);
-        c_free(data);
-        c_free(settings);
+        Reset();
         return false;
       }
 
-      double cur_fvalue = work->info->obj_val;
+      double cur_fvalue = work_->info->obj_val;
       double ftol = std::abs((last_fvalue - cur_fvalue) / last_fvalue);
 
       if (ftol < sqp_ftol_) {
@@ -180,11 +161,7 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
     if (!fconverged) {
       AERROR << "Max number of iteration reached";
       weight_curvature_constraint_slack_var_ = original_slack_penalty;
-      osqp_cleanup(work);
-      c_free(data->A);
-      c_free(data->P);
-      c_free(data);
-      c_free(settings);
+      Reset();
       return false;
     }
 
@@ -197,11 +174,7 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
       ADEBUG << "constraint voilation value drops to " << ctol
              << ", under max_ctol " << sqp_ctol_;
       weight_curvature_constraint_slack_var_ = original_slack_penalty;
-      osqp_cleanup(work);
-      c_free(data->A);
-      c_free(data->P);
-      c_free(data);
-      c_free(settings);
+      SetLastDeviations();
       return true;
     }
 
@@ -213,11 +186,7 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
   ADEBUG << "constraint voilation value drops to " << ctol
          << ", higher than max_ctol " << sqp_ctol_;
   weight_curvature_constraint_slack_var_ = original_slack_penalty;
-  osqp_cleanup(work);
-  c_free(data->A);
-  c_free(data->P);
-  c_free(data);
-  c_free(settings);
+  SetLastDeviations();
   return true;
 }
 
@@ -335,94 +304,140 @@ void FemPosDeviationSqpOsqpInterface::CalculateOffset(std::vector<c_float>* q) {
   }
 }
 
-std::vector<double>
-FemPosDeviationSqpOsqpInterface::CalculateLinearizedFemPosParams(
-    const std::vector<std::pair<double, double>>& points, const size_t index) {
-  CHECK_GT(index, 0U);
-  CHECK_LT(index, points.size() - 1);
-
-  double x_f = points[index - 1].first;
-  double x_m = points[index].first;
-  double x_l = points[index + 1].first;
-  double y_f = points[index - 1].second;
-  double y_m = points[index].second;
-  double y_l = points[index + 1].second;
-
-  double linear_term_x_f = 2.0 * x_f - 4.0 * x_m + 2.0 * x_l;
-  double linear_term_x_m = 8.0 * x_m - 4.0 * x_f - 4.0 * x_l;
-  double linear_term_x_l = 2.0 * x_l - 4.0 * x_m + 2.0 * x_f;
-  double linear_term_y_f = 2.0 * y_f - 4.0 * y_m + 2.0 * y_l;
-  double linear_term_y_m = 8.0 * y_m - 4.0 * y_f - 4.0 * y_l;
-  double linear_term_y_l = 2.0 * y_l - 4.0 * y_m + 2.0 * y_f;
-
-  double linear_approx = (-2.0 * x_m + x_f + x_l) * (-2.0 * x_m + x_f + x_l) +
-                         (-2.0 * y_m + y_f + y_l) * (-2.0 * y_m + y_f + y_l) +
-                         -x_f * linear_term_x_f + -x_m * linear_term_x_m +
-                         -x_l * linear_term_x_l + -y_f * linear_term_y_f +
-                         -y_m * linear_term_y_m + -y_l * linear_term_y_l;
-
-  return {linear_term_x_f, linear_term_y_f, linear_term_x_m, linear_term_y_m,
-          linear_term_x_l, linear_term_y_l, linear_approx};
-}
-
-void FemPosDeviationSqpOsqpInterface::CalculateAffineConstraint(
+void FemPosDeviationSqpOsqpInterface::CalculateLinearizedFemPosParams(
     const std::vector<std::pair<double, double>>& points,
-    std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
-    std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
-    std::vector<c_float>* upper_bounds) {
-  const double scale_factor = 1;
+    LinearizedFemPosParams* params) {
+  CHECK_EQ(points.size(), static_cast<size_t>(num_of_points_));
+  CHECK_GT(points.size(), 2U);
 
-  std::vector<std::vector<double>> lin_cache;
-  for (int i = 1; i < num_of_points_ - 1; ++i) {
-    lin_cache.push_back(CalculateLinearizedFemPosParams(points, i));
+  // Lay the coordinates out contiguously, so that the loops over the
+  // constraints below are vectorized
+  points_x_.resize(num_of_points_);
+  points_y_.resize(num_of_points_);
+  for (int i = 0; i < num_of_points_; ++i) {
+    points_x_[i] = points[i].first;
+    points_y_[i] = points[i].second;
+  }
+
+  const int num_of_constraints = num_of_curvature_constraints_;
+  params->linear_term_x_f.resize(num_of_constraints);
+  params->linear_term_y_f.resize(num_of_constraints);
+  params->linear_term_x_m.resize(num_of_constraints);
+  params->linear_term_y_m.resize(num_of_constraints);
+  params->linear_term_x_l.resize(num_of_constraints);
+  params->linear_term_y_l.resize(num_of_constraints);
+  params->linear_approx.resize(num_of_constraints);
+
+  const double* x = points_x_.data();
+  const double* y = points_y_.data();
+  double* linear_term_x_f = params->linear_term_x_f.data();
+  double* linear_term_y_f = params->linear_term_y_f.data();
+  double* linear_term_x_m = params->linear_term_x_m.data();
+  double* linear_term_y_m = params->linear_term_y_m.data();
+  double* linear_term_x_l = params->linear_term_x_l.data();
+  double* linear_term_y_l = params->linear_term_y_l.data();
+  double* linear_approx = params->linear_approx.data();
+  // Few enough arrays per loop for the compiler to check their aliasing
+  for (int i = 0; i < num_of_constraints; ++i) {
+    linear_term_x_f[i] = 2.0 * x[i] - 4.0 * x[i + 1] + 2.0 * x[i + 2];
+    linear_term_x_m[i] = 8.0 * x[i + 1] - 4.0 * x[i] - 4.0 * x[i + 2];
+    linear_term_x_l[i] = 2.0 * x[i + 2] - 4.0 * x[i + 1] + 2.0 * x[i];
+  }
+
+  for (int i = 0; i < num_of_constraints; ++i) {
+    linear_term_y_f[i] = 2.0 * y[i] - 4.0 * y[i + 1] + 2.0 * y[i + 2];
+    linear_term_y_m[i] = 8.0 * y[i + 1] - 4.0 * y[i] - 4.0 * y[i + 2];
+    linear_term_y_l[i] = 2.0 * y[i + 2] - 4.0 * y[i + 1] + 2.0 * y[i];
+  }
+
+  for (int i = 0; i < num_of_constraints; ++i) {
+    const double x_f = x[i];
+    const double x_m = x[i + 1];
+    const double x_l = x[i + 2];
+    const double y_f = y[i];
+    const double y_m = y[i + 1];
+    const double y_l = y[i + 2];
+    linear_approx[i] = (-2.0 * x_m + x_f + x_l) * (-2.0 * x_m + x_f + x_l) +
+                       (-2.0 * y_m + y_f + y_l) * (-2.0 * y_m + y_f + y_l) +
+                       -x_f * linear_term_x_f[i] + -x_m * linear_term_x_m[i] +
+                       -x_l * linear_term_x_l[i] + -y_f * linear_term_y_f[i] +
+                       -y_m * linear_term_y_m[i] + -y_l * linear_term_y_l[i];
   }
+}
 
-  std::vector<std::vector<std::pair<c_int, c_float>>> columns;
-  columns.resize(num_of_variables_);
-
-  for (int i = 0; i < num_of_variables_; ++i) {
-    columns[i].emplace_back(i, 1.0);
+void FemPosDeviationSqpOsqpInterface::CalculateAffineConstraint(
+    std::vector<c_int>* A_indices, std::vector<c_int>* A_indptr) {
+  // The columns of the positions of a point have the row of its variable
+  // constraint, followed by the rows of the curvature constraints with the
+  // point as the last, the middle and the first point, in the order
+  // CalculateAffineConstraintData fills them. The columns of the slack
+  // variables have the rows of their variable and curvature constraints.
+  int ind_a = 0;
+  for (int i = 0; i < num_of_points_; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      const int index = 2 * i + j;
+      A_indptr->push_back(ind_a);
+      A_indices->push_back(index);
+      ++ind_a;
+      if (i >= 2) {
+        A_indices->push_back(i - 2 + num_of_variables_);
+        ++ind_a;
+      }
+      if (i >= 1 && i < num_of_points_ - 1) {
+        A_indices->push_back(i - 1 + num_of_variables_);
+        ++ind_a;
+      }
+      if (i < num_of_points_ - 2) {
+        A_indices->push_back(i + num_of_variables_);
+        ++ind_a;
+      }
+    }
   }
 
   for (int i = num_of_pos_variables_; i < num_of_variables_; ++i) {
-    columns[i].emplace_back(i + num_of_slack_variables_, -1.0 * scale_factor);
-  }
-
-  for (int i = 2; i < num_of_points_; ++i) {
-    int index = 2 * i;
-    columns[index].emplace_back(i - 2 + num_of_variables_,
-                                lin_cache[i - 2][4] * scale_factor);
-    columns[index + 1].emplace_back(i - 2 + num_of_variables_,
-                                    lin_cache[i - 2][5] * scale_factor);
+    A_indptr->push_back(ind_a);
+    A_indices->push_back(i);
+    A_indices->push_back(i + num_of_slack_variables_);
+    ind_a += 2;
   }
+  A_indptr->push_back(ind_a);
+}
 
-  for (int i = 1; i < num_of_points_ - 1; ++i) {
-    int index = 2 * i;
-    columns[index].emplace_back(i - 1 + num_of_variables_,
-                                lin_cache[i - 1][2] * scale_factor);
-    columns[index + 1].emplace_back(i - 1 + num_of_variables_,
-                                    lin_cache[i - 1][3] * scale_factor);
-  }
+void FemPosDeviationSqpOsqpInterface::CalculateAffineConstraintData(
+    const LinearizedFemPosParams& params, std::vector<c_float>* A_data) {
+  // Two entries per slack variable, and four per position less the ones of
+  // the two points at each end not in all three roles
+  A_data->resize(num_of_pos_variables_ * 4 - 12 + num_of_slack_variables_ * 2);
 
-  for (int i = 0; i < num_of_points_ - 2; ++i) {
-    int index = 2 * i;
-    columns[index].emplace_back(i + num_of_variables_,
-                                lin_cache[i][0] * scale_factor);
-    columns[index + 1].emplace_back(i + num_of_variables_,
-                                    lin_cache[i][1] * scale_factor);
+  size_t ind_a = 0;
+  for (int i = 0; i < num_of_points_; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      (*A_data)[ind_a++] = 1.0;
+      if (i >= 2) {
+        (*A_data)[ind_a++] = j == 0 ? params.linear_term_x_l[i - 2]
+                                    : params.linear_term_y_l[i - 2];
+      }
+      if (i >= 1 && i < num_of_points_ - 1) {
+        (*A_data)[ind_a++] = j == 0 ? params.linear_term_x_m[i - 1]
+                                    : params.linear_term_y_m[i - 1];
+      }
+      if (i < num_of_points_ - 2) {
+        (*A_data)[ind_a++] =
+            j == 0 ? params.linear_term_x_f[i] : params.linear_term_y_f[i];
+      }
+    }
   }
 
-  int ind_a = 0;
-  for (int i = 0; i < num_of_variables_; ++i) {
-    A_indptr->push_back(ind_a);
-    for (const auto& row_data_pair : columns[i]) {
-      A_data->push_back(row_data_pair.second);
-      A_indices->push_back(row_data_pair.first);
-      ++ind_a;
-    }
+  for (int i = 0; i < num_of_slack_variables_; ++i) {
+    (*A_data)[ind_a++] = 1.0;
+    (*A_data)[ind_a++] = -1.0;
   }
-  A_indptr->push_back(ind_a);
+  CHECK_EQ(ind_a, A_data->size());
+}
 
+void FemPosDeviationSqpOsqpInterface::CalculateBounds(
+    const LinearizedFemPosParams& params, std::vector<c_float>* lower_bounds,
+    std::vector<c_float>* upper_bounds) {
   lower_bounds->resize(num_of_constraints_);
   upper_bounds->resize(num_of_constraints_);
 
@@ -444,7 +459,7 @@ void FemPosDeviationSqpOsqpInterface::CalculateAffineConstraint(
                                     (interval_sqr * curvature_constraint_);
   for (int i = 0; i < num_of_curvature_constraints_; ++i) {
     (*upper_bounds)[num_of_variable_constraints_ + i] =
-        (curvature_constraint_sqr - lin_cache[i][6]) * scale_factor;
+        curvature_constraint_sqr - params.linear_approx[i];
     (*lower_bounds)[num_of_variable_constraints_ + i] = -1e20;
   }
 }
@@ -481,22 +496,124 @@ void FemPosDeviationSqpOsqpInterface::SetPrimalWarmStart(
   average_interval_length_ = total_length / (num_of_points_ - 1);
 }
 
+bool FemPosDeviationSqpOsqpInterface::HasSameSetup() const {
+  return workspace_setup_.num_of_points == num_of_points_ &&
+         workspace_setup_.weight_fem_pos_deviation ==
+             weight_fem_pos_deviation_ &&
+         workspace_setup_.weight_path_length == weight_path_length_ &&
+         workspace_setup_.weight_ref_deviation == weight_ref_deviation_ &&
+         workspace_setup_.max_iter == max_iter_ &&
+         workspace_setup_.time_limit == time_limit_ &&
+         workspace_setup_.verbose == verbose_ &&
+         workspace_setup_.scaled_termination == scaled_termination_ &&
+         workspace_setup_.warm_start == warm_start_;
+}
+
+bool FemPosDeviationSqpOsqpInterface::SetupWorkspace() {
+  CleanupWorkspace();
+
+  // Calculate kernel
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+
+  // Calculate affine constraints
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  CalculateAffineConstraint(&A_indices, &A_indptr);
+  CalculateAffineConstraintData(linearized_params_, &A_data_);
+  CHECK_EQ(A_indices.size(), A_data_.size());
+
+  // Load matrices and vectors into OSQPData, which osqp_setup copies into the
+  // workspace
+  OSQPData data;
+  data.n = num_of_variables_;
+  data.m = num_of_constraints_;
+  data.P = csc_matrix(data.n, data.n, P_data.size(), P_data.data(),
+                      P_indices.data(), P_indptr.data());
+  data.q = q_.data();
+  data.A = csc_matrix(data.m, data.n, A_data_.size(), A_data_.data(),
+                      A_indices.data(), A_indptr.data());
+  data.l = lower_bounds_.data();
+  data.u = upper_bounds_.data();
+
+  // Define osqp solver settings
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.max_iter = max_iter_;
+  settings.time_limit = time_limit_;
+  settings.verbose = verbose_;
+  settings.scaled_termination = scaled_termination_;
+  settings.warm_start = warm_start_;
+  settings.polish = true;
+  settings.eps_abs = 1e-5;
+  settings.eps_rel = 1e-5;
+  settings.eps_prim_inf = 1e-5;
+  settings.eps_dual_inf = 1e-5;
+
+  work_ = osqp_setup(&data, &settings);
+  // csc_matrix only allocates the struct around the arrays
+  c_free(data.P);
+  c_free(data.A);
+  if (work_ == nullptr) {
+    return false;
+  }
+
+  workspace_setup_.num_of_points = num_of_points_;
+  workspace_setup_.weight_fem_pos_deviation = weight_fem_pos_deviation_;
+  workspace_setup_.weight_path_length = weight_path_length_;
+  workspace_setup_.weight_ref_deviation = weight_ref_deviation_;
+  workspace_setup_.max_iter = max_iter_;
+  workspace_setup_.time_limit = time_limit_;
+  workspace_setup_.verbose = verbose_;
+  workspace_setup_.scaled_termination = scaled_termination_;
+  workspace_setup_.warm_start = warm_start_;
+  return true;
+}
+
+bool FemPosDeviationSqpOsqpInterface::UpdateWorkspace() {
+  return osqp_update_lin_cost(work_, q_.data()) == 0 &&
+         osqp_update_A(work_, A_data_.data(), OSQP_NULL, A_data_.size()) ==
+             0 &&
+         osqp_update_bounds(work_, lower_bounds_.data(),
+                            upper_bounds_.data()) == 0;
+}
+
+void FemPosDeviationSqpOsqpInterface::CleanupWorkspace() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+}
+
+void FemPosDeviationSqpOsqpInterface::SetLastDeviations() {
+  last_deviations_.resize(num_of_variables_);
+  for (int i = 0; i < num_of_points_; ++i) {
+    last_deviations_[2 * i] = opt_xy_[i].first - ref_points_[i].first;
+    last_deviations_[2 * i + 1] = opt_xy_[i].second - ref_points_[i].second;
+  }
+  for (int i = 0; i < num_of_slack_variables_; ++i) {
+    last_deviations_[num_of_pos_variables_ + i] = slack_[i];
+  }
+}
+
 bool FemPosDeviationSqpOsqpInterface::OptimizeWithOsqp(
-    const std::vector<c_float>& primal_warm_start, OSQPWorkspace** work) {
-  osqp_warm_start_x(*work, primal_warm_start.data());
+    const std::vector<c_float>& primal_warm_start) {
+  osqp_warm_start_x(work_, primal_warm_start.data());
 
   // Solve Problem
-  osqp_solve(*work);
+  osqp_solve(work_);
 
-  auto status = (*work)->info->status_val;
+  auto status = work_->info->status_val;
 
   if (status < 0) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work_->info->status;
     return false;
   }
 
   if (status != 1 && status != 2) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work_->info->status;
     return false;
   }
 
@@ -505,12 +622,12 @@ bool FemPosDeviationSqpOsqpInterface::OptimizeWithOsqp(
   slack_.resize(num_of_slack_variables_);
   for (int i = 0; i < num_of_points_; ++i) {
     int index = i * 2;
-    opt_xy_.at(i) = std::make_pair((*work)->solution->x[index],
-                                   (*work)->solution->x[index + 1]);
+    opt_xy_.at(i) = std::make_pair(work_->solution->x[index],
+                                   work_->solution->x[index + 1]);
   }
 
   for (int i = 0; i < num_of_slack_variables_; ++i) {
-    slack_.at(i) = (*work)->solution->x[num_of_pos_variables_ + i];
+    slack_.at(i) = work_->solution->x[num_of_pos_variables_ + i];
   }
 
   return true;
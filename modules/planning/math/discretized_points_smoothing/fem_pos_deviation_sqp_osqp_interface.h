@@ -28,11 +28,24 @@
 namespace apollo {
 namespace planning {
 
+/*
+ * @brief:
+ * The OSQP workspace of the problem is kept across the SQP iterations and
+ * across Solve() calls. The sparsity of P and A only depends on the number of
+ * points, so that while it and the weights of P stay the same, an iteration
+ * only updates the values of A, q and the bounds. Each solve starts from the
+ * deviations of the last solution from its reference points.
+ */
 class FemPosDeviationSqpOsqpInterface {
  public:
   FemPosDeviationSqpOsqpInterface() = default;
 
-  virtual ~FemPosDeviationSqpOsqpInterface() = default;
+  virtual ~FemPosDeviationSqpOsqpInterface();
+
+  FemPosDeviationSqpOsqpInterface(const FemPosDeviationSqpOsqpInterface&) =
+      delete;
+  FemPosDeviationSqpOsqpInterface& operator=(
+      const FemPosDeviationSqpOsqpInterface&) = delete;
 
   void set_ref_points(
       const std::vector<std::pair<double, double>>& ref_points) {
@@ -91,31 +104,63 @@ class FemPosDeviationSqpOsqpInterface {
 
   bool Solve();
 
+  /**
+   * @brief Drops the workspace and the last solution, so that the next
+   * problem is set up again and starts from its reference points.
+   */
+  void Reset();
+
   const std::vector<std::pair<double, double>>& opt_xy() const {
     return opt_xy_;
   }
 
  private:
+  // The linearization of the curvature constraints around points, with the
+  // terms of the i-th constraint, on points i, i + 1 and i + 2, at index i
+  struct LinearizedFemPosParams {
+    std::vector<double> linear_term_x_f;
+    std::vector<double> linear_term_y_f;
+    std::vector<double> linear_term_x_m;
+    std::vector<double> linear_term_y_m;
+    std::vector<double> linear_term_x_l;
+    std::vector<double> linear_term_y_l;
+    std::vector<double> linear_approx;
+  };
+
   void CalculateKernel(std::vector<c_float>* P_data,
                        std::vector<c_int>* P_indices,
                        std::vector<c_int>* P_indptr);
 
   void CalculateOffset(std::vector<c_float>* q);
 
-  std::vector<double> CalculateLinearizedFemPosParams(
-      const std::vector<std::pair<double, double>>& points, const size_t index);
-
-  void CalculateAffineConstraint(
+  void CalculateLinearizedFemPosParams(
       const std::vector<std::pair<double, double>>& points,
-      std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
-      std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
-      std::vector<c_float>* upper_bounds);
+      LinearizedFemPosParams* params);
+
+  void CalculateAffineConstraint(std::vector<c_int>* A_indices,
+                                 std::vector<c_int>* A_indptr);
+
+  void CalculateAffineConstraintData(const LinearizedFemPosParams& params,
+                                     std::vector<c_float>* A_data);
+
+  void CalculateBounds(const LinearizedFemPosParams& params,
+                       std::vector<c_float>* lower_bounds,
+                       std::vector<c_float>* upper_bounds);
 
   void SetPrimalWarmStart(const std::vector<std::pair<double, double>>& points,
                           std::vector<c_float>* primal_warm_start);
 
-  bool OptimizeWithOsqp(const std::vector<c_float>& primal_warm_start,
-                        OSQPWorkspace** work);
+  bool HasSameSetup() const;
+
+  bool SetupWorkspace();
+
+  bool UpdateWorkspace();
+
+  void CleanupWorkspace();
+
+  void SetLastDeviations();
+
+  bool OptimizeWithOsqp(const std::vector<c_float>& primal_warm_start);
 
   double CalculateConstraintViolation(
       const std::vector<std::pair<double, double>>& points);
@@ -154,6 +199,36 @@ class FemPosDeviationSqpOsqpInterface {
   int num_of_curvature_constraints_ = 0;
   int num_of_constraints_ = 0;
 
+  // The problem the workspace is set up for
+  struct WorkspaceSetup {
+    int num_of_points = 0;
+    double weight_fem_pos_deviation = 0.0;
+    double weight_path_length = 0.0;
+    double weight_ref_deviation = 0.0;
+    int max_iter = 0;
+    double time_limit = 0.0;
+    bool verbose = false;
+    bool scaled_termination = false;
+    bool warm_start = false;
+  };
+
+  OSQPWorkspace* work_ = nullptr;
+  WorkspaceSetup workspace_setup_;
+
+  // Vectors of the problem, kept to save their allocations across iterations
+  LinearizedFemPosParams linearized_params_;
+  std::vector<double> points_x_;
+  std::vector<double> points_y_;
+  std::vector<c_float> q_;
+  std::vector<c_float> A_data_;
+  std::vector<c_float> lower_bounds_;
+  std::vector<c_float> upper_bounds_;
+  std::vector<c_float> primal_warm_start_;
+
+  // Deviations of the last solution from its reference points, followed by
+  // its slack variables
+  std::vector<c_float> last_deviations_;
+
   // Optimized_result
   std::vector<std::pair<double, double>> opt_xy_;
   std::vector<double> slack_;
@@ -16,6 +16,8 @@
 
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
 
@@ -48,42 +50,41 @@ PiecewiseJerkProblem::PiecewiseJerkProblem(
   weight_x_ref_vec_ = std::vector<double>(num_of_knots_, 0.0);
 }
 
-OSQPData* PiecewiseJerkProblem::FormulateProblem() {
+void PiecewiseJerkProblem::FormulateProblem(PiecewiseJerkQpData* const qp) {
+  CHECK_NOTNULL(qp);
+  *qp = PiecewiseJerkQpData();
   // calculate kernel
-  std::vector<c_float> P_data;
-  std::vector<c_int> P_indices;
-  std::vector<c_int> P_indptr;
-  CalculateKernel(&P_data, &P_indices, &P_indptr);
+  CalculateKernel(&qp->P_data, &qp->P_indices, &qp->P_indptr);
 
   // calculate affine constraints
-  std::vector<c_float> A_data;
-  std::vector<c_int> A_indices;
-  std::vector<c_int> A_indptr;
-  std::vector<c_float> lower_bounds;
-  std::vector<c_float> upper_bounds;
-  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
-                            &upper_bounds);
+  CalculateAffineConstraint(&qp->A_data, &qp->A_indices, &qp->A_indptr,
+                            &qp->lower_bounds, &qp->upper_bounds);
 
   // calculate offset
-  std::vector<c_float> q;
-  CalculateOffset(&q);
+  CalculateOffset(&qp->q);
+  CHECK_EQ(qp->lower_bounds.size(), qp->upper_bounds.size());
+}
+
+OSQPData* PiecewiseJerkProblem::FormulateProblem() {
+  PiecewiseJerkQpData qp;
+  FormulateProblem(&qp);
 
   OSQPData* data = reinterpret_cast<OSQPData*>(c_malloc(sizeof(OSQPData)));
-  CHECK_EQ(lower_bounds.size(), upper_bounds.size());
 
   size_t kernel_dim = 3 * num_of_knots_;
-  size_t num_affine_constraint = lower_bounds.size();
+  size_t num_affine_constraint = qp.lower_bounds.size();
 
   data->n = kernel_dim;
   data->m = num_affine_constraint;
-  data->P = csc_matrix(kernel_dim, kernel_dim, P_data.size(), CopyData(P_data),
-                       CopyData(P_indices), CopyData(P_indptr));
-  data->q = CopyData(q);
-  data->A =
-      csc_matrix(num_affine_constraint, kernel_dim, A_data.size(),
-                 CopyData(A_data), CopyData(A_indices), CopyData(A_indptr));
-  data->l = CopyData(lower_bounds);
-  data->u = CopyData(upper_bounds);
+  data->P = csc_matrix(kernel_dim, kernel_dim, qp.P_data.size(),
+                       CopyData(qp.P_data), CopyData(qp.P_indices),
+                       CopyData(qp.P_indptr));
+  data->q = CopyData(qp.q);
+  data->A = csc_matrix(num_affine_constraint, kernel_dim, qp.A_data.size(),
+                       CopyData(qp.A_data), CopyData(qp.A_indices),
+                       CopyData(qp.A_indptr));
+  data->l = CopyData(qp.lower_bounds);
+  data->u = CopyData(qp.upper_bounds);
   return data;
 }
 
@@ -116,15 +117,7 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   }
 
   // extract primal results
-  x_.resize(num_of_knots_);
-  dx_.resize(num_of_knots_);
-  ddx_.resize(num_of_knots_);
-  for (size_t i = 0; i < num_of_knots_; ++i) {
-    x_.at(i) = osqp_work->solution->x[i] / scale_factor_[0];
-    dx_.at(i) = osqp_work->solution->x[i + num_of_knots_] / scale_factor_[1];
-    ddx_.at(i) =
-        osqp_work->solution->x[i + 2 * num_of_knots_] / scale_factor_[2];
-  }
+  SetSolution(osqp_work->solution->x);
 
   // Cleanup
   osqp_cleanup(osqp_work);
@@ -133,6 +126,73 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   return true;
 }
 
+bool PiecewiseJerkProblem::Optimize(const int max_iter,
+                                    PiecewiseJerkSolver* const solver,
+                                    const double warm_start_shift) {
+  CHECK_NOTNULL(solver);
+  PiecewiseJerkQpData qp;
+  FormulateProblem(&qp);
+
+  OSQPSettings* settings = SolverDefaultSettings();
+  settings->max_iter = max_iter;
+
+  std::vector<c_float> solution;
+  const bool success = solver->Solve(
+      qp, *settings,
+      ShiftedWarmStart(solver->last_solution(), warm_start_shift), &solution);
+  c_free(settings);
+  if (!success) {
+    return false;
+  }
+  ADEBUG << "OSQP " << (solver->last_setup_reused() ? "update" : "setup")
+         << " time: " << solver->last_setup_time_ms()
+         << " ms, solve time: " << solver->last_solve_time_ms()
+         << " ms, iterations: " << solver->last_num_iterations();
+
+  SetSolution(solution.data());
+  return true;
+}
+
+std::vector<c_float> PiecewiseJerkProblem::ShiftedWarmStart(
+    const std::vector<c_float>& last_solution,
+    const double warm_start_shift) const {
+  std::vector<c_float> warm_start;
+  const size_t last_num_of_knots = last_solution.size() / 3;
+  if (last_num_of_knots < 2 || last_solution.size() % 3 != 0) {
+    return warm_start;
+  }
+  const double max_index = static_cast<double>(last_num_of_knots - 1);
+  warm_start.resize(3 * num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    const double index = std::min(
+        std::max(static_cast<double>(i) + warm_start_shift, 0.0), max_index);
+    const size_t lower = std::min(static_cast<size_t>(index),
+                                  last_num_of_knots - 2);
+    const double ratio = index - static_cast<double>(lower);
+    for (size_t j = 0; j < 3; ++j) {
+      const c_float* values = last_solution.data() + j * last_num_of_knots;
+      warm_start[j * num_of_knots_ + i] =
+          values[lower] + ratio * (values[lower + 1] - values[lower]);
+    }
+  }
+  const double x_offset = x_init_[0] * scale_factor_[0] - warm_start[0];
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    warm_start[i] += x_offset;
+  }
+  return warm_start;
+}
+
+void PiecewiseJerkProblem::SetSolution(const c_float* solution) {
+  x_.resize(num_of_knots_);
+  dx_.resize(num_of_knots_);
+  ddx_.resize(num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    x_.at(i) = solution[i] / scale_factor_[0];
+    dx_.at(i) = solution[i + num_of_knots_] / scale_factor_[1];
+    ddx_.at(i) = solution[i + 2 * num_of_knots_] / scale_factor_[2];
+  }
+}
+
 void PiecewiseJerkProblem::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
     std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_solver.h"
 #include "osqp/osqp.h"
 
 namespace apollo {
@@ -110,6 +111,19 @@ class PiecewiseJerkProblem {
 
   virtual bool Optimize(const int max_iter = 4000);
 
+  /**
+   * @brief Optimize in the workspace of a solver kept by the caller across
+   * planning cycles, starting from the last solution of the solver shifted
+   * by the knots the problem moved since.
+   *
+   * @param max_iter: optimization max iterations
+   * @param solver: the solver of the previous cycles
+   * @param warm_start_shift: the number of knots, possibly fractional, the
+   * first knot moved forward since the last solution of the solver
+   */
+  bool Optimize(const int max_iter, PiecewiseJerkSolver* const solver,
+                const double warm_start_shift);
+
   const std::vector<double>& opt_x() const { return x_; }
 
   const std::vector<double>& opt_dx() const { return dx_; }
@@ -134,6 +148,16 @@ class PiecewiseJerkProblem {
 
   OSQPData* FormulateProblem();
 
+  void FormulateProblem(PiecewiseJerkQpData* const qp);
+
+  // The previous solution moved back by warm_start_shift knots, with x moved
+  // to start at x_init, as for s measured from the start of each cycle.
+  std::vector<c_float> ShiftedWarmStart(
+      const std::vector<c_float>& last_solution,
+      const double warm_start_shift) const;
+
+  void SetSolution(const c_float* solution);
+
   void FreeData(OSQPData* data);
 
   template <typename T>
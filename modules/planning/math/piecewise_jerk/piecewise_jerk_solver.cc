@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_solver.h"
+
+#include <chrono>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+double ElapsedMs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+PiecewiseJerkSolver::~PiecewiseJerkSolver() { Reset(); }
+
+void PiecewiseJerkSolver::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  last_solution_.clear();
+}
+
+bool PiecewiseJerkSolver::Solve(const PiecewiseJerkQpData& qp,
+                                const OSQPSettings& settings,
+                                const std::vector<c_float>& primal_warm_start,
+                                std::vector<c_float>* const solution) {
+  CHECK_NOTNULL(solution);
+  CHECK_EQ(qp.lower_bounds.size(), qp.upper_bounds.size());
+  last_setup_time_ms_ = 0.0;
+  last_solve_time_ms_ = 0.0;
+  last_num_iterations_ = 0;
+  const auto setup_start = std::chrono::steady_clock::now();
+  last_setup_reused_ = work_ != nullptr && HasSameSparsity(qp);
+  if (last_setup_reused_) {
+    if (!Update(qp, settings)) {
+      AERROR << "Failed to update the OSQP workspace, set it up again.";
+      last_setup_reused_ = false;
+    }
+  }
+  if (!last_setup_reused_ && !Setup(qp, settings)) {
+    AERROR << "Failed to set up the OSQP workspace.";
+    Reset();
+    return false;
+  }
+  const size_t num_of_variables = qp.q.size();
+  if (primal_warm_start.size() == num_of_variables) {
+    osqp_warm_start_x(work_, primal_warm_start.data());
+  }
+  last_setup_time_ms_ = ElapsedMs(setup_start);
+
+  const auto solve_start = std::chrono::steady_clock::now();
+  osqp_solve(work_);
+  last_solve_time_ms_ = ElapsedMs(solve_start);
+  last_num_iterations_ = static_cast<int>(work_->info->iter);
+
+  const auto status = work_->info->status_val;
+  if (status < 0 || (status != 1 && status != 2)) {
+    AERROR << "failed optimization status:\t" << work_->info->status;
+    // The iterates of a failed solve are no start for the next one.
+    Reset();
+    return false;
+  } else if (work_->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    Reset();
+    return false;
+  }
+  last_solution_.assign(work_->solution->x,
+                        work_->solution->x + num_of_variables);
+  *solution = last_solution_;
+  return true;
+}
+
+bool PiecewiseJerkSolver::Setup(const PiecewiseJerkQpData& qp,
+                                const OSQPSettings& settings) {
+  Reset();
+  qp_ = qp;
+  const c_int n = static_cast<c_int>(qp_.q.size());
+  const c_int m = static_cast<c_int>(qp_.lower_bounds.size());
+
+  // osqp_setup copies the data into the workspace.
+  OSQPData data;
+  data.n = n;
+  data.m = m;
+  data.P = csc_matrix(n, n, static_cast<c_int>(qp_.P_data.size()),
+                      qp_.P_data.data(), qp_.P_indices.data(),
+                      qp_.P_indptr.data());
+  data.q = qp_.q.data();
+  data.A = csc_matrix(m, n, static_cast<c_int>(qp_.A_data.size()),
+                      qp_.A_data.data(), qp_.A_indices.data(),
+                      qp_.A_indptr.data());
+  data.l = qp_.lower_bounds.data();
+  data.u = qp_.upper_bounds.data();
+
+  work_ = osqp_setup(&data, &settings);
+  // csc_matrix only allocates the struct around the arrays.
+  c_free(data.P);
+  c_free(data.A);
+  ++num_setups_;
+  return work_ != nullptr;
+}
+
+bool PiecewiseJerkSolver::Update(const PiecewiseJerkQpData& qp,
+                                 const OSQPSettings& settings) {
+  const bool P_changed = qp.P_data != qp_.P_data;
+  const bool A_changed = qp.A_data != qp_.A_data;
+  c_int ret = 0;
+  if (P_changed) {
+    const std::vector<c_float> P_triu = UpperTriangularPData(qp);
+    if (A_changed) {
+      ret = osqp_update_P_A(work_, P_triu.data(), OSQP_NULL,
+                            static_cast<c_int>(P_triu.size()),
+                            qp.A_data.data(), OSQP_NULL,
+                            static_cast<c_int>(qp.A_data.size()));
+    } else {
+      ret = osqp_update_P(work_, P_triu.data(), OSQP_NULL,
+                          static_cast<c_int>(P_triu.size()));
+    }
+  } else if (A_changed) {
+    ret = osqp_update_A(work_, qp.A_data.data(), OSQP_NULL,
+                        static_cast<c_int>(qp.A_data.size()));
+  }
+  if (ret != 0) {
+    return false;
+  }
+  if (osqp_update_lin_cost(work_, qp.q.data()) != 0 ||
+      osqp_update_bounds(work_, qp.lower_bounds.data(),
+                         qp.upper_bounds.data()) != 0 ||
+      osqp_update_max_iter(work_, settings.max_iter) != 0) {
+    return false;
+  }
+  if (P_changed) {
+    qp_.P_data = qp.P_data;
+  }
+  if (A_changed) {
+    qp_.A_data = qp.A_data;
+  }
+  ++num_updates_;
+  return true;
+}
+
+bool PiecewiseJerkSolver::HasSameSparsity(
+    const PiecewiseJerkQpData& qp) const {
+  return qp.q.size() == qp_.q.size() &&
+         qp.lower_bounds.size() == qp_.lower_bounds.size() &&
+         qp.P_indices == qp_.P_indices && qp.P_indptr == qp_.P_indptr &&
+         qp.A_indices == qp_.A_indices && qp.A_indptr == qp_.A_indptr;
+}
+
+std::vector<c_float> PiecewiseJerkSolver::UpperTriangularPData(
+    const PiecewiseJerkQpData& qp) const {
+  std::vector<c_float> P_triu;
+  P_triu.reserve(qp.P_data.size());
+  for (size_t col = 0; col + 1 < qp.P_indptr.size(); ++col) {
+    for (c_int k = qp.P_indptr[col]; k < qp.P_indptr[col + 1]; ++k) {
+      if (qp.P_indices[k] <= static_cast<c_int>(col)) {
+        P_triu.push_back(qp.P_data[k]);
+      }
+    }
+  }
+  return P_triu;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <vector>
+
+#include "gtest/gtest_prod.h"
+#include "osqp/osqp.h"
+
+namespace apollo {
+namespace planning {
+
+/*
+ * @brief:
+ * The matrices and vectors of a quadratic program in the OSQP form
+ *   min 1/2 x'Px + q'x,  s.t. l <= Ax <= u,
+ * with P and A in CSC format. OSQP only reads the upper triangular part of P.
+ */
+struct PiecewiseJerkQpData {
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  std::vector<c_float> q;
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  std::vector<c_float> lower_bounds;
+  std::vector<c_float> upper_bounds;
+};
+
+/*
+ * @brief:
+ * An OSQP workspace kept across planning cycles by a task solving a piecewise
+ * jerk problem each cycle.
+ *
+ * While the problem keeps the sparsity of P and A, only the changed values
+ * are updated in the workspace, which skips the allocations and the symbolic
+ * factorization of a new setup; when only q, l and u change, the matrix is
+ * not factorized again either. A new sparsity, e.g. from a different number
+ * of knots, sets the workspace up again.
+ */
+class PiecewiseJerkSolver {
+ public:
+  PiecewiseJerkSolver() = default;
+
+  ~PiecewiseJerkSolver();
+
+  PiecewiseJerkSolver(const PiecewiseJerkSolver&) = delete;
+  PiecewiseJerkSolver& operator=(const PiecewiseJerkSolver&) = delete;
+
+  /**
+   * @brief Solves a problem in the kept workspace.
+   * @param qp the problem
+   * @param settings the settings for a new setup; only max_iter is applied to
+   * a kept workspace
+   * @param primal_warm_start the primal variables to start from, or empty to
+   * start from the last solution of the workspace
+   * @param solution the primal variables of the solution
+   * @return whether a solution is found
+   */
+  bool Solve(const PiecewiseJerkQpData& qp, const OSQPSettings& settings,
+             const std::vector<c_float>& primal_warm_start,
+             std::vector<c_float>* const solution);
+
+  /**
+   * @brief Drops the workspace, so that the next problem is set up again.
+   */
+  void Reset();
+
+  /**
+   * @brief The primal variables of the last solution, or empty if the last
+   * solve failed.
+   */
+  const std::vector<c_float>& last_solution() const { return last_solution_; }
+
+  // Instrumentation of the last solve.
+  bool last_setup_reused() const { return last_setup_reused_; }
+
+  double last_setup_time_ms() const { return last_setup_time_ms_; }
+
+  double last_solve_time_ms() const { return last_solve_time_ms_; }
+
+  int last_num_iterations() const { return last_num_iterations_; }
+
+  int num_setups() const { return num_setups_; }
+
+  int num_updates() const { return num_updates_; }
+
+ private:
+  bool Setup(const PiecewiseJerkQpData& qp, const OSQPSettings& settings);
+
+  bool Update(const PiecewiseJerkQpData& qp, const OSQPSettings& settings);
+
+  bool HasSameSparsity(const PiecewiseJerkQpData& qp) const;
+
+  // The values of the upper triangular part of P, in the order OSQP keeps
+  // them.
+  std::vector<c_float> UpperTriangularPData(
+      const PiecewiseJerkQpData& qp) const;
+
+ private:
+  OSQPWorkspace* work_ = nullptr;
+
+  // The problem in the workspace, to find what changed.
+  PiecewiseJerkQpData qp_;
+
+  std::vector<c_float> last_solution_;
+
+  bool last_setup_reused_ = false;
+  double last_setup_time_ms_ = 0.0;
+  double last_solve_time_ms_ = 0.0;
+  int last_num_iterations_ = 0;
+  int num_setups_ = 0;
+  int num_updates_ = 0;
+
+  FRIEND_TEST(PiecewiseJerkSolverTest, UpperTriangularPData);
+};
+
+}  // namespace planning
+}  // namespace apollo
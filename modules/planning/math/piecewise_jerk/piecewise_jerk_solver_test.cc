@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_solver.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+constexpr double kTolerance = 1e-4;
+
+// min 1/2 x'Px + q'x over three variables, with P symmetric and stored in
+// full, s.t. box bounds on each variable and a bound on a weighted sum.
+//   P = | 4p   p   0 |    A = | 1  0  0 |
+//       |  p  2p   p |        | 0  1  0 |
+//       |  0   p  3p |        | 0  0  1 |
+//                             | 1  a  1 |
+PiecewiseJerkQpData Qp(const double p, const double a, const double q1) {
+  PiecewiseJerkQpData qp;
+  qp.P_data = {4.0 * p, p, p, 2.0 * p, p, p, 3.0 * p};
+  qp.P_indices = {0, 1, 0, 1, 2, 1, 2};
+  qp.P_indptr = {0, 2, 5, 7};
+  qp.q = {-1.0, q1, 2.0};
+  qp.A_data = {1.0, 1.0, 1.0, a, 1.0, 1.0};
+  qp.A_indices = {0, 3, 1, 3, 2, 3};
+  qp.A_indptr = {0, 2, 4, 6};
+  qp.lower_bounds = {-1.0, -1.0, -1.0, -0.5};
+  qp.upper_bounds = {1.0, 1.0, 1.0, 0.5};
+  return qp;
+}
+
+OSQPSettings Settings() {
+  OSQPSettings settings;
+  osqp_set_default_settings(&settings);
+  settings.eps_abs = 1e-7;
+  settings.eps_rel = 1e-7;
+  settings.polish = true;
+  settings.verbose = false;
+  return settings;
+}
+
+std::vector<c_float> FreshSolution(const PiecewiseJerkQpData& qp) {
+  PiecewiseJerkSolver solver;
+  std::vector<c_float> solution;
+  EXPECT_TRUE(solver.Solve(qp, Settings(), {}, &solution));
+  return solution;
+}
+
+void ExpectSameSolution(const std::vector<c_float>& expected,
+                        const std::vector<c_float>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], kTolerance) << "variable " << i;
+  }
+}
+
+}  // namespace
+
+TEST(PiecewiseJerkSolverTest, ReusedWorkspaceMatchesFreshOne) {
+  PiecewiseJerkSolver solver;
+  std::vector<c_float> solution;
+  ASSERT_TRUE(solver.Solve(Qp(1.0, 2.0, 3.0), Settings(), {}, &solution));
+  EXPECT_FALSE(solver.last_setup_reused());
+  ExpectSameSolution(FreshSolution(Qp(1.0, 2.0, 3.0)), solution);
+
+  // Only q changes, which is updated in the workspace.
+  ASSERT_TRUE(solver.Solve(Qp(1.0, 2.0, -3.0), Settings(), {}, &solution));
+  EXPECT_TRUE(solver.last_setup_reused());
+  EXPECT_EQ(1, solver.num_setups());
+  EXPECT_EQ(1, solver.num_updates());
+  ExpectSameSolution(FreshSolution(Qp(1.0, 2.0, -3.0)), solution);
+  ExpectSameSolution(solution, solver.last_solution());
+}
+
+TEST(PiecewiseJerkSolverTest, UpdatesMatrixValues) {
+  PiecewiseJerkSolver solver;
+  std::vector<c_float> solution;
+  ASSERT_TRUE(solver.Solve(Qp(1.0, 2.0, 3.0), Settings(), {}, &solution));
+
+  // P alone, whose upper triangular part is passed to osqp_update_P.
+  ASSERT_TRUE(solver.Solve(Qp(5.0, 2.0, 3.0), Settings(), {}, &solution));
+  EXPECT_TRUE(solver.last_setup_reused());
+  ExpectSameSolution(FreshSolution(Qp(5.0, 2.0, 3.0)), solution);
+
+  // A alone.
+  ASSERT_TRUE(solver.Solve(Qp(5.0, -4.0, 3.0), Settings(), {}, &solution));
+  EXPECT_TRUE(solver.last_setup_reused());
+  ExpectSameSolution(FreshSolution(Qp(5.0, -4.0, 3.0)), solution);
+
+  // P and A together.
+  ASSERT_TRUE(solver.Solve(Qp(0.5, 3.0, 3.0), Settings(), {}, &solution));
+  EXPECT_TRUE(solver.last_setup_reused());
+  ExpectSameSolution(FreshSolution(Qp(0.5, 3.0, 3.0)), solution);
+
+  EXPECT_EQ(1, solver.num_setups());
+  EXPECT_EQ(3, solver.num_updates());
+}
+
+TEST(PiecewiseJerkSolverTest, UpperTriangularPData) {
+  PiecewiseJerkSolver solver;
+  const std::vector<c_float> expected = {4.0, 1.0, 2.0, 1.0, 3.0};
+  EXPECT_EQ(expected, solver.UpperTriangularPData(Qp(1.0, 2.0, 3.0)));
+
+  // An upper triangular P is kept as it is.
+  PiecewiseJerkQpData qp = Qp(1.0, 2.0, 3.0);
+  qp.P_data = expected;
+  qp.P_indices = {0, 0, 1, 1, 2};
+  qp.P_indptr = {0, 1, 3, 5};
+  EXPECT_EQ(expected, solver.UpperTriangularPData(qp));
+}
+
+TEST(PiecewiseJerkSolverTest, SparsityChangeSetsUpAgain) {
+  PiecewiseJerkSolver solver;
+  std::vector<c_float> solution;
+  ASSERT_TRUE(solver.Solve(Qp(1.0, 2.0, 3.0), Settings(), {}, &solution));
+
+  // The bound on the sum dropped, which changes the sparsity of A.
+  PiecewiseJerkQpData qp = Qp(1.0, 2.0, 3.0);
+  qp.A_data = {1.0, 1.0, 1.0};
+  qp.A_indices = {0, 1, 2};
+  qp.A_indptr = {0, 1, 2, 3};
+  qp.lower_bounds.pop_back();
+  qp.upper_bounds.pop_back();
+  ASSERT_TRUE(solver.Solve(qp, Settings(), {}, &solution));
+  EXPECT_FALSE(solver.last_setup_reused());
+  EXPECT_EQ(2, solver.num_setups());
+  EXPECT_EQ(0, solver.num_updates());
+  ExpectSameSolution(FreshSolution(qp), solution);
+
+  // A warm start of another size is ignored.
+  ASSERT_TRUE(
+      solver.Solve(Qp(1.0, 2.0, 3.0), Settings(), {0.0, 0.0}, &solution));
+  EXPECT_FALSE(solver.last_setup_reused());
+  EXPECT_EQ(3, solver.num_setups());
+  ExpectSameSolution(FreshSolution(Qp(1.0, 2.0, 3.0)), solution);
+}
+
+}  // namespace planning
+}  // namespace apollo
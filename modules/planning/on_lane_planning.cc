@@ -171,7 +171,8 @@ Status OnLanePlanning::InitFrame(const uint32_t sequence_num,
 
   auto status = frame_->Init(
       injector_->vehicle_state(), reference_lines, segments,
-      reference_line_provider_->FutureRouteWaypoints(), injector_->ego_info());
+      reference_line_provider_->FutureRouteWaypoints(), injector_->ego_info(),
+      injector_->frame_history()->Latest());
   if (!status.ok()) {
     AERROR << "failed to init frame:" << status.ToString();
     return status;
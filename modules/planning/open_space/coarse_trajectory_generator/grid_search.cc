@@ -112,11 +112,11 @@ bool GridSearch::GenerateAStarPath(
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec,
     GridAStartResult* result) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  std::priority_queue<std::pair<uint64_t, double>,
+                      std::vector<std::pair<uint64_t, double>>, cmp>
       open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> close_set;
+  absl::flat_hash_map<uint64_t, std::shared_ptr<Node2d>> open_set;
+  absl::flat_hash_map<uint64_t, std::shared_ptr<Node2d>> close_set;
   XYbounds_ = XYbounds;
   std::shared_ptr<Node2d> start_node =
       std::make_shared<Node2d>(sx, sy, xy_grid_resolution_, XYbounds_);
@@ -130,7 +130,7 @@ bool GridSearch::GenerateAStarPath(
   // Grid a star begins
   size_t explored_node_num = 0;
   while (!open_pq.empty()) {
-    std::string current_id = open_pq.top().first;
+    const uint64_t current_id = open_pq.top().first;
     open_pq.pop();
     std::shared_ptr<Node2d> current_node = open_set[current_id];
     // Check destination
@@ -173,11 +173,15 @@ bool GridSearch::GenerateDpMap(
     const double ex, const double ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  if (HasDpMap(ex, ey, XYbounds, obstacles_linesegments_vec)) {
+    ADEBUG << "reuse the dp map of " << dp_map_.size() << " grids";
+    return true;
+  }
+  std::priority_queue<std::pair<uint64_t, double>,
+                      std::vector<std::pair<uint64_t, double>>, cmp>
       open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  dp_map_ = decltype(dp_map_)();
+  absl::flat_hash_map<uint64_t, std::shared_ptr<Node2d>> open_set;
+  dp_map_.clear();
   XYbounds_ = XYbounds;
   // XYbounds with xmin, xmax, ymin, ymax
   max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
@@ -191,10 +195,11 @@ bool GridSearch::GenerateDpMap(
   // Grid a star begins
   size_t explored_node_num = 0;
   while (!open_pq.empty()) {
-    const std::string current_id = open_pq.top().first;
+    const uint64_t current_id = open_pq.top().first;
     open_pq.pop();
     std::shared_ptr<Node2d> current_node = open_set[current_id];
-    dp_map_.emplace(current_node->GetIndex(), current_node);
+    // The cost of a node does not change once it is in the dp map.
+    dp_map_.emplace(current_node->GetIndex(), current_node->GetCost());
     std::vector<std::shared_ptr<Node2d>> next_nodes =
         std::move(GenerateNextNodes(current_node));
     for (auto& next_node : next_nodes) {
@@ -204,27 +209,65 @@ bool GridSearch::GenerateDpMap(
       if (dp_map_.find(next_node->GetIndex()) != dp_map_.end()) {
         continue;
       }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
+      auto open_node = open_set.find(next_node->GetIndex());
+      if (open_node == open_set.end()) {
         ++explored_node_num;
         next_node->SetPreNode(current_node);
         open_set.emplace(next_node->GetIndex(), next_node);
         open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
       } else {
-        if (open_set[next_node->GetIndex()]->GetCost() > next_node->GetCost()) {
-          open_set[next_node->GetIndex()]->SetCost(next_node->GetCost());
-          open_set[next_node->GetIndex()]->SetPreNode(current_node);
+        if (open_node->second->GetCost() > next_node->GetCost()) {
+          open_node->second->SetCost(next_node->GetCost());
+          open_node->second->SetPreNode(current_node);
         }
       }
     }
   }
+  has_dp_map_ = true;
+  dp_map_end_x_ = ex;
+  dp_map_end_y_ = ey;
+  dp_map_XYbounds_ = XYbounds;
+  dp_map_obstacles_linesegments_vec_ = obstacles_linesegments_vec;
   ADEBUG << "explored node num is " << explored_node_num;
   return true;
 }
 
+bool GridSearch::HasDpMap(
+    const double ex, const double ey, const std::vector<double>& XYbounds,
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) const {
+  if (!has_dp_map_ || ex != dp_map_end_x_ || ey != dp_map_end_y_ ||
+      XYbounds != dp_map_XYbounds_ ||
+      obstacles_linesegments_vec.size() !=
+          dp_map_obstacles_linesegments_vec_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < obstacles_linesegments_vec.size(); ++i) {
+    const auto& linesegments = obstacles_linesegments_vec[i];
+    const auto& dp_map_linesegments = dp_map_obstacles_linesegments_vec_[i];
+    if (linesegments.size() != dp_map_linesegments.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < linesegments.size(); ++j) {
+      const auto& start = linesegments[j].start();
+      const auto& end = linesegments[j].end();
+      const auto& dp_map_start = dp_map_linesegments[j].start();
+      const auto& dp_map_end = dp_map_linesegments[j].end();
+      if (start.x() != dp_map_start.x() || start.y() != dp_map_start.y() ||
+          end.x() != dp_map_end.x() || end.y() != dp_map_end.y()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 double GridSearch::CheckDpMap(const double sx, const double sy) {
-  std::string index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
-  if (dp_map_.find(index) != dp_map_.end()) {
-    return dp_map_[index]->GetCost() * xy_grid_resolution_;
+  const uint64_t index =
+      Node2d::CalcIndex(sx, sy, xy_grid_resolution_, dp_map_XYbounds_);
+  auto cost = dp_map_.find(index);
+  if (cost != dp_map_.end()) {
+    return cost->second * xy_grid_resolution_;
   } else {
     return std::numeric_limits<double>::infinity();
   }
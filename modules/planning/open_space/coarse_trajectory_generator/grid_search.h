@@ -20,15 +20,14 @@
 
 #pragma once
 
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <queue>
-#include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "absl/strings/str_cat.h"
+#include "absl/container/flat_hash_map.h"
 #include "cyber/common/log.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/planning/proto/planner_open_space_config.pb.h"
@@ -45,7 +44,7 @@ class Node2d {
     y_ = y;
     grid_x_ = static_cast<int>((x - XYbounds[0]) / xy_resolution);
     grid_y_ = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
+    index_ = ComputeIndex(grid_x_, grid_y_);
   }
   void SetPathCost(const double path_cost) {
     path_cost_ = path_cost;
@@ -64,23 +63,24 @@ class Node2d {
   double GetPathCost() const { return path_cost_; }
   double GetHeuCost() const { return heuristic_; }
   double GetCost() const { return cost_; }
-  const std::string& GetIndex() const { return index_; }
+  uint64_t GetIndex() const { return index_; }
   std::shared_ptr<Node2d> GetPreNode() const { return pre_node_; }
-  static std::string CalcIndex(const double x, const double y,
-                               const double xy_resolution,
-                               const std::vector<double>& XYbounds) {
+  static uint64_t CalcIndex(const double x, const double y,
+                            const double xy_resolution,
+                            const std::vector<double>& XYbounds) {
     // XYbounds with xmin, xmax, ymin, ymax
     int grid_x = static_cast<int>((x - XYbounds[0]) / xy_resolution);
     int grid_y = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    return ComputeStringIndex(grid_x, grid_y);
+    return ComputeIndex(grid_x, grid_y);
   }
   bool operator==(const Node2d& right) const {
     return right.GetIndex() == index_;
   }
 
  private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid) {
-    return absl::StrCat(x_grid, "_", y_grid);
+  static uint64_t ComputeIndex(int x_grid, int y_grid) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(x_grid)) << 32 |
+           static_cast<uint32_t>(y_grid);
   }
 
  private:
@@ -91,7 +91,7 @@ class Node2d {
   double path_cost_ = 0.0;
   double heuristic_ = 0.0;
   double cost_ = 0.0;
-  std::string index_;
+  uint64_t index_ = 0;
   std::shared_ptr<Node2d> pre_node_ = nullptr;
 };
 
@@ -111,6 +111,8 @@ class GridSearch {
       const std::vector<std::vector<common::math::LineSegment2d>>&
           obstacles_linesegments_vec,
       GridAStartResult* result);
+  // Generates the map of the costs to the end point, or keeps the map of
+  // the last call if it had the same end point, bounds and obstacles.
   bool GenerateDpMap(
       const double ex, const double ey, const std::vector<double>& XYbounds,
       const std::vector<std::vector<common::math::LineSegment2d>>&
@@ -124,6 +126,10 @@ class GridSearch {
       std::shared_ptr<Node2d> node);
   bool CheckConstraints(std::shared_ptr<Node2d> node);
   void LoadGridAStarResult(GridAStartResult* result);
+  bool HasDpMap(const double ex, const double ey,
+                const std::vector<double>& XYbounds,
+                const std::vector<std::vector<common::math::LineSegment2d>>&
+                    obstacles_linesegments_vec) const;
 
  private:
   double xy_grid_resolution_ = 0.0;
@@ -138,12 +144,20 @@ class GridSearch {
       obstacles_linesegments_vec_;
 
   struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
+    bool operator()(const std::pair<uint64_t, double>& left,
+                    const std::pair<uint64_t, double>& right) const {
       return left.second >= right.second;
     }
   };
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  // The costs to the end point, by the indices of the grids.
+  absl::flat_hash_map<uint64_t, double> dp_map_;
+  // The end point, bounds and obstacles of the dp map.
+  bool has_dp_map_ = false;
+  double dp_map_end_x_ = 0.0;
+  double dp_map_end_y_ = 0.0;
+  std::vector<double> dp_map_XYbounds_;
+  std::vector<std::vector<common::math::LineSegment2d>>
+      dp_map_obstacles_linesegments_vec_;
 };
 }  // namespace planning
 }  // namespace apollo
@@ -25,6 +25,7 @@
 namespace apollo {
 namespace planning {
 
+using apollo::common::math::AABox2d;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 using apollo::cyber::Clock;
@@ -53,6 +54,11 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
       planner_open_space_config_.warm_start_config().traj_steer_penalty();
   traj_steer_change_penalty_ = planner_open_space_config_.warm_start_config()
                                    .traj_steer_change_penalty();
+  // With a margin over the rounding of the corners of the box.
+  constexpr double kVehicleBoxRadiusMargin = 1.0e-6;
+  vehicle_box_radius_ =
+      0.5 * std::hypot(vehicle_param_.length(), vehicle_param_.width()) +
+      kVehicleBoxRadiusMargin;
 }
 
 bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
@@ -76,44 +82,63 @@ bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
 
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
-  return ValidityCheck(node);
+  CHECK_GT(reeds_shepp_to_end->x.size(), 0U);
+  // The states are checked as those of a node, without making one.
+  const size_t check_start_index = reeds_shepp_to_end->x.size() == 1 ? 0 : 1;
+  return ValidityCheck(reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+                       reeds_shepp_to_end->phi, check_start_index);
 }
 
 bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
   CHECK_NOTNULL(node);
   CHECK_GT(node->GetStepSize(), 0U);
 
-  if (obstacles_linesegments_vec_.empty()) {
-    return true;
-  }
-
-  size_t node_step_size = node->GetStepSize();
-  const auto& traversed_x = node->GetXs();
-  const auto& traversed_y = node->GetYs();
-  const auto& traversed_phi = node->GetPhis();
-
   // The first {x, y, phi} is collision free unless they are start and end
   // configuration of search problem
   size_t check_start_index = 0;
-  if (node_step_size == 1) {
+  if (node->GetStepSize() == 1) {
     check_start_index = 0;
   } else {
     check_start_index = 1;
   }
+  return ValidityCheck(node->GetXs(), node->GetYs(), node->GetPhis(),
+                       check_start_index);
+}
+
+bool HybridAStar::ValidityCheck(const std::vector<double>& traversed_x,
+                                const std::vector<double>& traversed_y,
+                                const std::vector<double>& traversed_phi,
+                                const size_t check_start_index) {
+  if (obstacles_linesegments_vec_.empty()) {
+    return true;
+  }
 
-  for (size_t i = check_start_index; i < node_step_size; ++i) {
+  const double ego_length = vehicle_param_.length();
+  const double ego_width = vehicle_param_.width();
+  const double shift_distance =
+      ego_length / 2.0 - vehicle_param_.back_edge_to_center();
+  for (size_t i = check_start_index; i < traversed_x.size(); ++i) {
     if (traversed_x[i] > XYbounds_[1] || traversed_x[i] < XYbounds_[0] ||
         traversed_y[i] > XYbounds_[3] || traversed_y[i] < XYbounds_[2]) {
       return false;
     }
-    Box2d bounding_box = Node3d::GetBoundingBox(
-        vehicle_param_, traversed_x[i], traversed_y[i], traversed_phi[i]);
-    for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
+    // The box of Node3d::GetBoundingBox, which is only built when the
+    // obstacles are within the reach of its corners.
+    const double phi = traversed_phi[i];
+    const Vec2d center(traversed_x[i] + shift_distance * std::cos(phi),
+                       traversed_y[i] + shift_distance * std::sin(phi));
+    const AABox2d reach(center, 2.0 * vehicle_box_radius_,
+                        2.0 * vehicle_box_radius_);
+    if (!reach.HasOverlap(all_obstacles_aabox_)) {
+      continue;
+    }
+    const Box2d bounding_box(center, phi, ego_length, ego_width);
+    for (size_t j = 0; j < obstacles_linesegments_vec_.size(); ++j) {
+      if (!reach.HasOverlap(obstacles_aaboxes_[j])) {
+        continue;
+      }
       for (const common::math::LineSegment2d& linesegment :
-           obstacle_linesegments) {
+           obstacles_linesegments_vec_[j]) {
         if (bounding_box.HasOverlap(linesegment)) {
           ADEBUG << "collision start at x: " << linesegment.start().x();
           ADEBUG << "collision start at y: " << linesegment.start().y();
@@ -130,9 +155,8 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
 std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
     std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+  std::shared_ptr<Node3d> end_node = NewNode(
+      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi);
   end_node->SetPre(current_node);
   close_set_.emplace(end_node->GetIndex(), end_node);
   return end_node;
@@ -159,38 +183,37 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
   // take above motion primitive to generate a curve driving the car to a
   // different grid
   double arc = std::sqrt(2) * xy_grid_resolution_;
-  std::vector<double> intermediate_x;
-  std::vector<double> intermediate_y;
-  std::vector<double> intermediate_phi;
+  intermediate_x_.clear();
+  intermediate_y_.clear();
+  intermediate_phi_.clear();
   double last_x = current_node->GetX();
   double last_y = current_node->GetY();
   double last_phi = current_node->GetPhi();
-  intermediate_x.push_back(last_x);
-  intermediate_y.push_back(last_y);
-  intermediate_phi.push_back(last_phi);
+  intermediate_x_.push_back(last_x);
+  intermediate_y_.push_back(last_y);
+  intermediate_phi_.push_back(last_phi);
   for (size_t i = 0; i < arc / step_size_; ++i) {
     const double next_x = last_x + traveled_distance * std::cos(last_phi);
     const double next_y = last_y + traveled_distance * std::sin(last_phi);
     const double next_phi = common::math::NormalizeAngle(
         last_phi +
         traveled_distance / vehicle_param_.wheel_base() * std::tan(steering));
-    intermediate_x.push_back(next_x);
-    intermediate_y.push_back(next_y);
-    intermediate_phi.push_back(next_phi);
+    intermediate_x_.push_back(next_x);
+    intermediate_y_.push_back(next_y);
+    intermediate_phi_.push_back(next_phi);
     last_x = next_x;
     last_y = next_y;
     last_phi = next_phi;
   }
   // check if the vehicle runs outside of XY boundary
-  if (intermediate_x.back() > XYbounds_[1] ||
-      intermediate_x.back() < XYbounds_[0] ||
-      intermediate_y.back() > XYbounds_[3] ||
-      intermediate_y.back() < XYbounds_[2]) {
+  if (intermediate_x_.back() > XYbounds_[1] ||
+      intermediate_x_.back() < XYbounds_[0] ||
+      intermediate_y_.back() > XYbounds_[3] ||
+      intermediate_y_.back() < XYbounds_[2]) {
     return nullptr;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
+  std::shared_ptr<Node3d> next_node =
+      NewNode(intermediate_x_, intermediate_y_, intermediate_phi_);
   next_node->SetPre(current_node);
   next_node->SetDirec(traveled_distance > 0.0);
   next_node->SetSteer(steering);
@@ -232,6 +255,29 @@ double HybridAStar::HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node) {
                                                       next_node->GetY());
 }
 
+std::shared_ptr<Node3d> HybridAStar::NewNode(
+    const std::vector<double>& traversed_x,
+    const std::vector<double>& traversed_y,
+    const std::vector<double>& traversed_phi) {
+  // A node only links to nodes taken before it, so the nodes of the pool
+  // hold no cycles.
+  if (num_pool_nodes_ == node_pool_.size()) {
+    node_pool_.push_back(
+        std::make_shared<Node3d>(traversed_x, traversed_y, traversed_phi,
+                                 XYbounds_, planner_open_space_config_));
+  } else {
+    node_pool_[num_pool_nodes_]->Reset(traversed_x, traversed_y,
+                                       traversed_phi, XYbounds_,
+                                       planner_open_space_config_);
+  }
+  return node_pool_[num_pool_nodes_++];
+}
+
+void HybridAStar::DeleteLastNode() {
+  CHECK_GT(num_pool_nodes_, 0U);
+  --num_pool_nodes_;
+}
+
 bool HybridAStar::GetResult(HybridAStartResult* result) {
   std::shared_ptr<Node3d> current_node = final_node_;
   std::vector<double> hybrid_a_x;
@@ -642,6 +688,7 @@ bool HybridAStar::Plan(
   close_set_.clear();
   open_pq_ = decltype(open_pq_)();
   final_node_ = nullptr;
+  num_pool_nodes_ = 0;
 
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec;
@@ -656,6 +703,27 @@ bool HybridAStar::Plan(
     obstacles_linesegments_vec.emplace_back(obstacle_linesegments);
   }
   obstacles_linesegments_vec_ = std::move(obstacles_linesegments_vec);
+  obstacles_aaboxes_.clear();
+  all_obstacles_aabox_ = AABox2d();
+  bool has_obstacles_aabox = false;
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
+    AABox2d obstacle_aabox;
+    if (!obstacle_linesegments.empty()) {
+      obstacle_aabox = AABox2d(obstacle_linesegments.front().start(),
+                               obstacle_linesegments.front().end());
+      for (const auto& linesegment : obstacle_linesegments) {
+        obstacle_aabox.MergeFrom(linesegment.start());
+        obstacle_aabox.MergeFrom(linesegment.end());
+      }
+      if (has_obstacles_aabox) {
+        all_obstacles_aabox_.MergeFrom(obstacle_aabox);
+      } else {
+        all_obstacles_aabox_ = obstacle_aabox;
+        has_obstacles_aabox = true;
+      }
+    }
+    obstacles_aaboxes_.push_back(obstacle_aabox);
+  }
 
   // load XYbounds
   XYbounds_ = XYbounds;
@@ -687,7 +755,7 @@ bool HybridAStar::Plan(
   double rs_time = 0.0;
   while (!open_pq_.empty()) {
     // take out the lowest cost neighboring node
-    const std::string current_id = open_pq_.top().first;
+    const uint64_t current_id = open_pq_.top().first;
     open_pq_.pop();
     std::shared_ptr<Node3d> current_node = open_set_[current_id];
     // check if an analystic curve could be connected from current
@@ -708,10 +776,12 @@ bool HybridAStar::Plan(
       }
       // check if the node is already in the close set
       if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+        DeleteLastNode();
         continue;
       }
       // collision check
       if (!ValidityCheck(next_node)) {
+        DeleteLastNode();
         continue;
       }
       if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
@@ -722,6 +792,8 @@ bool HybridAStar::Plan(
         heuristic_time += end_time - start_time;
         open_set_.emplace(next_node->GetIndex(), next_node);
         open_pq_.emplace(next_node->GetIndex(), next_node->GetCost());
+      } else {
+        DeleteLastNode();
       }
     }
   }
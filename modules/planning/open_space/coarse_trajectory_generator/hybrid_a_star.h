@@ -21,18 +21,19 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <queue>
-#include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
 #include "cyber/time/clock.h"
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/aabox2d.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -70,6 +71,11 @@ class HybridAStar {
   bool AnalyticExpansion(std::shared_ptr<Node3d> current_node);
   // check collision and validity
   bool ValidityCheck(std::shared_ptr<Node3d> node);
+  // check collision and validity of the states from check_start_index on
+  bool ValidityCheck(const std::vector<double>& traversed_x,
+                     const std::vector<double>& traversed_y,
+                     const std::vector<double>& traversed_phi,
+                     const size_t check_start_index);
   // check Reeds Shepp path collision and validity
   bool RSPCheck(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end);
   // load the whole RSP as nodes and add to the close set
@@ -87,6 +93,13 @@ class HybridAStar {
   bool GetTemporalProfile(HybridAStartResult* result);
   bool GenerateSpeedAcceleration(HybridAStartResult* result);
   bool GenerateSCurveSpeedAcceleration(HybridAStartResult* result);
+  // The nodes of a search are taken from a pool kept across plans, so that
+  // the nodes and the memory of their states are reused.
+  std::shared_ptr<Node3d> NewNode(const std::vector<double>& traversed_x,
+                                  const std::vector<double>& traversed_y,
+                                  const std::vector<double>& traversed_phi);
+  // Returns the last node taken to the pool, when it is not kept.
+  void DeleteLastNode();
 
  private:
   PlannerOpenSpaceConfig planner_open_space_config_;
@@ -113,18 +126,32 @@ class HybridAStar {
   std::shared_ptr<Node3d> final_node_;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
+  // The bounding boxes of the obstacles, and of all of them, against which
+  // the vehicle boxes are checked before their line segments.
+  std::vector<common::math::AABox2d> obstacles_aaboxes_;
+  common::math::AABox2d all_obstacles_aabox_;
+  // The radius of the circle around the center of a vehicle box holding the
+  // box.
+  double vehicle_box_radius_ = 0.0;
+
+  std::vector<std::shared_ptr<Node3d>> node_pool_;
+  size_t num_pool_nodes_ = 0;
+  // The states of the motion primitive being generated.
+  std::vector<double> intermediate_x_;
+  std::vector<double> intermediate_y_;
+  std::vector<double> intermediate_phi_;
 
   struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
+    bool operator()(const std::pair<uint64_t, double>& left,
+                    const std::pair<uint64_t, double>& right) const {
       return left.second >= right.second;
     }
   };
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  std::priority_queue<std::pair<uint64_t, double>,
+                      std::vector<std::pair<uint64_t, double>>, cmp>
       open_pq_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> close_set_;
+  absl::flat_hash_map<uint64_t, std::shared_ptr<Node3d>> open_set_;
+  absl::flat_hash_map<uint64_t, std::shared_ptr<Node3d>> close_set_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
 };
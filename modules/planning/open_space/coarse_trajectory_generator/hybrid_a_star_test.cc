@@ -76,5 +76,26 @@ TEST_F(HybridATest, test1) {
   ASSERT_TRUE(hybrid_test->Plan(sx, sy, sphi, ex, ey, ephi, XYbounds_,
                                 obstacles_list, &result));
 }
+
+TEST_F(HybridATest, replan) {
+  std::vector<std::vector<Vec2d>> obstacles_list = {
+      {Vec2d(1.0, 0.0), Vec2d(-1.0, 0.0)}};
+  std::vector<double> XYbounds_ = {-50.0, 50.0, -50.0, 50.0};
+  HybridAStartResult result;
+  ASSERT_TRUE(hybrid_test->Plan(-15.0, 0.0, 0.0, 15.0, 0.0, 0.0, XYbounds_,
+                                obstacles_list, &result));
+  // A planner taking another start to the same end reuses its nodes and the
+  // heuristic of the end, and plans as a new planner does.
+  HybridAStartResult replan_result;
+  ASSERT_TRUE(hybrid_test->Plan(-10.0, 2.0, 0.0, 15.0, 0.0, 0.0, XYbounds_,
+                                obstacles_list, &replan_result));
+  HybridAStartResult expected_result;
+  HybridAStar hybrid_a_star(planner_open_space_config_);
+  ASSERT_TRUE(hybrid_a_star.Plan(-10.0, 2.0, 0.0, 15.0, 0.0, 0.0, XYbounds_,
+                                 obstacles_list, &expected_result));
+  EXPECT_EQ(expected_result.x, replan_result.x);
+  EXPECT_EQ(expected_result.y, replan_result.y);
+  EXPECT_EQ(expected_result.phi, replan_result.phi);
+}
 }  // namespace planning
 }  // namespace apollo
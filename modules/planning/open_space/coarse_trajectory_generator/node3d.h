@@ -20,8 +20,8 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <string>
 #include <vector>
 
 #include "modules/common/math/box2d.h"
@@ -43,6 +43,14 @@ class Node3d {
          const std::vector<double>& XYbounds,
          const PlannerOpenSpaceConfig& open_space_conf);
   virtual ~Node3d() = default;
+  // Sets the node to the end of the traversed states as the constructor
+  // does, and clears its costs and links. The memory of the traversed states
+  // is kept, so that a node of a pool is reused without allocations.
+  void Reset(const std::vector<double>& traversed_x,
+             const std::vector<double>& traversed_y,
+             const std::vector<double>& traversed_phi,
+             const std::vector<double>& XYbounds,
+             const PlannerOpenSpaceConfig& open_space_conf);
   static apollo::common::math::Box2d GetBoundingBox(
       const common::VehicleParam& vehicle_param_, const double x,
       const double y, const double phi);
@@ -56,7 +64,7 @@ class Node3d {
   double GetY() const { return y_; }
   double GetPhi() const { return phi_; }
   bool operator==(const Node3d& right) const;
-  const std::string& GetIndex() const { return index_; }
+  uint64_t GetIndex() const { return index_; }
   size_t GetStepSize() const { return step_size_; }
   bool GetDirec() const { return direction_; }
   double GetSteer() const { return steering_; }
@@ -71,7 +79,9 @@ class Node3d {
   void SetSteer(double steering) { steering_ = steering; }
 
  private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid, int phi_grid);
+  // Packs the grid indices, which are within the XY bounds for the nodes of
+  // a search, in 21 bits each.
+  static uint64_t ComputeIndex(int x_grid, int y_grid, int phi_grid);
 
  private:
   double x_ = 0.0;
@@ -84,7 +94,7 @@ class Node3d {
   int x_grid_ = 0;
   int y_grid_ = 0;
   int phi_grid_ = 0;
-  std::string index_;
+  uint64_t index_ = 0;
   double traj_cost_ = 0.0;
   double heuristic_cost_ = 0.0;
   double cost_ = 0.0;
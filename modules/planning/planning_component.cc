@@ -40,6 +40,8 @@ using apollo::storytelling::Stories;
 
 bool PlanningComponent::Init() {
   injector_ = std::make_shared<DependencyInjector>();
+  // The base map follows the localization in Proc().
+  HDMapUtil::EnableTiledBaseMap();
 
   if (FLAGS_use_navigation_mode) {
     planning_base_ = std::make_unique<NaviPlanning>(injector_);
@@ -130,6 +132,10 @@ bool PlanningComponent::Proc(
   local_view_.prediction_obstacles = prediction_obstacles;
   local_view_.chassis = chassis;
   local_view_.localization_estimate = localization_estimate;
+  if (localization_estimate != nullptr) {
+    HDMapUtil::UpdateBaseMapEgoPose(localization_estimate->pose().position(),
+                                    localization_estimate->pose().heading());
+  }
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!local_view_.routing ||
@@ -24,14 +24,15 @@
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/math/discrete_points_math.h"
 #include "modules/planning/math/discretized_points_smoothing/cos_theta_smoother.h"
-#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_smoother.h"
 
 namespace apollo {
 namespace planning {
 
 DiscretePointsReferenceLineSmoother::DiscretePointsReferenceLineSmoother(
     const ReferenceLineSmootherConfig& config)
-    : ReferenceLineSmoother(config) {}
+    : ReferenceLineSmoother(config),
+      fem_pos_smoother_(
+          config.discrete_points().fem_pos_deviation_smoothing()) {}
 
 bool DiscretePointsReferenceLineSmoother::Smooth(
     const ReferenceLine& raw_reference_line,
@@ -136,11 +137,6 @@ bool DiscretePointsReferenceLineSmoother::FemPosSmooth(
     const std::vector<std::pair<double, double>>& raw_point2d,
     const std::vector<double>& bounds,
     std::vector<std::pair<double, double>>* ptr_smoothed_point2d) {
-  const auto& fem_pos_config =
-      config_.discrete_points().fem_pos_deviation_smoothing();
-
-  FemPosDeviationSmoother smoother(fem_pos_config);
-
   // box contraints on pos are used in fem pos smoother, thus shrink the
   // bounds by 1.0 / sqrt(2.0)
   std::vector<double> box_bounds = bounds;
@@ -151,7 +147,8 @@ bool DiscretePointsReferenceLineSmoother::FemPosSmooth(
 
   std::vector<double> opt_x;
   std::vector<double> opt_y;
-  bool status = smoother.Solve(raw_point2d, box_bounds, &opt_x, &opt_y);
+  bool status =
+      fem_pos_smoother_.Solve(raw_point2d, box_bounds, &opt_x, &opt_y);
 
   if (!status) {
     AERROR << "Fem Pos reference line smoothing failed";
@@ -404,6 +404,22 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
+                           SLPoint* const sl_point,
+                           int* const hint_index) const {
+  double s = 0.0;
+  double l = 0.0;
+  double distance = 0.0;
+  if (!map_path_.GetProjectionWithHint(xy_point, hint_index, &s, &l,
+                                       &distance)) {
+    AERROR << "Cannot get nearest point from path.";
+    return false;
+  }
+  sl_point->set_s(s);
+  sl_point->set_l(l);
+  return true;
+}
+
 ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
     const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
     const double s1, const InterpolatedIndex& index) const {
@@ -671,9 +687,10 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
 
   // The order must be counter-clockwise
   std::vector<SLPoint> sl_corners;
+  int hint_index = 0;
   for (const auto& point : corners) {
     SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
+    if (!XYToSL(point, &sl_point, &hint_index)) {
       AERROR << "Failed to get projection for point: " << point.DebugString()
              << " on reference line.";
       return false;
@@ -689,7 +706,7 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
 
     const auto p_mid = (p0 + p1) * 0.5;
     SLPoint sl_point_mid;
-    if (!XYToSL(p_mid, &sl_point_mid)) {
+    if (!XYToSL(p_mid, &sl_point_mid, &hint_index)) {
       AERROR << "Failed to get projection for point: " << p_mid.DebugString()
              << " on reference line.";
       return false;
@@ -734,9 +751,10 @@ bool ReferenceLine::GetSLBoundary(const hdmap::Polygon& polygon,
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
+  int hint_index = 0;
   for (const auto& point : polygon.point()) {
     SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
+    if (!XYToSL({point.x(), point.y()}, &sl_point, &hint_index)) {
       AERROR << "Failed to get projection for point: " << point.DebugString()
              << " on reference line.";
       return false;
@@ -118,6 +118,14 @@ class ReferenceLine {
   bool XYToSL(const XYPoint& xy, common::SLPoint* const sl_point) const {
     return XYToSL(common::math::Vec2d(xy.x(), xy.y()), sl_point);
   }
+  /**
+   * @brief Same as XYToSL(), searched from the segment of the reference line
+   * at hint_index, which is set to the segment of the projection. Points
+   * near each other, such as the corners of an obstacle, are faster to
+   * project with the same hint.
+   */
+  bool XYToSL(const common::math::Vec2d& xy_point,
+              common::SLPoint* const sl_point, int* const hint_index) const;
 
   bool GetLaneWidth(const double s, double* const lane_left_width,
                     double* const lane_right_width) const;
@@ -91,6 +91,9 @@ ReferenceLineProvider::ReferenceLineProvider(
 bool ReferenceLineProvider::UpdateRoutingResponse(
     const routing::RoutingResponse &routing) {
   std::lock_guard<std::mutex> routing_lock(routing_mutex_);
+  if (!common::util::IsProtoEqual(routing_, routing)) {
+    ClearSmoothedReferenceLineCache();
+  }
   routing_ = routing;
   has_routing_ = true;
   return true;
@@ -144,6 +147,9 @@ void ReferenceLineProvider::UpdateReferenceLine(
            << ") are different";
     return;
   }
+  if (FLAGS_enable_reference_line_stitching) {
+    UpdateSmoothedReferenceLineCache(reference_lines, route_segments);
+  }
   std::lock_guard<std::mutex> lock(reference_lines_mutex_);
   if (reference_lines_.size() != reference_lines.size()) {
     reference_lines_ = reference_lines;
@@ -187,6 +193,37 @@ void ReferenceLineProvider::UpdateReferenceLine(
   }
 }
 
+void ReferenceLineProvider::UpdateSmoothedReferenceLineCache(
+    const std::list<ReferenceLine> &reference_lines,
+    const std::list<hdmap::RouteSegments> &route_segments) {
+  auto segment_iter = route_segments.begin();
+  for (auto iter = reference_lines.begin(); iter != reference_lines.end();
+       ++iter, ++segment_iter) {
+    if (iter->reference_points().empty()) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(smoothed_reference_line_cache_mutex_);
+    smoothed_reference_line_cache_.remove_if(
+        [&segment_iter](const SmoothedReferenceLine &cached) {
+          return cached.segments.IsConnectedSegment(*segment_iter);
+        });
+    // Assigned, since the copy constructor of ReferenceLine is explicit.
+    smoothed_reference_line_cache_.emplace_front();
+    smoothed_reference_line_cache_.front().segments = *segment_iter;
+    smoothed_reference_line_cache_.front().reference_line = *iter;
+    while (smoothed_reference_line_cache_.size() >
+           static_cast<size_t>(
+               std::max(0, FLAGS_reference_line_smoothing_cache_size))) {
+      smoothed_reference_line_cache_.pop_back();
+    }
+  }
+}
+
+void ReferenceLineProvider::ClearSmoothedReferenceLineCache() {
+  std::lock_guard<std::mutex> lock(smoothed_reference_line_cache_mutex_);
+  smoothed_reference_line_cache_.clear();
+}
+
 void ReferenceLineProvider::GenerateThread() {
   while (!is_stop_) {
     static constexpr int32_t kSleepTime = 50;  // milliseconds
@@ -569,6 +606,9 @@ bool ReferenceLineProvider::CreateReferenceLine(
     std::lock_guard<std::mutex> lock(pnc_map_mutex_);
     if (pnc_map_->IsNewRouting(routing)) {
       is_new_routing = true;
+      // Lines of the last routing smoothed after UpdateRoutingResponse()
+      // cleared the cache are dropped here.
+      ClearSmoothedReferenceLineCache();
       if (!pnc_map_->UpdateRoutingResponse(routing)) {
         AERROR << "Failed to update routing in pnc map";
         return false;
@@ -617,8 +657,6 @@ bool ReferenceLineProvider::CreateReferenceLine(
 bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
                                                 RouteSegments *segments,
                                                 ReferenceLine *reference_line) {
-  RouteSegments segment_properties;
-  segment_properties.SetProperties(*segments);
   auto prev_segment = route_segments_.begin();
   auto prev_ref = reference_lines_.begin();
   while (prev_segment != route_segments_.end()) {
@@ -628,29 +666,72 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     ++prev_segment;
     ++prev_ref;
   }
-  if (prev_segment == route_segments_.end()) {
-    if (!route_segments_.empty() && segments->IsOnSegment()) {
-      AWARN << "Current route segment is not connected with previous route "
-               "segment";
+  if (prev_segment != route_segments_.end()) {
+    return ExtendReferenceLine(state, *prev_segment, *prev_ref, segments,
+                               reference_line);
+  }
+  SmoothedReferenceLine cached;
+  bool is_cached = false;
+  {
+    std::lock_guard<std::mutex> lock(smoothed_reference_line_cache_mutex_);
+    for (const auto &smoothed : smoothed_reference_line_cache_) {
+      if (smoothed.segments.IsConnectedSegment(*segments)) {
+        cached = smoothed;
+        is_cached = true;
+        break;
+      }
     }
-    return SmoothRouteSegment(*segments, reference_line);
   }
+  if (is_cached) {
+    // It is a hit unless the extension falls back to a full smoothing.
+    const uint64_t num_full_smoothings = smoothing_cache_misses_;
+    const double start_time = Clock::NowInSeconds();
+    const bool extended = ExtendReferenceLine(
+        state, cached.segments, cached.reference_line, segments,
+        reference_line);
+    if (smoothing_cache_misses_ == num_full_smoothings) {
+      ++smoothing_cache_hits_;
+      const double time_ms = (Clock::NowInSeconds() - start_time) * 1000.0;
+      smoothing_time_saved_ms_ =
+          smoothing_time_saved_ms_ +
+          std::max(0.0, mean_full_smoothing_time_ms_ - time_ms);
+      ADEBUG << "Extended reference line from the cache in " << time_ms
+             << " ms, " << smoothing_cache_hits_ << " hits, "
+             << smoothing_cache_misses_ << " misses, "
+             << smoothing_time_saved_ms_ << " ms saved";
+      LogSmoothingCacheStats();
+    }
+    return extended;
+  }
+  if (!route_segments_.empty() && segments->IsOnSegment()) {
+    AWARN << "Current route segment is not connected with previous route "
+             "segment";
+  }
+  return SmoothRouteSegment(*segments, reference_line);
+}
+
+bool ReferenceLineProvider::ExtendReferenceLine(
+    const VehicleState &state, const RouteSegments &prev_segments,
+    const ReferenceLine &prev_ref, RouteSegments *segments,
+    ReferenceLine *reference_line) {
+  RouteSegments segment_properties;
+  segment_properties.SetProperties(*segments);
   common::SLPoint sl_point;
   Vec2d vec2d(state.x(), state.y());
   LaneWaypoint waypoint;
-  if (!prev_segment->GetProjection(vec2d, &sl_point, &waypoint)) {
+  if (!prev_segments.GetProjection(vec2d, &sl_point, &waypoint)) {
     AWARN << "Vehicle current point: " << vec2d.DebugString()
           << " not on previous reference line";
     return SmoothRouteSegment(*segments, reference_line);
   }
-  const double prev_segment_length = RouteSegments::Length(*prev_segment);
+  const double prev_segment_length = RouteSegments::Length(prev_segments);
   const double remain_s = prev_segment_length - sl_point.s();
   const double look_forward_required_distance =
       PncMap::LookForwardDistance(state.linear_velocity());
   if (remain_s > look_forward_required_distance) {
-    *segments = *prev_segment;
+    *segments = prev_segments;
     segments->SetProperties(segment_properties);
-    *reference_line = *prev_ref;
+    *reference_line = prev_ref;
     ADEBUG << "Reference line remain " << remain_s
            << ", which is more than required " << look_forward_required_distance
            << " and no need to extend";
@@ -663,31 +744,31 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
       prev_segment_length + FLAGS_look_forward_extend_distance;
   RouteSegments shifted_segments;
   std::unique_lock<std::mutex> lock(pnc_map_mutex_);
-  if (!pnc_map_->ExtendSegments(*prev_segment, future_start_s, future_end_s,
+  if (!pnc_map_->ExtendSegments(prev_segments, future_start_s, future_end_s,
                                 &shifted_segments)) {
     lock.unlock();
     AERROR << "Failed to shift route segments forward";
     return SmoothRouteSegment(*segments, reference_line);
   }
   lock.unlock();
-  if (prev_segment->IsWaypointOnSegment(shifted_segments.LastWaypoint())) {
-    *segments = *prev_segment;
+  if (prev_segments.IsWaypointOnSegment(shifted_segments.LastWaypoint())) {
+    *segments = prev_segments;
     segments->SetProperties(segment_properties);
-    *reference_line = *prev_ref;
+    *reference_line = prev_ref;
     ADEBUG << "Could not further extend reference line";
     return true;
   }
   hdmap::Path path(shifted_segments);
   ReferenceLine new_ref(path);
-  if (!SmoothPrefixedReferenceLine(*prev_ref, new_ref, reference_line)) {
+  if (!SmoothPrefixedReferenceLine(prev_ref, new_ref, reference_line)) {
     AWARN << "Failed to smooth forward shifted reference line";
     return SmoothRouteSegment(*segments, reference_line);
   }
-  if (!reference_line->Stitch(*prev_ref)) {
+  if (!reference_line->Stitch(prev_ref)) {
     AWARN << "Failed to stitch reference line";
     return SmoothRouteSegment(*segments, reference_line);
   }
-  if (!shifted_segments.Stitch(*prev_segment)) {
+  if (!shifted_segments.Stitch(prev_segments)) {
     AWARN << "Failed to stitch route segments";
     return SmoothRouteSegment(*segments, reference_line);
   }
@@ -870,8 +951,24 @@ void ReferenceLineProvider::GetAnchorPoints(
 
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
+  const double start_time = Clock::NowInSeconds();
   hdmap::Path path(segments);
-  return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  const bool smoothed =
+      SmoothReferenceLine(ReferenceLine(path), reference_line);
+  const double time_ms = (Clock::NowInSeconds() - start_time) * 1000.0;
+  ++smoothing_cache_misses_;
+  mean_full_smoothing_time_ms_ +=
+      (time_ms - mean_full_smoothing_time_ms_) /
+      static_cast<double>(smoothing_cache_misses_);
+  LogSmoothingCacheStats();
+  return smoothed;
+}
+
+void ReferenceLineProvider::LogSmoothingCacheStats() const {
+  AINFO_EVERY(100) << "Smoothed reference line cache: "
+                   << smoothing_cache_hits_ << " hits, "
+                   << smoothing_cache_misses_ << " misses, "
+                   << smoothing_time_saved_ms_ << " ms saved";
 }
 
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
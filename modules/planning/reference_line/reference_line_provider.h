@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <queue>
@@ -30,6 +32,7 @@
 #include <vector>
 
 #include "cyber/cyber.h"
+#include "gtest/gtest_prod.h"
 #include "modules/common/util/factory.h"
 #include "modules/common/util/util.h"
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
@@ -86,7 +89,27 @@ class ReferenceLineProvider {
 
   bool UpdatedReferenceLine() { return is_reference_line_updated_.load(); }
 
+  /**
+   * @brief The route segments extended from a cached smoothed reference line
+   * rather than smoothed in full, since they were not connected to the last
+   * reference lines.
+   */
+  uint64_t smoothing_cache_hits() const { return smoothing_cache_hits_; }
+
+  /**
+   * @brief The route segments smoothed in full.
+   */
+  uint64_t smoothing_cache_misses() const { return smoothing_cache_misses_; }
+
+  /**
+   * @brief The milliseconds saved by the cache hits, estimated from the mean
+   * time of the full smoothings.
+   */
+  double smoothing_time_saved_ms() const { return smoothing_time_saved_ms_; }
+
  private:
+  FRIEND_TEST(ReferenceLineProviderTest, SmoothedReferenceLineCache);
+
   /**
    * @brief Use PncMap to create reference line and the corresponding segments
    * based on routing and current position. This is a thread safe function.
@@ -127,6 +150,9 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  // Logs the smoothed reference line cache counters every so many smoothings.
+  void LogSmoothingCacheStats() const;
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -135,6 +161,30 @@ class ReferenceLineProvider {
                            hdmap::RouteSegments* segments,
                            ReferenceLine* reference_line);
 
+  /**
+   * @brief Extends the reference line of the previous segments connected to
+   * the given segments, smoothing only the new part.
+   */
+  bool ExtendReferenceLine(const common::VehicleState& state,
+                           const hdmap::RouteSegments& prev_segments,
+                           const ReferenceLine& prev_ref,
+                           hdmap::RouteSegments* segments,
+                           ReferenceLine* reference_line);
+
+  /**
+   * @brief Keeps the reference lines, replacing the cached ones they are
+   * connected to.
+   */
+  void UpdateSmoothedReferenceLineCache(
+      const std::list<ReferenceLine>& reference_lines,
+      const std::list<hdmap::RouteSegments>& route_segments);
+
+  /**
+   * @brief Drops the cached reference lines, which belong to the last
+   * routing.
+   */
+  void ClearSmoothedReferenceLineCache();
+
   AnchorPoint GetAnchorPoint(const ReferenceLine& reference_line,
                              double s) const;
 
@@ -182,6 +232,22 @@ class ReferenceLineProvider {
   std::queue<std::list<ReferenceLine>> reference_line_history_;
   std::queue<std::list<hdmap::RouteSegments>> route_segments_history_;
 
+  // The last smoothed reference lines, most recent first, with their route
+  // segments, which are the lanes and ranges they cover. Route segments which
+  // are not connected to the last reference lines, as after changing lanes
+  // back, are extended from one of these when they are connected to it.
+  // It is cleared when the routing changes.
+  struct SmoothedReferenceLine {
+    hdmap::RouteSegments segments;
+    ReferenceLine reference_line;
+  };
+  std::mutex smoothed_reference_line_cache_mutex_;
+  std::list<SmoothedReferenceLine> smoothed_reference_line_cache_;
+  std::atomic<uint64_t> smoothing_cache_hits_{0};
+  std::atomic<uint64_t> smoothing_cache_misses_{0};
+  std::atomic<double> smoothing_time_saved_ms_{0.0};
+  double mean_full_smoothing_time_ms_ = 0.0;
+
   std::future<void> task_future_;
 
   std::atomic<bool> is_reference_line_updated_{true};
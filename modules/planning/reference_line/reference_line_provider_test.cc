@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/reference_line/reference_line_provider.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/pnc_map/path.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+class ReferenceLineProviderTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    FLAGS_look_forward_short_distance = 50.0;
+    FLAGS_smoother_config_filename =
+        "/apollo/modules/planning/conf/discrete_points_smoother_config.pb.txt";
+    ASSERT_EQ(0, hdmap_.LoadMapFromFile(map_file));
+    lane_ = hdmap_.GetLaneById(hdmap::MakeMapId("1_-1"));
+    ASSERT_NE(nullptr, lane_);
+    provider_.reset(new ReferenceLineProvider(nullptr, &hdmap_));
+  }
+
+ protected:
+  hdmap::RouteSegments Segments(double start_s, double end_s) const {
+    hdmap::RouteSegments segments;
+    segments.emplace_back(lane_, start_s, end_s);
+    return segments;
+  }
+
+  common::VehicleState StateAt(double s) const {
+    const auto point = lane_->GetSmoothPoint(s);
+    common::VehicleState state;
+    state.set_x(point.x());
+    state.set_y(point.y());
+    state.set_heading(lane_->Heading(s));
+    state.set_linear_velocity(0.0);
+    return state;
+  }
+
+  const std::string map_file =
+      "/apollo/modules/planning/testdata/garage_map/base_map.txt";
+
+  hdmap::HDMap hdmap_;
+  hdmap::LaneInfoConstPtr lane_;
+  std::unique_ptr<ReferenceLineProvider> provider_;
+};
+
+TEST_F(ReferenceLineProviderTest, SmoothedReferenceLineCache) {
+  // Built in place, since the copy constructor of ReferenceLine is explicit.
+  std::list<ReferenceLine> cached_lines(1);
+  std::list<hdmap::RouteSegments> cached_segments(1, Segments(0.0, 100.0));
+  cached_lines.front() = ReferenceLine(hdmap::Path(cached_segments.front()));
+  const double cached_length = cached_lines.front().Length();
+  provider_->UpdateSmoothedReferenceLineCache(cached_lines, cached_segments);
+
+  // Route segments connected to the cached ones, with more than the look
+  // forward distance left, take the cached reference line as it is.
+  hdmap::RouteSegments segments = Segments(5.0, 100.0);
+  ReferenceLine reference_line;
+  EXPECT_TRUE(provider_->ExtendReferenceLine(StateAt(10.0), &segments,
+                                             &reference_line));
+  EXPECT_EQ(1U, provider_->smoothing_cache_hits());
+  EXPECT_EQ(0U, provider_->smoothing_cache_misses());
+  EXPECT_DOUBLE_EQ(cached_length, reference_line.Length());
+
+  // Route segments not connected to any cached ones are smoothed in full.
+  segments = Segments(120.0, 150.0);
+  provider_->ExtendReferenceLine(StateAt(125.0), &segments, &reference_line);
+  EXPECT_EQ(1U, provider_->smoothing_cache_hits());
+  EXPECT_EQ(1U, provider_->smoothing_cache_misses());
+
+  // A new routing drops the reference lines of the last one.
+  routing::RoutingResponse routing;
+  routing.mutable_header()->set_sequence_num(1);
+  EXPECT_TRUE(provider_->UpdateRoutingResponse(routing));
+  segments = Segments(5.0, 100.0);
+  provider_->ExtendReferenceLine(StateAt(10.0), &segments, &reference_line);
+  EXPECT_EQ(1U, provider_->smoothing_cache_hits());
+  EXPECT_EQ(2U, provider_->smoothing_cache_misses());
+
+  // The same routing again keeps them.
+  provider_->UpdateSmoothedReferenceLineCache(cached_lines, cached_segments);
+  EXPECT_TRUE(provider_->UpdateRoutingResponse(routing));
+  segments = Segments(5.0, 100.0);
+  provider_->ExtendReferenceLine(StateAt(10.0), &segments, &reference_line);
+  EXPECT_EQ(2U, provider_->smoothing_cache_hits());
+  EXPECT_EQ(2U, provider_->smoothing_cache_misses());
+}
+
+}  // namespace planning
+}  // namespace apollo
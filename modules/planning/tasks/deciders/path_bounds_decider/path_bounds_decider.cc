@@ -24,6 +24,7 @@
 
 #include "absl/strings/str_cat.h"
 
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -72,10 +73,31 @@ Status PathBoundsDecider::Process(
   // Initialization.
   InitPathBoundsDecider(*frame, *reference_line_info);
 
-  // Generate the fallback path boundary.
+  auto* pull_over_status = injector_->planning_context()
+                               ->mutable_planning_status()
+                               ->mutable_pull_over();
+  const bool plan_pull_over_path = pull_over_status->plan_pull_over_path();
+  const bool plan_lane_change_path = FLAGS_enable_smarter_lane_change &&
+                                     reference_line_info->IsChangeLanePath();
+
+  // Generate the fallback path boundary. Unless a pull-over or lane-change
+  // path boundary may take their place, the regular path boundaries are
+  // generated along with it: none of them writes the planning context.
   PathBound fallback_path_bound;
-  Status ret =
-      GenerateFallbackPathBound(*reference_line_info, &fallback_path_bound);
+  std::vector<RegularPathBound> regular_path_bounds;
+  Status ret;
+  if (FLAGS_enable_multi_thread_in_path_planning && !plan_pull_over_path &&
+      !plan_lane_change_path) {
+    regular_path_bounds = InitRegularPathBounds(*reference_line_info);
+    auto results =
+        GenerateRegularPathBounds(*reference_line_info, &regular_path_bounds);
+    ret = GenerateFallbackPathBound(*reference_line_info, &fallback_path_bound);
+    for (auto& result : results) {
+      result.get();
+    }
+  } else {
+    ret = GenerateFallbackPathBound(*reference_line_info, &fallback_path_bound);
+  }
   if (!ret.ok()) {
     ADEBUG << "Cannot generate a fallback path bound.";
     return Status(ErrorCode::PLANNING_ERROR, ret.error_message());
@@ -101,10 +123,6 @@ Status PathBoundsDecider::Process(
   candidate_path_boundaries.back().set_label("fallback");
 
   // If pull-over is requested, generate pull-over path boundary.
-  auto* pull_over_status = injector_->planning_context()
-                               ->mutable_planning_status()
-                               ->mutable_pull_over();
-  const bool plan_pull_over_path = pull_over_status->plan_pull_over_path();
   if (plan_pull_over_path) {
     PathBound pull_over_path_bound;
     Status ret = GeneratePullOverPathBound(*frame, *reference_line_info,
@@ -149,8 +167,7 @@ Status PathBoundsDecider::Process(
   }
 
   // If it's a lane-change reference-line, generate lane-change path boundary.
-  if (FLAGS_enable_smarter_lane_change &&
-      reference_line_info->IsChangeLanePath()) {
+  if (plan_lane_change_path) {
     PathBound lanechange_path_bound;
     Status ret = GenerateLaneChangePathBound(*reference_line_info,
                                              &lanechange_path_bound);
@@ -189,33 +206,21 @@ Status PathBoundsDecider::Process(
   }
 
   // Generate regular path boundaries.
-  std::vector<LaneBorrowInfo> lane_borrow_info_list;
-  lane_borrow_info_list.push_back(LaneBorrowInfo::NO_BORROW);
-
-  if (reference_line_info->is_path_lane_borrow()) {
-    const auto& path_decider_status =
-        injector_->planning_context()->planning_status().path_decider();
-    for (const auto& lane_borrow_direction :
-         path_decider_status.decided_side_pass_direction()) {
-      if (lane_borrow_direction == PathDeciderStatus::LEFT_BORROW) {
-        lane_borrow_info_list.push_back(LaneBorrowInfo::LEFT_BORROW);
-      } else if (lane_borrow_direction == PathDeciderStatus::RIGHT_BORROW) {
-        lane_borrow_info_list.push_back(LaneBorrowInfo::RIGHT_BORROW);
-      }
+  if (regular_path_bounds.empty()) {
+    regular_path_bounds = InitRegularPathBounds(*reference_line_info);
+    auto results =
+        GenerateRegularPathBounds(*reference_line_info, &regular_path_bounds);
+    for (auto& result : results) {
+      result.get();
     }
   }
 
   // Try every possible lane-borrow option:
   // PathBound regular_self_path_bound;
   // bool exist_self_path_bound = false;
-  for (const auto& lane_borrow_info : lane_borrow_info_list) {
-    PathBound regular_path_bound;
-    std::string blocking_obstacle_id = "";
-    std::string borrow_lane_type = "";
-    Status ret = GenerateRegularPathBound(
-        *reference_line_info, lane_borrow_info, &regular_path_bound,
-        &blocking_obstacle_id, &borrow_lane_type);
-    if (!ret.ok()) {
+  for (const auto& regular : regular_path_bounds) {
+    const PathBound& regular_path_bound = regular.path_bound;
+    if (!regular.status.ok()) {
       continue;
     }
     if (regular_path_bound.empty()) {
@@ -238,7 +243,7 @@ Status PathBoundsDecider::Process(
                                            kPathBoundsDeciderResolution,
                                            regular_path_bound_pair);
     std::string path_label = "";
-    switch (lane_borrow_info) {
+    switch (regular.lane_borrow_info) {
       case LaneBorrowInfo::LEFT_BORROW:
         path_label = "left";
         break;
@@ -253,9 +258,9 @@ Status PathBoundsDecider::Process(
     }
     // RecordDebugInfo(regular_path_bound, "", reference_line_info);
     candidate_path_boundaries.back().set_label(
-        absl::StrCat("regular/", path_label, "/", borrow_lane_type));
+        absl::StrCat("regular/", path_label, "/", regular.borrow_lane_type));
     candidate_path_boundaries.back().set_blocking_obstacle_id(
-        blocking_obstacle_id);
+        regular.blocking_obstacle_id);
   }
 
   // Remove redundant boundaries.
@@ -318,6 +323,51 @@ common::TrajectoryPoint PathBoundsDecider::InferFrontAxeCenterFromRearAxeCenter(
   return ret;
 }
 
+std::vector<PathBoundsDecider::RegularPathBound>
+PathBoundsDecider::InitRegularPathBounds(
+    const ReferenceLineInfo& reference_line_info) {
+  std::vector<RegularPathBound> regular_path_bounds(1);
+  regular_path_bounds.back().lane_borrow_info = LaneBorrowInfo::NO_BORROW;
+
+  if (reference_line_info.is_path_lane_borrow()) {
+    const auto& path_decider_status =
+        injector_->planning_context()->planning_status().path_decider();
+    for (const auto& lane_borrow_direction :
+         path_decider_status.decided_side_pass_direction()) {
+      if (lane_borrow_direction == PathDeciderStatus::LEFT_BORROW) {
+        regular_path_bounds.emplace_back();
+        regular_path_bounds.back().lane_borrow_info =
+            LaneBorrowInfo::LEFT_BORROW;
+      } else if (lane_borrow_direction == PathDeciderStatus::RIGHT_BORROW) {
+        regular_path_bounds.emplace_back();
+        regular_path_bounds.back().lane_borrow_info =
+            LaneBorrowInfo::RIGHT_BORROW;
+      }
+    }
+  }
+  return regular_path_bounds;
+}
+
+std::vector<std::future<void>> PathBoundsDecider::GenerateRegularPathBounds(
+    const ReferenceLineInfo& reference_line_info,
+    std::vector<RegularPathBound>* const regular_path_bounds) {
+  std::vector<std::future<void>> results;
+  for (auto& regular : *regular_path_bounds) {
+    // Each option writes its own element only.
+    auto generate = [this, &reference_line_info, &regular]() {
+      regular.status = GenerateRegularPathBound(
+          reference_line_info, regular.lane_borrow_info, &regular.path_bound,
+          &regular.blocking_obstacle_id, &regular.borrow_lane_type);
+    };
+    if (FLAGS_enable_multi_thread_in_path_planning) {
+      results.push_back(cyber::Async(generate));
+    } else {
+      generate();
+    }
+  }
+  return results;
+}
+
 Status PathBoundsDecider::GenerateRegularPathBound(
     const ReferenceLineInfo& reference_line_info,
     const LaneBorrowInfo& lane_borrow_info, PathBound* const path_bound,
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -75,6 +76,34 @@ class PathBoundsDecider : public Decider {
   common::TrajectoryPoint InferFrontAxeCenterFromRearAxeCenter(
       const common::TrajectoryPoint& traj_point);
 
+  /** @brief A regular path boundary being generated for a lane-borrow
+   *   option.
+   */
+  struct RegularPathBound {
+    LaneBorrowInfo lane_borrow_info = LaneBorrowInfo::NO_BORROW;
+    std::vector<std::tuple<double, double, double>> path_bound;
+    std::string blocking_obstacle_id;
+    std::string borrow_lane_type;
+    common::Status status;
+  };
+
+  /** @brief The lane-borrow options to generate regular path boundaries for,
+   *   no borrowing first and then the decided side-pass directions.
+   */
+  std::vector<RegularPathBound> InitRegularPathBounds(
+      const ReferenceLineInfo& reference_line_info);
+
+  /** @brief Generates the regular path boundaries of all lane-borrow
+   *   options, on the task pool if multi-threading is enabled.
+   * @param reference_line_info
+   * @param The regular path boundaries, in the order of the options.
+   * @return The futures to wait for before the path boundaries are read,
+   *   none if they are generated already.
+   */
+  std::vector<std::future<void>> GenerateRegularPathBounds(
+      const ReferenceLineInfo& reference_line_info,
+      std::vector<RegularPathBound>* const regular_path_bounds);
+
   /** @brief The regular path boundary generation considers the ADC itself
    *   and other static environments:
    *   - ADC's position (lane-changing considerations)
@@ -48,6 +48,11 @@ using apollo::common::Status;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 
+namespace {
+// The number of points the path is sub-sampled to for moving obstacles.
+constexpr size_t kDefaultNumPoint = 50;
+}  // namespace
+
 STBoundaryMapper::STBoundaryMapper(
     const SpeedBoundsDeciderConfig& config, const ReferenceLine& reference_line,
     const PathData& path_data, const double planning_distance,
@@ -72,6 +77,9 @@ Status STBoundaryMapper::ComputeSTBoundary(PathDecision* path_decision) const {
                   "Fail to get params because of too few path points");
   }
 
+  const PathOverlapIndex path_index =
+      BuildPathOverlapIndex(path_data_.discretized_path());
+
   // Go through every obstacle.
   Obstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
@@ -82,7 +90,7 @@ Status STBoundaryMapper::ComputeSTBoundary(PathDecision* path_decision) const {
 
     // If no longitudinal decision has been made, then plot it onto ST-graph.
     if (!ptr_obstacle->HasLongitudinalDecision()) {
-      ComputeSTBoundary(ptr_obstacle);
+      ComputeSTBoundary(path_index, ptr_obstacle);
       continue;
     }
 
@@ -104,7 +112,7 @@ Status STBoundaryMapper::ComputeSTBoundary(PathDecision* path_decision) const {
                decision.has_yield()) {
       // 2. Depending on the longitudinal overtake/yield decision,
       //    fine-tune the upper/lower st-boundary of related obstacles.
-      ComputeSTBoundaryWithDecision(ptr_obstacle, decision);
+      ComputeSTBoundaryWithDecision(path_index, ptr_obstacle, decision);
     } else if (!decision.has_ignore()) {
       // 3. Ignore those unrelated obstacles.
       AWARN << "No mapping for decision: " << decision.DebugString();
@@ -161,15 +169,16 @@ bool STBoundaryMapper::MapStopDecision(
   return true;
 }
 
-void STBoundaryMapper::ComputeSTBoundary(Obstacle* obstacle) const {
+void STBoundaryMapper::ComputeSTBoundary(const PathOverlapIndex& path_index,
+                                         Obstacle* obstacle) const {
   if (FLAGS_use_st_drivable_boundary) {
     return;
   }
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(path_index, *obstacle, &upper_points,
+                                &lower_points)) {
     return;
   }
 
@@ -188,27 +197,117 @@ void STBoundaryMapper::ComputeSTBoundary(Obstacle* obstacle) const {
   obstacle->set_path_st_boundary(boundary);
 }
 
-bool STBoundaryMapper::GetOverlapBoundaryPoints(
-    const std::vector<PathPoint>& path_points, const Obstacle& obstacle,
-    std::vector<STPoint>* upper_points,
-    std::vector<STPoint>* lower_points) const {
-  // Sanity checks.
-  DCHECK(upper_points->empty());
-  DCHECK(lower_points->empty());
+STBoundaryMapper::PathOverlapIndex STBoundaryMapper::BuildPathOverlapIndex(
+    const std::vector<PathPoint>& path_points) const {
+  PathOverlapIndex path_index;
   if (path_points.empty()) {
-    AERROR << "No points in path_data_.discretized_path().";
-    return false;
+    return path_index;
   }
 
   const auto* planning_status = injector_->planning_context()
                                     ->mutable_planning_status()
                                     ->mutable_change_lane();
-
-  double l_buffer =
+  path_index.l_buffer =
       planning_status->status() == ChangeLaneStatus::IN_CHANGE_LANE
           ? FLAGS_lane_change_obstacle_nudge_l_buffer
           : FLAGS_nonstatic_obstacle_nudge_l_buffer;
 
+  for (const auto& path_point : path_points) {
+    if (path_point.s() > planning_max_distance_) {
+      break;
+    }
+    AddPathBox(path_point, path_point.s(), path_index.l_buffer,
+               &path_index.path_point_boxes);
+  }
+
+  // Subsample to reduce computation time.
+  if (path_points.size() > 2 * kDefaultNumPoint) {
+    const auto ratio = path_points.size() / kDefaultNumPoint;
+    std::vector<PathPoint> sampled_path_points;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      if (i % ratio == 0) {
+        sampled_path_points.push_back(path_points[i]);
+      }
+    }
+    path_index.sampled_path = DiscretizedPath(std::move(sampled_path_points));
+  } else {
+    path_index.sampled_path = DiscretizedPath(path_points);
+  }
+  const auto& sampled_path = path_index.sampled_path;
+  const double step_length = vehicle_param_.front_edge_to_center();
+  const double path_len =
+      std::min(FLAGS_max_trajectory_len, sampled_path.Length());
+  for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
+    AddPathBox(sampled_path.Evaluate(path_s + sampled_path.front().s()),
+               path_s, path_index.l_buffer, &path_index.sampled_path_boxes);
+  }
+  return path_index;
+}
+
+void STBoundaryMapper::AddPathBox(const PathPoint& path_point, const double s,
+                                  const double l_buffer,
+                                  PathBoxes* path_boxes) const {
+  const size_t index = path_boxes->boxes.size();
+  path_boxes->s.push_back(s);
+  path_boxes->boxes.push_back(GetAdcBox(path_point, l_buffer));
+  const Box2d& box = path_boxes->boxes.back();
+  if (index % kPathBoxRunSize == 0) {
+    path_boxes->run_min_x.push_back(box.min_x());
+    path_boxes->run_max_x.push_back(box.max_x());
+    path_boxes->run_min_y.push_back(box.min_y());
+    path_boxes->run_max_y.push_back(box.max_y());
+  } else {
+    const size_t run = index / kPathBoxRunSize;
+    path_boxes->run_min_x[run] =
+        std::fmin(path_boxes->run_min_x[run], box.min_x());
+    path_boxes->run_max_x[run] =
+        std::fmax(path_boxes->run_max_x[run], box.max_x());
+    path_boxes->run_min_y[run] =
+        std::fmin(path_boxes->run_min_y[run], box.min_y());
+    path_boxes->run_max_y[run] =
+        std::fmax(path_boxes->run_max_y[run], box.max_y());
+  }
+}
+
+int STBoundaryMapper::FindFirstOverlap(const PathBoxes& path_boxes,
+                                       const Box2d& obs_box) {
+  const double min_x = obs_box.min_x();
+  const double max_x = obs_box.max_x();
+  const double min_y = obs_box.min_y();
+  const double max_y = obs_box.max_y();
+  const size_t num_runs = path_boxes.run_min_x.size();
+  for (size_t run = 0; run < num_runs; ++run) {
+    if (path_boxes.run_max_x[run] < min_x ||
+        path_boxes.run_min_x[run] > max_x ||
+        path_boxes.run_max_y[run] < min_y ||
+        path_boxes.run_min_y[run] > max_y) {
+      continue;
+    }
+    const size_t end = std::min(path_boxes.boxes.size(),
+                                (run + 1) * kPathBoxRunSize);
+    for (size_t i = run * kPathBoxRunSize; i < end; ++i) {
+      // Box2d::HasOverlap rejects by the bounding boxes first.
+      if (obs_box.HasOverlap(path_boxes.boxes[i])) {
+        return static_cast<int>(i);
+      }
+    }
+  }
+  return -1;
+}
+
+bool STBoundaryMapper::GetOverlapBoundaryPoints(
+    const PathOverlapIndex& path_index, const Obstacle& obstacle,
+    std::vector<STPoint>* upper_points,
+    std::vector<STPoint>* lower_points) const {
+  // Sanity checks.
+  DCHECK(upper_points->empty());
+  DCHECK(lower_points->empty());
+  if (path_index.sampled_path.empty()) {
+    AERROR << "No points in path_data_.discretized_path().";
+    return false;
+  }
+  const double l_buffer = path_index.l_buffer;
+
   // Draw the given obstacle on the ST-graph.
   const auto& trajectory = obstacle.Trajectory();
   if (trajectory.trajectory_point().empty()) {
@@ -219,47 +318,29 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
             << "] has NO prediction trajectory."
             << obstacle.Perception().ShortDebugString();
     }
-    for (const auto& curr_point_on_path : path_points) {
-      if (curr_point_on_path.s() > planning_max_distance_) {
-        break;
-      }
-
-      const Box2d& obs_box = obstacle.PerceptionBoundingBox();
-      if (CheckOverlap(curr_point_on_path, obs_box, l_buffer)) {
-        // If there is overlapping, then plot it on ST-graph.
-        const double backward_distance = -vehicle_param_.front_edge_to_center();
-        const double forward_distance = obs_box.length();
-        double low_s =
-            std::fmax(0.0, curr_point_on_path.s() + backward_distance);
-        double high_s = std::fmin(planning_max_distance_,
-                                  curr_point_on_path.s() + forward_distance);
-        // It is an unrotated rectangle appearing on the ST-graph.
-        // TODO(jiacheng): reconsider the backward_distance, it might be
-        // unnecessary, but forward_distance is indeed meaningful though.
-        lower_points->emplace_back(low_s, 0.0);
-        lower_points->emplace_back(low_s, planning_max_time_);
-        upper_points->emplace_back(high_s, 0.0);
-        upper_points->emplace_back(high_s, planning_max_time_);
-        break;
-      }
+    const Box2d& obs_box = obstacle.PerceptionBoundingBox();
+    const int overlap_index =
+        FindFirstOverlap(path_index.path_point_boxes, obs_box);
+    if (overlap_index >= 0) {
+      // If there is overlapping, then plot it on ST-graph.
+      const double curr_s = path_index.path_point_boxes.s[overlap_index];
+      const double backward_distance = -vehicle_param_.front_edge_to_center();
+      const double forward_distance = obs_box.length();
+      double low_s = std::fmax(0.0, curr_s + backward_distance);
+      double high_s =
+          std::fmin(planning_max_distance_, curr_s + forward_distance);
+      // It is an unrotated rectangle appearing on the ST-graph.
+      // TODO(jiacheng): reconsider the backward_distance, it might be
+      // unnecessary, but forward_distance is indeed meaningful though.
+      lower_points->emplace_back(low_s, 0.0);
+      lower_points->emplace_back(low_s, planning_max_time_);
+      upper_points->emplace_back(high_s, 0.0);
+      upper_points->emplace_back(high_s, planning_max_time_);
     }
   } else {
     // For those with predicted trajectories (moving obstacles):
-    // 1. Subsample to reduce computation time.
-    const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const auto ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
-      }
-      discretized_path = DiscretizedPath(std::move(sampled_path_points));
-    } else {
-      discretized_path = DiscretizedPath(path_points);
-    }
+    // 1. Use the sub-sampled path of the index.
+    const DiscretizedPath& discretized_path = path_index.sampled_path;
     // 2. Go through every point of the predicted obstacle trajectory.
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
@@ -272,62 +353,58 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
       }
 
       const double step_length = vehicle_param_.front_edge_to_center();
-      auto path_len =
-          std::min(FLAGS_max_trajectory_len, discretized_path.Length());
-      // Go through every point of the ADC's path.
-      for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
-        const auto curr_adc_path_point =
-            discretized_path.Evaluate(path_s + discretized_path.front().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box, l_buffer)) {
-          // Found overlap, start searching with higher resolution
-          const double backward_distance = -step_length;
-          const double forward_distance = vehicle_param_.length() +
-                                          vehicle_param_.width() +
-                                          obs_box.length() + obs_box.width();
-          const double default_min_step = 0.1;  // in meters
-          const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
-
-          bool find_low = false;
-          bool find_high = false;
-          double low_s = std::fmax(0.0, path_s + backward_distance);
-          double high_s =
-              std::fmin(discretized_path.Length(), path_s + forward_distance);
-
-          // Keep shrinking by the resolution bidirectionally until finally
-          // locating the tight upper and lower bounds.
-          while (low_s < high_s) {
-            if (find_low && find_high) {
-              break;
-            }
-            if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.front().s());
-              if (!CheckOverlap(point_low, obs_box, l_buffer)) {
-                low_s += fine_tuning_step_length;
-              } else {
-                find_low = true;
-              }
-            }
-            if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.front().s());
-              if (!CheckOverlap(point_high, obs_box, l_buffer)) {
-                high_s -= fine_tuning_step_length;
-              } else {
-                find_high = true;
-              }
+      // Go through the points of the ADC's path near the obstacle.
+      const int overlap_index =
+          FindFirstOverlap(path_index.sampled_path_boxes, obs_box);
+      if (overlap_index >= 0) {
+        const double path_s = path_index.sampled_path_boxes.s[overlap_index];
+        // Found overlap, start searching with higher resolution
+        const double backward_distance = -step_length;
+        const double forward_distance = vehicle_param_.length() +
+                                        vehicle_param_.width() +
+                                        obs_box.length() + obs_box.width();
+        const double default_min_step = 0.1;  // in meters
+        const double fine_tuning_step_length = std::fmin(
+            default_min_step, discretized_path.Length() / kDefaultNumPoint);
+
+        bool find_low = false;
+        bool find_high = false;
+        double low_s = std::fmax(0.0, path_s + backward_distance);
+        double high_s =
+            std::fmin(discretized_path.Length(), path_s + forward_distance);
+
+        // Keep shrinking by the resolution bidirectionally until finally
+        // locating the tight upper and lower bounds.
+        while (low_s < high_s) {
+          if (find_low && find_high) {
+            break;
+          }
+          if (!find_low) {
+            const auto& point_low = discretized_path.Evaluate(
+                low_s + discretized_path.front().s());
+            if (!CheckOverlap(point_low, obs_box, l_buffer)) {
+              low_s += fine_tuning_step_length;
+            } else {
+              find_low = true;
             }
           }
-          if (find_high && find_low) {
-            lower_points->emplace_back(
-                low_s - speed_bounds_config_.point_extension(),
-                trajectory_point_time);
-            upper_points->emplace_back(
-                high_s + speed_bounds_config_.point_extension(),
-                trajectory_point_time);
+          if (!find_high) {
+            const auto& point_high = discretized_path.Evaluate(
+                high_s + discretized_path.front().s());
+            if (!CheckOverlap(point_high, obs_box, l_buffer)) {
+              high_s -= fine_tuning_step_length;
+            } else {
+              find_high = true;
+            }
           }
-          break;
+        }
+        if (find_high && find_low) {
+          lower_points->emplace_back(
+              low_s - speed_bounds_config_.point_extension(),
+              trajectory_point_time);
+          upper_points->emplace_back(
+              high_s + speed_bounds_config_.point_extension(),
+              trajectory_point_time);
         }
       }
     }
@@ -339,7 +416,8 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
 }
 
 void STBoundaryMapper::ComputeSTBoundaryWithDecision(
-    Obstacle* obstacle, const ObjectDecisionType& decision) const {
+    const PathOverlapIndex& path_index, Obstacle* obstacle,
+    const ObjectDecisionType& decision) const {
   DCHECK(decision.has_follow() || decision.has_yield() ||
          decision.has_overtake())
       << "decision is " << decision.DebugString()
@@ -354,8 +432,8 @@ void STBoundaryMapper::ComputeSTBoundaryWithDecision(
     lower_points = path_st_boundary.lower_points();
     upper_points = path_st_boundary.upper_points();
   } else {
-    if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                  &upper_points, &lower_points)) {
+    if (!GetOverlapBoundaryPoints(path_index, *obstacle, &upper_points,
+                                  &lower_points)) {
       return;
     }
   }
@@ -389,6 +467,12 @@ void STBoundaryMapper::ComputeSTBoundaryWithDecision(
 bool STBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double l_buffer) const {
+  // Check whether ADC bounding box overlaps with obstacle bounding box.
+  return obs_box.HasOverlap(GetAdcBox(path_point, l_buffer));
+}
+
+Box2d STBoundaryMapper::GetAdcBox(const PathPoint& path_point,
+                                  const double l_buffer) const {
   // Convert reference point from center of rear axis to center of ADC.
   Vec2d ego_center_map_frame((vehicle_param_.front_edge_to_center() -
                               vehicle_param_.back_edge_to_center()) *
@@ -401,11 +485,8 @@ bool STBoundaryMapper::CheckOverlap(const PathPoint& path_point,
   ego_center_map_frame.set_y(ego_center_map_frame.y() + path_point.y());
 
   // Compute the ADC bounding box.
-  Box2d adc_box(ego_center_map_frame, path_point.theta(),
-                vehicle_param_.length(), vehicle_param_.width() + l_buffer * 2);
-
-  // Check whether ADC bounding box overlaps with obstacle bounding box.
-  return obs_box.HasOverlap(adc_box);
+  return Box2d(ego_center_map_frame, path_point.theta(),
+               vehicle_param_.length(), vehicle_param_.width() + l_buffer * 2);
 }
 
 }  // namespace planning
@@ -25,9 +25,11 @@
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
+#include "modules/common/math/box2d.h"
 #include "modules/common/status/status.h"
 #include "modules/planning/common/dependency_injector.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path/discretized_path.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
@@ -52,21 +54,72 @@ class STBoundaryMapper {
 
  private:
   FRIEND_TEST(StBoundaryMapperTest, check_overlap_test);
+  FRIEND_TEST(StBoundaryMapperTest, path_boxes_test);
+
+  // The number of consecutive path samples bounded together.
+  static constexpr size_t kPathBoxRunSize = 8;
+
+  /** @brief The ADC boxes at samples along the path, in the order of s,
+   * with the axis-aligned bounding boxes of the runs of kPathBoxRunSize
+   * consecutive samples, which sweep the path. An obstacle box is only
+   * checked against the samples of the runs its bounding box meets.
+   */
+  struct PathBoxes {
+    std::vector<double> s;
+    std::vector<common::math::Box2d> boxes;
+    std::vector<double> run_min_x;
+    std::vector<double> run_max_x;
+    std::vector<double> run_min_y;
+    std::vector<double> run_max_y;
+  };
+
+  /** @brief The path of the ADC, indexed once for the overlap checks of all
+   * obstacles.
+   */
+  struct PathOverlapIndex {
+    double l_buffer = 0.0;
+    // The path points up to the planning distance, for the obstacles
+    // without predicted trajectories.
+    PathBoxes path_point_boxes;
+    // The sub-sampled path, with the boxes every front_edge_to_center, for
+    // the obstacles with predicted trajectories.
+    DiscretizedPath sampled_path;
+    PathBoxes sampled_path_boxes;
+  };
+
+  PathOverlapIndex BuildPathOverlapIndex(
+      const std::vector<common::PathPoint>& path_points) const;
+
+  void AddPathBox(const common::PathPoint& path_point, const double s,
+                  const double l_buffer, PathBoxes* path_boxes) const;
+
+  /** @brief Returns the index of the first sample whose ADC box overlaps
+   * the obstacle box, or -1 if none does.
+   */
+  static int FindFirstOverlap(const PathBoxes& path_boxes,
+                              const common::math::Box2d& obs_box);
 
   /** @brief Calls GetOverlapBoundaryPoints to get upper and lower points
    * for a given obstacle, and then formulate STBoundary based on that.
    * It also labels boundary type based on previously documented decisions.
    */
-  void ComputeSTBoundary(Obstacle* obstacle) const;
+  void ComputeSTBoundary(const PathOverlapIndex& path_index,
+                         Obstacle* obstacle) const;
 
   /** @brief Map the given obstacle onto the ST-Graph. The boundary is
    * represented as upper and lower points for every s of interests.
    * Note that upper_points.size() = lower_points.size()
    */
-  bool GetOverlapBoundaryPoints(
-      const std::vector<common::PathPoint>& path_points,
-      const Obstacle& obstacle, std::vector<STPoint>* upper_points,
-      std::vector<STPoint>* lower_points) const;
+  bool GetOverlapBoundaryPoints(const PathOverlapIndex& path_index,
+                                const Obstacle& obstacle,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
+
+  /** @brief The bounding box of the ADC, with the extra lateral buffer, when
+   * at a path-point of the center of rear-axis.
+   */
+  common::math::Box2d GetAdcBox(const common::PathPoint& path_point,
+                                const double l_buffer) const;
 
   /** @brief Given a path-point and an obstacle bounding box, check if the
    *        ADC, when at that path-point, will collide with the obstacle.
@@ -89,7 +142,8 @@ class STBoundaryMapper {
    * Increase boundary on the s-dimension or set the boundary type, etc.,
    * when necessary.
    */
-  void ComputeSTBoundaryWithDecision(Obstacle* obstacle,
+  void ComputeSTBoundaryWithDecision(const PathOverlapIndex& path_index,
+                                     Obstacle* obstacle,
                                      const ObjectDecisionType& decision) const;
 
  private:
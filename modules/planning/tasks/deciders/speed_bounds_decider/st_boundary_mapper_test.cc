@@ -16,6 +16,8 @@
 
 #include "modules/planning/tasks/deciders/speed_bounds_decider/st_boundary_mapper.h"
 
+#include <cmath>
+
 #include "cyber/common/log.h"
 #include "gmock/gmock.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -91,5 +93,36 @@ TEST_F(StBoundaryMapperTest, check_overlap_test) {
   EXPECT_TRUE(mapper.CheckOverlap(path_point, box, 0.0));
 }
 
+TEST_F(StBoundaryMapperTest, path_boxes_test) {
+  SpeedBoundsDeciderConfig config;
+  double planning_distance = 70.0;
+  double planning_time = 10.0;
+  STBoundaryMapper mapper(config, *reference_line_, path_data_,
+                          planning_distance, planning_time, injector_);
+  const auto path_index =
+      mapper.BuildPathOverlapIndex(path_data_.discretized_path());
+  const auto& path_boxes = path_index.path_point_boxes;
+  ASSERT_FALSE(path_boxes.boxes.empty());
+
+  // The index finds the first overlapping sample, as checking all does.
+  for (const auto& path_point : path_data_.discretized_path()) {
+    for (const double l : {0.0, 2.0, 4.0, 20.0}) {
+      const common::math::Vec2d center(
+          path_point.x() - l * std::sin(path_point.theta()),
+          path_point.y() + l * std::cos(path_point.theta()));
+      common::math::Box2d obs_box(center, path_point.theta() + 0.5, 4.0, 2.0);
+      int expected_index = -1;
+      for (size_t i = 0; i < path_boxes.boxes.size(); ++i) {
+        if (obs_box.HasOverlap(path_boxes.boxes[i])) {
+          expected_index = static_cast<int>(i);
+          break;
+        }
+      }
+      EXPECT_EQ(expected_index,
+                STBoundaryMapper::FindFirstOverlap(path_boxes, obs_box));
+    }
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -44,22 +45,35 @@ DpStCost::DpStCost(const DpStSpeedOptimizerConfig& config, const double total_t,
       init_point_(init_point),
       unit_t_(config.unit_t()),
       total_s_(total_s) {
-  int index = 0;
-  for (const auto& obstacle : obstacles) {
-    boundary_map_[obstacle->path_st_boundary().id()] = index++;
+  for (const auto* obstacle : obstacles) {
+    // Not applying obstacle approaching cost to virtual obstacle like created
+    // stop fences
+    if (obstacle->IsVirtual()) {
+      continue;
+    }
+    // Stop obstacles are assumed to have a safety margin when mapping them out,
+    // so repelling force in dp st is not needed as it is designed to have adc
+    // stop right at the stop distance we design in prior mapping process
+    if (obstacle->LongitudinalDecision().has_stop()) {
+      continue;
+    }
+    const auto& boundary = obstacle->path_st_boundary();
+    if (boundary.IsEmpty() ||
+        boundary.min_s() > FLAGS_speed_lon_decision_horizon) {
+      continue;
+    }
+    CostBoundary cost_boundary;
+    cost_boundary.boundary = &boundary;
+    cost_boundary.lower_points = boundary.lower_points();
+    cost_boundary.upper_points = boundary.upper_points();
+    cost_boundaries_.push_back(std::move(cost_boundary));
   }
+  obstacle_slices_.reserve(cost_boundaries_.size());
 
   AddToKeepClearRange(obstacles);
 
-  const auto dimension_t =
-      static_cast<uint32_t>(std::ceil(total_t / static_cast<double>(unit_t_))) +
-      1;
-  boundary_cost_.resize(obstacles_.size());
-  for (auto& vec : boundary_cost_) {
-    vec.resize(dimension_t, std::make_pair(-1.0, -1.0));
-  }
-  accel_cost_.fill(-1.0);
-  jerk_cost_.fill(-1.0);
+  InitAccelCost();
+  InitJerkCost();
 }
 
 void DpStCost::AddToKeepClearRange(
@@ -110,85 +124,105 @@ bool DpStCost::InKeepClearRange(double s) const {
   return false;
 }
 
-double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
-  const double s = st_graph_point.point().s();
-  const double t = st_graph_point.point().t();
-
-  double cost = 0.0;
-
-  if (FLAGS_use_st_drivable_boundary) {
+void DpStCost::SliceObstacles(const double t) {
+  check_drivable_boundary_ = FLAGS_use_st_drivable_boundary;
+  if (check_drivable_boundary_) {
     // TODO(Jiancheng): move to configs
     static constexpr double boundary_resolution = 0.1;
     int index = static_cast<int>(t / boundary_resolution);
-    const double lower_bound =
-        st_drivable_boundary_.st_boundary(index).s_lower();
-    const double upper_bound =
-        st_drivable_boundary_.st_boundary(index).s_upper();
-
-    if (s > upper_bound || s < lower_bound) {
-      return kInf;
-    }
+    drivable_s_lower_ = st_drivable_boundary_.st_boundary(index).s_lower();
+    drivable_s_upper_ = st_drivable_boundary_.st_boundary(index).s_upper();
   }
 
-  for (const auto* obstacle : obstacles_) {
-    // Not applying obstacle approaching cost to virtual obstacle like created
-    // stop fences
-    if (obstacle->IsVirtual()) {
-      continue;
-    }
-
-    // Stop obstacles are assumed to have a safety margin when mapping them out,
-    // so repelling force in dp st is not needed as it is designed to have adc
-    // stop right at the stop distance we design in prior mapping process
-    if (obstacle->LongitudinalDecision().has_stop()) {
-      continue;
-    }
-
-    auto boundary = obstacle->path_st_boundary();
-
-    if (boundary.min_s() > FLAGS_speed_lon_decision_horizon) {
-      continue;
-    }
+  obstacle_slices_.clear();
+  for (const auto& cost_boundary : cost_boundaries_) {
+    const STBoundary& boundary = *cost_boundary.boundary;
     if (t < boundary.min_t() || t > boundary.max_t()) {
       continue;
     }
-    if (boundary.IsPointInBoundary(st_graph_point.point())) {
-      return kInf;
+    ObstacleSlice slice;
+    // The points on the time of the ends are never in the boundary.
+    slice.check_in_boundary = t > boundary.min_t() && t < boundary.max_t();
+    if (slice.check_in_boundary) {
+      const auto& lower_points = cost_boundary.lower_points;
+      const auto& upper_points = cost_boundary.upper_points;
+      auto comp = [](const STPoint& p, const double time) {
+        return p.t() < time;
+      };
+      const auto first_ge =
+          std::lower_bound(lower_points.begin(), lower_points.end(), t, comp);
+      const size_t index = std::distance(lower_points.begin(), first_ge);
+      size_t left = 0;
+      size_t right = 0;
+      if (first_ge == lower_points.end()) {
+        left = right = lower_points.size() - 1;
+      } else if (index > 0) {
+        left = index - 1;
+        right = index;
+      }
+      slice.upper_left_dt = upper_points[left].t() - t;
+      slice.upper_left_s = upper_points[left].s();
+      slice.upper_right_dt = upper_points[right].t() - t;
+      slice.upper_right_s = upper_points[right].s();
+      slice.lower_left_dt = lower_points[left].t() - t;
+      slice.lower_left_s = lower_points[left].s();
+      slice.lower_right_dt = lower_points[right].t() - t;
+      slice.lower_right_s = lower_points[right].s();
     }
-    double s_upper = 0.0;
-    double s_lower = 0.0;
-
-    int boundary_index = boundary_map_[boundary.id()];
-    if (boundary_cost_[boundary_index][st_graph_point.index_t()].first < 0.0) {
-      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
-      boundary_cost_[boundary_index][st_graph_point.index_t()] =
-          std::make_pair(s_upper, s_lower);
-    } else {
-      s_upper = boundary_cost_[boundary_index][st_graph_point.index_t()].first;
-      s_lower = boundary_cost_[boundary_index][st_graph_point.index_t()].second;
+    boundary.GetBoundarySRange(t, &slice.s_upper, &slice.s_lower);
+    obstacle_slices_.push_back(slice);
+  }
+}
+
+void DpStCost::GetObstacleCosts(const double* s, const size_t size,
+                                double* costs) const {
+  std::fill(costs, costs + size, 0.0);
+  if (check_drivable_boundary_) {
+    for (size_t i = 0; i < size; ++i) {
+      if (s[i] > drivable_s_upper_ || s[i] < drivable_s_lower_) {
+        costs[i] = kInf;
+      }
     }
-    if (s < s_lower) {
-      const double follow_distance_s = config_.safe_distance();
-      if (s + follow_distance_s < s_lower) {
-        continue;
-      } else {
-        auto s_diff = follow_distance_s - s_lower + s;
-        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
-                s_diff * s_diff;
+  }
+
+  const double follow_distance_s = config_.safe_distance();
+  const double overtake_distance_s =
+      StGapEstimator::EstimateSafeOvertakingGap();
+  const double weight =
+      config_.obstacle_weight() * config_.default_obstacle_cost();
+  // Once a point is in a boundary, its cost stays infinite as it is summed up.
+  for (const auto& slice : obstacle_slices_) {
+    for (size_t i = 0; i < size; ++i) {
+      if (slice.check_in_boundary) {
+        // The cross products of STBoundary::IsPointInBoundary.
+        const double check_upper =
+            slice.upper_left_dt * (slice.upper_right_s - s[i]) -
+            (slice.upper_left_s - s[i]) * slice.upper_right_dt;
+        const double check_lower =
+            slice.lower_left_dt * (slice.lower_right_s - s[i]) -
+            (slice.lower_left_s - s[i]) * slice.lower_right_dt;
+        if (check_upper * check_lower < 0) {
+          costs[i] = kInf;
+          continue;
+        }
       }
-    } else if (s > s_upper) {
-      const double overtake_distance_s =
-          StGapEstimator::EstimateSafeOvertakingGap();
-      if (s > s_upper + overtake_distance_s) {  // or calculated from velocity
-        continue;
-      } else {
-        auto s_diff = overtake_distance_s + s_upper - s;
-        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
-                s_diff * s_diff;
+      if (s[i] < slice.s_lower) {
+        if (s[i] + follow_distance_s >= slice.s_lower) {
+          const double s_diff = follow_distance_s - slice.s_lower + s[i];
+          costs[i] += weight * s_diff * s_diff;
+        }
+      } else if (s[i] > slice.s_upper) {
+        // or calculated from velocity
+        if (s[i] <= slice.s_upper + overtake_distance_s) {
+          const double s_diff = overtake_distance_s + slice.s_upper - s[i];
+          costs[i] += weight * s_diff * s_diff;
+        }
       }
     }
   }
-  return cost * unit_t_;
+  for (size_t i = 0; i < size; ++i) {
+    costs[i] *= unit_t_;
+  }
 }
 
 double DpStCost::GetSpatialPotentialCost(const StGraphPoint& point) {
@@ -238,23 +272,17 @@ double DpStCost::GetSpeedCost(const STPoint& first, const STPoint& second,
   return cost;
 }
 
-double DpStCost::GetAccelCost(const double accel) {
-  double cost = 0.0;
+void DpStCost::InitAccelCost() {
   static constexpr double kEpsilon = 0.1;
-  static constexpr size_t kShift = 100;
-  const size_t accel_key = static_cast<size_t>(accel / kEpsilon + 0.5 + kShift);
-  DCHECK_LT(accel_key, accel_cost_.size());
-  if (accel_key >= accel_cost_.size()) {
-    return kInf;
-  }
-
-  if (accel_cost_.at(accel_key) < 0.0) {
+  static constexpr int kShift = 100;
+  const double max_acc = config_.max_acceleration();
+  const double max_dec = config_.max_deceleration();
+  const double accel_penalty = config_.accel_penalty();
+  const double decel_penalty = config_.decel_penalty();
+  for (size_t key = 0; key < accel_cost_.size(); ++key) {
+    const double accel = (static_cast<int>(key) - kShift) * kEpsilon;
     const double accel_sq = accel * accel;
-    double max_acc = config_.max_acceleration();
-    double max_dec = config_.max_deceleration();
-    double accel_penalty = config_.accel_penalty();
-    double decel_penalty = config_.decel_penalty();
-
+    double cost = 0.0;
     if (accel > 0.0) {
       cost = accel_penalty * accel_sq;
     } else {
@@ -264,57 +292,65 @@ double DpStCost::GetAccelCost(const double accel) {
                 (1 + std::exp(1.0 * (accel - max_dec))) +
             accel_sq * accel_penalty * accel_penalty /
                 (1 + std::exp(-1.0 * (accel - max_acc)));
-    accel_cost_.at(accel_key) = cost;
-  } else {
-    cost = accel_cost_.at(accel_key);
+    accel_cost_[key] = cost;
   }
-  return cost * unit_t_;
+}
+
+double DpStCost::GetAccelCost(const double accel) const {
+  static constexpr double kEpsilon = 0.1;
+  static constexpr size_t kShift = 100;
+  const size_t accel_key = static_cast<size_t>(accel / kEpsilon + 0.5 + kShift);
+  DCHECK_LT(accel_key, accel_cost_.size());
+  if (accel_key >= accel_cost_.size()) {
+    return kInf;
+  }
+  return accel_cost_[accel_key] * unit_t_;
 }
 
 double DpStCost::GetAccelCostByThreePoints(const STPoint& first,
                                            const STPoint& second,
-                                           const STPoint& third) {
+                                           const STPoint& third) const {
   double accel = (first.s() + third.s() - 2 * second.s()) / (unit_t_ * unit_t_);
   return GetAccelCost(accel);
 }
 
 double DpStCost::GetAccelCostByTwoPoints(const double pre_speed,
                                          const STPoint& pre_point,
-                                         const STPoint& curr_point) {
+                                         const STPoint& curr_point) const {
   double current_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   double accel = (current_speed - pre_speed) / unit_t_;
   return GetAccelCost(accel);
 }
 
-double DpStCost::JerkCost(const double jerk) {
-  double cost = 0.0;
+void DpStCost::InitJerkCost() {
   static constexpr double kEpsilon = 0.1;
-  static constexpr size_t kShift = 200;
-  const size_t jerk_key = static_cast<size_t>(jerk / kEpsilon + 0.5 + kShift);
-  if (jerk_key >= jerk_cost_.size()) {
-    return kInf;
-  }
-
-  if (jerk_cost_.at(jerk_key) < 0.0) {
-    double jerk_sq = jerk * jerk;
+  static constexpr int kShift = 200;
+  for (size_t key = 0; key < jerk_cost_.size(); ++key) {
+    const double jerk = (static_cast<int>(key) - kShift) * kEpsilon;
+    const double jerk_sq = jerk * jerk;
     if (jerk > 0) {
-      cost = config_.positive_jerk_coeff() * jerk_sq * unit_t_;
+      jerk_cost_[key] = config_.positive_jerk_coeff() * jerk_sq * unit_t_;
     } else {
-      cost = config_.negative_jerk_coeff() * jerk_sq * unit_t_;
+      jerk_cost_[key] = config_.negative_jerk_coeff() * jerk_sq * unit_t_;
     }
-    jerk_cost_.at(jerk_key) = cost;
-  } else {
-    cost = jerk_cost_.at(jerk_key);
   }
+}
 
+double DpStCost::JerkCost(const double jerk) const {
+  static constexpr double kEpsilon = 0.1;
+  static constexpr size_t kShift = 200;
+  const size_t jerk_key = static_cast<size_t>(jerk / kEpsilon + 0.5 + kShift);
+  if (jerk_key >= jerk_cost_.size()) {
+    return kInf;
+  }
   // TODO(All): normalize to unit_t_
-  return cost;
+  return jerk_cost_[jerk_key];
 }
 
 double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
                                          const STPoint& second,
                                          const STPoint& third,
-                                         const STPoint& fourth) {
+                                         const STPoint& fourth) const {
   double jerk = (fourth.s() - 3 * third.s() + 3 * second.s() - first.s()) /
                 (unit_t_ * unit_t_ * unit_t_);
   return JerkCost(jerk);
@@ -323,7 +359,7 @@ double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
 double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
                                         const double pre_acc,
                                         const STPoint& pre_point,
-                                        const STPoint& curr_point) {
+                                        const STPoint& curr_point) const {
   const double curr_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   const double curr_accel = (curr_speed - pre_speed) / unit_t_;
   const double jerk = (curr_accel - pre_acc) / unit_t_;
@@ -333,7 +369,7 @@ double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
 double DpStCost::GetJerkCostByThreePoints(const double first_speed,
                                           const STPoint& first,
                                           const STPoint& second,
-                                          const STPoint& third) {
+                                          const STPoint& third) const {
   const double pre_speed = (second.s() - first.s()) / unit_t_;
   const double pre_acc = (pre_speed - first_speed) / unit_t_;
   const double curr_speed = (third.s() - second.s()) / unit_t_;
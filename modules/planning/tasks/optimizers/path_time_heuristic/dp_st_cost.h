@@ -20,8 +20,7 @@
 
 #pragma once
 
-#include <string>
-#include <unordered_map>
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -43,7 +42,22 @@ class DpStCost {
            const STDrivableBoundary& st_drivable_boundary,
            const common::TrajectoryPoint& init_point);
 
-  double GetObstacleCost(const StGraphPoint& point);
+  /**
+   * @brief Slices the obstacle ST-boundaries at the time of a column, so that
+   * the obstacle costs of the column only read the slices. Must be called
+   * before GetObstacleCosts() for each column.
+   * @param t the time of the column
+   */
+  void SliceObstacles(const double t);
+
+  /**
+   * @brief Computes the obstacle costs of points of the sliced column.
+   * @param s the s of the points, contiguous
+   * @param size the number of points
+   * @param costs the obstacle costs of the points
+   */
+  void GetObstacleCosts(const double* s, const size_t size,
+                        double* costs) const;
 
   double GetSpatialPotentialCost(const StGraphPoint& point);
 
@@ -55,24 +69,46 @@ class DpStCost {
                       const double cruise_speed) const;
 
   double GetAccelCostByTwoPoints(const double pre_speed, const STPoint& first,
-                                 const STPoint& second);
+                                 const STPoint& second) const;
   double GetAccelCostByThreePoints(const STPoint& first, const STPoint& second,
-                                   const STPoint& third);
+                                   const STPoint& third) const;
 
   double GetJerkCostByTwoPoints(const double pre_speed, const double pre_acc,
                                 const STPoint& pre_point,
-                                const STPoint& curr_point);
+                                const STPoint& curr_point) const;
   double GetJerkCostByThreePoints(const double first_speed,
                                   const STPoint& first_point,
                                   const STPoint& second_point,
-                                  const STPoint& third_point);
+                                  const STPoint& third_point) const;
 
   double GetJerkCostByFourPoints(const STPoint& first, const STPoint& second,
-                                 const STPoint& third, const STPoint& fourth);
+                                 const STPoint& third,
+                                 const STPoint& fourth) const;
 
  private:
-  double GetAccelCost(const double accel);
-  double JerkCost(const double jerk);
+  // An obstacle ST-boundary at the time of a column.
+  struct ObstacleSlice {
+    // The differences in t and the s of the ends of the upper and lower
+    // segments around the time, to check points in the boundary as
+    // STBoundary::IsPointInBoundary does.
+    double upper_left_dt = 0.0;
+    double upper_left_s = 0.0;
+    double upper_right_dt = 0.0;
+    double upper_right_s = 0.0;
+    double lower_left_dt = 0.0;
+    double lower_left_s = 0.0;
+    double lower_right_dt = 0.0;
+    double lower_right_s = 0.0;
+    bool check_in_boundary = false;
+    // The s range of the boundary from STBoundary::GetBoundarySRange.
+    double s_upper = 0.0;
+    double s_lower = 0.0;
+  };
+
+  void InitAccelCost();
+  void InitJerkCost();
+  double GetAccelCost(const double accel) const;
+  double JerkCost(const double jerk) const;
 
   void AddToKeepClearRange(const std::vector<const Obstacle*>& obstacles);
   static void SortAndMergeRange(
@@ -89,11 +125,25 @@ class DpStCost {
   double unit_t_ = 0.0;
   double total_s_ = 0.0;
 
-  std::unordered_map<std::string, int> boundary_map_;
-  std::vector<std::vector<std::pair<double, double>>> boundary_cost_;
+  // The ST-boundaries of the obstacles considered in the obstacle cost, with
+  // copies of their points, which STBoundary only returns by value.
+  struct CostBoundary {
+    const STBoundary* boundary = nullptr;
+    std::vector<STPoint> lower_points;
+    std::vector<STPoint> upper_points;
+  };
+  std::vector<CostBoundary> cost_boundaries_;
+
+  // The slices of the current column.
+  std::vector<ObstacleSlice> obstacle_slices_;
+  bool check_drivable_boundary_ = false;
+  double drivable_s_lower_ = 0.0;
+  double drivable_s_upper_ = 0.0;
 
   std::vector<std::pair<double, double>> keep_clear_range_;
 
+  // Costs by buckets of accel and jerk, filled at construction, so that the
+  // edge costs may be computed from several threads.
   std::array<double, 200> accel_cost_;
   std::array<double, 400> jerk_cost_;
 };
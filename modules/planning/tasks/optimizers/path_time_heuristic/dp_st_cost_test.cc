@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/tasks/optimizers/path_time_heuristic/dp_st_cost.h"
+
+#include <cmath>
+#include <limits>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/tasks/utils/st_gap_estimator.h"
+
+namespace apollo {
+namespace planning {
+
+class DpStCostTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    FLAGS_use_st_drivable_boundary = false;
+    config_.set_unit_t(1.0);
+    config_.set_safe_distance(20.0);
+    config_.set_obstacle_weight(1.0);
+    config_.set_default_obstacle_cost(1e4);
+    init_point_.set_v(10.0);
+  }
+
+  virtual void TearDown() {}
+
+ protected:
+  // Adds an obstacle whose ST-boundary goes through the lower and upper s at
+  // the times of the points.
+  void AddObstacle(const std::vector<std::pair<double, double>>& s_ranges,
+                   const std::vector<double>& times) {
+    std::vector<std::pair<STPoint, STPoint>> point_pairs;
+    for (size_t i = 0; i < times.size(); ++i) {
+      point_pairs.emplace_back(STPoint(s_ranges[i].first, times[i]),
+                               STPoint(s_ranges[i].second, times[i]));
+    }
+    obstacle_list_.emplace_back();
+    obstacle_list_.back().set_path_st_boundary(STBoundary(point_pairs));
+    obstacles_.push_back(&obstacle_list_.back());
+  }
+
+  // The obstacle cost of a point, as it was computed point by point before
+  // the obstacles were sliced by column.
+  double GetObstacleCost(const double s, const double t) const {
+    double cost = 0.0;
+    for (const auto* obstacle : obstacles_) {
+      const auto& boundary = obstacle->path_st_boundary();
+      if (boundary.min_s() > FLAGS_speed_lon_decision_horizon) {
+        continue;
+      }
+      if (t < boundary.min_t() || t > boundary.max_t()) {
+        continue;
+      }
+      if (boundary.IsPointInBoundary(STPoint(s, t))) {
+        return std::numeric_limits<double>::infinity();
+      }
+      double s_upper = 0.0;
+      double s_lower = 0.0;
+      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
+      if (s < s_lower) {
+        const double follow_distance_s = config_.safe_distance();
+        if (s + follow_distance_s < s_lower) {
+          continue;
+        }
+        const double s_diff = follow_distance_s - s_lower + s;
+        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
+                s_diff * s_diff;
+      } else if (s > s_upper) {
+        const double overtake_distance_s =
+            StGapEstimator::EstimateSafeOvertakingGap();
+        if (s > s_upper + overtake_distance_s) {
+          continue;
+        }
+        const double s_diff = overtake_distance_s + s_upper - s;
+        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
+                s_diff * s_diff;
+      }
+    }
+    return cost * config_.unit_t();
+  }
+
+  void ExpectSameCosts() {
+    DpStCost dp_st_cost(config_, 8.0, 100.0, obstacles_, STDrivableBoundary(),
+                        init_point_);
+    std::vector<double> s;
+    for (double s_value = 0.0; s_value <= 100.0; s_value += 0.5) {
+      s.push_back(s_value);
+    }
+    std::vector<double> costs(s.size());
+    for (double t = 0.0; t <= 8.0; t += config_.unit_t()) {
+      dp_st_cost.SliceObstacles(t);
+      dp_st_cost.GetObstacleCosts(s.data(), s.size(), costs.data());
+      for (size_t i = 0; i < s.size(); ++i) {
+        const double expected = GetObstacleCost(s[i], t);
+        if (std::isinf(expected)) {
+          EXPECT_TRUE(std::isinf(costs[i])) << "s: " << s[i] << ", t: " << t;
+        } else {
+          EXPECT_NEAR(expected, costs[i], 1e-9 * std::fmax(1.0, expected))
+              << "s: " << s[i] << ", t: " << t;
+        }
+      }
+    }
+  }
+
+  DpStSpeedOptimizerConfig config_;
+  common::TrajectoryPoint init_point_;
+  std::list<Obstacle> obstacle_list_;
+  std::vector<const Obstacle*> obstacles_;
+};
+
+TEST_F(DpStCostTest, StaticObstacle) {
+  AddObstacle({{30.0, 45.0}, {30.0, 45.0}}, {2.0, 6.0});
+  ExpectSameCosts();
+}
+
+TEST_F(DpStCostTest, ObstaclesWithinColumns) {
+  // Boundaries starting and ending between the times of two columns.
+  AddObstacle({{40.0, 44.0}, {40.0, 44.0}}, {1.3, 4.6});
+  AddObstacle({{12.0, 16.0}, {20.0, 24.0}, {36.0, 40.0}}, {2.5, 3.5, 5.7});
+  ExpectSameCosts();
+}
+
+TEST_F(DpStCostTest, MovingObstacles) {
+  // A cut-in, a leading vehicle and an oncoming one, overlapping in time.
+  AddObstacle({{25.0, 30.0}, {35.0, 40.0}, {52.0, 57.0}}, {0.0, 3.0, 8.0});
+  AddObstacle({{60.0, 65.0}, {70.0, 76.0}}, {0.8, 7.2});
+  AddObstacle({{90.0, 95.0}, {50.0, 55.0}}, {1.0, 5.5});
+  ExpectSameCosts();
+}
+
+}  // namespace planning
+}  // namespace apollo
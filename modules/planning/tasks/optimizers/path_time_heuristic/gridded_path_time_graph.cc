@@ -21,6 +21,7 @@
 #include "modules/planning/tasks/optimizers/path_time_heuristic/gridded_path_time_graph.h"
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <string>
 
@@ -28,6 +29,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/task/task.h"
+#include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -44,19 +46,18 @@ namespace {
 
 static constexpr double kDoubleEpsilon = 1.0e-6;
 
+// The number of rows of a column computed by a task, large enough for the
+// rows to share the obstacle slices and the boundaries of the column.
+static constexpr uint32_t kRowsPerTask = 32;
+
 // Continuous-time collision check using linear interpolation as closed-loop
 // dynamics
 bool CheckOverlapOnDpStGraph(const std::vector<const STBoundary*>& boundaries,
                              const StGraphPoint& p1, const StGraphPoint& p2) {
-  if (FLAGS_use_st_drivable_boundary) {
-    return false;
-  }
+  const common::math::LineSegment2d segment(p1.point(), p2.point());
   for (const auto* boundary : boundaries) {
-    if (boundary->boundary_type() == STBoundary::BoundaryType::KEEP_CLEAR) {
-      continue;
-    }
     // Check collision between a polygon and a line segment
-    if (boundary->HasOverlap({p1.point(), p2.point()})) {
+    if (boundary->HasOverlap(segment)) {
       return true;
     }
   }
@@ -237,20 +238,44 @@ Status GriddedPathTimeGraph::CalculateTotalCost() {
     int count = static_cast<int>(next_highest_row) -
                 static_cast<int>(next_lowest_row) + 1;
     if (count > 0) {
-      std::vector<std::future<void>> results;
-      for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
-        auto msg = std::make_shared<StGraphMessage>(c, r);
-        if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-          results.push_back(
-              cyber::Async(&GriddedPathTimeGraph::CalculateCostAt, this, msg));
-        } else {
-          CalculateCostAt(msg);
+      const double t = cost_table_[c][0].point().t();
+      dp_st_cost_.SliceObstacles(t);
+
+      // The boundaries which may overlap the edges from the previous column,
+      // by the bounding box check of Polygon2d::HasOverlap in t.
+      std::vector<const STBoundary*> boundaries;
+      if (c > 0 && !FLAGS_use_st_drivable_boundary) {
+        const double pre_t = cost_table_[c - 1][0].point().t();
+        for (const auto* boundary : st_graph_data_.st_boundaries()) {
+          // KeepClear obstacles not considered in Dp St decision
+          if (boundary->boundary_type() ==
+              STBoundary::BoundaryType::KEEP_CLEAR) {
+            continue;
+          }
+          if (t < boundary->min_t() || pre_t > boundary->max_t()) {
+            continue;
+          }
+          boundaries.push_back(boundary);
         }
       }
+
+      const uint32_t row_begin = static_cast<uint32_t>(next_lowest_row);
+      const uint32_t row_end = static_cast<uint32_t>(next_highest_row) + 1;
       if (FLAGS_enable_multi_thread_in_dp_st_graph) {
+        std::vector<std::future<void>> results;
+        for (uint32_t r = row_begin; r < row_end; r += kRowsPerTask) {
+          const uint32_t r_end = std::min(r + kRowsPerTask, row_end);
+          results.push_back(cyber::Async([this, c, r, r_end, &boundaries]() {
+            CalculateCostInRows(static_cast<uint32_t>(c), r, r_end,
+                                boundaries);
+          }));
+        }
         for (auto& result : results) {
           result.get();
         }
+      } else {
+        CalculateCostInRows(static_cast<uint32_t>(c), row_begin, row_end,
+                            boundaries);
       }
     }
 
@@ -315,13 +340,27 @@ void GriddedPathTimeGraph::GetRowRange(const StGraphPoint& point,
   }
 }
 
+void GriddedPathTimeGraph::CalculateCostInRows(
+    const uint32_t c, const uint32_t row_begin, const uint32_t row_end,
+    const std::vector<const STBoundary*>& boundaries) {
+  // The s of the rows are the same in all columns.
+  std::array<double, kRowsPerTask> obstacle_costs;
+  for (uint32_t r = row_begin; r < row_end; r += kRowsPerTask) {
+    const uint32_t size = std::min(kRowsPerTask, row_end - r);
+    dp_st_cost_.GetObstacleCosts(&spatial_distance_by_index_[r], size,
+                                 obstacle_costs.data());
+    for (uint32_t i = 0; i < size; ++i) {
+      CalculateCostAt(c, r + i, obstacle_costs[i], boundaries);
+    }
+  }
+}
+
 void GriddedPathTimeGraph::CalculateCostAt(
-    const std::shared_ptr<StGraphMessage>& msg) {
-  const uint32_t c = msg->c;
-  const uint32_t r = msg->r;
+    const uint32_t c, const uint32_t r, const double obstacle_cost,
+    const std::vector<const STBoundary*>& boundaries) {
   auto& cost_cr = cost_table_[c][r];
 
-  cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
+  cost_cr.SetObstacleCost(obstacle_cost);
   if (cost_cr.obstacle_cost() > std::numeric_limits<double>::max()) {
     return;
   }
@@ -354,8 +393,7 @@ void GriddedPathTimeGraph::CalculateCostAt(
       return;
     }
 
-    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
-                                cost_init)) {
+    if (CheckOverlapOnDpStGraph(boundaries, cost_cr, cost_init)) {
       return;
     }
     cost_cr.SetTotalCost(
@@ -415,8 +453,7 @@ void GriddedPathTimeGraph::CalculateCostAt(
 
       // Filter out continuous-time node connection which is in collision with
       // obstacle
-      if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
-                                  pre_col[r_pre])) {
+      if (CheckOverlapOnDpStGraph(boundaries, cost_cr, pre_col[r_pre])) {
         continue;
       }
       curr_speed_limit =
@@ -461,8 +498,7 @@ void GriddedPathTimeGraph::CalculateCostAt(
       continue;
     }
 
-    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
-                                pre_col[r_pre])) {
+    if (CheckOverlapOnDpStGraph(boundaries, cost_cr, pre_col[r_pre])) {
       continue;
     }
 
@@ -555,14 +591,16 @@ Status GriddedPathTimeGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
 
 double GriddedPathTimeGraph::CalculateEdgeCost(
     const STPoint& first, const STPoint& second, const STPoint& third,
-    const STPoint& forth, const double speed_limit, const double cruise_speed) {
+    const STPoint& forth, const double speed_limit,
+    const double cruise_speed) const {
   return dp_st_cost_.GetSpeedCost(third, forth, speed_limit, cruise_speed) +
          dp_st_cost_.GetAccelCostByThreePoints(second, third, forth) +
          dp_st_cost_.GetJerkCostByFourPoints(first, second, third, forth);
 }
 
 double GriddedPathTimeGraph::CalculateEdgeCostForSecondCol(
-    const uint32_t row, const double speed_limit, const double cruise_speed) {
+    const uint32_t row, const double speed_limit,
+    const double cruise_speed) const {
   double init_speed = init_point_.v();
   double init_acc = init_point_.a();
   const STPoint& pre_point = cost_table_[0][0].point();
@@ -577,7 +615,7 @@ double GriddedPathTimeGraph::CalculateEdgeCostForSecondCol(
 
 double GriddedPathTimeGraph::CalculateEdgeCostForThirdCol(
     const uint32_t curr_row, const uint32_t pre_row, const double speed_limit,
-    const double cruise_speed) {
+    const double cruise_speed) const {
   double init_speed = init_point_.v();
   const STPoint& first = cost_table_[0][0].point();
   const STPoint& second = cost_table_[1][pre_row].point();
@@ -20,7 +20,6 @@
 
 #pragma once
 
-#include <memory>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
@@ -58,24 +57,28 @@ class GriddedPathTimeGraph {
 
   common::Status CalculateTotalCost();
 
-  // defined for cyber task
-  struct StGraphMessage {
-    StGraphMessage(const uint32_t c_, const int32_t r_) : c(c_), r(r_) {}
-    uint32_t c;
-    uint32_t r;
-  };
-  void CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg);
+  // Computes the costs of the rows [row_begin, row_end) of column c, whose
+  // obstacles are sliced, with the boundaries which may overlap the edges
+  // from column c - 1.
+  void CalculateCostInRows(const uint32_t c, const uint32_t row_begin,
+                           const uint32_t row_end,
+                           const std::vector<const STBoundary*>& boundaries);
+
+  void CalculateCostAt(const uint32_t c, const uint32_t r,
+                       const double obstacle_cost,
+                       const std::vector<const STBoundary*>& boundaries);
 
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
                            const STPoint& third, const STPoint& forth,
-                           const double speed_limit, const double cruise_speed);
+                           const double speed_limit,
+                           const double cruise_speed) const;
   double CalculateEdgeCostForSecondCol(const uint32_t row,
                                        const double speed_limit,
-                                       const double cruise_speed);
+                                       const double cruise_speed) const;
   double CalculateEdgeCostForThirdCol(const uint32_t curr_row,
                                       const uint32_t pre_row,
                                       const double speed_limit,
-                                      const double cruise_speed);
+                                      const double cruise_speed) const;
 
   // get the row-range of next time step
   void GetRowRange(const StGraphPoint& point, size_t* next_highest_row,
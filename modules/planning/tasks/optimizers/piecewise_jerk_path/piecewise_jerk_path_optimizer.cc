@@ -20,9 +20,13 @@
 
 #include "modules/planning/tasks/optimizers/piecewise_jerk_path/piecewise_jerk_path_optimizer.h"
 
+#include <algorithm>
+#include <future>
 #include <memory>
 #include <string>
+#include <unordered_set>
 
+#include "cyber/task/task.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/planning/common/planning_context.h"
@@ -39,6 +43,21 @@ using apollo::common::Status;
 using apollo::common::VehicleConfigHelper;
 using apollo::common::math::Gaussian;
 
+namespace {
+
+// The lanes of a reference line, which tell it apart from the other
+// reference lines of the frame, and from those of other routings.
+std::string ReferenceLineId(const ReferenceLineInfo& reference_line_info) {
+  std::string id;
+  for (const auto& segment : reference_line_info.Lanes()) {
+    id += segment.lane->id().id();
+    id += ",";
+  }
+  return id;
+}
+
+}  // namespace
+
 PiecewiseJerkPathOptimizer::PiecewiseJerkPathOptimizer(
     const TaskConfig& config,
     const std::shared_ptr<DependencyInjector>& injector)
@@ -83,9 +102,30 @@ common::Status PiecewiseJerkPathOptimizer::Process(
   const auto& path_boundaries =
       reference_line_info_->GetCandidatePathBoundaries();
   ADEBUG << "There are " << path_boundaries.size() << " path boundaries.";
-  const auto& reference_path_data = reference_line_info_->path_data();
 
-  std::vector<PathData> candidate_path_data;
+  const common::math::Vec2d start_point(planning_start_point.path_point().x(),
+                                        planning_start_point.path_point().y());
+
+  // Release the workspaces of the reference lines which are gone.
+  std::unordered_set<std::string> reference_line_ids;
+  for (const auto& info : frame_->reference_line_info()) {
+    reference_line_ids.insert(ReferenceLineId(info));
+  }
+  for (auto iter = path_solvers_.begin(); iter != path_solvers_.end();) {
+    if (reference_line_ids.count(iter->second.reference_line_id) == 0) {
+      iter = path_solvers_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  const std::string reference_line_id =
+      ReferenceLineId(*reference_line_info_);
+
+  // Pick the solver of each candidate path boundary first, so that the
+  // candidates, which share nothing else, are optimized concurrently.
+  std::vector<const PathBoundary*> candidate_path_boundaries;
+  std::vector<PiecewiseJerkSolver*> candidate_solvers;
+  std::vector<double> warm_start_shifts;
   for (const auto& path_boundary : path_boundaries) {
     size_t path_boundary_size = path_boundary.boundary().size();
 
@@ -96,102 +136,55 @@ common::Status PiecewiseJerkPathOptimizer::Process(
       continue;
     }
 
-    int max_iter = 4000;
-    // lower max_iter for regular/self/
-    if (path_boundary.label().find("self") != std::string::npos) {
-      max_iter = 4000;
-    }
-
     CHECK_GT(path_boundary_size, 1U);
 
-    std::vector<double> opt_l;
-    std::vector<double> opt_dl;
-    std::vector<double> opt_ddl;
-
-    std::array<double, 3> end_state = {0.0, 0.0, 0.0};
-
-    if (!FLAGS_enable_force_pull_over_open_space_parking_test) {
-      // pull over scenario
-      // set end lateral to be at the desired pull over destination
-      const auto& pull_over_status =
-          injector_->planning_context()->planning_status().pull_over();
-      if (pull_over_status.has_position() &&
-          pull_over_status.position().has_x() &&
-          pull_over_status.position().has_y() &&
-          path_boundary.label().find("pullover") != std::string::npos) {
-        common::SLPoint pull_over_sl;
-        reference_line.XYToSL(pull_over_status.position(), &pull_over_sl);
-        end_state[0] = pull_over_sl.l();
-      }
-    }
-
-    // TODO(all): double-check this;
-    // final_path_data might carry info from upper stream
-    PathData path_data = *final_path_data;
-
-    // updated cost function for path reference
-    std::vector<double> path_reference_l(path_boundary_size, 0.0);
-    bool is_valid_path_reference = false;
-    size_t path_reference_size = reference_path_data.path_reference().size();
-
-    if (path_boundary.label().find("regular") != std::string::npos &&
-        reference_path_data.is_valid_path_reference()) {
-      ADEBUG << "path label is: " << path_boundary.label();
-      // when path reference is ready
-      for (size_t i = 0; i < path_reference_size; ++i) {
-        common::SLPoint path_reference_sl;
-        reference_line.XYToSL(
-            common::util::PointFactory::ToPointENU(
-                reference_path_data.path_reference().at(i).x(),
-                reference_path_data.path_reference().at(i).y()),
-            &path_reference_sl);
-        path_reference_l[i] = path_reference_sl.l();
-      }
-      end_state[0] = path_reference_l.back();
-      path_data.set_is_optimized_towards_trajectory_reference(true);
-      is_valid_path_reference = true;
+    // The reference line is built again each cycle, so that the distance
+    // driven tells how far the path moved better than s.
+    std::string solver_key = reference_line_id +
+                             (reference_line_info_->IsChangeLanePath()
+                                  ? "lane_change/"
+                                  : "lane_keeping/") +
+                             path_boundary.label();
+    // Each candidate needs a workspace of its own, even if labels repeat.
+    while (std::find(candidate_solvers.begin(), candidate_solvers.end(),
+                     &path_solvers_[solver_key].solver) !=
+           candidate_solvers.end()) {
+      solver_key += "+";
     }
+    auto& path_solver = path_solvers_[solver_key];
+    path_solver.reference_line_id = reference_line_id;
+    warm_start_shifts.push_back(
+        start_point.DistanceTo(path_solver.last_start_point) /
+        path_boundary.delta_s());
+    path_solver.last_start_point = start_point;
+    candidate_path_boundaries.push_back(&path_boundary);
+    candidate_solvers.push_back(&path_solver.solver);
+  }
 
-    const auto& veh_param =
-        common::VehicleConfigHelper::GetConfig().vehicle_param();
-    const double lat_acc_bound =
-        std::tan(veh_param.max_steer_angle() / veh_param.steer_ratio()) /
-        veh_param.wheel_base();
-    std::vector<std::pair<double, double>> ddl_bounds;
-    for (size_t i = 0; i < path_boundary_size; ++i) {
-      double s = static_cast<double>(i) * path_boundary.delta_s() +
-                 path_boundary.start_s();
-      double kappa = reference_line.GetNearestReferencePoint(s).kappa();
-      ddl_bounds.emplace_back(-lat_acc_bound - kappa, lat_acc_bound - kappa);
-    }
+  // TODO(all): double-check this;
+  // final_path_data might carry info from upper stream
+  const size_t num_candidates = candidate_path_boundaries.size();
+  std::vector<PathData> candidate_results(num_candidates, *final_path_data);
+  const std::vector<bool> candidate_succeeded = OptimizeCandidatePaths(
+      reference_line, init_frenet_state.second, w, candidate_path_boundaries,
+      warm_start_shifts, candidate_solvers, &candidate_results);
 
-    bool res_opt = OptimizePath(
-        init_frenet_state.second, end_state, std::move(path_reference_l),
-        path_reference_size, path_boundary.delta_s(), is_valid_path_reference,
-        path_boundary.boundary(), ddl_bounds, w, max_iter, &opt_l, &opt_dl,
-        &opt_ddl);
-
-    if (res_opt) {
-      for (size_t i = 0; i < path_boundary_size; i += 4) {
-        ADEBUG << "for s[" << static_cast<double>(i) * path_boundary.delta_s()
-               << "], l = " << opt_l[i] << ", dl = " << opt_dl[i];
-      }
-      auto frenet_frame_path =
-          ToPiecewiseJerkPath(opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
-                              path_boundary.start_s());
-
-      path_data.SetReferenceLine(&reference_line);
-      path_data.SetFrenetPath(std::move(frenet_frame_path));
-      if (FLAGS_use_front_axe_center_in_path_planning) {
-        auto discretized_path = DiscretizedPath(
-            ConvertPathPointRefFromFrontAxeToRearAxe(path_data));
-        path_data.SetDiscretizedPath(discretized_path);
-      }
-      path_data.set_path_label(path_boundary.label());
-      path_data.set_blocking_obstacle_id(path_boundary.blocking_obstacle_id());
-      candidate_path_data.push_back(std::move(path_data));
+  // Keep the paths in the order of their boundaries.
+  double solver_time_ms = 0.0;
+  std::vector<PathData> candidate_path_data;
+  for (size_t i = 0; i < num_candidates; ++i) {
+    const auto& solver = *candidate_solvers[i];
+    solver_time_ms += solver.last_setup_time_ms() + solver.last_solve_time_ms();
+    if (candidate_succeeded[i]) {
+      candidate_path_data.push_back(std::move(candidate_results[i]));
     }
   }
+  if (FLAGS_enable_record_debug) {
+    auto* ptr_stats =
+        reference_line_info_->mutable_latency_stats()->add_task_stats();
+    ptr_stats->set_name(Name() + "_osqp");
+    ptr_stats->set_time_ms(solver_time_ms);
+  }
   if (candidate_path_data.empty()) {
     return Status(ErrorCode::PLANNING_ERROR,
                   "Path Optimizer failed to generate path");
@@ -200,6 +193,137 @@ common::Status PiecewiseJerkPathOptimizer::Process(
   return Status::OK();
 }
 
+std::vector<bool> PiecewiseJerkPathOptimizer::OptimizeCandidatePaths(
+    const ReferenceLine& reference_line,
+    const std::array<double, 3>& init_state, const std::array<double, 5>& w,
+    const std::vector<const PathBoundary*>& path_boundaries,
+    const std::vector<double>& warm_start_shifts,
+    const std::vector<PiecewiseJerkSolver*>& solvers,
+    std::vector<PathData>* const path_data) {
+  const size_t num_candidates = path_boundaries.size();
+  std::vector<bool> succeeded(num_candidates, false);
+  if (FLAGS_enable_multi_thread_in_path_planning && num_candidates > 1) {
+    std::vector<std::future<bool>> results;
+    for (size_t i = 0; i < num_candidates; ++i) {
+      results.push_back(cyber::Async([&, i]() {
+        return OptimizeCandidatePath(reference_line, init_state, w,
+                                     *path_boundaries[i], warm_start_shifts[i],
+                                     solvers[i], &path_data->at(i));
+      }));
+    }
+    for (size_t i = 0; i < num_candidates; ++i) {
+      succeeded[i] = results[i].get();
+    }
+  } else {
+    for (size_t i = 0; i < num_candidates; ++i) {
+      succeeded[i] = OptimizeCandidatePath(
+          reference_line, init_state, w, *path_boundaries[i],
+          warm_start_shifts[i], solvers[i], &path_data->at(i));
+    }
+  }
+  return succeeded;
+}
+
+bool PiecewiseJerkPathOptimizer::OptimizeCandidatePath(
+    const ReferenceLine& reference_line,
+    const std::array<double, 3>& init_state, const std::array<double, 5>& w,
+    const PathBoundary& path_boundary, const double warm_start_shift,
+    PiecewiseJerkSolver* const solver, PathData* const path_data) {
+  size_t path_boundary_size = path_boundary.boundary().size();
+
+  int max_iter = 4000;
+  // lower max_iter for regular/self/
+  if (path_boundary.label().find("self") != std::string::npos) {
+    max_iter = 4000;
+  }
+
+  std::vector<double> opt_l;
+  std::vector<double> opt_dl;
+  std::vector<double> opt_ddl;
+
+  std::array<double, 3> end_state = {0.0, 0.0, 0.0};
+
+  if (!FLAGS_enable_force_pull_over_open_space_parking_test) {
+    // pull over scenario
+    // set end lateral to be at the desired pull over destination
+    const auto& pull_over_status =
+        injector_->planning_context()->planning_status().pull_over();
+    if (pull_over_status.has_position() &&
+        pull_over_status.position().has_x() &&
+        pull_over_status.position().has_y() &&
+        path_boundary.label().find("pullover") != std::string::npos) {
+      common::SLPoint pull_over_sl;
+      reference_line.XYToSL(pull_over_status.position(), &pull_over_sl);
+      end_state[0] = pull_over_sl.l();
+    }
+  }
+
+  // updated cost function for path reference
+  const auto& reference_path_data = reference_line_info_->path_data();
+  std::vector<double> path_reference_l(path_boundary_size, 0.0);
+  bool is_valid_path_reference = false;
+  size_t path_reference_size = reference_path_data.path_reference().size();
+
+  if (path_boundary.label().find("regular") != std::string::npos &&
+      reference_path_data.is_valid_path_reference()) {
+    ADEBUG << "path label is: " << path_boundary.label();
+    // when path reference is ready
+    for (size_t i = 0; i < path_reference_size; ++i) {
+      common::SLPoint path_reference_sl;
+      reference_line.XYToSL(
+          common::util::PointFactory::ToPointENU(
+              reference_path_data.path_reference().at(i).x(),
+              reference_path_data.path_reference().at(i).y()),
+          &path_reference_sl);
+      path_reference_l[i] = path_reference_sl.l();
+    }
+    end_state[0] = path_reference_l.back();
+    path_data->set_is_optimized_towards_trajectory_reference(true);
+    is_valid_path_reference = true;
+  }
+
+  const auto& veh_param =
+      common::VehicleConfigHelper::GetConfig().vehicle_param();
+  const double lat_acc_bound =
+      std::tan(veh_param.max_steer_angle() / veh_param.steer_ratio()) /
+      veh_param.wheel_base();
+  std::vector<std::pair<double, double>> ddl_bounds;
+  for (size_t i = 0; i < path_boundary_size; ++i) {
+    double s = static_cast<double>(i) * path_boundary.delta_s() +
+               path_boundary.start_s();
+    double kappa = reference_line.GetNearestReferencePoint(s).kappa();
+    ddl_bounds.emplace_back(-lat_acc_bound - kappa, lat_acc_bound - kappa);
+  }
+
+  bool res_opt = OptimizePath(
+      init_state, end_state, std::move(path_reference_l), path_reference_size,
+      path_boundary.delta_s(), is_valid_path_reference,
+      path_boundary.boundary(), ddl_bounds, w, max_iter, solver,
+      warm_start_shift, &opt_l, &opt_dl, &opt_ddl);
+  if (!res_opt) {
+    return false;
+  }
+
+  for (size_t i = 0; i < path_boundary_size; i += 4) {
+    ADEBUG << "for s[" << static_cast<double>(i) * path_boundary.delta_s()
+           << "], l = " << opt_l[i] << ", dl = " << opt_dl[i];
+  }
+  auto frenet_frame_path =
+      ToPiecewiseJerkPath(opt_l, opt_dl, opt_ddl, path_boundary.delta_s(),
+                          path_boundary.start_s());
+
+  path_data->SetReferenceLine(&reference_line);
+  path_data->SetFrenetPath(std::move(frenet_frame_path));
+  if (FLAGS_use_front_axe_center_in_path_planning) {
+    auto discretized_path =
+        DiscretizedPath(ConvertPathPointRefFromFrontAxeToRearAxe(*path_data));
+    path_data->SetDiscretizedPath(discretized_path);
+  }
+  path_data->set_path_label(path_boundary.label());
+  path_data->set_blocking_obstacle_id(path_boundary.blocking_obstacle_id());
+  return true;
+}
+
 common::TrajectoryPoint
 PiecewiseJerkPathOptimizer::InferFrontAxeCenterFromRearAxeCenter(
     const common::TrajectoryPoint& traj_point) {
@@ -239,8 +363,10 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
     const double delta_s, const bool is_valid_path_reference,
     const std::vector<std::pair<double, double>>& lat_boundaries,
     const std::vector<std::pair<double, double>>& ddl_bounds,
-    const std::array<double, 5>& w, const int max_iter, std::vector<double>* x,
-    std::vector<double>* dx, std::vector<double>* ddx) {
+    const std::array<double, 5>& w, const int max_iter,
+    PiecewiseJerkSolver* const solver, const double warm_start_shift,
+    std::vector<double>* x, std::vector<double>* dx,
+    std::vector<double>* ddx) {
   // num of knots
   const size_t kNumKnots = lat_boundaries.size();
   PiecewiseJerkPathProblem piecewise_jerk_problem(kNumKnots, delta_s,
@@ -307,7 +433,8 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
                                                  axis_distance, max_yaw_rate);
   piecewise_jerk_problem.set_dddx_bound(jerk_bound);
 
-  bool success = piecewise_jerk_problem.Optimize(max_iter);
+  bool success =
+      piecewise_jerk_problem.Optimize(max_iter, solver, warm_start_shift);
 
   auto end_time = std::chrono::system_clock::now();
   std::chrono::duration<double> diff = end_time - start_time;
@@ -21,9 +21,15 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "gtest/gtest_prod.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/common/path_boundary.h"
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_solver.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -50,6 +56,50 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
   std::vector<common::PathPoint> ConvertPathPointRefFromFrontAxeToRearAxe(
       const PathData& path_data);
 
+  /**
+   * @brief Optimizes the paths within the candidate path boundaries,
+   * concurrently if FLAGS_enable_multi_thread_in_path_planning is set.
+   *
+   * @param reference_line: the reference line of the paths
+   * @param init_state: lateral state of the path start point
+   * @param w: weighting scales
+   * @param path_boundaries: the candidate path boundaries
+   * @param warm_start_shifts: the knots the path start moved since the last
+   * solution of each solver
+   * @param solvers: the solver of each candidate, distinct from each other
+   * @param path_data: the path data of each candidate, to complete with its
+   * optimized path
+   * @return whether the optimization of each candidate succeeds
+   */
+  std::vector<bool> OptimizeCandidatePaths(
+      const ReferenceLine& reference_line,
+      const std::array<double, 3>& init_state, const std::array<double, 5>& w,
+      const std::vector<const PathBoundary*>& path_boundaries,
+      const std::vector<double>& warm_start_shifts,
+      const std::vector<PiecewiseJerkSolver*>& solvers,
+      std::vector<PathData>* const path_data);
+
+  /**
+   * @brief Optimizes the path within a candidate path boundary.
+   *
+   * @param reference_line: the reference line of the path
+   * @param init_state: lateral state of the path start point
+   * @param w: weighting scales
+   * @param path_boundary: the candidate path boundary
+   * @param warm_start_shift: the knots the path start moved since the last
+   * solution of the solver
+   * @param solver: the solver kept for the path boundary
+   * @param path_data: the path data to complete with the optimized path
+   * @return whether the optimization succeeds
+   */
+  bool OptimizeCandidatePath(const ReferenceLine& reference_line,
+                             const std::array<double, 3>& init_state,
+                             const std::array<double, 5>& w,
+                             const PathBoundary& path_boundary,
+                             const double warm_start_shift,
+                             PiecewiseJerkSolver* const solver,
+                             PathData* const path_data);
+
   /**
    * @brief
    *
@@ -63,6 +113,9 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
    * @param ddl_bounds: constains
    * @param w: weighting scales
    * @param max_iter: optimization max interations
+   * @param solver: the solver kept for the path boundary
+   * @param warm_start_shift: the knots the path start moved since the last
+   * solution of the solver
    * @param ptr_x: optimization result of x
    * @param ptr_dx: optimization result of dx
    * @param ptr_ddx: optimization result of ddx
@@ -78,6 +131,7 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
       const std::vector<std::pair<double, double>>& lat_boundaries,
       const std::vector<std::pair<double, double>>& ddl_bounds,
       const std::array<double, 5>& w, const int max_iter,
+      PiecewiseJerkSolver* const solver, const double warm_start_shift,
       std::vector<double>* ptr_x, std::vector<double>* ptr_dx,
       std::vector<double>* ptr_ddx);
 
@@ -93,6 +147,19 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
 
   double GaussianWeighting(const double x, const double peak_weighting,
                            const double peak_weighting_x) const;
+
+ private:
+  FRIEND_TEST(PiecewiseJerkPathOptimizerTest, ParallelMatchesSerial);
+
+  struct PathSolver {
+    PiecewiseJerkSolver solver;
+    common::math::Vec2d last_start_point;
+    std::string reference_line_id;
+  };
+  // The OSQP workspaces kept across planning cycles, one for each label of
+  // path boundary on each reference line, told apart by its lanes. They are
+  // released once no reference line of the frame is over their lanes.
+  std::unordered_map<std::string, PathSolver> path_solvers_;
 };
 
 }  // namespace planning
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/tasks/optimizers/piecewise_jerk_path/piecewise_jerk_path_optimizer.h"
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/proto/planning_config.pb.h"
+
+namespace apollo {
+namespace planning {
+
+class PiecewiseJerkPathOptimizerTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    config_.set_task_type(TaskConfig::PIECEWISE_JERK_PATH_OPTIMIZER);
+    config_.mutable_piecewise_jerk_path_optimizer_config();
+    injector_ = std::make_shared<DependencyInjector>();
+
+    common::VehicleConfig vehicle_config;
+    auto* vehicle_param = vehicle_config.mutable_vehicle_param();
+    vehicle_param->set_wheel_base(2.8448);
+    vehicle_param->set_max_steer_angle(8.20304748437);
+    vehicle_param->set_max_steer_angle_rate(6.98131700798);
+    vehicle_param->set_steer_ratio(16.0);
+    common::VehicleConfigHelper::Init(vehicle_config);
+
+    // A straight reference line along x.
+    std::vector<ReferencePoint> ref_points;
+    for (int i = 0; i <= 100; ++i) {
+      const hdmap::MapPathPoint map_path_point(
+          common::math::Vec2d(static_cast<double>(i), 0.0), 0.0);
+      ref_points.emplace_back(map_path_point, 0.0, 0.0);
+    }
+    reference_line_.reset(new ReferenceLine(ref_points));
+  }
+
+  virtual void TearDown() {
+    FLAGS_enable_multi_thread_in_path_planning = false;
+  }
+
+ protected:
+  TaskConfig config_;
+  std::shared_ptr<DependencyInjector> injector_;
+  std::unique_ptr<ReferenceLine> reference_line_;
+};
+
+TEST_F(PiecewiseJerkPathOptimizerTest, ParallelMatchesSerial) {
+  PiecewiseJerkPathOptimizer optimizer(config_, injector_);
+  ReferenceLineInfo reference_line_info;
+  optimizer.reference_line_info_ = &reference_line_info;
+
+  // Candidates as the path bounds decider makes them: the lane, and the
+  // lane with a side borrowed, around an obstacle on the right.
+  const double delta_s = 0.5;
+  const std::vector<std::pair<std::string, std::pair<double, double>>>
+      candidates = {{"regular/self", {-1.5, 1.5}},
+                    {"regular/left/forward", {-1.5, 4.5}},
+                    {"regular/right/forward", {-4.5, 1.5}}};
+  std::vector<PathBoundary> path_boundaries;
+  for (const auto& candidate : candidates) {
+    std::vector<std::pair<double, double>> boundary(120, candidate.second);
+    for (size_t i = 40; i < 60; ++i) {
+      boundary[i].first = std::fmax(boundary[i].first, -0.5);
+    }
+    path_boundaries.emplace_back(0.0, delta_s, boundary);
+    path_boundaries.back().set_label(candidate.first);
+  }
+  std::vector<const PathBoundary*> candidate_path_boundaries;
+  for (const auto& path_boundary : path_boundaries) {
+    candidate_path_boundaries.push_back(&path_boundary);
+  }
+  const std::vector<double> warm_start_shifts(path_boundaries.size(), 0.0);
+  const std::array<double, 3> init_state = {0.3, 0.1, 0.0};
+  const std::array<double, 5> w = {1.0, 100.0, 1000.0, 50000.0, 0.0};
+
+  const auto optimize = [&](const bool multi_thread,
+                            std::vector<PathData>* const path_data) {
+    FLAGS_enable_multi_thread_in_path_planning = multi_thread;
+    std::vector<PiecewiseJerkSolver> solvers(path_boundaries.size());
+    std::vector<PiecewiseJerkSolver*> candidate_solvers;
+    for (auto& solver : solvers) {
+      candidate_solvers.push_back(&solver);
+    }
+    path_data->assign(path_boundaries.size(), PathData());
+    return optimizer.OptimizeCandidatePaths(
+        *reference_line_, init_state, w, candidate_path_boundaries,
+        warm_start_shifts, candidate_solvers, path_data);
+  };
+
+  std::vector<PathData> serial_path_data;
+  const std::vector<bool> serial_succeeded =
+      optimize(false, &serial_path_data);
+  std::vector<PathData> parallel_path_data;
+  const std::vector<bool> parallel_succeeded =
+      optimize(true, &parallel_path_data);
+
+  ASSERT_EQ(serial_succeeded, parallel_succeeded);
+  for (size_t i = 0; i < path_boundaries.size(); ++i) {
+    EXPECT_TRUE(serial_succeeded[i]);
+    EXPECT_EQ(serial_path_data[i].path_label(),
+              parallel_path_data[i].path_label());
+    const auto& serial_path = serial_path_data[i].frenet_frame_path();
+    const auto& parallel_path = parallel_path_data[i].frenet_frame_path();
+    ASSERT_EQ(serial_path.size(), parallel_path.size());
+    for (size_t j = 0; j < serial_path.size(); ++j) {
+      EXPECT_DOUBLE_EQ(serial_path[j].s(), parallel_path[j].s());
+      EXPECT_DOUBLE_EQ(serial_path[j].l(), parallel_path[j].l());
+      EXPECT_DOUBLE_EQ(serial_path[j].dl(), parallel_path[j].dl());
+    }
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "cyber/time/clock.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -39,6 +40,7 @@ using apollo::common::PathPoint;
 using apollo::common::SpeedPoint;
 using apollo::common::Status;
 using apollo::common::TrajectoryPoint;
+using apollo::cyber::Clock;
 
 PiecewiseJerkSpeedOptimizer::PiecewiseJerkSpeedOptimizer(
     const TaskConfig& config)
@@ -157,8 +159,25 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   piecewise_jerk_problem.set_penalty_dx(penalty_dx);
   piecewise_jerk_problem.set_dx_bounds(std::move(s_dot_bounds));
 
-  // Solve the problem
-  if (!piecewise_jerk_problem.Optimize()) {
+  // Solve the problem, starting from the last solution moved by the time
+  // passed since.
+  auto& speed_solver =
+      speed_solvers_[reference_line_info_->IsChangeLanePath() ? 1 : 0];
+  const double now = Clock::NowInSeconds();
+  const double warm_start_shift =
+      (now - speed_solver.last_solve_time) / delta_t;
+  speed_solver.last_solve_time = now;
+  constexpr int kMaxIter = 4000;
+  const bool success = piecewise_jerk_problem.Optimize(
+      kMaxIter, &speed_solver.solver, warm_start_shift);
+  if (FLAGS_enable_record_debug) {
+    auto* ptr_stats =
+        reference_line_info_->mutable_latency_stats()->add_task_stats();
+    ptr_stats->set_name(Name() + "_osqp");
+    ptr_stats->set_time_ms(speed_solver.solver.last_setup_time_ms() +
+                           speed_solver.solver.last_solve_time_ms());
+  }
+  if (!success) {
     const std::string msg = "Piecewise jerk speed optimizer failed!";
     AERROR << msg;
     speed_data->clear();
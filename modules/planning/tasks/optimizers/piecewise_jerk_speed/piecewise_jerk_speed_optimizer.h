@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <array>
+
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_solver.h"
 #include "modules/planning/tasks/optimizers/speed_optimizer.h"
 
 namespace apollo {
@@ -35,6 +38,14 @@ class PiecewiseJerkSpeedOptimizer : public SpeedOptimizer {
   common::Status Process(const PathData& path_data,
                          const common::TrajectoryPoint& init_point,
                          SpeedData* const speed_data) override;
+
+  struct SpeedSolver {
+    PiecewiseJerkSolver solver;
+    double last_solve_time = 0.0;
+  };
+  // The OSQP workspaces kept across planning cycles, for lane keeping and
+  // lane change reference lines.
+  std::array<SpeedSolver, 2> speed_solvers_;
 };
 
 }  // namespace planning
@@ -0,0 +1,234 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Rebuilds the ST graphs of the speed heuristic optimizer from the debug of a
+// planning record, which is recorded with --enable_record_debug, and measures
+// how long the DP searches take. Compare runs with
+// --enable_multi_thread_in_dp_st_graph on and off.
+
+#include <algorithm>
+#include <chrono>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "cyber/record/record_reader.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/speed/st_boundary.h"
+#include "modules/planning/common/speed_limit.h"
+#include "modules/planning/common/st_graph_data.h"
+#include "modules/planning/proto/decision.pb.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/tasks/optimizers/path_time_heuristic/gridded_path_time_graph.h"
+
+DEFINE_string(record_file, "",
+              "Record of the planning channel, with the debug recorded.");
+DEFINE_string(planning_config,
+              "/apollo/modules/planning/conf/planning_config.pb.txt",
+              "Planning config with the speed heuristic optimizer config.");
+DEFINE_string(st_graph_name, "SPEED_HEURISTIC_OPTIMIZER",
+              "Name of the ST graphs searched in the debug.");
+DEFINE_double(st_graph_total_time, 7.0,
+              "Total time of the ST graphs, which the debug does not record.");
+DEFINE_int32(iterations, 3, "Passes over the record.");
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+using apollo::planning_internal::STGraphDebug;
+using apollo::planning_internal::StGraphBoundaryDebug;
+
+STBoundary::BoundaryType ToBoundaryType(
+    const StGraphBoundaryDebug& boundary_debug) {
+  switch (boundary_debug.type()) {
+    case StGraphBoundaryDebug::ST_BOUNDARY_TYPE_FOLLOW:
+      return STBoundary::BoundaryType::FOLLOW;
+    case StGraphBoundaryDebug::ST_BOUNDARY_TYPE_OVERTAKE:
+      return STBoundary::BoundaryType::OVERTAKE;
+    case StGraphBoundaryDebug::ST_BOUNDARY_TYPE_STOP:
+      return STBoundary::BoundaryType::STOP;
+    case StGraphBoundaryDebug::ST_BOUNDARY_TYPE_YIELD:
+      return STBoundary::BoundaryType::YIELD;
+    case StGraphBoundaryDebug::ST_BOUNDARY_TYPE_KEEP_CLEAR:
+      return STBoundary::BoundaryType::KEEP_CLEAR;
+    default:
+      return STBoundary::BoundaryType::UNKNOWN;
+  }
+}
+
+// The obstacles of a recorded ST graph, with their ST-boundaries rebuilt from
+// the polygons of the debug, which are the lower points followed by the upper
+// points in reverse.
+std::list<Obstacle> ToObstacles(const STGraphDebug& st_graph_debug) {
+  std::list<Obstacle> obstacles;
+  for (const auto& boundary_debug : st_graph_debug.boundary()) {
+    const int num_points = boundary_debug.point_size();
+    if (num_points < 4 || num_points % 2 != 0) {
+      continue;
+    }
+    std::vector<STPoint> lower_points;
+    std::vector<STPoint> upper_points;
+    for (int i = 0; i < num_points / 2; ++i) {
+      const auto& lower = boundary_debug.point(i);
+      const auto& upper = boundary_debug.point(num_points - 1 - i);
+      lower_points.emplace_back(lower.s(), lower.t());
+      upper_points.emplace_back(upper.s(), upper.t());
+    }
+    STBoundary boundary =
+        STBoundary::CreateInstanceAccurate(lower_points, upper_points);
+    if (boundary.IsEmpty()) {
+      continue;
+    }
+    boundary.set_id(boundary_debug.name());
+    boundary.SetBoundaryType(ToBoundaryType(boundary_debug));
+
+    obstacles.emplace_back();
+    Obstacle& obstacle = obstacles.back();
+    obstacle.SetId(boundary_debug.name());
+    if (boundary.boundary_type() == STBoundary::BoundaryType::STOP) {
+      // Stop boundaries come from obstacles with a stop decision, which the
+      // obstacle cost skips.
+      ObjectDecisionType stop_decision;
+      stop_decision.mutable_stop();
+      obstacle.AddLongitudinalDecision("dp_st_graph_benchmark", stop_decision);
+    }
+    obstacle.set_path_st_boundary(boundary);
+  }
+  return obstacles;
+}
+
+// Returns the milliseconds spent in each search of a pass.
+std::vector<double> ReplayRecord(const std::string& filename,
+                                 const DpStSpeedOptimizerConfig& dp_config) {
+  std::vector<double> search_ms;
+  cyber::record::RecordReader reader(filename);
+  cyber::record::RecordMessage message;
+  while (reader.ReadMessage(&message)) {
+    if (message.channel_name != FLAGS_planning_trajectory_topic) {
+      continue;
+    }
+    ADCTrajectory trajectory;
+    if (!trajectory.ParseFromString(message.content)) {
+      continue;
+    }
+    const auto& planning_data = trajectory.debug().planning_data();
+    for (const auto& st_graph_debug : planning_data.st_graph()) {
+      if (st_graph_debug.name() != FLAGS_st_graph_name ||
+          st_graph_debug.speed_limit_size() == 0) {
+        continue;
+      }
+      const std::list<Obstacle> obstacle_list = ToObstacles(st_graph_debug);
+      std::vector<const Obstacle*> obstacles;
+      std::vector<const STBoundary*> boundaries;
+      for (const auto& obstacle : obstacle_list) {
+        obstacles.push_back(&obstacle);
+        boundaries.push_back(&obstacle.path_st_boundary());
+      }
+
+      SpeedLimit speed_limit;
+      for (const auto& point : st_graph_debug.speed_limit()) {
+        speed_limit.AppendSpeedLimit(point.s(), point.v());
+      }
+      // The speed limits are sampled along the whole path.
+      const double path_length = speed_limit.speed_limit_points().back().first;
+      double min_s_on_st_boundaries = path_length;
+      for (const auto* boundary : boundaries) {
+        min_s_on_st_boundaries =
+            std::min(min_s_on_st_boundaries, boundary->min_s());
+      }
+
+      StGraphData st_graph_data;
+      STGraphDebug unused_st_graph_debug;
+      st_graph_data.LoadData(boundaries, min_s_on_st_boundaries,
+                             planning_data.init_point(), speed_limit,
+                             FLAGS_default_cruise_speed, path_length,
+                             FLAGS_st_graph_total_time, &unused_st_graph_debug);
+
+      GriddedPathTimeGraph dp_st_graph(st_graph_data, dp_config, obstacles,
+                                       planning_data.init_point());
+      SpeedData speed_data;
+      const auto start = std::chrono::steady_clock::now();
+      const auto status = dp_st_graph.Search(&speed_data);
+      search_ms.push_back(std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - start)
+                              .count());
+      if (!status.ok()) {
+        AWARN << "Search failed at " << trajectory.header().timestamp_sec()
+              << ": " << status.error_message();
+      }
+    }
+  }
+  return search_ms;
+}
+
+}  // namespace
+
+int Run() {
+  PlanningConfig planning_config;
+  if (!cyber::common::GetProtoFromFile(FLAGS_planning_config,
+                                       &planning_config)) {
+    AERROR << "Failed to load planning config file " << FLAGS_planning_config;
+    return -1;
+  }
+  DpStSpeedOptimizerConfig dp_config;
+  for (const auto& cfg : planning_config.default_task_config()) {
+    if (cfg.task_type() == TaskConfig::SPEED_HEURISTIC_OPTIMIZER) {
+      dp_config = cfg.speed_heuristic_optimizer_config().default_speed_config();
+      break;
+    }
+  }
+
+  for (int i = 0; i < FLAGS_iterations; ++i) {
+    std::vector<double> search_ms =
+        ReplayRecord(FLAGS_record_file, dp_config);
+    if (search_ms.empty()) {
+      AERROR << "No ST graph named " << FLAGS_st_graph_name << " in "
+             << FLAGS_record_file;
+      return -1;
+    }
+    double total_ms = 0.0;
+    for (const double ms : search_ms) {
+      total_ms += ms;
+    }
+    std::sort(search_ms.begin(), search_ms.end());
+    AINFO << "Pass " << i << ": " << search_ms.size() << " searches, mean "
+          << total_ms / static_cast<double>(search_ms.size())
+          << " ms, median " << search_ms[search_ms.size() / 2]
+          << " ms, p99 " << search_ms[search_ms.size() * 99 / 100]
+          << " ms, max " << search_ms.back() << " ms";
+  }
+  return 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+  FLAGS_alsologtostderr = true;
+  return apollo::planning::Run();
+}
@@ -0,0 +1,227 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Smooths the anchor points of reference lines along the routing of the
+// sunnyvale_loop integration test, moving the window of the reference line a
+// little each cycle as the vehicle does, and measures how long the FEM pos
+// deviation smoother takes when it is created for each smoothing and when it
+// is kept across the cycles, which keeps its OSQP workspaces and starts from
+// its last solution. Compare runs with --use_sqp on and off.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/pnc_map/path.h"
+#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_smoother.h"
+#include "modules/planning/proto/reference_line_smoother_config.pb.h"
+#include "modules/routing/proto/routing.pb.h"
+
+DEFINE_string(map_file, "/apollo/modules/map/data/sunnyvale_loop/base_map.bin",
+              "Map of the routing.");
+DEFINE_string(routing_file,
+              "/apollo/modules/planning/testdata/sunnyvale_loop_test/"
+              "1_routing.pb.txt",
+              "Routing response the reference lines follow.");
+DEFINE_string(smoother_config,
+              "/apollo/modules/planning/conf/"
+              "discrete_points_smoother_config.pb.txt",
+              "Reference line smoother config with the FEM pos deviation "
+              "smoother config.");
+DEFINE_bool(use_sqp, false,
+            "Apply the curvature constraint with the SQP OSQP interface.");
+DEFINE_double(look_forward_distance, 180.0,
+              "Length of the reference line of a cycle.");
+DEFINE_double(anchor_interval, 5.0, "Distance between anchor points.");
+DEFINE_double(box_bound, 0.2, "Bound of the anchor points around the lane.");
+DEFINE_double(cycle_distance, 1.0,
+              "Distance the reference line moves each cycle.");
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+using apollo::hdmap::LaneSegment;
+using apollo::hdmap::Path;
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// The paths along the first passage of each road of the routing, split where
+// a passage does not continue the previous one.
+std::vector<Path> RoutingPaths(const hdmap::HDMap& hdmap,
+                               const routing::RoutingResponse& routing) {
+  std::vector<Path> paths;
+  std::vector<LaneSegment> segments;
+  for (const auto& road : routing.road()) {
+    if (road.passage_size() == 0) {
+      continue;
+    }
+    for (const auto& segment : road.passage(0).segment()) {
+      const auto lane = hdmap.GetLaneById(hdmap::MakeMapId(segment.id()));
+      if (lane == nullptr) {
+        AWARN << "Lane " << segment.id() << " is not in the map.";
+        continue;
+      }
+      if (!segments.empty()) {
+        const auto end =
+            segments.back().lane->GetSmoothPoint(segments.back().end_s);
+        const auto start = lane->GetSmoothPoint(segment.start_s());
+        if (std::hypot(end.x() - start.x(), end.y() - start.y()) > 0.5) {
+          paths.emplace_back(std::move(segments));
+          segments.clear();
+        }
+      }
+      segments.emplace_back(lane, segment.start_s(), segment.end_s());
+    }
+  }
+  if (!segments.empty()) {
+    paths.emplace_back(std::move(segments));
+  }
+  return paths;
+}
+
+// The anchor points of the reference line from start_s, translated to start
+// at the origin as the discrete points smoother does.
+std::vector<std::pair<double, double>> AnchorPoints(const Path& path,
+                                                    const double start_s) {
+  const int num_of_intervals = std::max(
+      2, static_cast<int>(
+             FLAGS_look_forward_distance / FLAGS_anchor_interval + 0.5));
+  const double interval =
+      FLAGS_look_forward_distance / static_cast<double>(num_of_intervals);
+  const auto origin = path.GetSmoothPoint(start_s);
+  std::vector<std::pair<double, double>> anchor_points;
+  for (int i = 0; i <= num_of_intervals; ++i) {
+    const auto point = path.GetSmoothPoint(start_s + interval * i);
+    anchor_points.emplace_back(point.x() - origin.x(), point.y() - origin.y());
+  }
+  return anchor_points;
+}
+
+void Report(const char* name, std::vector<double> times_ms) {
+  double total_ms = 0.0;
+  for (const double ms : times_ms) {
+    total_ms += ms;
+  }
+  std::sort(times_ms.begin(), times_ms.end());
+  AINFO << name << ": mean "
+        << total_ms / static_cast<double>(times_ms.size()) << " ms, median "
+        << times_ms[times_ms.size() / 2] << " ms, p99 "
+        << times_ms[times_ms.size() * 99 / 100] << " ms, max "
+        << times_ms.back() << " ms";
+}
+
+}  // namespace
+
+int Run() {
+  hdmap::HDMap hdmap;
+  if (hdmap.LoadMapFromFile(FLAGS_map_file) != 0) {
+    AERROR << "Failed to load map file " << FLAGS_map_file;
+    return -1;
+  }
+  routing::RoutingResponse routing;
+  if (!cyber::common::GetProtoFromFile(FLAGS_routing_file, &routing)) {
+    AERROR << "Failed to load routing file " << FLAGS_routing_file;
+    return -1;
+  }
+  ReferenceLineSmootherConfig smoother_config;
+  if (!cyber::common::GetProtoFromFile(FLAGS_smoother_config,
+                                       &smoother_config)) {
+    AERROR << "Failed to load smoother config file " << FLAGS_smoother_config;
+    return -1;
+  }
+  FemPosDeviationSmootherConfig config =
+      smoother_config.discrete_points().fem_pos_deviation_smoothing();
+  config.set_apply_curvature_constraint(FLAGS_use_sqp);
+  config.set_use_sqp(FLAGS_use_sqp);
+
+  FemPosDeviationSmoother kept_smoother(config);
+  std::vector<double> created_ms;
+  std::vector<double> kept_ms;
+  double max_difference = 0.0;
+  int num_of_failures = 0;
+  for (const Path& path : RoutingPaths(hdmap, routing)) {
+    for (double start_s = 0.0;
+         start_s + FLAGS_look_forward_distance <= path.length();
+         start_s += FLAGS_cycle_distance) {
+      const auto anchor_points = AnchorPoints(path, start_s);
+      std::vector<double> bounds(anchor_points.size(), FLAGS_box_bound);
+      bounds.front() = 0.0;
+      bounds.back() = 0.0;
+
+      std::vector<double> created_x;
+      std::vector<double> created_y;
+      auto start = std::chrono::steady_clock::now();
+      FemPosDeviationSmoother created_smoother(config);
+      const bool created_solved = created_smoother.Solve(
+          anchor_points, bounds, &created_x, &created_y);
+      created_ms.push_back(MillisecondsSince(start));
+
+      std::vector<double> kept_x;
+      std::vector<double> kept_y;
+      start = std::chrono::steady_clock::now();
+      const bool kept_solved =
+          kept_smoother.Solve(anchor_points, bounds, &kept_x, &kept_y);
+      kept_ms.push_back(MillisecondsSince(start));
+
+      if (!created_solved || !kept_solved) {
+        ++num_of_failures;
+        continue;
+      }
+      for (size_t i = 0; i < kept_x.size(); ++i) {
+        max_difference =
+            std::max(max_difference, std::hypot(kept_x[i] - created_x[i],
+                                                kept_y[i] - created_y[i]));
+      }
+    }
+  }
+  if (created_ms.empty()) {
+    AERROR << "No reference line of " << FLAGS_look_forward_distance
+           << " m along the routing.";
+    return -1;
+  }
+  AINFO << created_ms.size() << " smoothings, " << num_of_failures
+        << " failed";
+  Report("Smoother created each cycle", created_ms);
+  Report("Smoother kept across cycles", kept_ms);
+  AINFO << "Max distance between their points: " << max_difference << " m";
+  return 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+  FLAGS_alsologtostderr = true;
+  return apollo::planning::Run();
+}
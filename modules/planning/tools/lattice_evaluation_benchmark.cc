@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Evaluates bundles of 1d trajectories like the ones of the lattice planner on
+// a straight reference line without obstacles, and measures how long building
+// the evaluator and taking the top pairs from it take. Compare runs with
+// --enable_multi_thread_in_lattice_evaluation on and off.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "modules/common/proto/pnc_point.pb.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/lattice/behavior/path_time_graph.h"
+#include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
+#include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+#include "modules/planning/proto/lattice_structure.pb.h"
+
+DEFINE_int32(iterations, 100, "Evaluations to measure.");
+DEFINE_int32(num_top_pairs, 10,
+             "Pairs taken from each evaluation, as the planner does until a "
+             "pair is collision free.");
+DEFINE_double(init_speed, 10.0, "Initial longitudinal speed.");
+DEFINE_double(init_offset, 0.5, "Initial lateral offset.");
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+using apollo::common::PathPoint;
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+std::vector<PathPoint> StraightReferenceLine(const double length) {
+  std::vector<PathPoint> reference_line;
+  for (double s = 0.0; s <= length; s += FLAGS_trajectory_space_resolution) {
+    PathPoint point;
+    point.set_x(s);
+    point.set_y(0.0);
+    point.set_s(s);
+    point.set_theta(0.0);
+    point.set_kappa(0.0);
+    point.set_dkappa(0.0);
+    reference_line.push_back(point);
+  }
+  return reference_line;
+}
+
+// Cruising trajectories to sampled speeds at sampled times, as the end
+// condition sampler gives them.
+std::vector<std::shared_ptr<Curve1d>> LonTrajectories(
+    const std::array<double, 3>& init_s) {
+  std::vector<std::shared_ptr<Curve1d>> lon_trajectories;
+  for (double t = 1.0; t <= FLAGS_trajectory_time_length; t += 1.0) {
+    for (double v = 0.0; v <= 2.0 * FLAGS_init_speed;
+         v += 0.1 * FLAGS_init_speed) {
+      auto curve = std::make_shared<QuarticPolynomialCurve1d>(
+          init_s, std::array<double, 2>{v, 0.0}, t);
+      lon_trajectories.push_back(std::make_shared<LatticeTrajectory1d>(curve));
+    }
+  }
+  return lon_trajectories;
+}
+
+std::vector<std::shared_ptr<Curve1d>> LatTrajectories(
+    const std::array<double, 3>& init_d) {
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories;
+  for (const double s : {10.0, 20.0, 40.0, 80.0}) {
+    for (const double d : {-0.5, 0.0, 0.5}) {
+      auto curve = std::make_shared<QuinticPolynomialCurve1d>(
+          init_d, std::array<double, 3>{d, 0.0, 0.0}, s);
+      lat_trajectories.push_back(std::make_shared<LatticeTrajectory1d>(curve));
+    }
+  }
+  return lat_trajectories;
+}
+
+void Report(const char* name, std::vector<double> times_ms) {
+  double total_ms = 0.0;
+  for (const double ms : times_ms) {
+    total_ms += ms;
+  }
+  std::sort(times_ms.begin(), times_ms.end());
+  AINFO << name << ": mean "
+        << total_ms / static_cast<double>(times_ms.size()) << " ms, median "
+        << times_ms[times_ms.size() / 2] << " ms, p99 "
+        << times_ms[times_ms.size() * 99 / 100] << " ms, max "
+        << times_ms.back() << " ms";
+}
+
+}  // namespace
+
+int Run() {
+  const std::array<double, 3> init_s = {0.0, FLAGS_init_speed, 0.0};
+  const std::array<double, 3> init_d = {FLAGS_init_offset, 0.0, 0.0};
+  auto reference_line = std::make_shared<std::vector<PathPoint>>(
+      StraightReferenceLine(3.0 * FLAGS_speed_lon_decision_horizon));
+  auto path_time_graph = std::make_shared<PathTimeGraph>(
+      std::vector<const Obstacle*>(), *reference_line, nullptr, init_s[0],
+      init_s[0] + FLAGS_speed_lon_decision_horizon, 0.0,
+      FLAGS_trajectory_time_length, init_d);
+
+  PlanningTarget planning_target;
+  planning_target.set_cruise_speed(FLAGS_init_speed);
+
+  const auto lon_trajectories = LonTrajectories(init_s);
+  const auto lat_trajectories = LatTrajectories(init_d);
+  AINFO << lon_trajectories.size() << " lon. and " << lat_trajectories.size()
+        << " lat. trajectories";
+
+  std::vector<double> construction_ms;
+  std::vector<double> top_pairs_ms;
+  for (int i = 0; i < FLAGS_iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    TrajectoryEvaluator trajectory_evaluator(
+        init_s, planning_target, lon_trajectories, lat_trajectories,
+        path_time_graph, reference_line);
+    construction_ms.push_back(MillisecondsSince(start));
+
+    start = std::chrono::steady_clock::now();
+    for (int j = 0; j < FLAGS_num_top_pairs &&
+                    trajectory_evaluator.has_more_trajectory_pairs();
+         ++j) {
+      trajectory_evaluator.top_trajectory_pair_cost();
+      trajectory_evaluator.next_top_trajectory_pair();
+    }
+    top_pairs_ms.push_back(MillisecondsSince(start));
+  }
+  if (construction_ms.empty()) {
+    AERROR << "No evaluation measured.";
+    return -1;
+  }
+  Report("Construction", construction_ms);
+  Report("Top pairs", top_pairs_ms);
+  return 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::cyber::Init(argv[0]);
+  FLAGS_alsologtostderr = true;
+  return apollo::planning::Run();
+}
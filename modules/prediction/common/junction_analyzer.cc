@@ -45,7 +45,7 @@ void JunctionAnalyzer::Clear() {
   // Clear all data
   junction_info_ptr_ = nullptr;
   junction_exits_.clear();
-  junction_features_.clear();
+  junction_features_.Clear();
 }
 
 void JunctionAnalyzer::SetAllJunctionExits() {
@@ -116,24 +116,23 @@ std::vector<JunctionExit> JunctionAnalyzer::GetJunctionExits(
   return junction_exits;
 }
 
-const JunctionFeature& JunctionAnalyzer::GetJunctionFeature(
+JunctionFeature JunctionAnalyzer::GetJunctionFeature(
     const std::string& start_lane_id) {
-  if (junction_features_.find(start_lane_id) != junction_features_.end()) {
-    return junction_features_[start_lane_id];
-  }
-  JunctionFeature junction_feature;
-  junction_feature.set_junction_id(GetJunctionId());
-  junction_feature.set_junction_range(ComputeJunctionRange());
-  // Find all junction-exit-lanes that are successors of the start_lane_id.
-  std::vector<JunctionExit> junction_exits = GetJunctionExits(start_lane_id);
-
-  for (const auto& junction_exit : junction_exits) {
-    junction_feature.add_junction_exit()->CopyFrom(junction_exit);
-  }
-  junction_feature.mutable_enter_lane()->set_lane_id(start_lane_id);
-  junction_feature.add_start_lane_id(start_lane_id);
-  junction_features_[start_lane_id] = junction_feature;
-  return junction_features_[start_lane_id];
+  return junction_features_.GetOrCompute(start_lane_id, [&]() {
+    JunctionFeature junction_feature;
+    junction_feature.set_junction_id(GetJunctionId());
+    junction_feature.set_junction_range(ComputeJunctionRange());
+    // Find all junction-exit-lanes that are successors of the start_lane_id.
+    std::vector<JunctionExit> junction_exits =
+        GetJunctionExits(start_lane_id);
+
+    for (const auto& junction_exit : junction_exits) {
+      junction_feature.add_junction_exit()->CopyFrom(junction_exit);
+    }
+    junction_feature.mutable_enter_lane()->set_lane_id(start_lane_id);
+    junction_feature.add_start_lane_id(start_lane_id);
+    return junction_feature;
+  });
 }
 
 JunctionFeature JunctionAnalyzer::GetJunctionFeature(
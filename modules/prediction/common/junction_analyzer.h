@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "modules/common/util/concurrent_lru_cache.h"
 #include "modules/prediction/common/prediction_map.h"
 #include "modules/prediction/proto/feature.pb.h"
 
@@ -53,11 +54,12 @@ class JunctionAnalyzer {
   double ComputeJunctionRange();
 
   /**
-   * @brief Get junction feature starting from start_lane_id
+   * @brief Get junction feature starting from start_lane_id, which may be
+   *        called from several threads at once
    * @param start lane ID
    * @return junction
    */
-  const JunctionFeature& GetJunctionFeature(const std::string& start_lane_id);
+  JunctionFeature GetJunctionFeature(const std::string& start_lane_id);
 
   /**
    * @brief Get junction feature starting from start_lane_ids
@@ -68,6 +70,8 @@ class JunctionAnalyzer {
       const std::vector<std::string>& start_lane_ids);
 
  private:
+  static constexpr size_t kJunctionFeatureCacheCapacity = 256;
+
   /**
    * @brief Set all junction exits in the hashtable junction_exits_
    */
@@ -92,8 +96,10 @@ class JunctionAnalyzer {
   std::shared_ptr<const apollo::hdmap::JunctionInfo> junction_info_ptr_;
   // Hashtable: exit_lane_id -> junction_exit
   std::unordered_map<std::string, JunctionExit> junction_exits_;
-  // Hashtable: start_lane_id -> junction_feature
-  std::unordered_map<std::string, JunctionFeature> junction_features_;
+  // Cache: start_lane_id -> junction_feature, shared by the evaluators of
+  // all obstacles
+  common::util::ConcurrentLRUCache<std::string, JunctionFeature>
+      junction_features_{kJunctionFeatureCacheCapacity};
 };
 
 }  // namespace prediction
@@ -32,6 +32,9 @@ TEST_F(JunctionAnalyzerTest, SingleLane) {
   EXPECT_EQ(junction_feature.junction_id(), "j2");
   EXPECT_EQ(junction_feature.enter_lane().lane_id(), "l61");
   EXPECT_GT(junction_feature.junction_exit_size(), 0);
+  // The second lookup is served by the cache.
+  EXPECT_EQ(junction_analyzer.GetJunctionFeature("l61").junction_exit_size(),
+            junction_feature.junction_exit_size());
   junction_analyzer.Clear();
 }
 
@@ -22,6 +22,7 @@
 #include "cyber/record/record_reader.h"
 #include "cyber/record/record_writer.h"
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/map/hdmap/hdmap_util.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/junction_analyzer.h"
 #include "modules/prediction/common/prediction_constants.h"
@@ -54,6 +55,8 @@ bool MessageProcess::Init(ContainerManager* container_manager,
                           EvaluatorManager* evaluator_manager,
                           PredictorManager* predictor_manager,
                           const PredictionConf& prediction_conf) {
+  // The base map follows the localization in OnLocalization().
+  hdmap::HDMapUtil::EnableTiledBaseMap();
   InitContainers(container_manager);
   InitEvaluators(evaluator_manager, prediction_conf);
   InitPredictors(predictor_manager, prediction_conf);
@@ -240,6 +243,8 @@ void MessageProcess::OnLocalization(
       AdapterConfig::LOCALIZATION);
   ACHECK(ptr_ego_pose_container != nullptr);
   ptr_ego_pose_container->Insert(localization);
+  hdmap::HDMapUtil::UpdateBaseMapEgoPose(localization.pose().position(),
+                                         localization.pose().heading());
 
   ADEBUG << "Received a localization message ["
          << localization.ShortDebugString() << "].";
@@ -59,6 +59,10 @@ DEFINE_double(surrounding_lane_search_radius, 3.0,
 // Semantic Map
 DEFINE_double(base_image_half_range, 100.0, "The half range of base image.");
 DEFINE_bool(img_show_semantic_map, false, "If show the image of semantic map.");
+DEFINE_int32(semantic_map_tile_size, 256,
+             "The side in pixels of the cached tiles of the base image.");
+DEFINE_int32(semantic_map_max_num_tiles, 128,
+             "The number of cached tiles of the base image.");
 
 // Scenario
 DEFINE_double(junction_distance_threshold, 10.0,
@@ -46,6 +46,8 @@ DECLARE_double(surrounding_lane_search_radius);
 // Semantic Map
 DECLARE_double(base_image_half_range);
 DECLARE_bool(img_show_semantic_map);
+DECLARE_int32(semantic_map_tile_size);
+DECLARE_int32(semantic_map_max_num_tiles);
 
 // Scenario
 DECLARE_double(junction_distance_threshold);
@@ -36,6 +36,20 @@ namespace prediction {
 
 namespace {
 
+constexpr double kResolution = 0.1;
+constexpr int kBaseImageSize = 2000;
+// Margin of the map queries of a tile. Roads and lanes are found by the
+// distance to the central curves of their lanes, while their boundaries and
+// road edges lie up to half a lane, plus any shoulder, away from these
+// curves, drawn with lines up to 4 pixels thick. The margin covers lanes and
+// shoulders of up to about 9 m together, so that no geometry reaching into
+// the tile is left out of it.
+constexpr double kTileQueryMargin = 5.0;
+// Half the side of the window around an obstacle that its cropped area,
+// 300 pixels ahead, 100 behind and 200 to each side, covers when rotated,
+// with the pixels interpolated from.
+constexpr int kCropWindowHalfSize = 364;
+
 bool ValidFeatureHistory(const ObstacleHistory& obstacle_history,
                          const double curr_base_x, const double curr_base_y) {
   if (obstacle_history.feature_size() == 0) {
@@ -57,6 +71,12 @@ bool ValidFeatureHistory(const ObstacleHistory& obstacle_history,
 SemanticMap::SemanticMap() {}
 
 void SemanticMap::Init() {
+  base_map_cache_.reset(new hdmap::MapRasterCache(
+      kResolution, 1, FLAGS_semantic_map_tile_size,
+      FLAGS_semantic_map_max_num_tiles, CV_8UC3,
+      [this](const hdmap::MapRasterTile& tile, cv::Mat* img) {
+        DrawStaticLayers(tile, img);
+      }));
   curr_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
   obstacle_id_history_map_.clear();
 }
@@ -69,18 +89,18 @@ void SemanticMap::RunCurrFrame(
   }
 
   ego_feature_ = obstacle_id_history_map.at(FLAGS_ego_vehicle_id).feature(0);
+  const double x = ego_feature_.position().x();
+  const double y = ego_feature_.position().y();
   if (!FLAGS_enable_async_draw_base_image) {
-    double x = ego_feature_.position().x();
-    double y = ego_feature_.position().y();
-    curr_base_x_ = x - FLAGS_base_image_half_range;
-    curr_base_y_ = y - FLAGS_base_image_half_range;
-    DrawBaseMap(x, y, curr_base_x_, curr_base_y_);
-    base_img_.copyTo(curr_img_);
+    DrawBaseMap(x, y, &curr_img_, &curr_base_x_, &curr_base_y_);
   } else {
-    base_img_.copyTo(curr_img_);
-    curr_base_x_ = base_x_;
-    curr_base_y_ = base_y_;
-    task_future_ = cyber::Async(&SemanticMap::DrawBaseMapThread, this);
+    {
+      std::lock_guard<std::mutex> lock(draw_base_map_thread_mutex_);
+      base_img_.copyTo(curr_img_);
+      curr_base_x_ = base_x_;
+      curr_base_y_ = base_y_;
+    }
+    task_future_ = cyber::Async(&SemanticMap::DrawBaseMapThread, this, x, y);
     // This is only for the first frame without base image yet
     if (!started_drawing_) {
       started_drawing_ = true;
@@ -107,30 +127,43 @@ void SemanticMap::RunCurrFrame(
   }
 }
 
-void SemanticMap::DrawBaseMap(const double x, const double y,
-                              const double base_x, const double base_y) {
-  base_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
-  common::PointENU center_point = common::util::PointFactory::ToPointENU(x, y);
-  DrawRoads(center_point, base_x, base_y);
-  DrawJunctions(center_point, base_x, base_y);
-  DrawCrosswalks(center_point, base_x, base_y);
-  DrawLanes(center_point, base_x, base_y);
+void SemanticMap::DrawBaseMap(const double x, const double y, cv::Mat* img,
+                              double* base_x, double* base_y) {
+  const cv::Point2i origin = base_map_cache_->ToPixel(
+      0, x - FLAGS_base_image_half_range,
+      y - FLAGS_base_image_half_range + kBaseImageSize * kResolution);
+  *base_x = origin.x * kResolution;
+  *base_y = -(origin.y + kBaseImageSize) * kResolution;
+  base_map_cache_->GetArea(0, origin, cv::Size(kBaseImageSize, kBaseImageSize),
+                           img);
 }
 
-void SemanticMap::DrawBaseMapThread() {
+void SemanticMap::DrawBaseMapThread(const double x, const double y) {
+  cv::Mat img;
+  double base_x = 0.0;
+  double base_y = 0.0;
+  DrawBaseMap(x, y, &img, &base_x, &base_y);
   std::lock_guard<std::mutex> lock(draw_base_map_thread_mutex_);
-  double x = ego_feature_.position().x();
-  double y = ego_feature_.position().y();
-  base_x_ = x - FLAGS_base_image_half_range;
-  base_y_ = y - FLAGS_base_image_half_range;
-  DrawBaseMap(x, y, base_x_, base_y_);
+  base_img_ = img;
+  base_x_ = base_x;
+  base_y_ = base_y;
+}
+
+void SemanticMap::DrawStaticLayers(const hdmap::MapRasterTile& tile,
+                                   cv::Mat* img) {
+  DrawRoads(tile, img);
+  DrawJunctions(tile, img);
+  DrawCrosswalks(tile, img);
+  DrawLanes(tile, img);
 }
 
-void SemanticMap::DrawRoads(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+void SemanticMap::DrawRoads(const hdmap::MapRasterTile& tile, cv::Mat* img,
                             const cv::Scalar& color) {
+  const common::PointENU center_point =
+      common::util::PointFactory::ToPointENU(tile.center_x(), tile.center_y());
+  const double radius = tile.radius() + kTileQueryMargin;
   std::vector<apollo::hdmap::RoadInfoConstPtr> roads;
-  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, 141.4, &roads);
+  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, radius, &roads);
   for (const auto& road : roads) {
     for (const auto& section : road->road().section()) {
       std::vector<cv::Point> polygon;
@@ -138,78 +171,78 @@ void SemanticMap::DrawRoads(const common::PointENU& center_point,
         if (edge.type() == 2) {  // left edge
           for (const auto& segment : edge.curve().segment()) {
             for (const auto& point : segment.line_segment().point()) {
-              polygon.push_back(std::move(
-                  GetTransPoint(point.x(), point.y(), base_x, base_y)));
+              polygon.push_back(std::move(tile.ToPixel(point.x(), point.y())));
             }
           }
         } else if (edge.type() == 3) {  // right edge
           for (const auto& segment : edge.curve().segment()) {
             for (const auto& point : segment.line_segment().point()) {
               polygon.insert(polygon.begin(),
-                             std::move(GetTransPoint(point.x(), point.y(),
-                                                     base_x, base_y)));
+                             std::move(tile.ToPixel(point.x(), point.y())));
             }
           }
         }
       }
-      cv::fillPoly(base_img_,
+      cv::fillPoly(*img,
                    std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                    color);
     }
   }
 }
 
-void SemanticMap::DrawJunctions(const common::PointENU& center_point,
-                                const double base_x, const double base_y,
-                                const cv::Scalar& color) {
+void SemanticMap::DrawJunctions(const hdmap::MapRasterTile& tile,
+                                cv::Mat* img, const cv::Scalar& color) {
+  const common::PointENU center_point =
+      common::util::PointFactory::ToPointENU(tile.center_x(), tile.center_y());
+  const double radius = tile.radius() + kTileQueryMargin;
   std::vector<apollo::hdmap::JunctionInfoConstPtr> junctions;
-  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, radius,
                                                    &junctions);
   for (const auto& junction : junctions) {
     std::vector<cv::Point> polygon;
     for (const auto& point : junction->junction().polygon().point()) {
-      polygon.push_back(
-          std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
+      polygon.push_back(std::move(tile.ToPixel(point.x(), point.y())));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(*img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                  color);
   }
 }
 
-void SemanticMap::DrawCrosswalks(const common::PointENU& center_point,
-                                 const double base_x, const double base_y,
-                                 const cv::Scalar& color) {
+void SemanticMap::DrawCrosswalks(const hdmap::MapRasterTile& tile,
+                                 cv::Mat* img, const cv::Scalar& color) {
+  const common::PointENU center_point =
+      common::util::PointFactory::ToPointENU(tile.center_x(), tile.center_y());
+  const double radius = tile.radius() + kTileQueryMargin;
   std::vector<apollo::hdmap::CrosswalkInfoConstPtr> crosswalks;
-  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, radius,
                                                     &crosswalks);
   for (const auto& crosswalk : crosswalks) {
     std::vector<cv::Point> polygon;
     for (const auto& point : crosswalk->crosswalk().polygon().point()) {
-      polygon.push_back(
-          std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
+      polygon.push_back(std::move(tile.ToPixel(point.x(), point.y())));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(*img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                  color);
   }
 }
 
-void SemanticMap::DrawLanes(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+void SemanticMap::DrawLanes(const hdmap::MapRasterTile& tile, cv::Mat* img,
                             const cv::Scalar& color) {
+  const common::PointENU center_point =
+      common::util::PointFactory::ToPointENU(tile.center_x(), tile.center_y());
+  const double radius = tile.radius() + kTileQueryMargin;
   std::vector<apollo::hdmap::LaneInfoConstPtr> lanes;
-  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, 141.4, &lanes);
+  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, radius, &lanes);
   for (const auto& lane : lanes) {
     // Draw lane_central first
     for (const auto& segment : lane->lane().central_curve().segment()) {
       for (int i = 0; i < segment.line_segment().point_size() - 1; ++i) {
-        const auto& p0 =
-            GetTransPoint(segment.line_segment().point(i).x(),
-                          segment.line_segment().point(i).y(), base_x, base_y);
-        const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
-                                       segment.line_segment().point(i + 1).y(),
-                                       base_x, base_y);
+        const auto& p0 = tile.ToPixel(segment.line_segment().point(i).x(),
+                                      segment.line_segment().point(i).y());
+        const auto& p1 = tile.ToPixel(segment.line_segment().point(i + 1).x(),
+                                      segment.line_segment().point(i + 1).y());
         double theta = atan2(segment.line_segment().point(i + 1).y() -
                                  segment.line_segment().point(i).y(),
                              segment.line_segment().point(i + 1).x() -
@@ -223,7 +256,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         //     cv::Scalar(rgb.at<float>(0, 0) * 255, rgb.at<float>(0, 1) * 255,
         //                rgb.at<float>(0, 2) * 255);
 
-        cv::line(base_img_, p0, p1, HSVtoRGB(H), 4);
+        cv::line(*img, p0, p1, HSVtoRGB(H), 4);
       }
     }
     // Not drawing boundary for virtual city_driving lane
@@ -234,26 +267,22 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
     // Draw lane's left_boundary
     for (const auto& segment : lane->lane().left_boundary().curve().segment()) {
       for (int i = 0; i < segment.line_segment().point_size() - 1; ++i) {
-        const auto& p0 =
-            GetTransPoint(segment.line_segment().point(i).x(),
-                          segment.line_segment().point(i).y(), base_x, base_y);
-        const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
-                                       segment.line_segment().point(i + 1).y(),
-                                       base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        const auto& p0 = tile.ToPixel(segment.line_segment().point(i).x(),
+                                      segment.line_segment().point(i).y());
+        const auto& p1 = tile.ToPixel(segment.line_segment().point(i + 1).x(),
+                                      segment.line_segment().point(i + 1).y());
+        cv::line(*img, p0, p1, color, 2);
       }
     }
     // Draw lane's right_boundary
     for (const auto& segment :
          lane->lane().right_boundary().curve().segment()) {
       for (int i = 0; i < segment.line_segment().point_size() - 1; ++i) {
-        const auto& p0 =
-            GetTransPoint(segment.line_segment().point(i).x(),
-                          segment.line_segment().point(i).y(), base_x, base_y);
-        const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
-                                       segment.line_segment().point(i + 1).y(),
-                                       base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        const auto& p0 = tile.ToPixel(segment.line_segment().point(i).x(),
+                                      segment.line_segment().point(i).y());
+        const auto& p1 = tile.ToPixel(segment.line_segment().point(i + 1).x(),
+                                      segment.line_segment().point(i + 1).y());
+        cv::line(*img, p0, p1, color, 2);
       }
     }
   }
@@ -283,7 +312,7 @@ cv::Scalar SemanticMap::HSVtoRGB(double H, double S, double V) {
 
 void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Point2i& offset) {
   double obs_l = feature.length();
   double obs_w = feature.width();
   double obs_x = feature.position().x();
@@ -308,36 +337,37 @@ void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
       obs_x + (cos(theta) * obs_l - sin(theta) * -obs_w) / 2,
       obs_y + (sin(theta) * obs_l + cos(theta) * -obs_w) / 2, base_x, base_y)));
   cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+               color, cv::LINE_8, 0, offset);
 }
 
 void SemanticMap::DrawPoly(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Point2i& offset) {
   std::vector<cv::Point> polygon;
   for (auto& polygon_point : feature.polygon_point()) {
     polygon.push_back(std::move(
         GetTransPoint(polygon_point.x(), polygon_point.y(), base_x, base_y)));
   }
   cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+               color, cv::LINE_8, 0, offset);
 }
 
 void SemanticMap::DrawHistory(const ObstacleHistory& history,
                               const cv::Scalar& color, const double base_x,
-                              const double base_y, cv::Mat* img) {
+                              const double base_y, cv::Mat* img,
+                              const cv::Point2i& offset) {
   for (int i = history.feature_size() - 1; i >= 0; --i) {
     const Feature& feature = history.feature(i);
     double time_decay = 1.0 - ego_feature_.timestamp() + feature.timestamp();
     cv::Scalar decay_color = color * time_decay;
     if (feature.id() == FLAGS_ego_vehicle_id) {
-      DrawRect(feature, decay_color, base_x, base_y, img);
+      DrawRect(feature, decay_color, base_x, base_y, img, offset);
     } else {
       if (feature.polygon_point_size() == 0) {
         AERROR << "No polygon points in feature, please check!";
         continue;
       }
-      DrawPoly(feature, decay_color, base_x, base_y, img);
+      DrawPoly(feature, decay_color, base_x, base_y, img, offset);
     }
   }
 }
@@ -347,23 +377,37 @@ cv::Mat SemanticMap::CropArea(const cv::Mat& input_img,
                               const double heading) {
   cv::Mat rotation_mat =
       cv::getRotationMatrix2D(center_point, 90.0 - heading * 180.0 / M_PI, 1.0);
-  cv::Mat rotated_mat;
-  cv::warpAffine(input_img, rotated_mat, rotation_mat, input_img.size());
+  // Only the cropped area is rotated, moved to the origin of the output.
   cv::Rect rect(center_point.x - 200, center_point.y - 300, 400, 400);
+  rotation_mat.at<double>(0, 2) -= rect.x;
+  rotation_mat.at<double>(1, 2) -= rect.y;
+  cv::Mat rotated_mat;
+  cv::warpAffine(input_img, rotated_mat, rotation_mat, rect.size());
   cv::Mat output_img;
-  cv::resize(rotated_mat(rect), output_img, cv::Size(224, 224));
+  cv::resize(rotated_mat, output_img, cv::Size(224, 224));
   return output_img;
 }
 
 cv::Mat SemanticMap::CropByHistory(const ObstacleHistory& history,
                                    const cv::Scalar& color, const double base_x,
                                    const double base_y) {
-  cv::Mat feature_map = curr_img_.clone();
-  DrawHistory(history, color, base_x, base_y, &feature_map);
   const Feature& curr_feature = history.feature(0);
   const cv::Point2i& center_point = GetTransPoint(
       curr_feature.position().x(), curr_feature.position().y(), base_x, base_y);
-  return CropArea(feature_map, center_point, curr_feature.theta());
+  // The history is drawn on a copy of the window around the obstacle only,
+  // black beyond the image as warpAffine() takes it.
+  const cv::Rect window(center_point.x - kCropWindowHalfSize,
+                        center_point.y - kCropWindowHalfSize,
+                        2 * kCropWindowHalfSize, 2 * kCropWindowHalfSize);
+  cv::Mat feature_map(window.size(), curr_img_.type(), cv::Scalar(0, 0, 0));
+  const cv::Rect visible_area =
+      window & cv::Rect(0, 0, curr_img_.cols, curr_img_.rows);
+  if (visible_area.area() > 0) {
+    curr_img_(visible_area).copyTo(feature_map(visible_area - window.tl()));
+  }
+  DrawHistory(history, color, base_x, base_y, &feature_map, -window.tl());
+  return CropArea(feature_map, center_point - window.tl(),
+                  curr_feature.theta());
 }
 
 bool SemanticMap::GetMapById(const int obstacle_id, cv::Mat* feature_map) {
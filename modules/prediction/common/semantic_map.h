@@ -17,11 +17,15 @@
 #pragma once
 
 #include <future>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
+#include "gtest/gtest_prod.h"
 #include "opencv2/opencv.hpp"
 
 #include "cyber/common/macros.h"
+#include "modules/map/hdmap/map_raster_cache.h"
 #include "modules/prediction/proto/feature.pb.h"
 
 namespace apollo {
@@ -47,37 +51,43 @@ class SemanticMap {
                        static_cast<int>(2000 - (y - base_y) / 0.1));
   }
 
-  void DrawBaseMap(const double x, const double y, const double base_x,
-                   const double base_y);
+  // Copies the base image around (x, y) from the cached tiles, aligned with
+  // their pixel grid, and sets the base_x and base_y it ends up with.
+  void DrawBaseMap(const double x, const double y, cv::Mat* img,
+                   double* base_x, double* base_y);
 
-  void DrawBaseMapThread();
+  void DrawBaseMapThread(const double x, const double y);
 
-  void DrawRoads(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  // Renders a tile of the base image.
+  void DrawStaticLayers(const hdmap::MapRasterTile& tile, cv::Mat* img);
+
+  void DrawRoads(const hdmap::MapRasterTile& tile, cv::Mat* img,
                  const cv::Scalar& color = cv::Scalar(64, 64, 64));
 
-  void DrawJunctions(const common::PointENU& center_point, const double base_x,
-                     const double base_y,
+  void DrawJunctions(const hdmap::MapRasterTile& tile, cv::Mat* img,
                      const cv::Scalar& color = cv::Scalar(128, 128, 128));
 
-  void DrawCrosswalks(const common::PointENU& center_point, const double base_x,
-                      const double base_y,
+  void DrawCrosswalks(const hdmap::MapRasterTile& tile, cv::Mat* img,
                       const cv::Scalar& color = cv::Scalar(192, 192, 192));
 
-  void DrawLanes(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  void DrawLanes(const hdmap::MapRasterTile& tile, cv::Mat* img,
                  const cv::Scalar& color = cv::Scalar(255, 255, 255));
 
   cv::Scalar HSVtoRGB(double H = 1.0, double S = 1.0, double V = 1.0);
 
+  // The offset is added to the points, for images of a part of the base
+  // image.
   void DrawRect(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Point2i& offset = cv::Point2i());
 
   void DrawPoly(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Point2i& offset = cv::Point2i());
 
   void DrawHistory(const ObstacleHistory& history, const cv::Scalar& color,
-                   const double base_x, const double base_y, cv::Mat* img);
+                   const double base_x, const double base_y, cv::Mat* img,
+                   const cv::Point2i& offset = cv::Point2i());
 
   cv::Mat CropArea(const cv::Mat& input_img, const cv::Point2i& center_point,
                    const double heading);
@@ -86,6 +96,9 @@ class SemanticMap {
                         const double base_x, const double base_y);
 
  private:
+  // Tiles of the roads, junctions, crosswalks and lanes of the base image
+  std::unique_ptr<hdmap::MapRasterCache> base_map_cache_;
+
   // base_image, base_x, and base_y to be updated by async thread
   cv::Mat base_img_;
   double base_x_ = 0.0;
@@ -104,6 +117,8 @@ class SemanticMap {
   std::future<void> task_future_;
 
   bool started_drawing_ = false;
+
+  FRIEND_TEST(SemanticMapTest, TiledBaseMapMatchesDirectRender);
 };
 
 }  // namespace prediction
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/semantic_map.h"
+
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/prediction/common/kml_map_based_test.h"
+
+namespace apollo {
+namespace prediction {
+
+class SemanticMapTest : public KMLMapBasedTest {};
+
+TEST_F(SemanticMapTest, TiledBaseMapMatchesDirectRender) {
+  const auto lane =
+      hdmap::HDMapUtil::BaseMap().GetLaneById(hdmap::MakeMapId("l61"));
+  ASSERT_NE(nullptr, lane);
+  const auto& start = lane->points().front();
+
+  SemanticMap semantic_map;
+  semantic_map.Init();
+  // An area of several tiles around the lane, whose tile borders cut through
+  // the lanes, boundaries and road edges around it.
+  const cv::Size size(1000, 1000);
+  const cv::Point2i origin =
+      semantic_map.base_map_cache_->ToPixel(0, start.x(), start.y()) -
+      cv::Point2i(size.width / 2, size.height / 2);
+  cv::Mat tiled;
+  semantic_map.base_map_cache_->GetArea(0, origin, size, &tiled);
+  EXPECT_GT(semantic_map.base_map_cache_->num_tiles(), 1U);
+
+  hdmap::MapRasterTile area;
+  area.resolution = semantic_map.base_map_cache_->resolution(0);
+  area.origin = origin;
+  area.size = size;
+  cv::Mat direct(size, CV_8UC3, cv::Scalar(0, 0, 0));
+  semantic_map.DrawStaticLayers(area, &direct);
+  ASSERT_GT(cv::countNonZero(direct.reshape(1)), 0);
+
+  // Thick lines clipped at the tile borders may round a few pixels
+  // differently, while any line or edge missing from a tile differs over
+  // hundreds of pixels.
+  cv::Mat diff;
+  cv::absdiff(tiled, direct, diff);
+  cv::cvtColor(diff, diff, cv::COLOR_BGR2GRAY);
+  EXPECT_LT(cv::countNonZero(diff), 100);
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -115,18 +115,27 @@ SubTopoGraph::~SubTopoGraph() {}
 void SubTopoGraph::GetSubInEdgesIntoSubGraph(
     const TopoEdge* edge,
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
+  std::vector<const TopoEdge*> sub_edge_vec;
+  GetSubInEdgesIntoSubGraph(edge, &sub_edge_vec);
+  sub_edges->insert(sub_edge_vec.begin(), sub_edge_vec.end());
+}
+
+void SubTopoGraph::GetSubInEdgesIntoSubGraph(
+    const TopoEdge* edge,
+    std::vector<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (from_node->IsSubNode() || to_node->IsSubNode() ||
-      !GetSubNodes(to_node, &sub_nodes)) {
-    sub_edges->insert(edge);
+  const auto* sub_nodes =
+      (from_node->IsSubNode() || to_node->IsSubNode()) ? nullptr
+                                                       : GetSubNodes(to_node);
+  if (sub_nodes == nullptr) {
+    sub_edges->push_back(edge);
     return;
   }
-  for (const auto* sub_node : sub_nodes) {
+  for (const auto* sub_node : *sub_nodes) {
     for (const auto* in_edge : sub_node->InFromAllEdge()) {
       if (in_edge->FromNode() == from_node) {
-        sub_edges->insert(in_edge);
+        sub_edges->push_back(in_edge);
       }
     }
   }
@@ -137,13 +146,14 @@ void SubTopoGraph::GetSubOutEdgesIntoSubGraph(
     std::unordered_set<const TopoEdge*>* const sub_edges) const {
   const auto* from_node = edge->FromNode();
   const auto* to_node = edge->ToNode();
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (from_node->IsSubNode() || to_node->IsSubNode() ||
-      !GetSubNodes(from_node, &sub_nodes)) {
+  const auto* sub_nodes =
+      (from_node->IsSubNode() || to_node->IsSubNode()) ? nullptr
+                                                       : GetSubNodes(from_node);
+  if (sub_nodes == nullptr) {
     sub_edges->insert(edge);
     return;
   }
-  for (const auto* sub_node : sub_nodes) {
+  for (const auto* sub_node : *sub_nodes) {
     for (const auto* out_edge : sub_node->OutToAllEdge()) {
       if (out_edge->ToNode() == to_node) {
         sub_edges->insert(out_edge);
@@ -167,12 +177,16 @@ const TopoNode* SubTopoGraph::GetSubNodeWithS(const TopoNode* topo_node,
   return sorted_vec[index].GetTopoNode();
 }
 
+int SubTopoGraph::NumSubNodes() const {
+  return static_cast<int>(topo_nodes_.size());
+}
+
 void SubTopoGraph::InitSubNodeByValidRange(
     const TopoNode* topo_node, const std::vector<NodeSRange>& valid_range) {
   // Attention: no matter topo node has valid_range or not,
   // create map value first;
   auto& sub_node_vec = sub_node_range_sorted_map_[topo_node];
-  auto& sub_node_set = sub_node_map_[topo_node];
+  auto& sub_nodes = sub_node_map_[topo_node];
 
   std::vector<TopoNode*> sub_node_sorted_vec;
   for (const auto& range : valid_range) {
@@ -181,8 +195,9 @@ void SubTopoGraph::InitSubNodeByValidRange(
     }
     std::shared_ptr<TopoNode> sub_topo_node_ptr;
     sub_topo_node_ptr.reset(new TopoNode(topo_node, range));
+    sub_topo_node_ptr->SetIndex(static_cast<int>(topo_nodes_.size()));
     sub_node_vec.emplace_back(sub_topo_node_ptr.get(), range);
-    sub_node_set.insert(sub_topo_node_ptr.get());
+    sub_nodes.push_back(sub_topo_node_ptr.get());
     sub_node_sorted_vec.push_back(sub_topo_node_ptr.get());
     topo_nodes_.push_back(std::move(sub_topo_node_ptr));
   }
@@ -206,12 +221,12 @@ void SubTopoGraph::InitSubNodeByValidRange(
 }
 
 void SubTopoGraph::InitSubEdge(const TopoNode* topo_node) {
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (!GetSubNodes(topo_node, &sub_nodes)) {
+  const auto* sub_nodes = GetSubNodes(topo_node);
+  if (sub_nodes == nullptr) {
     return;
   }
 
-  for (auto* sub_node : sub_nodes) {
+  for (auto* sub_node : *sub_nodes) {
     InitInSubNodeSubEdge(sub_node, topo_node->InFromAllEdge());
     InitOutSubNodeSubEdge(sub_node, topo_node->OutToAllEdge());
   }
@@ -219,11 +234,11 @@ void SubTopoGraph::InitSubEdge(const TopoNode* topo_node) {
 
 void SubTopoGraph::InitInSubNodeSubEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::vector<const TopoEdge*>& origin_edge) {
   for (const auto* in_edge : origin_edge) {
-    if (GetSubNodes(in_edge->FromNode(), &other_sub_nodes)) {
-      for (auto* sub_from_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(in_edge->FromNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_from_node : *other_sub_nodes) {
         if (!sub_from_node->IsOverlapEnough(sub_node, in_edge)) {
           continue;
         }
@@ -246,11 +261,11 @@ void SubTopoGraph::InitInSubNodeSubEdge(
 
 void SubTopoGraph::InitOutSubNodeSubEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::vector<const TopoEdge*>& origin_edge) {
   for (const auto* out_edge : origin_edge) {
-    if (GetSubNodes(out_edge->ToNode(), &other_sub_nodes)) {
-      for (auto* sub_to_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(out_edge->ToNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_to_node : *other_sub_nodes) {
         if (!sub_node->IsOverlapEnough(sub_to_node, out_edge)) {
           continue;
         }
@@ -271,24 +286,21 @@ void SubTopoGraph::InitOutSubNodeSubEdge(
   }
 }
 
-bool SubTopoGraph::GetSubNodes(
-    const TopoNode* node,
-    std::unordered_set<TopoNode*>* const sub_nodes) const {
+const std::vector<TopoNode*>* SubTopoGraph::GetSubNodes(
+    const TopoNode* node) const {
   const auto& iter = sub_node_map_.find(node);
   if (iter == sub_node_map_.end()) {
-    return false;
+    return nullptr;
   }
-  sub_nodes->clear();
-  sub_nodes->insert(iter->second.begin(), iter->second.end());
-  return true;
+  return &iter->second;
 }
 
 void SubTopoGraph::AddPotentialEdge(const TopoNode* topo_node) {
-  std::unordered_set<TopoNode*> sub_nodes;
-  if (!GetSubNodes(topo_node, &sub_nodes)) {
+  const auto* sub_nodes = GetSubNodes(topo_node);
+  if (sub_nodes == nullptr) {
     return;
   }
-  for (auto* sub_node : sub_nodes) {
+  for (auto* sub_node : *sub_nodes) {
     AddPotentialInEdge(sub_node, topo_node->InFromLeftOrRightEdge());
     AddPotentialOutEdge(sub_node, topo_node->OutToLeftOrRightEdge());
   }
@@ -296,11 +308,11 @@ void SubTopoGraph::AddPotentialEdge(const TopoNode* topo_node) {
 
 void SubTopoGraph::AddPotentialInEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::vector<const TopoEdge*>& origin_edge) {
   for (const auto* in_edge : origin_edge) {
-    if (GetSubNodes(in_edge->FromNode(), &other_sub_nodes)) {
-      for (auto* sub_from_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(in_edge->FromNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_from_node : *other_sub_nodes) {
         if (sub_node->GetInEdgeFrom(sub_from_node) != nullptr) {
           continue;
         }
@@ -329,11 +341,11 @@ void SubTopoGraph::AddPotentialInEdge(
 
 void SubTopoGraph::AddPotentialOutEdge(
     TopoNode* const sub_node,
-    const std::unordered_set<const TopoEdge*> origin_edge) {
-  std::unordered_set<TopoNode*> other_sub_nodes;
+    const std::vector<const TopoEdge*>& origin_edge) {
   for (const auto* out_edge : origin_edge) {
-    if (GetSubNodes(out_edge->ToNode(), &other_sub_nodes)) {
-      for (auto* sub_to_node : other_sub_nodes) {
+    const auto* other_sub_nodes = GetSubNodes(out_edge->ToNode());
+    if (other_sub_nodes != nullptr) {
+      for (auto* sub_to_node : *other_sub_nodes) {
         if (sub_node->GetOutEdgeTo(sub_to_node) != nullptr) {
           continue;
         }
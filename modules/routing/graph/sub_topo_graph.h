@@ -48,6 +48,11 @@ class SubTopoGraph {
   void GetSubInEdgesIntoSubGraph(
       const TopoEdge* edge,
       std::unordered_set<const TopoEdge*>* const sub_edges) const;
+  // Same as above, appending the edges to a vector, which the search reuses
+  // between nodes.
+  void GetSubInEdgesIntoSubGraph(
+      const TopoEdge* edge,
+      std::vector<const TopoEdge*>* const sub_edges) const;
 
   // edge: A -> B         not sub edge
   // 1. A has no sub node, B has no sub node
@@ -68,6 +73,10 @@ class SubTopoGraph {
 
   const TopoNode* GetSubNodeWithS(const TopoNode* topo_node, double s) const;
 
+  // Sub nodes are indexed from 0 to NumSubNodes() - 1, apart from the nodes
+  // of the topo graph.
+  int NumSubNodes() const;
+
  private:
   void InitSubNodeByValidRange(const TopoNode* topo_node,
                                const std::vector<NodeSRange>& valid_range);
@@ -75,29 +84,28 @@ class SubTopoGraph {
 
   void InitInSubNodeSubEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::vector<const TopoEdge*>& origin_edge);
   void InitOutSubNodeSubEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::vector<const TopoEdge*>& origin_edge);
 
-  bool GetSubNodes(const TopoNode* node,
-                   std::unordered_set<TopoNode*>* const sub_nodes) const;
+  // Returns nullptr if the node has no sub nodes.
+  const std::vector<TopoNode*>* GetSubNodes(const TopoNode* node) const;
 
   void AddPotentialEdge(const TopoNode* topo_node);
   void AddPotentialInEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::vector<const TopoEdge*>& origin_edge);
   void AddPotentialOutEdge(
       TopoNode* const sub_node,
-      const std::unordered_set<const TopoEdge*> origin_edge);
+      const std::vector<const TopoEdge*>& origin_edge);
 
  private:
   std::vector<std::shared_ptr<TopoNode>> topo_nodes_;
   std::vector<std::shared_ptr<TopoEdge>> topo_edges_;
   std::unordered_map<const TopoNode*, std::vector<NodeWithRange>>
       sub_node_range_sorted_map_;
-  std::unordered_map<const TopoNode*, std::unordered_set<TopoNode*>>
-      sub_node_map_;
+  std::unordered_map<const TopoNode*, std::vector<TopoNode*>> sub_node_map_;
 };
 
 }  // namespace routing
@@ -38,6 +38,8 @@ class TopoGraph {
   const std::string& MapVersion() const;
   const std::string& MapDistrict() const;
   const TopoNode* GetNode(const std::string& id) const;
+  // Nodes are indexed from 0 to NumNodes() - 1, in the order of the graph.
+  int NumNodes() const;
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
@@ -21,7 +21,6 @@
 #include <utility>
 
 #include "cyber/common/log.h"
-#include "modules/common/util/map_util.h"
 #include "modules/routing/graph/range_utils.h"
 
 namespace apollo {
@@ -32,7 +31,6 @@ namespace {
 const double MIN_INTERNAL_FOR_NODE = 0.01;  // in meter
 const double kLenghtEpsilon = 1e-6;         // in meter
 
-using apollo::common::util::FindPtrOrNull;
 using ::google::protobuf::RepeatedPtrField;
 
 void ConvertOutRange(const RepeatedPtrField<CurveRange>& range_vec,
@@ -177,58 +175,71 @@ const std::vector<NodeSRange>& TopoNode::RightOutRange() const {
   return right_out_sorted_range_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::InFromAllEdge() const {
-  return in_from_all_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::InFromAllEdge() const {
+  return in_from_all_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::InFromLeftEdge() const {
-  return in_from_left_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::InFromLeftEdge() const {
+  return in_from_left_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::InFromRightEdge() const {
-  return in_from_right_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::InFromRightEdge() const {
+  return in_from_right_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::InFromLeftOrRightEdge()
-    const {
-  return in_from_left_or_right_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::InFromLeftOrRightEdge() const {
+  return in_from_left_or_right_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::InFromPreEdge() const {
-  return in_from_pre_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::InFromPreEdge() const {
+  return in_from_pre_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::OutToAllEdge() const {
-  return out_to_all_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::OutToAllEdge() const {
+  return out_to_all_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::OutToLeftEdge() const {
-  return out_to_left_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::OutToLeftEdge() const {
+  return out_to_left_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::OutToRightEdge() const {
-  return out_to_right_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::OutToRightEdge() const {
+  return out_to_right_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::OutToLeftOrRightEdge()
-    const {
-  return out_to_left_or_right_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::OutToLeftOrRightEdge() const {
+  return out_to_left_or_right_edge_;
 }
 
-const std::unordered_set<const TopoEdge*>& TopoNode::OutToSucEdge() const {
-  return out_to_suc_edge_set_;
+const std::vector<const TopoEdge*>& TopoNode::OutToSucEdge() const {
+  return out_to_suc_edge_;
 }
 
 const TopoEdge* TopoNode::GetInEdgeFrom(const TopoNode* from_node) const {
-  return FindPtrOrNull(in_edge_map_, from_node);
+  // Nodes have a handful of edges, which a scan finds faster than a hash.
+  for (const auto* edge : in_from_all_edge_) {
+    if (edge->FromNode() == from_node) {
+      return edge;
+    }
+  }
+  return nullptr;
 }
 
 const TopoEdge* TopoNode::GetOutEdgeTo(const TopoNode* to_node) const {
-  return FindPtrOrNull(out_edge_map_, to_node);
+  for (const auto* edge : out_to_all_edge_) {
+    if (edge->ToNode() == to_node) {
+      return edge;
+    }
+  }
+  return nullptr;
 }
 
 const TopoNode* TopoNode::OriginNode() const { return origin_node_; }
 
+int TopoNode::Index() const { return index_; }
+
+void TopoNode::SetIndex(int index) { index_ = index; }
+
 double TopoNode::StartS() const { return start_s_; }
 
 double TopoNode::EndS() const { return end_s_; }
@@ -257,48 +268,46 @@ void TopoNode::AddInEdge(const TopoEdge* edge) {
   if (edge->ToNode() != this) {
     return;
   }
-  if (in_edge_map_.count(edge->FromNode()) != 0) {
+  if (GetInEdgeFrom(edge->FromNode()) != nullptr) {
     return;
   }
   switch (edge->Type()) {
     case TET_LEFT:
-      in_from_right_edge_set_.insert(edge);
-      in_from_left_or_right_edge_set_.insert(edge);
+      in_from_right_edge_.push_back(edge);
+      in_from_left_or_right_edge_.push_back(edge);
       break;
     case TET_RIGHT:
-      in_from_left_edge_set_.insert(edge);
-      in_from_left_or_right_edge_set_.insert(edge);
+      in_from_left_edge_.push_back(edge);
+      in_from_left_or_right_edge_.push_back(edge);
       break;
     default:
-      in_from_pre_edge_set_.insert(edge);
+      in_from_pre_edge_.push_back(edge);
       break;
   }
-  in_from_all_edge_set_.insert(edge);
-  in_edge_map_[edge->FromNode()] = edge;
+  in_from_all_edge_.push_back(edge);
 }
 
 void TopoNode::AddOutEdge(const TopoEdge* edge) {
   if (edge->FromNode() != this) {
     return;
   }
-  if (out_edge_map_.count(edge->ToNode()) != 0) {
+  if (GetOutEdgeTo(edge->ToNode()) != nullptr) {
     return;
   }
   switch (edge->Type()) {
     case TET_LEFT:
-      out_to_left_edge_set_.insert(edge);
-      out_to_left_or_right_edge_set_.insert(edge);
+      out_to_left_edge_.push_back(edge);
+      out_to_left_or_right_edge_.push_back(edge);
       break;
     case TET_RIGHT:
-      out_to_right_edge_set_.insert(edge);
-      out_to_left_or_right_edge_set_.insert(edge);
+      out_to_right_edge_.push_back(edge);
+      out_to_left_or_right_edge_.push_back(edge);
       break;
     default:
-      out_to_suc_edge_set_.insert(edge);
+      out_to_suc_edge_.push_back(edge);
       break;
   }
-  out_to_all_edge_set_.insert(edge);
-  out_edge_map_[edge->ToNode()] = edge;
+  out_to_all_edge_.push_back(edge);
 }
 
 bool TopoNode::IsInFromPreEdgeValid() const {
@@ -17,7 +17,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
-#include <queue>
+#include <utility>
 
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
@@ -28,25 +28,6 @@ namespace apollo {
 namespace routing {
 namespace {
 
-struct SearchNode {
-  const TopoNode* topo_node = nullptr;
-  double f = std::numeric_limits<double>::max();
-
-  SearchNode() = default;
-  explicit SearchNode(const TopoNode* node)
-      : topo_node(node), f(std::numeric_limits<double>::max()) {}
-  SearchNode(const SearchNode& search_node) = default;
-
-  bool operator<(const SearchNode& node) const {
-    // in order to let the top of priority queue is the smallest one!
-    return f > node.f;
-  }
-
-  bool operator==(const SearchNode& node) const {
-    return topo_node == node.topo_node;
-  }
-};
-
 double GetCostToNeighbor(const TopoEdge* edge) {
   return (edge->Cost() + edge->ToNode()->Cost());
 }
@@ -175,16 +156,40 @@ bool AdjustLaneChange(std::vector<const TopoNode*>* const result_node_vec) {
   return true;
 }
 
-bool Reconstruct(
-    const std::unordered_map<const TopoNode*, const TopoNode*>& came_from,
-    const TopoNode* dest_node, std::vector<NodeWithRange>* result_nodes) {
-  std::vector<const TopoNode*> result_node_vec;
-  result_node_vec.push_back(dest_node);
+}  // namespace
+
+AStarStrategy::AStarStrategy(bool enable_change)
+    : change_lane_enabled_(enable_change) {}
+
+void AStarStrategy::Clear() {
+  for (const int slot : used_slots_) {
+    states_[slot] = SearchState();
+  }
+  used_slots_.clear();
+  open_set_.clear();
+}
+
+int AStarStrategy::GetSlot(const TopoNode* node) const {
+  return node->IsSubNode() ? num_graph_nodes_ + node->Index() : node->Index();
+}
 
-  auto iter = came_from.find(dest_node);
-  while (iter != came_from.end()) {
-    result_node_vec.push_back(iter->second);
-    iter = came_from.find(iter->second);
+AStarStrategy::SearchState* AStarStrategy::GetState(const TopoNode* node) {
+  const int slot = GetSlot(node);
+  DCHECK_GE(slot, 0);
+  DCHECK_LT(slot, static_cast<int>(states_.size()));
+  auto* state = &states_[slot];
+  if (state->topo_node == nullptr) {
+    state->topo_node = node;
+    used_slots_.push_back(slot);
+  }
+  return state;
+}
+
+bool AStarStrategy::Reconstruct(
+    int dest_slot, std::vector<NodeWithRange>* const result_nodes) const {
+  std::vector<const TopoNode*> result_node_vec;
+  for (int slot = dest_slot; slot >= 0; slot = states_[slot].came_from) {
+    result_node_vec.push_back(states_[slot].topo_node);
   }
   std::reverse(result_node_vec.begin(), result_node_vec.end());
   if (!AdjustLaneChange(&result_node_vec)) {
@@ -199,17 +204,69 @@ bool Reconstruct(
   return true;
 }
 
-}  // namespace
+void AStarStrategy::PushOpenSet(int slot, double f) {
+  states_[slot].f = f;
+  states_[slot].heap_index = static_cast<int>(open_set_.size());
+  open_set_.push_back(slot);
+  SiftUp(states_[slot].heap_index);
+}
 
-AStarStrategy::AStarStrategy(bool enable_change)
-    : change_lane_enabled_(enable_change) {}
+void AStarStrategy::DecreaseOpenSetKey(int slot, double f) {
+  states_[slot].f = f;
+  SiftUp(states_[slot].heap_index);
+}
 
-void AStarStrategy::Clear() {
-  closed_set_.clear();
-  open_set_.clear();
-  came_from_.clear();
-  enter_s_.clear();
-  g_score_.clear();
+void AStarStrategy::PopOpenSet() {
+  states_[open_set_.front()].heap_index = -1;
+  const int last_slot = open_set_.back();
+  open_set_.pop_back();
+  if (!open_set_.empty()) {
+    open_set_.front() = last_slot;
+    states_[last_slot].heap_index = 0;
+    SiftDown(0);
+  }
+}
+
+void AStarStrategy::SiftUp(int heap_index) {
+  const int slot = open_set_[heap_index];
+  const double f = states_[slot].f;
+  while (heap_index > 0) {
+    const int parent = (heap_index - 1) / 2;
+    const int parent_slot = open_set_[parent];
+    if (states_[parent_slot].f <= f) {
+      break;
+    }
+    open_set_[heap_index] = parent_slot;
+    states_[parent_slot].heap_index = heap_index;
+    heap_index = parent;
+  }
+  open_set_[heap_index] = slot;
+  states_[slot].heap_index = heap_index;
+}
+
+void AStarStrategy::SiftDown(int heap_index) {
+  const int size = static_cast<int>(open_set_.size());
+  const int slot = open_set_[heap_index];
+  const double f = states_[slot].f;
+  while (true) {
+    int child = 2 * heap_index + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size &&
+        states_[open_set_[child + 1]].f < states_[open_set_[child]].f) {
+      ++child;
+    }
+    const int child_slot = open_set_[child];
+    if (f <= states_[child_slot].f) {
+      break;
+    }
+    open_set_[heap_index] = child_slot;
+    states_[child_slot].heap_index = heap_index;
+    heap_index = child;
+  }
+  open_set_[heap_index] = slot;
+  states_[slot].heap_index = heap_index;
 }
 
 double AStarStrategy::HeuristicCost(const TopoNode* src_node,
@@ -228,37 +285,27 @@ bool AStarStrategy::Search(const TopoGraph* graph,
   Clear();
   AINFO << "Start A* search algorithm.";
 
-  std::priority_queue<SearchNode> open_set_detail;
-
-  SearchNode src_search_node(src_node);
-  src_search_node.f = HeuristicCost(src_node, dest_node);
-  open_set_detail.push(src_search_node);
+  num_graph_nodes_ = graph->NumNodes();
+  states_.resize(num_graph_nodes_ + sub_graph->NumSubNodes());
 
-  open_set_.insert(src_node);
-  g_score_[src_node] = 0.0;
-  enter_s_[src_node] = src_node->StartS();
+  auto* src_state = GetState(src_node);
+  src_state->g_score = 0.0;
+  src_state->enter_s = src_node->StartS();
+  src_state->has_enter_s = true;
+  PushOpenSet(GetSlot(src_node), HeuristicCost(src_node, dest_node));
 
-  SearchNode current_node;
-  std::unordered_set<const TopoEdge*> next_edge_set;
-  std::unordered_set<const TopoEdge*> sub_edge_set;
-  while (!open_set_detail.empty()) {
-    current_node = open_set_detail.top();
-    const auto* from_node = current_node.topo_node;
-    if (current_node.topo_node == dest_node) {
-      if (!Reconstruct(came_from_, from_node, result_nodes)) {
+  while (!open_set_.empty()) {
+    const int from_slot = open_set_.front();
+    const auto* from_node = states_[from_slot].topo_node;
+    if (from_node == dest_node) {
+      if (!Reconstruct(from_slot, result_nodes)) {
         AERROR << "Failed to reconstruct route.";
         return false;
       }
       return true;
     }
-    open_set_.erase(from_node);
-    open_set_detail.pop();
-
-    if (closed_set_.count(from_node) != 0) {
-      // if showed before, just skip...
-      continue;
-    }
-    closed_set_.emplace(from_node);
+    PopOpenSet();
+    states_[from_slot].closed = true;
 
     // if residual_s is less than FLAGS_min_length_for_lane_change, only move
     // forward
@@ -268,38 +315,39 @@ bool AStarStrategy::Search(const TopoGraph* graph,
             ? from_node->OutToAllEdge()
             : from_node->OutToSucEdge();
     double tentative_g_score = 0.0;
-    next_edge_set.clear();
+    next_edges_.clear();
     for (const auto* edge : neighbor_edges) {
-      sub_edge_set.clear();
-      sub_graph->GetSubInEdgesIntoSubGraph(edge, &sub_edge_set);
-      next_edge_set.insert(sub_edge_set.begin(), sub_edge_set.end());
+      sub_graph->GetSubInEdgesIntoSubGraph(edge, &next_edges_);
     }
 
-    for (const auto* edge : next_edge_set) {
+    const double from_g_score = states_[from_slot].g_score;
+    const double from_enter_s = states_[from_slot].enter_s;
+    for (const auto* edge : next_edges_) {
       const auto* to_node = edge->ToNode();
-      if (closed_set_.count(to_node) == 1) {
+      auto* to_state = GetState(to_node);
+      if (to_state->closed) {
         continue;
       }
       if (GetResidualS(edge, to_node) < FLAGS_min_length_for_lane_change) {
         continue;
       }
-      tentative_g_score =
-          g_score_[current_node.topo_node] + GetCostToNeighbor(edge);
+      tentative_g_score = from_g_score + GetCostToNeighbor(edge);
       if (edge->Type() != TopoEdgeType::TET_FORWARD) {
         tentative_g_score -=
             (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
       }
       double f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      if (open_set_.count(to_node) != 0 && f >= g_score_[to_node]) {
+      const bool is_open = to_state->heap_index >= 0;
+      if (is_open && f >= to_state->g_score) {
         continue;
       }
       // if to_node is reached by forward, reset enter_s to start_s
       if (edge->Type() == TopoEdgeType::TET_FORWARD) {
-        enter_s_[to_node] = to_node->StartS();
+        to_state->enter_s = to_node->StartS();
       } else {
         // else, add enter_s with FLAGS_min_length_for_lane_change
         double to_node_enter_s =
-            (enter_s_[from_node] + FLAGS_min_length_for_lane_change) /
+            (from_enter_s + FLAGS_min_length_for_lane_change) /
             from_node->Length() * to_node->Length();
         // enter s could be larger than end_s but should be less than length
         to_node_enter_s = std::min(to_node_enter_s, to_node->Length());
@@ -307,16 +355,16 @@ bool AStarStrategy::Search(const TopoGraph* graph,
         if (to_node_enter_s > to_node->EndS() && to_node == dest_node) {
           continue;
         }
-        enter_s_[to_node] = to_node_enter_s;
+        to_state->enter_s = to_node_enter_s;
       }
+      to_state->has_enter_s = true;
 
-      g_score_[to_node] = f;
-      SearchNode next_node(to_node);
-      next_node.f = f;
-      open_set_detail.push(next_node);
-      came_from_[to_node] = from_node;
-      if (open_set_.count(to_node) == 0) {
-        open_set_.insert(to_node);
+      to_state->g_score = f;
+      to_state->came_from = from_slot;
+      if (is_open) {
+        DecreaseOpenSetKey(GetSlot(to_node), f);
+      } else {
+        PushOpenSet(GetSlot(to_node), f);
       }
     }
   }
@@ -326,12 +374,12 @@ bool AStarStrategy::Search(const TopoGraph* graph,
 
 double AStarStrategy::GetResidualS(const TopoNode* node) {
   double start_s = node->StartS();
-  const auto iter = enter_s_.find(node);
-  if (iter != enter_s_.end()) {
-    if (iter->second > node->EndS()) {
+  const auto* state = GetState(node);
+  if (state->has_enter_s) {
+    if (state->enter_s > node->EndS()) {
       return 0.0;
     }
-    start_s = iter->second;
+    start_s = state->enter_s;
   } else {
     AWARN << "lane " << node->LaneId() << "(" << node->StartS() << ", "
           << node->EndS() << "not found in enter_s map";
@@ -339,7 +387,7 @@ double AStarStrategy::GetResidualS(const TopoNode* node) {
   double end_s = node->EndS();
   const TopoNode* succ_node = nullptr;
   for (const auto* edge : node->OutToAllEdge()) {
-    if (edge->ToNode()->LaneId() == node->LaneId()) {
+    if (edge->ToNode()->OriginNode() == node->OriginNode()) {
       succ_node = edge->ToNode();
       break;
     }
@@ -357,9 +405,10 @@ double AStarStrategy::GetResidualS(const TopoEdge* edge,
   }
   double start_s = to_node->StartS();
   const auto* from_node = edge->FromNode();
-  const auto iter = enter_s_.find(from_node);
-  if (iter != enter_s_.end()) {
-    double temp_s = iter->second / from_node->Length() * to_node->Length();
+  const auto* from_state = GetState(from_node);
+  if (from_state->has_enter_s) {
+    double temp_s =
+        from_state->enter_s / from_node->Length() * to_node->Length();
     start_s = std::max(start_s, temp_s);
   } else {
     AWARN << "lane " << from_node->LaneId() << "(" << from_node->StartS()
@@ -368,7 +417,7 @@ double AStarStrategy::GetResidualS(const TopoEdge* edge,
   double end_s = to_node->EndS();
   const TopoNode* succ_node = nullptr;
   for (const auto* edge : to_node->OutToAllEdge()) {
-    if (edge->ToNode()->LaneId() == to_node->LaneId()) {
+    if (edge->ToNode()->OriginNode() == to_node->OriginNode()) {
       succ_node = edge->ToNode();
       break;
     }
@@ -16,8 +16,6 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "modules/routing/strategy/strategy.h"
@@ -35,18 +33,51 @@ class AStarStrategy : public Strategy {
                       std::vector<NodeWithRange>* const result_nodes);
 
  private:
+  // The search state of a node, kept in a slot numbered by the index of the
+  // node in the topo graph, or by the number of nodes of the topo graph plus
+  // the index of the sub node in the sub graph.
+  struct SearchState {
+    const TopoNode* topo_node = nullptr;
+    // The score that later paths to the node must beat, which includes the
+    // heuristic cost to the destination for all nodes but the source.
+    double g_score = 0.0;
+    // The key of the node in the open set.
+    double f = 0.0;
+    double enter_s = 0.0;
+    bool has_enter_s = false;
+    bool closed = false;
+    // The slot of the node the best path comes from, or -1.
+    int came_from = -1;
+    // The position of the node in the open set heap, or -1 if not open.
+    int heap_index = -1;
+  };
+
   void Clear();
   double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
   double GetResidualS(const TopoNode* node);
   double GetResidualS(const TopoEdge* edge, const TopoNode* to_node);
 
+  int GetSlot(const TopoNode* node) const;
+  SearchState* GetState(const TopoNode* node);
+  bool Reconstruct(int dest_slot,
+                   std::vector<NodeWithRange>* const result_nodes) const;
+
+  // The open set is a binary min heap of slots ordered by f, which moves a
+  // node up when its f decreases, instead of pushing it again.
+  void PushOpenSet(int slot, double f);
+  void DecreaseOpenSetKey(int slot, double f);
+  void PopOpenSet();
+  void SiftUp(int heap_index);
+  void SiftDown(int heap_index);
+
  private:
   bool change_lane_enabled_;
-  std::unordered_set<const TopoNode*> open_set_;
-  std::unordered_set<const TopoNode*> closed_set_;
-  std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
-  std::unordered_map<const TopoNode*, double> g_score_;
-  std::unordered_map<const TopoNode*, double> enter_s_;
+  int num_graph_nodes_ = 0;
+  // Kept between searches, and reset only in the slots the last search used.
+  std::vector<SearchState> states_;
+  std::vector<int> used_slots_;
+  std::vector<int> open_set_;
+  std::vector<const TopoEdge*> next_edges_;
 };
 
 }  // namespace routing
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/strategy/a_star_strategy.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_range_manager.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+void ExpectRoute(const std::vector<std::string>& lane_ids,
+                 const std::vector<NodeWithRange>& result_nodes) {
+  ASSERT_EQ(lane_ids.size(), result_nodes.size());
+  for (size_t i = 0; i < lane_ids.size(); ++i) {
+    EXPECT_EQ(lane_ids[i], result_nodes[i].LaneId());
+    EXPECT_DOUBLE_EQ(0.0, result_nodes[i].StartS());
+    EXPECT_DOUBLE_EQ(TEST_LANE_LENGTH, result_nodes[i].EndS());
+  }
+}
+
+}  // namespace
+
+TEST(AStarStrategyTestSuit, test_search) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_5 = topo_graph.GetNode(TEST_L5);
+  const TopoNode* node_6 = topo_graph.GetNode(TEST_L6);
+
+  TopoRangeManager range_manager;
+  SubTopoGraph sub_graph(range_manager.RangeMap());
+  std::vector<NodeWithRange> result_nodes;
+  AStarStrategy strategy(true);
+  ASSERT_TRUE(
+      strategy.Search(&topo_graph, &sub_graph, node_1, node_6, &result_nodes));
+  ExpectRoute({TEST_L1, TEST_L2, TEST_L4, TEST_L6}, result_nodes);
+  // The same strategy searches again, as for the next pair of waypoints.
+  ASSERT_TRUE(
+      strategy.Search(&topo_graph, &sub_graph, node_1, node_5, &result_nodes));
+  ExpectRoute({TEST_L1, TEST_L3, TEST_L5}, result_nodes);
+
+  AStarStrategy forward_strategy(false);
+  ASSERT_TRUE(forward_strategy.Search(&topo_graph, &sub_graph, node_1, node_5,
+                                      &result_nodes));
+  ExpectRoute({TEST_L1, TEST_L3, TEST_L5}, result_nodes);
+  EXPECT_FALSE(forward_strategy.Search(&topo_graph, &sub_graph, node_1, node_6,
+                                       &result_nodes));
+}
+
+TEST(AStarStrategyTestSuit, test_search_with_black_list) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_3 = topo_graph.GetNode(TEST_L3);
+  const TopoNode* node_5 = topo_graph.GetNode(TEST_L5);
+
+  TopoRangeManager range_manager;
+  range_manager.Add(node_3, 40.0, 60.0);
+  SubTopoGraph sub_graph(range_manager.RangeMap());
+  std::vector<NodeWithRange> result_nodes;
+  AStarStrategy strategy(true);
+  // The black list cuts L3 in two, so that the route goes around it.
+  ASSERT_TRUE(
+      strategy.Search(&topo_graph, &sub_graph, node_1, node_5, &result_nodes));
+  ExpectRoute({TEST_L1, TEST_L2, TEST_L4, TEST_L6, TEST_L5}, result_nodes);
+
+  AStarStrategy forward_strategy(false);
+  EXPECT_FALSE(forward_strategy.Search(&topo_graph, &sub_graph, node_1, node_5,
+                                       &result_nodes));
+}
+
+}  // namespace routing
+}  // namespace apollo